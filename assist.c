@@ -173,24 +173,24 @@ DEF_INST(obtain_local_lock)
 
     PERFORM_SERIALIZATION(regs);
 
-    /* MAINLOCK may be required if cmpxchg assists unavailable */
-    OBTAIN_MAINLOCK(regs);
-    {
-        if (ACCESS_REGISTER_MODE(&regs->psw))
-            acc_mode = USE_PRIMARY_SPACE;
+    if (ACCESS_REGISTER_MODE(&regs->psw))
+        acc_mode = USE_PRIMARY_SPACE;
 
-        /* Load ASCB address from first operand location */
-        ascb_addr = ARCH_DEP(vfetch4) ( effective_addr1, acc_mode, regs );
+    /* Load ASCB address from first operand location */
+    ascb_addr = ARCH_DEP(vfetch4) ( effective_addr1, acc_mode, regs );
 
-        /* Load locks held bits from second operand location */
-        hlhi_word = ARCH_DEP(vfetch4) ( effective_addr2, acc_mode, regs );
+    /* Load locks held bits from second operand location */
+    hlhi_word = ARCH_DEP(vfetch4) ( effective_addr2, acc_mode, regs );
 
-        /* Fetch our logical CPU address from PSALCPUA */
-        lcpa = ARCH_DEP(vfetch4) ( effective_addr2 - 4, acc_mode, regs );
+    /* Fetch our logical CPU address from PSALCPUA */
+    lcpa = ARCH_DEP(vfetch4) ( effective_addr2 - 4, acc_mode, regs );
 
-        /* Get mainstor address of ASCBLOCK word */
-        mainstor = MADDRL (ascb_addr + ASCBLOCK, 4, b2, regs, ACCTYPE_WRITE, regs->psw.pkey);
+    /* Get mainstor address of ASCBLOCK word */
+    mainstor = MADDRL (ascb_addr + ASCBLOCK, 4, b2, regs, ACCTYPE_WRITE, regs->psw.pkey);
 
+    /* MAINLOCK may be required if cmpxchg assists unavailable */
+    OBTAIN_MAINLOCK(regs, mainstor);
+    {
         /* The lock word should contain 0; use this as our compare value.
            Swap in the CPU address in lpca */
         old = 0;
@@ -254,6 +254,7 @@ U32     lock;                           /* Lock value                */
 U32     susp;                           /* Lock suspend queue        */
 U32     lcpa;                           /* Logical CPU address       */
 VADR    newia;                          /* Unsuccessful branch addr  */
+BYTE   *mainstor;                       /* mainstor address of lock  */
 int     acc_mode = 0;                   /* access mode to use        */
 
     SSE(inst, regs, b1, effective_addr1, b2, effective_addr2);
@@ -265,9 +266,6 @@ int     acc_mode = 0;                   /* access mode to use        */
     if ((effective_addr1 & 0x00000003) || (effective_addr2 & 0x00000003))
         ARCH_DEP(program_interrupt) (regs, PGM_SPECIFICATION_EXCEPTION);
 
-    /* Obtain main-storage access lock */
-    OBTAIN_MAINLOCK_UNCONDITIONAL(regs);
-
     if (ACCESS_REGISTER_MODE(&regs->psw))
         acc_mode = USE_PRIMARY_SPACE;
 
@@ -280,8 +278,12 @@ int     acc_mode = 0;                   /* access mode to use        */
     /* Fetch our logical CPU address from PSALCPUA */
     lcpa = ARCH_DEP(vfetch4) ( effective_addr2 - 4, acc_mode, regs );
 
-    /* Fetch the local lock and the suspend queue from the ASCB */
+    /* Obtain main-storage access lock for the local lock word */
     lock_addr = (ascb_addr + ASCBLOCK) & ADDRESS_MAXWRAP(regs);
+    mainstor = MADDRL (lock_addr, 4, acc_mode, regs, ACCTYPE_READ, regs->psw.pkey);
+    OBTAIN_MAINLOCK_UNCONDITIONAL(regs, mainstor);
+
+    /* Fetch the local lock and the suspend queue from the ASCB */
     susp_addr = (ascb_addr + ASCBLSWQ) & ADDRESS_MAXWRAP(regs);
     lock = ARCH_DEP(vfetch4) ( lock_addr, acc_mode, regs );
     susp = ARCH_DEP(vfetch4) ( susp_addr, acc_mode, regs );
@@ -368,18 +370,21 @@ DEF_INST(obtain_cms_lock)
     lock_addr = regs->GR_L(11) & ADDRESS_MAXWRAP(regs);
     lock_arn = 11;
 
-    /* MAINLOCK may be required if cmpxchg assists unavailable */
-    OBTAIN_MAINLOCK(regs);
-    {
-        if (ACCESS_REGISTER_MODE(&regs->psw))
-            acc_mode = USE_PRIMARY_SPACE;
+    if (ACCESS_REGISTER_MODE(&regs->psw))
+        acc_mode = USE_PRIMARY_SPACE;
+
+    /* Load ASCB address from first operand location */
+    ascb_addr = ARCH_DEP(vfetch4) ( effective_addr1, acc_mode, regs );
 
-        /* Load ASCB address from first operand location */
-        ascb_addr = ARCH_DEP(vfetch4) ( effective_addr1, acc_mode, regs );
+    /* Load locks held bits from second operand location */
+    hlhi_word = ARCH_DEP(vfetch4) ( effective_addr2, acc_mode, regs );
 
-        /* Load locks held bits from second operand location */
-        hlhi_word = ARCH_DEP(vfetch4) ( effective_addr2, acc_mode, regs );
+    /* Get mainstor address of lock word */
+    mainstor = MADDRL (lock_addr, 4, acc_mode, regs, ACCTYPE_READ, regs->psw.pkey);
 
+    /* MAINLOCK may be required if cmpxchg assists unavailable */
+    OBTAIN_MAINLOCK(regs, mainstor);
+    {
         /* Fetch the lock addressed by general register 11 */
         lock = ARCH_DEP(vfetch4) ( lock_addr, acc_mode, regs );
 
@@ -458,6 +463,7 @@ int     lock_arn;                       /* Lock access register      */
 U32     lock;                           /* Lock value                */
 U32     susp;                           /* Lock suspend queue        */
 VADR    newia;                          /* Unsuccessful branch addr  */
+BYTE   *mainstor;                       /* mainstor address of lock  */
 int     acc_mode = 0;                   /* access mode to use        */
 
     SSE(inst, regs, b1, effective_addr1, b2, effective_addr2);
@@ -473,9 +479,6 @@ int     acc_mode = 0;                   /* access mode to use        */
     lock_addr = regs->GR_L(11) & ADDRESS_MAXWRAP(regs);
     lock_arn = 11;
 
-    /* Obtain main-storage access lock */
-    OBTAIN_MAINLOCK_UNCONDITIONAL(regs);
-
     if (ACCESS_REGISTER_MODE(&regs->psw))
         acc_mode = USE_PRIMARY_SPACE;
 
@@ -485,6 +488,10 @@ int     acc_mode = 0;                   /* access mode to use        */
     /* Load locks held bits from second operand location */
     hlhi_word = ARCH_DEP(vfetch4) ( effective_addr2, acc_mode, regs );
 
+    /* Obtain main-storage access lock for the CMS lock word */
+    mainstor = MADDRL (lock_addr, 4, acc_mode, regs, ACCTYPE_READ, regs->psw.pkey);
+    OBTAIN_MAINLOCK_UNCONDITIONAL(regs, mainstor);
+
     /* Fetch the CMS lock and the suspend queue word */
     lock = ARCH_DEP(vfetch4) ( lock_addr, acc_mode, regs );
     susp = ARCH_DEP(vfetch4) ( lock_addr + 4, acc_mode, regs );
@@ -189,6 +189,7 @@ static INLINE void ETOD_sub  (ETOD* result, const ETOD a, const ETOD b );
 static INLINE void ETOD_shift(ETOD* result, const ETOD a, int shift    );
 
 static INLINE TOD  host_tod();
+static INLINE U64  host_cycles();
 static INLINE TOD  ETOD2TOD                 ( const ETOD ETOD );
 static INLINE TOD  ETOD_high64_to_TOD_high56( const U64  etod );
 static INLINE TOD  TOD_high64_to_ETOD_high56( const TOD   tod );
@@ -595,6 +596,28 @@ TOD host_tod()
   return ( result );
 }
 
+/*-------------------------------------------------------------------*/
+/*                          host_cycles                              */
+/*-------------------------------------------------------------------*/
+/* Cheapest available free running host counter for measuring short */
+/* intervals (e.g. instruction execution times). The units are host  */
+/* dependent (TSC cycles on x86, the generic timer on ARM64, else    */
+/* host_tod units) so results can only be compared with each other. */
+/*-------------------------------------------------------------------*/
+static INLINE
+U64 host_cycles()
+{
+#if defined( _MSVC_ ) || defined( _GCC_SSE2_ )
+  return __rdtsc();
+#elif defined( __GNUC__ ) && defined( __aarch64__ )
+  U64  cycles;
+  __asm__ __volatile__( "mrs %0, cntvct_el0" : "=r" (cycles) );
+  return cycles;
+#else
+  return host_tod();
+#endif
+}
+
 #endif // _CLOCK_H
 
 /*-------------------------------------------------------------------*/
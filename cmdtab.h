@@ -367,6 +367,24 @@
   "Entering the command with no arguments displays the current value.\n"
 
 #define cpuidfmt_cmd_desc       "Set format BASIC/0/1 STIDP generation"
+#define cpuloops_cmd_desc       "Display or set adaptive interrupt check interval"
+#define cpuloops_cmd_help       \
+                                \
+  "Format: \"cpuloops [nnn | OFF | RESET]\"\n"                                  \
+  "\n"                                                                          \
+  "Each CPU executes a number of instructions between its checks for\n"         \
+  "pending interrupts. By default (OFF) this interval is fixed at 256\n"        \
+  "instructions. Specifying 'nnn' sets an interrupt latency target in\n"        \
+  "microseconds instead: each CPU then measures how long pending I/O,\n"        \
+  "external call and emergency signal interrupts wait before it notices\n"      \
+  "them and narrows or widens its interval (between 16 and 8192\n"              \
+  "instructions) to meet it. A low target favors I/O response times;\n"         \
+  "a high target favors throughput.\n"                                          \
+  "\n"                                                                          \
+  "Entering \"cpuloops\" by itself displays the current target and, for\n"      \
+  "each online CPU, its current interval and observed interrupt latency.\n"     \
+  "'RESET' resets the latency statistics.\n"
+
 #define cpumodel_cmd_desc       "Set CPU model number"
 #define cpuserial_cmd_desc      "Set CPU serial number"
 #define cpuverid_cmd_desc       "Set CPU verion number"
@@ -526,6 +544,18 @@
   "directly to the host operating system via the 'sh' and 'exec' commands.\n"   \
   "Use the SHCMDOPT command's NODIAG8 option to disable this ability.\n"
 
+#define dirty_cmd_desc          "Display or reset changed frame statistics"
+#define dirty_cmd_help          \
+                                \
+  "Format: \"dirty [RESET]\"\n"                                                  \
+  "\n"                                                                          \
+  "Entering \"dirty\" by itself displays how many 4K frames of main storage\n"   \
+  "have been changed since the host's changed frame bitmap was last reset\n"   \
+  "(or storage was last cleared) and the rate at which they were changed.\n"   \
+  "\n"                                                                          \
+  "'RESET' displays the same statistics and then clears the bitmap, which\n"   \
+  "starts a new interval.\n"
+
 #define ds_cmd_desc             "Display subchannel"
 #define ecps_cmd_desc           "Command deprecated - Use \"ECPSVM\""
 #define ecps_cmd_help           \
@@ -702,7 +732,8 @@
 #define icount_cmd_desc         "Display individual instruction counts"
 #define icount_cmd_help         \
                                 \
-  "Format: \"icount [[Enable|STArt] | [Disable|STOp] | [Clear|Reset|Zero]]\".\n" \
+  "Format: \"icount [Enable|STArt | Disable|STOp | Clear|Reset|Zero]\"\n"       \
+  "        \"icount [SAmple n | CSV filename | JSON filename]\"\n"              \
   "\n"                                                                          \
   "Enables or disables the counting of, resets the counts for, or\n"            \
   "displays how often each instruction opcode is executed. This is a\n"         \
@@ -715,7 +746,13 @@
   "before enabling counting when your workload begins. Use the stop\n"          \
   "option when your workload ends to stop counting. Enter the command\n"        \
   "with no options to display a list of executed instruction opcodes\n"         \
-  "sorted by frequency/popularity.\n"
+  "sorted by frequency/popularity.\n"                                           \
+  "\n"                                                                          \
+  "Each CPU counts separately; the counts are merged when displayed.\n"         \
+  "Execution time is measured in host cycles for one out of every n\n"          \
+  "instructions (SAMPLE option, default 64; 1 times every instruction).\n"      \
+  "The CSV and JSON options write the counts, timed samples, total\n"           \
+  "cycles and a log2 histogram of the cycles of each opcode to a file.\n"
 
 #define iodelay_cmd_desc        "Display or set I/O delay value"
 #define iodelay_cmd_help        \
@@ -857,7 +894,9 @@
 #define mainsize_cmd_desc       "Define/Display mainsize parameter"
 #define mainsize_cmd_help       \
                                 \
-  "Format: mainsize [ mmmm | nnnS [ lOCK | unlOCK ] ]\n"                        \
+  "Format: mainsize [ mmmm | nnnS [ lOCK | unlOCK ] [ HUGEpages | THP |\n"      \
+  "                                  NOHUGEpages ] [ INTERleave | NODE=n |\n"  \
+  "                                  ANYnode ] ]\n"                             \
   "        mmmm    - define main storage size mmmm Megabytes\n"                 \
   "\n"                                                                          \
   "        nnnS    - define main storage size nnn S where S is the\n"           \
@@ -873,6 +912,14 @@
   "        lOCK    - attempt to lock storage (pages lock by host OS)\n"         \
   "        unlOCK  - leave storage unlocked (pagable by host OS)\n"             \
   "\n"                                                                          \
+  "        HUGEpages   - back storage with hugetlb host pages, falling back\n"  \
+  "                      to transparent huge pages if none are available\n"   \
+  "        THP         - back storage with transparent huge pages\n"          \
+  "        NOHUGEpages - use the normal host pages (default)\n"                \
+  "        INTERleave  - interleave storage across all host NUMA nodes\n"      \
+  "        NODE=n      - bind storage to host NUMA node n\n"                   \
+  "        ANYnode     - use the host's default NUMA policy (default)\n"       \
+  "\n"                                                                          \
   "      (none)    - display current mainsize value\n"                          \
   "\n"                                                                          \
   " Note: Multipliers 'T', 'P', and 'E' are not available on 32bit machines\n"
@@ -1123,6 +1170,26 @@
   "\n"                                                                          \
   "Enter \"psw\" by itself to display the current PSW without altering it.\n"
 
+#define pswprof_cmd_desc        "PSW sampling profiler"
+#define pswprof_cmd_help        \
+                                \
+  "Format: \"pswprof [ON [nnn] | OFF | RESET | FOLDED file | PPROF file]\"\n"   \
+  "\n"                                                                          \
+  "'ON' starts sampling the instruction address of every running CPU\n"        \
+  "each 'nnn' microseconds (default 1000, but never more often than the\n"     \
+  "timerint value). The samples are taken by the timer thread, so the\n"       \
+  "CPUs themselves run at full speed. Each sample is recorded against\n"       \
+  "its CPU, problem or supervisor state, SIE guest state and primary\n"        \
+  "address space number. 'OFF' stops sampling but keeps the samples.\n"        \
+  "'RESET' discards them.\n"                                                   \
+  "\n"                                                                          \
+  "'FOLDED file' writes the samples as folded stacks for flamegraph.pl\n"      \
+  "or speedscope. 'PPROF file' writes a legacy gperftools CPU profile\n"       \
+  "which can be read by pprof.\n"                                              \
+  "\n"                                                                          \
+  "Entering \"pswprof\" by itself displays the sampling status and the\n"      \
+  "ten most frequently sampled addresses.\n"
+
 #define ptp_cmd_desc            "Enable/Disable PTP debugging"
 #define ptp_cmd_help            \
                                 \
@@ -1607,6 +1674,21 @@
 
 #endif // defined( OPTION_SHARED_DEVICES )
 
+#define simd_cmd_desc           "Display or set the host SIMD kernels"
+#define simd_cmd_help           \
+                                \
+  "Format: \"simd [NONE | SSE2 | AVX2 | BEST]\"\n"                              \
+  "\n"                                                                          \
+  "Entering \"simd\" by itself displays which host SIMD kernels are used\n"     \
+  "by the instructions which move long operands, and the best ones the\n"     \
+  "host CPU supports. At startup the best ones are selected. Selecting\n"     \
+  "NONE makes those instructions use their plain C loops instead, which is\n"  \
+  "mostly useful when measuring the kernels' effect.\n"                       \
+  "\n"                                                                          \
+  "With SSE2 or AVX2 selected, the crypto instructions (KM, KMC, KMCTR,\n"     \
+  "KIMD and KLMD) also use the host's AES, SHA and PCLMULQDQ instructions\n"  \
+  "where the host CPU has them; NONE makes them use the portable C code.\n"
+
 #define sizeof_cmd_desc         "Display size of structures"
 #define spm_cmd_desc            "SIE performance monitor"
 #define ssd_cmd_desc            "Signal shutdown"
@@ -1842,7 +1924,20 @@
   "in relationship to the actual process priority (nice value) of the\n"        \
   "Hercules process itself.\n"
 
-#define tlb_cmd_desc            "Display TLB tables"
+#define tlb_cmd_desc            "Display TLB tables or statistics"
+#define tlb_cmd_help            \
+                                \
+  "Format: \"tlb [STATS | RESET]\"\n"                                            \
+  "\n"                                                                          \
+  "Entering \"tlb\" by itself displays the translation lookaside buffer\n"     \
+  "entries of the target cpu.\n"                                               \
+  "\n"                                                                          \
+  "'STATS' displays the TLB geometry (number of sets and ways, chosen\n"       \
+  "at build time via TLB_SETS and TLB_WAYS) and, for each online CPU,\n"       \
+  "the number of storage accesses which hit or missed in its TLB since\n"      \
+  "the last 'RESET', and how many of its misses for pages of EDAT-1\n"         \
+  "1M frames were resolved from large frame entries without walking\n"         \
+  "the DAT tables.\n"
 #define toddrag_cmd_desc        "Display or set TOD clock drag factor"
 #define traceopt_cmd_desc       "Instruction and/or CCW trace display option"
 #define traceopt_cmd_help       \
@@ -1887,7 +1982,7 @@
 #define xpndsize_cmd_desc       "Define/Display xpndsize parameter"
 #define xpndsize_cmd_help       \
                                 \
-  "Format: xpndsize [ mmmm | nnnS [ lOCK | unlOCK ] ]\n"                                \
+  "Format: xpndsize [ mmmm | nnnS [ lOCK | unlOCK ] [ FILE=path | NOFile ] ]\n"         \
   "        mmmm    - define expanded storage size mmmm Megabytes\n"                     \
   "\n"                                                                                  \
   "        nnnS    - define expanded storage size nnn S where S is the multiplier\n"    \
@@ -1900,6 +1995,11 @@
   "        lOCK    - attempt to lock storage (pages lock by host OS)\n"                 \
   "        unlOCK  - leave storage unlocked (pagable by host OS)\n"                     \
   "\n"                                                                                  \
+  "        FILE=path - back storage with a sparse host file which is created\n"         \
+  "                    (or emptied) and mapped, so that expanded storage can\n"         \
+  "                    be larger than host memory without using host swap\n"            \
+  "        NOFile    - back storage with host memory (default)\n"                       \
+  "\n"                                                                                  \
   " Note: Multiplier 'T' is not available on 32bit machines\n"                          \
   "       Expanded storage is limited to 1G on 32bit machines\n"
 
@@ -1985,9 +2085,11 @@ COMMAND( "clocks",                  clocks_cmd,             SYSCMDNOPER,
 COMMAND( "codepage",                codepage_cmd,           SYSCMDNOPER,        codepage_cmd_desc,      codepage_cmd_help   )
 COMMAND( "conkpalv",                conkpalv_cmd,           SYSCMDNOPER,        conkpalv_cmd_desc,      conkpalv_cmd_help   )
 COMMAND( "cp_updt",                 cp_updt_cmd,            SYSCMDNOPER,        cp_updt_cmd_desc,       cp_updt_cmd_help    )
+COMMAND( "cpuloops",                cpuloops_cmd,           SYSCMDNOPER,        cpuloops_cmd_desc,      cpuloops_cmd_help   )
 COMMAND( "cr",                      cr_cmd,                 SYSCMDNOPER,        cr_cmd_desc,            cr_cmd_help         )
 COMMAND( "cscript",                 cscript_cmd,            SYSCMDNOPER,        cscript_cmd_desc,       cscript_cmd_help    )
 COMMAND( "ctc",                     ctc_cmd,                SYSCMDNOPER,        ctc_cmd_desc,           ctc_cmd_help        )
+COMMAND( "dirty",                   dirty_cmd,              SYSCMDNOPER,        dirty_cmd_desc,         dirty_cmd_help      )
 COMMAND( "ds",                      ds_cmd,                 SYSCMDNOPER,        ds_cmd_desc,            NULL                )
 COMMAND( "f?",                      fquest_cmd,             SYSCMDNOPER,        fquest_cmd_desc,        NULL                )
 COMMAND( "fpc",                     fpc_cmd,                SYSCMDNOPER,        fpc_cmd_desc,           fpc_cmd_help        )
@@ -2009,6 +2111,7 @@ COMMAND( "ostailor",                ostailor_cmd,           SYSCMDNOPER,
 COMMAND( "pgmtrace",                pgmtrace_cmd,           SYSCMDNOPER,        pgmtrace_cmd_desc,      pgmtrace_cmd_help   )
 COMMAND( "pr",                      pr_cmd,                 SYSCMDNOPER,        pr_cmd_desc,            pr_cmd_help         )
 COMMAND( "psw",                     psw_cmd,                SYSCMDNOPER,        psw_cmd_desc,           psw_cmd_help        )
+COMMAND( "pswprof",                 pswprof_cmd,            SYSCMDNOPER,        pswprof_cmd_desc,       pswprof_cmd_help    )
 COMMAND( "ptp",                     ptp_cmd,                SYSCMDNOPER,        ptp_cmd_desc,           ptp_cmd_help        )
 COMMAND( "ptt",                     EXTCMD( ptt_cmd ),      SYSCMDNOPER,        ptt_cmd_desc,           ptt_cmd_help        )
 COMMAND( "qd",                      qd_cmd,                 SYSCMDNOPER,        qd_cmd_desc,            qd_cmd_help         )
@@ -2025,6 +2128,7 @@ COMMAND( "s+",                      trace_cmd,              SYSCMDNOPER,
 COMMAND( "savecore",                savecore_cmd,           SYSCMDNOPER,        savecore_cmd_desc,      savecore_cmd_help   )
 COMMAND( "script",                  script_cmd,             SYSCMDNOPER,        script_cmd_desc,        script_cmd_help     )
 COMMAND( "sh",                      sh_cmd,                 SYSCMDNOPER,        sh_cmd_desc,            sh_cmd_help         )
+COMMAND( "simd",                    simd_cmd,               SYSCMDNOPER,        simd_cmd_desc,          simd_cmd_help       )
 COMMAND( "suspend",                 suspend_cmd,            SYSCMDNOPER,        suspend_cmd_desc,       NULL                )
 COMMAND( "symptom",                 traceopt_cmd,           SYSCMDNOPER,        symptom_cmd_desc,       NULL                )
 
@@ -2038,7 +2142,7 @@ COMMAND( "txf",                     txf_cmd,                SYSCMDNOPER,
 #endif
 COMMAND( "t+-",                     auto_trace_cmd,         SYSCMDNOPER,        auto_trace_desc,        auto_trace_help     )
 COMMAND( "timerint",                timerint_cmd,           SYSCMDNOPER,        timerint_cmd_desc,      timerint_cmd_help   )
-COMMAND( "tlb",                     tlb_cmd,                SYSCMDNOPER,        tlb_cmd_desc,           NULL                )
+COMMAND( "tlb",                     tlb_cmd,                SYSCMDNOPER,        tlb_cmd_desc,           tlb_cmd_help        )
 COMMAND( "toddrag",                 toddrag_cmd,            SYSCMDNOPER,        toddrag_cmd_desc,       NULL                )
 COMMAND( "traceopt",                traceopt_cmd,           SYSCMDNOPER,        traceopt_cmd_desc,      traceopt_cmd_help   )
 COMMAND( "u",                       u_cmd,                  SYSCMDNOPER,        u_cmd_desc,             u_cmd_help          )
@@ -230,6 +230,397 @@ DISABLE_GCC_WARNING( "-Wint-to-pointer-cast" )
 /* configure_storage - configure MAIN storage                        */
 /*-------------------------------------------------------------------*/
 
+/*-------------------------------------------------------------------*/
+/* Main storage host page backing and NUMA placement                 */
+/*-------------------------------------------------------------------*/
+/* Main storage is an anonymous demand-zero mapping (calloc is only */
+/* used on Windows), so host memory is committed only as the guest   */
+/* touches its storage, and clearing it hands the pages back to the  */
+/* host instead of writing zeroes over all of it. Main storage proper*/
+/* is aligned on a host (or huge) page boundary with the storage key */
+/* array placed just below it. Explicit hugetlb pages fall back to   */
+/* transparent huge pages, and those to the normal host pages, when  */
+/* the host cannot provide them. The page size actually obtained is  */
+/* recorded in SYSBLK for the qstor command.                         */
+/*-------------------------------------------------------------------*/
+
+static size_t config_allocmlen   = 0;   /* Mapped length; 0 = calloc */
+static BYTE   config_allocpages  = MAINPAGES_DEFAULT;
+static int    config_allocnode   = MAINNODE_ANY;
+
+static const char* mainpages_name( BYTE mainpages )
+{
+    switch (mainpages)
+    {
+    case MAINPAGES_HUGETLB: return "hugetlb";
+    case MAINPAGES_THP:     return "transparent huge";
+    default:                return "normal";
+    }
+}
+
+#if !defined( _MSVC_ )
+
+#if !defined( MAP_NORESERVE )
+  #define MAP_NORESERVE  0
+#endif
+
+/* Return host's default hugetlb page size, or 0 if unknown */
+static U64 hugetlb_pagesize()
+{
+    FILE*  f;
+    char   line[128];
+    U64    kb = 0;
+
+    if ((f = fopen( "/proc/meminfo", "r" )))
+    {
+        while (fgets( line, sizeof( line ), f ))
+            if (sscanf( line, "Hugepagesize: %"SCNu64, &kb ) == 1)
+                break;
+        fclose( f );
+    }
+    return kb << SHIFT_KIBIBYTE;
+}
+
+/* Return host's transparent huge page size (2M if unknown) */
+static U64 thp_pagesize()
+{
+    FILE*  f;
+    U64    size = 0;
+
+    if ((f = fopen( "/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r" )))
+    {
+        if (fscanf( f, "%"SCNu64, &size ) != 1)
+            size = 0;
+        fclose( f );
+    }
+    return size ? size : (2 * ONE_MEGABYTE);
+}
+
+/* Apply the requested NUMA memory policy to a fresh mapping */
+static void mainstor_numa_policy( BYTE* addr, size_t len, int node )
+{
+#if defined( __linux__ ) && defined( SYS_mbind )
+    unsigned long  mask  = 0;
+    int            mode;
+
+    if (node == MAINNODE_INTERLEAVE)
+    {
+        FILE*  f;
+        int    lo, hi;
+        char   sep;
+
+        /* Interleave across the online nodes, e.g. "0-3,6" */
+        if ((f = fopen( "/sys/devices/system/node/online", "r" )))
+        {
+            while (fscanf( f, "%d", &lo ) == 1)
+            {
+                hi = lo;
+                if (fscanf( f, "%c", &sep ) == 1 && sep == '-')
+                    if (fscanf( f, "%d%c", &hi, &sep ) < 1)
+                        break;
+                for (; lo <= hi && lo < (int)(sizeof( mask ) * 8); ++lo)
+                    mask |= 1UL << lo;
+                if (sep != ',')
+                    break;
+            }
+            fclose( f );
+        }
+        if (!mask)
+            mask = 1;
+        mode = 3;                       /* MPOL_INTERLEAVE           */
+    }
+    else
+    {
+        if (node >= (int)(sizeof( mask ) * 8))
+        {
+            // "Error in function %s: %s"
+            WRMSG( HHC01430, "W", "mbind()", strerror( EINVAL ));
+            return;
+        }
+        mask = 1UL << node;
+        mode = 2;                       /* MPOL_BIND                 */
+    }
+
+    if (syscall( SYS_mbind, addr, len, mode, &mask,
+                 sizeof( mask ) * 8, 0 ) != 0)
+        // "Error in function %s: %s"
+        WRMSG( HHC01430, "W", "mbind()", strerror( errno ));
+#else
+    UNREFERENCED( addr );
+    UNREFERENCED( len );
+    UNREFERENCED( node );
+    // "%s support not included in this engine build"
+    WRMSG( HHC17015, "W", "NUMA" );
+#endif
+}
+
+#endif // !defined( _MSVC_ )
+
+/* Obtain zeroed storage for the storage key array followed by main
+   storage. Returns the allocation (to be passed to free_mainstor
+   along with *mlen), and sets *storkeys to the page aligned storage
+   key array. */
+static BYTE* alloc_mainstor( U64 storsize, U32 skeysize,
+                             BYTE** storkeys, size_t* mlen )
+{
+    BYTE*  addr;
+
+    *mlen = 0;
+
+#if !defined( _MSVC_ )
+    {
+        size_t  skeybytes  = (size_t) skeysize << SHIFT_4K;
+        size_t  mainbytes  = (size_t)(storsize - skeysize) << SHIFT_4K;
+        size_t  pagesz     = (size_t) hostinfo.hostpagesz;
+        size_t  keyspan, len;
+        BYTE    obtained   = MAINPAGES_DEFAULT;
+
+        addr = MAP_FAILED;
+
+  #if defined( MAP_HUGETLB )
+        if (sysblk.mainpages == MAINPAGES_HUGETLB
+         && (pagesz = (size_t) hugetlb_pagesize()) != 0)
+        {
+            keyspan = ROUND_UP( skeybytes, pagesz );
+            len     = keyspan + ROUND_UP( mainbytes, pagesz );
+            addr = mmap( NULL, len, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+            if (addr != MAP_FAILED)
+            {
+                obtained = MAINPAGES_HUGETLB;
+                *mlen = len;
+                *storkeys = addr + keyspan - skeybytes;
+            }
+        }
+  #endif
+        if (addr == MAP_FAILED)
+        {
+            /* Over-allocate by one (huge) page so that main storage
+               can be aligned on a (huge) page boundary. No swap is
+               reserved: most of a large guest is usually never used */
+            pagesz  = (size_t)(sysblk.mainpages != MAINPAGES_DEFAULT ?
+                               thp_pagesize() : hostinfo.hostpagesz);
+            keyspan = ROUND_UP( skeybytes, pagesz );
+            len     = keyspan + ROUND_UP( mainbytes, pagesz ) + pagesz;
+            addr = mmap( NULL, len, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                         -1, 0 );
+            if (addr == MAP_FAILED)
+                return NULL;
+
+            *mlen = len;
+            *storkeys = (BYTE*) ROUND_UP( (uintptr_t) addr, pagesz )
+                      + keyspan - skeybytes;
+
+  #if defined( MADV_HUGEPAGE )
+            if (sysblk.mainpages != MAINPAGES_DEFAULT
+             && madvise( addr, len, MADV_HUGEPAGE ) == 0)
+                obtained = MAINPAGES_THP;
+  #endif
+            if (obtained == MAINPAGES_DEFAULT)
+                pagesz = (size_t) hostinfo.hostpagesz;
+        }
+
+        if (sysblk.mainnode != MAINNODE_ANY)
+            mainstor_numa_policy( addr, len, sysblk.mainnode );
+
+        sysblk.mainpagesz   = pagesz;
+        sysblk.mainpagetype = mainpages_name( obtained );
+
+        if (obtained < sysblk.mainpages)
+            // "%s pages for %s storage not available; using %s pages instead"
+            WRMSG( HHC17017, "W", mainpages_name( sysblk.mainpages ),
+                "main", sysblk.mainpagetype );
+
+        return addr;
+    }
+#else
+    /* Obtain storage with pagesize hint for cleanest allocation */
+    if (!(addr = calloc( (size_t)(storsize + 1), _4K )))
+        return NULL;
+
+    *storkeys = (BYTE*)(((U64)addr + (_4K-1)) & ~0x0FFFULL);
+
+    sysblk.mainpagesz   = hostinfo.hostpagesz;
+    sysblk.mainpagetype = mainpages_name( MAINPAGES_DEFAULT );
+
+    if (sysblk.mainpages != MAINPAGES_DEFAULT)
+        // "%s pages for %s storage not available; using %s pages instead"
+        WRMSG( HHC17017, "W", mainpages_name( sysblk.mainpages ),
+            "main", sysblk.mainpagetype );
+
+    return addr;
+#endif
+}
+
+/* Release storage obtained by alloc_mainstor */
+static void free_mainstor( BYTE* addr, size_t mlen )
+{
+#if !defined( _MSVC_ )
+    if (mlen)
+    {
+        munmap( addr, mlen );
+        return;
+    }
+#else
+    UNREFERENCED( mlen );
+#endif
+    free( addr );
+}
+
+/*-------------------------------------------------------------------*/
+/* clear_mainstor  --  clear main storage and its storage keys       */
+/*-------------------------------------------------------------------*/
+/* Whole host pages of mapped storage are discarded rather than      */
+/* zeroed, the host supplying zeroed pages again when they are next  */
+/* touched, so clearing a large mostly untouched guest is cheap.     */
+/*-------------------------------------------------------------------*/
+void clear_mainstor()
+{
+    BYTE*  beg  = sysblk.storkeys;
+    BYTE*  end  = sysblk.mainstor + sysblk.mainsize;
+
+    if (!sysblk.mainstor || !beg)
+        return;
+
+    /* Changes are tracked from when storage was last cleared */
+    if (sysblk.dirtymap)
+        memset( sysblk.dirtymap, 0x00, DIRTYMAP_BYTES( sysblk.mainsize ));
+    sysblk.dirtytime = host_tod();
+
+#if !defined( _MSVC_ ) && defined( MADV_DONTNEED )
+    if (config_allocmlen)
+    {
+        uintptr_t  pagesz  = (uintptr_t) sysblk.mainpagesz;
+        BYTE*      lo      = (BYTE*)(((uintptr_t) beg + pagesz - 1) & ~(pagesz - 1));
+        BYTE*      hi      = (BYTE*)( (uintptr_t) end                & ~(pagesz - 1));
+
+        if (lo < hi && madvise( lo, hi - lo, MADV_DONTNEED ) == 0)
+        {
+            /* Zero any partial pages at either end */
+            memset( beg, 0x00, lo - beg );
+            memset( hi,  0x00, end - hi );
+            return;
+        }
+    }
+#endif
+
+    memset( sysblk.mainstor, 0x00, sysblk.mainsize );
+    memset( sysblk.storkeys, 0x00, sysblk.mainsize / _STORKEY_ARRAY_UNITSIZE );
+}
+
+/*-------------------------------------------------------------------*/
+/* mainstor_resident  --  bytes of main storage resident on the host */
+/*-------------------------------------------------------------------*/
+/* Returns ~0 if this cannot be determined (calloc'ed storage).      */
+/*-------------------------------------------------------------------*/
+U64 mainstor_resident()
+{
+#if !defined( _MSVC_ )
+    if (config_allocmlen && sysblk.mainstor)
+    {
+        unsigned char  vec[ 4096 ];
+        U64     pagesz    = hostinfo.hostpagesz;
+        U64     chunk     = pagesz * sizeof( vec );
+        U64     resident  = 0;
+        U64     off, len, i;
+
+        for (off=0; off < sysblk.mainsize; off += chunk)
+        {
+            len = MIN( chunk, sysblk.mainsize - off );
+
+            if (mincore( sysblk.mainstor + off, (size_t) len, (void*) vec ) != 0)
+                return ~0ULL;
+
+            for (i=0; i < (len + pagesz - 1) / pagesz; i++)
+                if (vec[i] & 1)
+                    resident += pagesz;
+        }
+        return MIN( resident, sysblk.mainsize );
+    }
+#endif
+    return ~0ULL;
+}
+
+/*-------------------------------------------------------------------*/
+/* get_dirty_frames  --  fetch (and clear) changed 4K frame bits     */
+/*-------------------------------------------------------------------*/
+/* Counts the 4K frames of absolute storage 'abs' for 'len' bytes    */
+/* changed since their bits were last cleared (or storage was), and  */
+/* if 'map' is not NULL sets their bits in it (0x80 of map[0] for    */
+/* the frame at 'abs'). If 'clear' is true each bit is atomically    */
+/* fetched and cleared, and the TLBs of all CPUs are then purged, as */
+/* a store that hits in a TLB does not set the change bit again: the */
+/* next store into a cleared frame marks it again, so the contents   */
+/* of the frames read after return include every unmarked change.    */
+/* (CPUs which are stopped purge their TLBs when they are started.)  */
+/*-------------------------------------------------------------------*/
+U64 get_dirty_frames( U64 abs, U64 len, BYTE* map, bool clear )
+{
+    U64   frame, end, count = 0;
+    BYTE* ptr;
+    BYTE  mask, old, got;
+    int   i;
+
+    if (!sysblk.dirtymap || abs >= sysblk.mainsize)
+        return 0;
+
+    len   = MIN( len, sysblk.mainsize - abs );
+    frame = abs >> SHIFT_4K;
+    end   = (abs + len + _4K - 1) >> SHIFT_4K;
+
+    if (map)
+        memset( map, 0x00, (size_t)((end - frame + 7) >> 3) );
+
+    while (frame < end)
+    {
+        ptr = &sysblk.dirtymap[ frame >> 3 ];
+
+        /* Skip 64 unchanged frames at a time */
+        if (!(frame & 63) && frame + 64 <= end && !*(U64*)ptr)
+        {
+            frame += 64;
+            continue;
+        }
+
+        /* Bits of this byte's frames within the range */
+        mask = 0xFF >> (frame & 7);
+        if (end - (frame & ~7ULL) < 8)
+            mask &= 0xFF << (8 - (end & 7));
+
+        if ((old = *ptr) & mask)
+        {
+            if (clear)
+                while (cmpxchg1( &old, old & ~mask, ptr ))
+                    ;   /* (old updated on failure) */
+
+            got = old & mask;
+
+            for (i=0; i < 8; i++)
+            {
+                if (got & (0x80 >> i))
+                {
+                    U64 n = (frame & ~7ULL) + i - (abs >> SHIFT_4K);
+                    if (map)
+                        map[ n >> 3 ] |= 0x80 >> (n & 7);
+                    count++;
+                }
+            }
+        }
+        frame = (frame | 7) + 1;
+    }
+
+    if (clear && count)
+    {
+        OBTAIN_INTLOCK( NULL );
+        {
+            tlb_shootdown( NULL, 0xFFFF, TLB_SHOOT_TLB, 0 );
+        }
+        RELEASE_INTLOCK( NULL );
+    }
+    return count;
+}
+
 static U64    config_allocmsize  = 0;
 static BYTE*  config_allocmaddr  = NULL;
 
@@ -237,7 +628,12 @@ int configure_storage( U64 mainsize /* number of 4K pages */ )
 {
     BYTE*  mainstor;
     BYTE*  storkeys;
+    BYTE*  allocaddr;
+    size_t alloclen;
+    BYTE*  dirtymap = NULL;
+    BYTE*  olddirty = NULL;
     BYTE*  dofree = NULL;
+    size_t doflen = 0;
     char*  mfree  = NULL;
     U64    storsize;
     U32    skeysize;
@@ -250,14 +646,17 @@ int configure_storage( U64 mainsize /* number of 4K pages */ )
     if (mainsize == ~0ULL)
     {
         if (config_allocmaddr)
-            free( config_allocmaddr );
+            free_mainstor( config_allocmaddr, config_allocmlen );
+        free( sysblk.dirtymap );
 
         sysblk.storkeys = 0;
         sysblk.mainstor = 0;
         sysblk.mainsize = 0;
+        sysblk.dirtymap = NULL;
 
         config_allocmsize = 0;
         config_allocmaddr = NULL;
+        config_allocmlen  = 0;
 
         return 0;
     }
@@ -308,23 +707,35 @@ int configure_storage( U64 mainsize /* number of 4K pages */ )
 
     /* New memory is obtained only if the requested and calculated size
      * is larger than the last allocated size, or if the request is for
-     * less than 2M of memory.
+     * less than 2M of memory, or if the host page backing or NUMA
+     * placement requested has changed (mapped storage is always
+     * obtained anew so that main storage stays huge page aligned).
      */
     if (0
         || (storsize > config_allocmsize)
         || (storsize < config_allocmsize && mainsize <= DEF_MAINSIZE_PAGES)
+        || (storsize != config_allocmsize && config_allocmlen)
+        || (sysblk.mainpages != config_allocpages)
+        || (sysblk.mainnode  != config_allocnode)
     )
     {
         if (config_mfree && mainsize > DEF_MAINSIZE_PAGES)
             mfree = malloc( config_mfree );
 
-        /* Obtain storage with pagesize hint for cleanest allocation */
-        storkeys = calloc( (size_t)(storsize + 1), _4K );
+        allocaddr = alloc_mainstor( storsize, skeysize, &storkeys, &alloclen );
+
+        /* Changed frame bitmap for the new storage */
+        if (allocaddr && !(dirtymap = calloc( DIRTYMAP_BYTES(
+            (storsize - skeysize) << SHIFT_4K ), 1 )))
+        {
+            free_mainstor( allocaddr, alloclen );
+            allocaddr = NULL;
+        }
 
         if (mfree)
             free( mfree );
 
-        if (!storkeys)
+        if (!allocaddr)
         {
             char buf[64];
             char memsize[64];
@@ -340,16 +751,21 @@ int configure_storage( U64 mainsize /* number of 4K pages */ )
         }
 
         /* Previously allocated storage to be freed, update actual
-         * storage pointers and adjust new storage to page boundary.
+         * storage pointers (storkeys is already on a page boundary).
          */
         dofree = config_allocmaddr;
+        doflen = config_allocmlen;
+        olddirty = sysblk.dirtymap;
+        sysblk.dirtymap = dirtymap;
+        sysblk.dirtytime = host_tod();
 
         config_allocmsize = storsize;
-        config_allocmaddr = storkeys;
+        config_allocmaddr = allocaddr;
+        config_allocmlen  = alloclen;
+        config_allocpages = sysblk.mainpages;
+        config_allocnode  = sysblk.mainnode;
 
         sysblk.main_clear = 1;
-
-        storkeys = (BYTE*)(((U64)storkeys + (_4K-1)) & ~0x0FFFULL);
     }
     else
     {
@@ -375,7 +791,10 @@ int configure_storage( U64 mainsize /* number of 4K pages */ )
      *         allocation.
      */
     if (dofree)
-        free( dofree );
+    {
+        free_mainstor( dofree, doflen );
+        free( olddirty );
+    }
 
     /* Initial power-on reset for main storage */
     storage_clear();  /* only clears if needed */
@@ -419,18 +838,171 @@ int configure_storage( U64 mainsize /* number of 4K pages */ )
 }
 
 /*-------------------------------------------------------------------*/
-/* configure_xstorage - configure EXPANDED storage                   */
+/* Expanded storage is normally obtained from host memory, but may   */
+/* instead be backed by a sparse host file (xpndsize FILE= option)   */
+/* which is mapped shared: blocks the guest pages out are then       */
+/* written back to the file rather than to swap when the host needs  */
+/* the memory, and read back on demand when the guest pages them in, */
+/* so expanded storage can be much larger than host memory.          */
 /*-------------------------------------------------------------------*/
 
 static U64    config_allocxsize  = 0;
 static BYTE*  config_allocxaddr  = NULL;
+static size_t config_allocxlen   = 0;   /* Mapped length; 0 = calloc */
+static int    config_allocxfd    = -1;  /* Backing file descriptor   */
+static char*  config_allocxfile  = NULL;/* Backing file name         */
+
+#if defined( _FEATURE_EXPANDED_STORAGE )
+
+/* Map 'xpndsize' megabytes of the (emptied) expanded storage file */
+static BYTE* alloc_xpndstor_file( U64 xpndsize, size_t* xlen, int* xfd )
+{
+#if !defined( _MSVC_ )
+    size_t  len  = (size_t) xpndsize << SHIFT_MEBIBYTE;
+    BYTE*   addr;
+    int     fd, err;
+
+    if ((fd = HOPEN( sysblk.xpndfile, O_RDWR | O_CREAT | O_BINARY,
+                     S_IRUSR | S_IWUSR )) < 0)
+        return NULL;
 
+    /* Discard any previous contents, leaving a sparse file which
+       takes host disk space only for the blocks the guest uses */
+    if (0
+        || ftruncate( fd, 0 ) != 0
+        || ftruncate( fd, (off_t) len ) != 0
+        || (addr = mmap( NULL, len, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_NORESERVE, fd, 0 )) == MAP_FAILED
+    )
+    {
+        err = errno;
+        close( fd );
+        errno = err;
+        return NULL;
+    }
+
+    *xlen = len;
+    *xfd  = fd;
+    return addr;
+#else
+    UNREFERENCED( xpndsize );
+    UNREFERENCED( xlen );
+    UNREFERENCED( xfd );
+    errno = ENOTSUP;
+    return NULL;
+#endif
+}
+
+/* Release expanded storage, emptying its file if 'empty' is true */
+static void free_xpndstor( BYTE* addr, size_t xlen, int xfd, bool empty )
+{
+#if !defined( _MSVC_ )
+    if (xlen)
+    {
+        munmap( addr, xlen );
+        if (empty && ftruncate( xfd, 0 ) != 0)
+            // "Error in function %s: %s"
+            WRMSG( HHC01430, "W", "ftruncate()", strerror( errno ));
+        close( xfd );
+        return;
+    }
+#else
+    UNREFERENCED( xlen );
+    UNREFERENCED( xfd );
+    UNREFERENCED( empty );
+#endif
+    free( addr );
+}
+
+#endif /* defined( _FEATURE_EXPANDED_STORAGE ) */
+
+/*-------------------------------------------------------------------*/
+/* clear_xpndstor  --  clear expanded storage                        */
+/*-------------------------------------------------------------------*/
+/* The blocks of a file backed expanded storage are discarded from   */
+/* both host memory and the file rather than zeroed.                 */
+/*-------------------------------------------------------------------*/
+void clear_xpndstor()
+{
+    size_t  len  = (size_t) sysblk.xpndsize * XSTORE_PAGESIZE;
+
+    if (!sysblk.xpndstor)
+        return;
+
+#if !defined( _MSVC_ ) && defined( MADV_REMOVE )
+    if (config_allocxlen && madvise( sysblk.xpndstor, len, MADV_REMOVE ) == 0)
+        return;
+#endif
+
+    memset( sysblk.xpndstor, 0x00, len );
+}
+
+/*-------------------------------------------------------------------*/
+/* xpndstor_advise  --  host paging hint for a PGIN or PGOUT block   */
+/*-------------------------------------------------------------------*/
+/* Called for each block moved to or from file backed expanded       */
+/* storage. Once a CPU has moved XSTORE_SEQ_BLOCKS consecutive       */
+/* blocks in the same direction, the host is asked to read the next  */
+/* ones in ahead of a PGIN run, or told that the ones a PGOUT run    */
+/* has just written are the first it should write back to the file  */
+/* and drop from host memory.                                        */
+/*-------------------------------------------------------------------*/
+void xpndstor_advise( REGS* regs, U32 xaddr, bool pgout )
+{
+#if !defined( _MSVC_ )
+    U32   blk;
+    int   advice;
+
+    if (xaddr != regs->xpndnext || pgout != regs->xpndout)
+        regs->xpndrun = 0;
+
+    regs->xpndnext = xaddr + 1;
+    regs->xpndout  = pgout;
+
+    if (++regs->xpndrun < XSTORE_SEQ_BLOCKS)
+        return;
+
+    regs->xpndrun = 0;
+
+    if (pgout)
+    {
+  #if defined( MADV_COLD )
+        blk    = xaddr + 1 - XSTORE_SEQ_BLOCKS;
+        advice = MADV_COLD;
+  #else
+        return;
+  #endif
+    }
+    else
+    {
+        if ((blk = xaddr + 1) >= sysblk.xpndsize)
+            return;
+        advice = MADV_WILLNEED;
+    }
+
+    madvise( sysblk.xpndstor + ((size_t) blk << XSTORE_PAGESHIFT),
+             (size_t) MIN( XSTORE_SEQ_BLOCKS, sysblk.xpndsize - blk )
+                 << XSTORE_PAGESHIFT, advice );
+#else
+    UNREFERENCED( regs );
+    UNREFERENCED( xaddr );
+    UNREFERENCED( pgout );
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/* configure_xstorage - configure EXPANDED storage                   */
+/*-------------------------------------------------------------------*/
 int configure_xstorage( U64 xpndsize )
 {
 #ifdef _FEATURE_EXPANDED_STORAGE
 
     BYTE*  xpndstor;
     BYTE*  dofree = NULL;
+    size_t doflen = 0;
+    int    doffd  = -1;
+    size_t xlen   = 0;
+    int    xfd    = -1;
     char*  mfree  = NULL;
 
     /* Ensure all CPUs have been stopped */
@@ -441,30 +1013,51 @@ int configure_xstorage( U64 xpndsize )
     if (!xpndsize || xpndsize == ~0ULL)
     {
         if (config_allocxaddr)
-            free(config_allocxaddr);
+            free_xpndstor( config_allocxaddr, config_allocxlen,
+                           config_allocxfd, true );
+        free( config_allocxfile );
 
         sysblk.xpndsize = 0;
         sysblk.xpndstor = 0;
+        sysblk.xpndstor_mapped = 0;
 
         config_allocxsize = 0;
         config_allocxaddr = NULL;
+        config_allocxlen  = 0;
+        config_allocxfd   = -1;
+        config_allocxfile = NULL;
 
         return 0;
     }
 
     /* New memory is obtained only if the requested and calculated size
-     * is larger than the last allocated size.
+     * is larger than the last allocated size, or if the backing file
+     * requested has changed (a file backed storage is always obtained
+     * anew when its size changes, as its file is sized to fit).
      */
-    if (xpndsize > config_allocxsize)
+    if (0
+        || (xpndsize > config_allocxsize)
+        || (xpndsize != config_allocxsize && config_allocxlen)
+        || (!sysblk.xpndfile != !config_allocxfile)
+        || (sysblk.xpndfile && strcmp( sysblk.xpndfile, config_allocxfile ) != 0)
+    )
     {
-        if (config_mfree)
-            mfree = malloc( config_mfree );
+        if (sysblk.xpndfile)
+        {
+            /* Obtain expanded storage by mapping its file */
+            xpndstor = alloc_xpndstor_file( xpndsize, &xlen, &xfd );
+        }
+        else
+        {
+            if (config_mfree)
+                mfree = malloc( config_mfree );
 
-        /* Obtain expanded storage, hinting to megabyte boundary */
-        xpndstor = calloc( (size_t)(xpndsize + 1), ONE_MEGABYTE );
+            /* Obtain expanded storage, hinting to megabyte boundary */
+            xpndstor = calloc( (size_t)(xpndsize + 1), ONE_MEGABYTE );
 
-        if (mfree)
-            free( mfree );
+            if (mfree)
+                free( mfree );
+        }
 
         if (!xpndstor)
         {
@@ -485,14 +1078,23 @@ int configure_xstorage( U64 xpndsize )
          * storage pointers and adjust new storage to megabyte boundary.
          */
         dofree = config_allocxaddr;
+        doflen = config_allocxlen;
+        doffd  = config_allocxfd;
+
+        free( config_allocxfile );
 
         config_allocxsize = xpndsize;
         config_allocxaddr = xpndstor;
+        config_allocxlen  = xlen;
+        config_allocxfd   = xfd;
+        config_allocxfile = sysblk.xpndfile ? strdup( sysblk.xpndfile ) : NULL;
 
         sysblk.xpnd_clear = 1;
+        sysblk.xpndstor_mapped = xlen ? 1 : 0;
 
-        xpndstor = (BYTE*)(((U64)xpndstor + (ONE_MEGABYTE - 1)) &
-                           ~((U64)ONE_MEGABYTE - 1));
+        if (!xlen)
+            xpndstor = (BYTE*)(((U64)xpndstor + (ONE_MEGABYTE - 1)) &
+                               ~((U64)ONE_MEGABYTE - 1));
 
         sysblk.xpndstor = xpndstor;
     }
@@ -513,7 +1115,8 @@ int configure_xstorage( U64 xpndsize )
      *         allocation.
      */
     if (dofree)
-        free( dofree );
+        /* (a replaced file is not emptied: it may be the new one) */
+        free_xpndstor( dofree, doflen, doffd, false );
 
     /* Initial power-on reset for expanded storage */
     xstorage_clear();
@@ -880,8 +880,6 @@ U64     new64;                          /* New value (CSPG)          */
     {
         OBTAIN_INTLOCK( regs );
         {
-            SYNCHRONIZE_CPUS( regs );
-
 #if defined( _FEATURE_SIE )
             if (SIE_MODE( regs ) && regs->sie_scao)
             {
@@ -915,7 +913,7 @@ U64     new64;                          /* New value (CSPG)          */
             }
 
             /* MAINLOCK may be required if cmpxchg assists unavailable */
-            OBTAIN_MAINLOCK( regs );
+            OBTAIN_MAINLOCK( regs, main2 );
             {
                 /* Attempt to exchange the values */
                 if (CSPG)
@@ -1838,8 +1836,6 @@ bool    do_range = false;               /* helper flag               */
 
     if (!local) OBTAIN_INTLOCK( regs );
     {
-        if (!local) SYNCHRONIZE_CPUS( regs );
-
 #if defined( _FEATURE_SIE )
 
         /* Try to obtain the SCA IPTE interlock. If successfully
@@ -2516,14 +2512,14 @@ CREG    pte;                            /* Page Table Entry          */
 
     n2 = regs->GR(r2) & ADDRESS_MAXWRAP( regs );
 
-    /* Access to PTE must be serialized */
-    OBTAIN_MAINLOCK_UNCONDITIONAL( regs );
-
     /* Return condition code 3 if translation exception */
     if (ARCH_DEP( translate_addr )( n2, r2, regs, ACCTYPE_PTE ) == 0)
     {
         rpte = APPLY_PREFIXING( regs->dat.raddr, regs->PX );
 
+        /* Access to PTE must be serialized */
+        OBTAIN_MAINLOCK_UNCONDITIONAL( regs, regs->mainstor + rpte );
+
         pte =
 #if defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
               ARCH_DEP( fetch_doubleword_absolute )( rpte, regs );
@@ -2573,12 +2569,11 @@ CREG    pte;                            /* Page Table Entry          */
                 regs->psw.cc = 1;
         }
 
+        RELEASE_MAINLOCK_UNCONDITIONAL( regs );
     }
     else
         regs->psw.cc = 3;
 
-    RELEASE_MAINLOCK_UNCONDITIONAL( regs );
-
 } /* end DEF_INST(lock_page) */
 #endif /* defined( FEATURE_LOCK_PAGE ) */
 
@@ -3728,7 +3723,10 @@ int     rc;                             /* return code from load_psw */
 
     /* Now INVALIDATE ALL TLB ENTRIES in our working copy.. */
     memset( &newregs.tlb.vaddr, 0, TLBN * sizeof(DW) );
+    memset( &newregs.tlbrmap, 0, sizeof( newregs.tlbrmap ));
+    memset( &newregs.tlblarge, 0, sizeof( newregs.tlblarge ));
     newregs.tlbID = 1;
+    newregs.tlbIDlo = newregs.tlbIDmax = 1;
 
     /* Set the breaking event address register in the copy */
     SET_BEAR_REG( &newregs, newregs.ip - (likely( !newregs.execflag ) ? 2 :
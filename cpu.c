@@ -549,6 +549,8 @@ DLL_EXPORT void ARCH_DEP( trace_program_interrupt )( REGS* regs, int pcode, int
 
     if (code == PGM_DATA_EXCEPTION)
        MSGBUF( dxcstr, " DXC=%2.2X", regs->dxc );
+    else if (code == PGM_VECTOR_PROCESSING_EXCEPTION)
+       MSGBUF( dxcstr, " VXC=%2.2X", regs->dxc );
 
     if (regs->insttrace && sysblk.traceFILE)
         tf_0801( regs, pcode, ilc );
@@ -688,9 +690,8 @@ bool    intercept;                      /* False for virtual pgmint  */
     if (IS_INTLOCK_HELD( realregs ))
         RELEASE_INTLOCK( realregs );
 
-    /* Unlock the main storage lock if held */
-    if (sysblk.mainowner == realregs->cpuad)
-        RELEASE_MAINLOCK_UNCONDITIONAL( realregs );
+    /* Unlock any main storage locks held */
+    RELEASE_MAINLOCK_UNCONDITIONAL( realregs );
 
     /* Ensure psw.IA is set and aia invalidated */
     INVALIDATE_AIA(realregs);
@@ -1242,8 +1243,12 @@ bool    intercept;                      /* False for virtual pgmint  */
 
         realregs->TEA = 0;
 
-        /* Store Data exception code in PSA */
-        if (code == PGM_DATA_EXCEPTION)
+        /* Store Data exception code (or the Vector exception code,
+           which is passed in the same field) in PSA */
+        if (0
+            || code == PGM_DATA_EXCEPTION
+            || code == PGM_VECTOR_PROCESSING_EXCEPTION
+        )
         {
             STORE_FW( psa->DXC, regs->dxc );
 
@@ -1693,6 +1698,10 @@ void (ATTR_REGPARM(1) ARCH_DEP(process_interrupt))(REGS *regs)
     OFF_IC_INTERRUPT(regs);
     regs->breakortrace = (sysblk.instbreak || (sysblk.insttrace && regs->insttrace));
 
+    /* Measure interrupt latency for adaptive interrupt check interval */
+    if (regs->intpend_tod)
+        cpuloops_update( regs );
+
     /* Ensure psw.IA is set and invalidate the aia */
     INVALIDATE_AIA(regs);
 
@@ -1897,6 +1906,7 @@ cpustate_stopping:
         /* Calculate the time we waited */
         regs->waittime += host_tod() - regs->waittod;
         regs->waittod = 0;
+        regs->intpend_tod = 0;
 
         /* If late state change to stopping, go reprocess */
         if (unlikely(regs->cpustate == CPUSTATE_STOPPING))
@@ -2016,7 +2026,7 @@ int     aswitch;
     TXF_ALLOCMAP( regs );
 
     /* Get pointer to primary opcode table */
-    current_opcode_table = regs->ARCH_DEP( runtime_opcode_xxxx );
+    current_opcode_table = RUNTIME_OPCODE_TABLE( regs );
 
     /* Signal cpu has started */
     if(!aswitch)
@@ -2078,6 +2088,9 @@ int     aswitch;
 
 fastest_no_txf_loop:
 
+    if (TLB_SHOOTDOWN_PENDING( regs ))
+        tlb_shootdown_ack( regs );
+
     if (INTERRUPT_PENDING( regs ))
         ARCH_DEP( process_interrupt )( regs );
 
@@ -2089,7 +2102,7 @@ enter_fastest_no_txf_loop:
     regs->instcount++;
     UPDATE_SYSBLK_INSTCOUNT( 1 );
 
-    for (i=0; i < MAX_CPU_LOOPS/2; i++)
+    for (i=0; i < regs->cpuloops; i++)
     {
         UNROLLED_EXECUTE( current_opcode_table, regs );
         UNROLLED_EXECUTE( current_opcode_table, regs );
@@ -2105,6 +2118,9 @@ enter_fastest_no_txf_loop:
 
 txf_facility_loop:
 
+    if (TLB_SHOOTDOWN_PENDING( regs ))
+        tlb_shootdown_ack( regs );
+
     if (INTERRUPT_PENDING( regs ))
         ARCH_DEP( process_interrupt )( regs );
 
@@ -2119,7 +2135,7 @@ enter_txf_faster_loop:
     regs->instcount++;
     UPDATE_SYSBLK_INSTCOUNT( 1 );
 
-    for (i=0; i < MAX_CPU_LOOPS/2; i++)
+    for (i=0; i < regs->cpuloops; i++)
     {
         if (regs->txf_tnd)
             break;
@@ -2139,6 +2155,9 @@ enter_txf_faster_loop:
 
 //txf_slower_loop:
 
+    if (TLB_SHOOTDOWN_PENDING( regs ))
+        tlb_shootdown_ack( regs );
+
     if (INTERRUPT_PENDING( regs ))
         ARCH_DEP( process_interrupt )( regs );
 
@@ -2153,7 +2172,7 @@ enter_txf_slower_loop:
     regs->instcount++;
     UPDATE_SYSBLK_INSTCOUNT( 1 );
 
-    for (i=0; i < MAX_CPU_LOOPS/2; i++)
+    for (i=0; i < regs->cpuloops; i++)
     {
         if (!regs->txf_tnd)
             break;
@@ -2330,6 +2349,53 @@ static REGS* (*run_cpu[ NUM_GEN_ARCHS ])( int cpu, REGS* oldregs ) =
 #endif
 };
 
+/*-------------------------------------------------------------------*/
+/* Adaptive interrupt check interval                                 */
+/*-------------------------------------------------------------------*/
+/* Called by process_interrupt with intlock held when an enabled I/O */
+/* or SIGP interrupt was made pending for this CPU while it was      */
+/* running (see SET_INTPEND_TOD in cpuint.h). The time it took us to */
+/* notice it is the cost of our regs->cpuloops UNROLLED_EXECUTE loop */
+/* between INTERRUPT_PENDING checks. If it exceeds the configured    */
+/* target the interval is halved; if it is comfortably below it the */
+/* interval is slowly widened again to gain back throughput.         */
+/*                                                                   */
+/* Samples longer than the widest interval could possibly take are   */
+/* not the loop's fault (e.g. the CPU disabled itself for I/O right  */
+/* after the interrupt was made pending) and thus only recorded.     */
+/*-------------------------------------------------------------------*/
+void cpuloops_update( REGS* regs )
+{
+    U64  latency;
+    U32  target  = sysblk.cpuloops_target;
+    int  loops   = regs->cpuloops;
+
+    latency = (host_tod() - regs->intpend_tod) >> 4;  /* (usecs) */
+    regs->intpend_tod = 0;
+
+    regs->intlat_count++;
+    regs->intlat_total += latency;
+    if (latency > regs->intlat_max)
+        regs->intlat_max = latency;
+
+    if (!target || latency > (MAX_ADAPT_CPU_LOOPS * 2))
+        return;
+
+    if (latency > target)
+        loops >>= 1;
+    else if (latency < (target >> 1))
+        loops += (loops >> 3) + 1;
+    else
+        return;
+
+    if (loops < MIN_ADAPT_CPU_LOOPS/2)
+        loops = MIN_ADAPT_CPU_LOOPS/2;
+    else if (loops > MAX_ADAPT_CPU_LOOPS/2)
+        loops = MAX_ADAPT_CPU_LOOPS/2;
+
+    regs->cpuloops = loops;
+}
+
 /*-------------------------------------------------------------------*/
 /* CPU instruction execution thread                                  */
 /*-------------------------------------------------------------------*/
@@ -2419,6 +2485,7 @@ int i;
 
     regs->cpuad = cpu;
     regs->cpubit = CPU_BIT(cpu);
+    regs->cpuloops = MAX_CPU_LOOPS/2;
 
     /* Save CPU creation time without epoch set, as epoch may change. When using
      * the field, subtract the current epoch from any time being used in
@@ -323,6 +323,19 @@
    (_regs)->ints_state |= BIT(IC_INTERRUPT) | BIT(IC_STORSTAT); \
  } while (0)
 
+  /*
+   * Remember when an enabled interrupt was made pending for a CPU
+   * that is running (not waiting) so process_interrupt can measure
+   * how long it took the CPU's instruction execution loop to notice
+   * it. Only done when the adaptive interrupt check interval is on.
+   * Caller must hold intlock.
+   */
+#define SET_INTPEND_TOD(_regs) \
+ do { \
+   if (sysblk.cpuloops_target && !(sysblk.waiting_mask & (_regs)->cpubit) && !(_regs)->intpend_tod) \
+     (_regs)->intpend_tod = host_tod(); \
+ } while (0)
+
 #define ON_IC_IOPENDING \
  do { \
    REGS *regs; \
@@ -339,7 +352,10 @@
        { \
          regs = sysblk.regs[i]; \
          if ( regs->ints_mask & BIT(IC_IO) ) \
+         { \
            regs->ints_state |= BIT(IC_INTERRUPT) | BIT(IC_IO); \
+           SET_INTPEND_TOD( regs ); \
+         } \
          else \
            regs->ints_state |= BIT(IC_IO), \
            wake ^= regs->cpubit; \
@@ -438,7 +454,10 @@
 #define ON_IC_EXTCALL(_regs) \
  do { \
    if ( (_regs)->ints_mask & BIT(IC_EXTCALL) ) \
+   { \
      (_regs)->ints_state |= BIT(IC_INTERRUPT) | BIT(IC_EXTCALL); \
+     SET_INTPEND_TOD( _regs ); \
+   } \
    else \
      (_regs)->ints_state |= BIT(IC_EXTCALL); \
  } while (0)
@@ -454,7 +473,10 @@
 #define ON_IC_EMERSIG(_regs) \
  do { \
    if ( (_regs)->ints_mask & BIT(IC_EMERSIG) ) \
+   { \
      (_regs)->ints_state |= BIT(IC_INTERRUPT) | BIT(IC_EMERSIG); \
+     SET_INTPEND_TOD( _regs ); \
+   } \
    else \
      (_regs)->ints_state |= BIT(IC_EMERSIG); \
  } while (0)
@@ -176,16 +176,105 @@ void ARCH_DEP( set_guest_aea_mode )( REGS* regs )
 /*-------------------------------------------------------------------*/
 /*                      do_purge_tlb                                 */
 /*-------------------------------------------------------------------*/
+/*                                                                   */
+/* Invalidates every TLB entry, including those of any retained SIE  */
+/* guest TLB contexts, by making a new tlbID the lowest valid one.   */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( new_tlbID )( REGS* regs )
+{
+    if (((++regs->tlbIDmax) & TLBID_BYTEMASK) == 0)
+    {
+        memset( &regs->tlb.vaddr, 0, TLBN * sizeof( DW ));
+        memset( &regs->tlbrmap, 0, sizeof( regs->tlbrmap ));
+        memset( &regs->tlblarge, 0, sizeof( regs->tlblarge ));
+        regs->tlblargeID = 0;
+#if defined( _FEATURE_SIE )
+        memset( &regs->tlbctx, 0, sizeof( regs->tlbctx ));
+#endif
+        regs->tlbIDmax = regs->tlbIDlo = 1;
+    }
+    regs->tlbID = regs->tlbIDmax;
+}
+
 void ARCH_DEP( do_purge_tlb )( REGS* regs )
 {
     INVALIDATE_AIA( regs );
 
-    if (((++regs->tlbID) & TLBID_BYTEMASK) == 0)
+    ARCH_DEP( new_tlbID )( regs );
+    regs->tlbIDlo = regs->tlbID;
+}
+
+#if defined( _FEATURE_SIE )
+/*-------------------------------------------------------------------*/
+/*                   sie_tlb_context                                 */
+/*-------------------------------------------------------------------*/
+/* Called by SIE to switch the guest REGS 'regs' to the TLB context  */
+/* of the state descriptor at host real address 'sd'. Its previous   */
+/* TLB entries are reused if it was last dispatched by this host CPU */
+/* ('same_cpu') with the same guest storage origin, limit, prefix    */
+/* and mode. Otherwise it is given a new tlbID, replacing the least  */
+/* recently dispatched context (or its own previous one).            */
+/*-------------------------------------------------------------------*/
+void ARCH_DEP( sie_tlb_context )( REGS* regs, RADR sd, bool same_cpu )
+{
+TLBCTX  *ctx;                           /* -> TLB context            */
+TLBCTX  *victim = NULL;                 /* -> Context to replace     */
+int      i;
+
+    regs->tlbctxuse++;
+
+    for (i=0; i < TLB_CONTEXTS; i++)
     {
-        memset( &regs->tlb.vaddr, 0, TLBN * sizeof( DW ));
-        regs->tlbID = 1;
+        ctx = &regs->tlbctx[i];
+
+        if (ctx->tlbID < regs->tlbIDlo)
+        {
+            /* (purged: use in preference to a live context) */
+            if (!victim || victim->tlbID >= regs->tlbIDlo)
+                victim = ctx;
+            continue;
+        }
+
+        if (ctx->sd == sd)
+        {
+            if (1
+                && same_cpu
+                && ctx->mso       == regs->sie_mso
+                && ctx->mainlim   == regs->mainlim
+                && ctx->px        == regs->PX
+                && ctx->arch_mode == regs->arch_mode
+                && ctx->pref      == regs->sie_pref
+            )
+            {
+                INVALIDATE_AIA( regs );
+                regs->tlbID  = ctx->tlbID;
+                ctx->lastuse = regs->tlbctxuse;
+                regs->tlbctxhits++;
+                return;
+            }
+
+            /* (never leave a stale context for the same SD) */
+            victim = ctx;
+            break;
+        }
+
+        if (!victim || (victim->tlbID >= regs->tlbIDlo && ctx->lastuse < victim->lastuse))
+            victim = ctx;
     }
+
+    INVALIDATE_AIA( regs );
+    ARCH_DEP( new_tlbID )( regs );
+
+    victim->sd        = sd;
+    victim->mso       = regs->sie_mso;
+    victim->mainlim   = regs->mainlim;
+    victim->px        = regs->PX;
+    victim->arch_mode = regs->arch_mode;
+    victim->pref      = regs->sie_pref;
+    victim->tlbID     = regs->tlbID;
+    victim->lastuse   = regs->tlbctxuse;
 }
+#endif /* defined( _FEATURE_SIE ) */
 
 /*-------------------------------------------------------------------*/
 /* Purge entire translation lookaside buffer for this CPU            */
@@ -831,6 +920,274 @@ U16     eax;                            /* Authorization index       */
 } /* end function load_address_space_designator */
 
 
+#if TLB_WAYS > 1
+/*-------------------------------------------------------------------*/
+/* Exchange two TLB entries                                          */
+/*-------------------------------------------------------------------*/
+static inline void ARCH_DEP( tlb_swap )( TLB* tlb, int a, int b )
+{
+DW      dw;
+BYTE   *p;
+BYTE    c;
+
+    dw = tlb->asd    [a]; tlb->asd    [a] = tlb->asd    [b]; tlb->asd    [b] = dw;
+    dw = tlb->vaddr  [a]; tlb->vaddr  [a] = tlb->vaddr  [b]; tlb->vaddr  [b] = dw;
+    dw = tlb->pte    [a]; tlb->pte    [a] = tlb->pte    [b]; tlb->pte    [b] = dw;
+    p  = tlb->main   [a]; tlb->main   [a] = tlb->main   [b]; tlb->main   [b] = p;
+    p  = tlb->storkey[a]; tlb->storkey[a] = tlb->storkey[b]; tlb->storkey[b] = p;
+    c  = tlb->skey   [a]; tlb->skey   [a] = tlb->skey   [b]; tlb->skey   [b] = c;
+    c  = tlb->common [a]; tlb->common [a] = tlb->common [b]; tlb->common [b] = c;
+    c  = tlb->protect[a]; tlb->protect[a] = tlb->protect[b]; tlb->protect[b] = c;
+    c  = tlb->acc    [a]; tlb->acc    [a] = tlb->acc    [b]; tlb->acc    [b] = c;
+}
+
+/*-------------------------------------------------------------------*/
+/* Look for a TLB hit in ways 1-n of the set            (maddr_l)    */
+/*                                                                   */
+/* Called by maddr_l when the page's entry was not found in way 0    */
+/* of its TLB set. Applies the same tests as maddr_l to each of the  */
+/* set's other ways, and if one of them hits, exchanges it with way  */
+/* 0 and returns the mainstor address. Otherwise returns NULL.       */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT
+BYTE* ARCH_DEP( tlb_assoc_hit )( VADR addr, int aea_crn, REGS* regs,
+                                 int acctype, BYTE akey )
+{
+int     ix = TLBIX( addr );             /* Index of way 0 of the set */
+int     way;                            /* Way being tested          */
+int     wix;                            /* Index of way being tested */
+
+    for (way = 1; way < TLB_WAYS; way++)
+    {
+        wix = ix + way * TLB_SETS;
+
+        if (1
+            && (0
+                || (regs->CR( aea_crn ) == regs->tlb.TLB_ASD( wix ))
+                || (regs->AEA_COMMON( aea_crn ) & regs->tlb.common[ wix ])
+               )
+            && (akey == 0 || akey == regs->tlb.skey[ wix ])
+            && ((addr & TLBID_PAGEMASK) | regs->tlbID) == regs->tlb.TLB_VADDR( wix )
+            && (acctype & regs->tlb.acc[ wix ])
+        )
+        {
+            ARCH_DEP( tlb_swap )( &regs->tlb, ix, wix );
+
+            if (acctype & ACC_CHECK)
+                regs->dat.storkey = regs->tlb.storkey[ ix ];
+
+            regs->tlbhits++;
+            return MAINADDR( regs->tlb.main[ ix ], addr );
+        }
+    }
+    return NULL;
+}
+#endif /* TLB_WAYS > 1 */
+
+/*-------------------------------------------------------------------*/
+/* Make way 0 of a virtual page's TLB set available for the page     */
+/*                                                                   */
+/* Called before the TLB is searched for (and then possibly updated  */
+/* with) a translation. If another way of the set holds a valid entry*/
+/* for the page in address space 'asd', it is exchanged with way 0.  */
+/* Otherwise the ways before the first free one (or all but the last */
+/* and least recently used one) are moved down one place, and way 0  */
+/* is invalidated ready for the new entry. So on return TLBIX(vaddr) */
+/* is always the index of the entry to be checked and/or updated.    */
+/* Entries of retained SIE guest TLB contexts are not free ways.     */
+/*-------------------------------------------------------------------*/
+static inline void ARCH_DEP( tlb_mru )( VADR vaddr, RADR asd, bool pvtaddr, REGS* regs )
+{
+#if TLB_WAYS > 1
+int     ix = TLBIX( vaddr );            /* Index of way 0 of the set */
+int     way;                            /* Way being tested          */
+int     wix;                            /* Index of way being tested */
+int     freeway = -1;                   /* First free way            */
+
+    for (way = 0; way < TLB_WAYS; way++)
+    {
+        wix = ix + way * TLB_SETS;
+
+        if (((vaddr & TLBID_PAGEMASK) | regs->tlbID) == regs->tlb.TLB_VADDR( wix ))
+        {
+            if (1
+                && (regs->tlb.common[ wix ] || asd == regs->tlb.TLB_ASD( wix ))
+                && !(regs->tlb.common[ wix ] && pvtaddr)
+            )
+            {
+                if (way)
+                    ARCH_DEP( tlb_swap )( &regs->tlb, ix, wix );
+                return;
+            }
+        }
+        else if (freeway < 0 && (regs->tlb.TLB_VADDR( wix ) & TLBID_BYTEMASK) < regs->tlbIDlo)
+            freeway = way;
+    }
+
+    if (freeway == 0)
+        return;
+    if (freeway < 0)
+        freeway = TLB_WAYS - 1;
+
+    for (way = freeway; way > 0; way--)
+        ARCH_DEP( tlb_swap )( &regs->tlb, ix + way * TLB_SETS,
+                                          ix + (way - 1) * TLB_SETS );
+
+    regs->tlb.TLB_VADDR( ix ) &= TLBID_PAGEMASK;
+#else
+    UNREFERENCED( vaddr );
+    UNREFERENCED( asd );
+    UNREFERENCED( pvtaddr );
+    UNREFERENCED( regs );
+#endif
+}
+
+
+/*-------------------------------------------------------------------*/
+/* Return the TLB reverse map bucket number for a page frame         */
+/*                                                                   */
+/* 'frame' is either a TLB entry's 'pte' field or, for purge_tlbe,   */
+/* the value it is compared with by is_tlbe_match. Only the bits     */
+/* common to all of is_tlbe_match's PFRA masks are hashed.           */
+/*-------------------------------------------------------------------*/
+static inline U32 ARCH_DEP( tlb_rmap_bucket )( RADR frame )
+{
+#if !defined( FEATURE_S390_DAT ) && !defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
+    frame &= PAGETAB_PFRA_4K;           /* (also covers 2K PFRAs)    */
+#endif
+#if defined( FEATURE_S390_DAT )
+    frame &= PAGETAB_PFRA;
+#endif
+#if defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
+    frame &= (RADR)ZPGETAB_PFRA;
+#endif
+    return TLB_RMAP_HASH( frame );
+}
+
+/*-------------------------------------------------------------------*/
+/* Record a new TLB entry's set in the TLB reverse map               */
+/*                                                                   */
+/* Called whenever the 'pte' field of TLB entry 'ix' is set. If the  */
+/* frame's bucket is full, sets which no longer hold a valid entry   */
+/* for a frame hashing to the bucket are first dropped from it, and  */
+/* if that doesn't make room the bucket is marked as overflowed.     */
+/*-------------------------------------------------------------------*/
+void ARCH_DEP( tlb_rmap_add )( REGS* regs, int ix )
+{
+U32      bucket;                        /* Bucket number             */
+TLBRMAP *rmap;                          /* -> Bucket                 */
+U16      set = ix & TLB_MASK;           /* Set of new entry          */
+int      i, n, way, wix;                /* Work                      */
+
+    bucket = ARCH_DEP( tlb_rmap_bucket )( regs->tlb.TLB_PTE( ix ));
+    rmap   = &regs->tlbrmap[ bucket ];
+
+    if (rmap->id != regs->tlbIDlo)
+    {
+        rmap->id = regs->tlbIDlo;
+        rmap->n  = 0;
+    }
+    else if (rmap->n == TLB_RMAP_OVERFLOW)
+        return;
+
+    for (i=0; i < rmap->n; i++)
+        if (rmap->set[i] == set)
+            return;
+
+    if (rmap->n == TLB_RMAP_SETS)
+    {
+        /* Drop sets with no remaining entry for this bucket */
+        for (i=0, n=0; i < TLB_RMAP_SETS; i++)
+        {
+            for (way=0; way < TLB_WAYS; way++)
+            {
+                wix = rmap->set[i] + way * TLB_SETS;
+
+                if (1
+                    && (regs->tlb.TLB_VADDR( wix ) & TLBID_BYTEMASK) >= regs->tlbIDlo
+                    && ARCH_DEP( tlb_rmap_bucket )( regs->tlb.TLB_PTE( wix )) == bucket
+                )
+                {
+                    rmap->set[n++] = rmap->set[i];
+                    break;
+                }
+            }
+        }
+        if (n == TLB_RMAP_SETS)
+        {
+            rmap->n = TLB_RMAP_OVERFLOW;
+            return;
+        }
+        rmap->n = n;
+    }
+
+    rmap->set[ rmap->n++ ] = set;
+}
+
+#if defined( FEATURE_008_ENHANCED_DAT_FACILITY_1 )
+/*-------------------------------------------------------------------*/
+/* Translate an address within an EDAT-1 1M frame                    */
+/*                                                                   */
+/* Sets the real address of 'vaddr' within the frame at real address */
+/* 'frame' and, unless ACC_NOTLB, creates TLB entry 'tlbix' for its  */
+/* 4K page with a fake page table entry.                             */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( tlb_large_frame )( VADR vaddr, RADR frame, BYTE common,
+                                         int acctype, REGS* regs, int tlbix )
+{
+    /* Combine the segment frame real address with the byte index
+       of the virtual address to form the real address */
+    regs->dat.raddr = frame | (vaddr & ~ZSEGTAB_SFAA);
+    /* Fake 4K PFRA for TLB purposes */
+    regs->dat.rpfra = regs->dat.raddr & PAGEFRAME_PAGEMASK;
+
+    /* [3.11.4.2] Place the translated address in the TLB */
+    if (!(acctype & ACC_NOTLB))
+    {
+        regs->tlb.TLB_ASD(tlbix)   = regs->dat.asd;
+        regs->tlb.TLB_VADDR(tlbix) = (vaddr & TLBID_PAGEMASK) | regs->tlbID;
+        /* Fake 4K PTE for TLB purposes */
+        regs->tlb.TLB_PTE(tlbix)   = regs->dat.rpfra;
+        regs->tlb.common[tlbix]    = common;
+        regs->tlb.protect[tlbix]   = regs->dat.protect;
+        regs->tlb.acc[tlbix]       = 0;
+        regs->tlb.main[tlbix]      = NULL;
+        ARCH_DEP( tlb_rmap_add )( regs, tlbix );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* Resolve a TLB miss from the large frame TLB                       */
+/*                                                                   */
+/* Returns true, having translated the address and created its TLB   */
+/* entry, if the address lies in an EDAT-1 1M frame of the current   */
+/* address space whose segment table entry is in the large frame     */
+/* TLB. Entries are only made for segments which the address space   */
+/* may use, so matching the ASCE exactly is enough.                  */
+/*-------------------------------------------------------------------*/
+static inline bool ARCH_DEP( tlb_large_hit )( VADR vaddr, int acctype,
+                                              REGS* regs, int tlbix )
+{
+TLBLARGE *ent = &regs->tlblarge[ TLB_LARGE_IX( vaddr )];
+
+    if (0
+        || ent->id    != regs->tlbID
+        || ent->vaddr != (vaddr & ZSEGTAB_SFAA)
+        || ent->asd   != regs->dat.asd
+        || (acctype & (ACC_PTE | ACC_LPTEA))
+        || !(regs->CR_L(0) & CR0_ED)
+        || !FACILITY_ENABLED( 008_EDAT_1, regs )
+    )
+        return false;
+
+    regs->dat.protect |= ent->protect;
+    ARCH_DEP( tlb_large_frame )( vaddr, ent->frame, ent->common, acctype, regs, tlbix );
+    regs->tlblargehits++;
+    return true;
+}
+#endif /* defined( FEATURE_008_ENHANCED_DAT_FACILITY_1 ) */
+
+
 /*-------------------------------------------------------------------*/
 /*                        translate_addr                             */
 /*           PRIMARY DYNAMIC ADDRESS TRANSLATION LOGIC               */
@@ -961,6 +1318,8 @@ U32     ptl;                            /* Page table length         */
        goto tran_spec_excp;
 
     /* Look up the address in the TLB */
+    if (!(acctype & ACC_NOTLB))
+        ARCH_DEP( tlb_mru )( vaddr, regs->dat.asd, regs->dat.pvtaddr, regs );
     if (   ((vaddr & TLBID_PAGEMASK) | regs->tlbID) == regs->tlb.TLB_VADDR(tlbix)
         && (regs->tlb.common[tlbix] || regs->dat.asd == regs->tlb.TLB_ASD(tlbix))
         && !(regs->tlb.common[tlbix] && regs->dat.pvtaddr)
@@ -1066,10 +1425,13 @@ U32     ptl;                            /* Page table length         */
             regs->tlb.protect[tlbix]   = regs->dat.protect;
             regs->tlb.acc[tlbix]       = 0;
             regs->tlb.main[tlbix]      = NULL;
+            ARCH_DEP( tlb_rmap_add )( regs, tlbix );
 
             /* Set adjacent TLB entry if 4K page sizes */
             if ((regs->CR(0) & CR0_PAGE_SIZE) == CR0_PAGE_SZ_4K)
             {
+                ARCH_DEP( tlb_mru )( vaddr ^ 0x800, regs->dat.asd, regs->dat.pvtaddr, regs );
+
                 regs->tlb.TLB_ASD(tlbix^1)   = regs->tlb.TLB_ASD(tlbix);
                 regs->tlb.TLB_VADDR(tlbix^1) = (vaddr & TLBID_PAGEMASK) | regs->tlbID;
                 regs->tlb.TLB_PTE(tlbix^1)   = regs->tlb.TLB_PTE(tlbix);
@@ -1077,6 +1439,7 @@ U32     ptl;                            /* Page table length         */
                 regs->tlb.protect[tlbix^1]   = regs->tlb.protect[tlbix];
                 regs->tlb.acc[tlbix^1]       = 0;
                 regs->tlb.main[tlbix^1]      = NULL;
+                ARCH_DEP( tlb_rmap_add )( regs, tlbix^1 );
             }
         }
     } /* end if(!TLB) */
@@ -1116,6 +1479,8 @@ U32     ptl;                            /* Page table length         */
     regs->dat.pvtaddr = ((regs->dat.asd & STD_PRIVATE) != 0);
 
     /* [3.11.4] Look up the address in the TLB */
+    if (!(acctype & ACC_NOTLB))
+        ARCH_DEP( tlb_mru )( vaddr, regs->dat.asd, regs->dat.pvtaddr, regs );
     if (   ((vaddr & TLBID_PAGEMASK) | regs->tlbID) == regs->tlb.TLB_VADDR(tlbix)
         && (regs->tlb.common[tlbix] || regs->dat.asd == regs->tlb.TLB_ASD(tlbix))
         && !(regs->tlb.common[tlbix] && regs->dat.pvtaddr)
@@ -1204,6 +1569,7 @@ U32     ptl;                            /* Page table length         */
             regs->tlb.acc[tlbix]       = 0;
             regs->tlb.protect[tlbix]   = regs->dat.protect;
             regs->tlb.main[tlbix]      = NULL;
+            ARCH_DEP( tlb_rmap_add )( regs, tlbix );
         }
     } /* end if(!TLB) */
 
@@ -1249,6 +1615,8 @@ U16     sx, px;                         /* Segment and page index,
 //  LOGMSG("asce=%16.16"PRIX64"\n",regs->dat.asd);
 
     /* [3.11.4] Look up the address in the TLB */
+    if (!(acctype & ACC_NOTLB))
+        ARCH_DEP( tlb_mru )( vaddr, regs->dat.asd, regs->dat.pvtaddr, regs );
     if (   ((vaddr & TLBID_PAGEMASK) | regs->tlbID) == regs->tlb.TLB_VADDR(tlbix)
         && (regs->tlb.common[tlbix] || regs->dat.asd == regs->tlb.TLB_ASD(tlbix))
         && !(regs->tlb.common[tlbix] && regs->dat.pvtaddr)
@@ -1278,6 +1646,15 @@ U16     sx, px;                         /* Segment and page index,
         }
         else
         {
+#if defined( FEATURE_008_ENHANCED_DAT_FACILITY_1 )
+            /* Skip the table walk if the address is in a 1M frame
+               whose translation is in the large frame TLB */
+            if (ARCH_DEP( tlb_large_hit )( vaddr, acctype, regs, tlbix ))
+            {
+                regs->dat.xcode = 0;
+                return 0;
+            }
+#endif
             /* Extract the table origin, type, and length from the ASCE,
                and set the table offset to zero */
             rto = regs->dat.asd & ASCE_TO;
@@ -1530,25 +1907,26 @@ U16     sx, px;                         /* Segment and page index,
                     return cc;
                 } /* end if(ACCTYPE_LPTEA) */
 
-                /* Combine the page frame real address with the byte index
-                   of the virtual address to form the real address */
-                regs->dat.raddr = (ste & ZSEGTAB_SFAA) | (vaddr & ~ZSEGTAB_SFAA);
-                /* Fake 4K PFRA for TLB purposes */
-                regs->dat.rpfra = ((ste & ZSEGTAB_SFAA) | (vaddr & ~ZSEGTAB_SFAA)) & PAGEFRAME_PAGEMASK;
+                ARCH_DEP( tlb_large_frame )( vaddr, ste & ZSEGTAB_SFAA,
+                    (ste & SEGTAB_COMMON) ? 1 : 0, acctype, regs, tlbix );
 
 //              LOGMSG("raddr:%16.16"PRIX64" cc=0\n",regs->dat.raddr);
 
-                /* [3.11.4.2] Place the translated address in the TLB */
-                if (!(acctype & ACC_NOTLB))
+                /* Remember the frame's translation so that TLB misses
+                   for its other pages need not walk the tables again */
+                if (!(acctype & (ACC_NOTLB | ACC_PTE)))
                 {
-                    regs->tlb.TLB_ASD(tlbix)   = regs->dat.asd;
-                    regs->tlb.TLB_VADDR(tlbix) = (vaddr & TLBID_PAGEMASK) | regs->tlbID;
-                    /* Fake 4K PTE for TLB purposes */
-                    regs->tlb.TLB_PTE(tlbix)   = ((ste & ZSEGTAB_SFAA) | (vaddr & ~ZSEGTAB_SFAA)) & PAGEFRAME_PAGEMASK;
-                    regs->tlb.common[tlbix]    = (ste & SEGTAB_COMMON) ? 1 : 0;
-                    regs->tlb.protect[tlbix]   = regs->dat.protect;
-                    regs->tlb.acc[tlbix]       = 0;
-                    regs->tlb.main[tlbix]      = NULL;
+                    TLBLARGE* ent = &regs->tlblarge[ TLB_LARGE_IX( vaddr )];
+
+                    ent->asd     = regs->dat.asd;
+                    ent->vaddr   = vaddr & ZSEGTAB_SFAA;
+                    ent->frame   = ste & ZSEGTAB_SFAA;
+                    ent->id      = regs->tlbID;
+                    ent->common  = (ste & SEGTAB_COMMON) ? 1 : 0;
+                    ent->protect = regs->dat.protect & 1;
+
+                    regs->tlblargeID = regs->tlbID;
+                    regs->tlblargefills++;
                 }
 
                 /* Clear exception code and return with zero return code */
@@ -1616,6 +1994,7 @@ U16     sx, px;                         /* Segment and page index,
             regs->tlb.protect[tlbix]   = regs->dat.protect;
             regs->tlb.acc[tlbix]       = 0;
             regs->tlb.main[tlbix]      = NULL;
+            ARCH_DEP( tlb_rmap_add )( regs, tlbix );
         }
     }
 
@@ -1891,18 +2270,98 @@ bool match = false;
     return match;
 }
 
+/*-------------------------------------------------------------------*/
+/*                      tlb_rmap_find                                */
+/*-------------------------------------------------------------------*/
+/* Copy the TLB sets which may hold entries for the page frame that  */
+/* purge_tlbe was called for into 'sets' (room for TLB_RMAP_SETS)    */
+/* and return their number, or -1 if the whole TLB must be scanned.  */
+/*-------------------------------------------------------------------*/
+int ARCH_DEP( tlb_rmap_find )( REGS* regs, U64 pfra, U16* sets )
+{
+TLBRMAP *rmap;                          /* -> Bucket                 */
+RADR     frame;                         /* Frame as held in TLB 'pte'*/
+
+#if !defined( FEATURE_S390_DAT ) && !defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
+    frame = (pfra & 0xFFFFFF) >> 8;
+#else
+    frame = pfra;
+#endif
+
+    rmap = &regs->tlbrmap[ ARCH_DEP( tlb_rmap_bucket )( frame )];
+
+    if (rmap->id != regs->tlbIDlo)
+        return 0;
+
+    if (rmap->n == TLB_RMAP_OVERFLOW)
+        return -1;
+
+    memcpy( sets, rmap->set, rmap->n * sizeof( U16 ));
+    return rmap->n;
+}
+
 /*-------------------------------------------------------------------*/
 /*                      do_purge_tlbe                                */
+/*                                                                   */
+/* Uses the TLB reverse map to find the sets which may hold entries  */
+/* for the page frame. Guest entries are checked against the host's  */
+/* entry with the same index too (see purge_tlbe below), so the sets */
+/* listed in the host's reverse map are checked as well. The whole   */
+/* TLB is only scanned when either bucket has overflowed.            */
 /*-------------------------------------------------------------------*/
 void ARCH_DEP( do_purge_tlbe )( REGS* regs, REGS* host_regs, U64 pfra )
 {
-int  i;
+U16  sets[ 2 * TLB_RMAP_SETS ];         /* Candidate TLB sets        */
+int  n, hn;                             /* Number of candidate sets  */
+int  i, way;
 
     INVALIDATE_AIA( regs );
 
-    for (i=0; i < TLBN; i++)
-        if (ARCH_DEP( is_tlbe_match )( regs, host_regs, pfra, i ))
-            regs->tlb.TLB_VADDR(i) &= TLBID_PAGEMASK;
+#if defined( FEATURE_008_ENHANCED_DAT_FACILITY_1 )
+    /* Purge any large frame TLB entry for a frame including the
+       page, unless none has been made since the last full purge.
+       (Guest entries hold guest frames, so a purge of host frames
+       for a guest (host_regs) never affects them.) */
+    if (!host_regs && regs->tlblargeID >= regs->tlbIDlo)
+    {
+        for (i=0; i < TLB_LARGE_N; i++)
+            if (regs->tlblarge[i].frame == (pfra & ZSEGTAB_SFAA))
+                regs->tlblarge[i].id = 0;
+    }
+#endif
+
+    n = ARCH_DEP( tlb_rmap_find )( regs, pfra, sets );
+
+    if (n >= 0 && host_regs)
+    {
+        switch (host_regs->arch_mode)
+        {
+        case ARCH_370_IDX: hn = s370_tlb_rmap_find( host_regs, pfra, sets + n ); break;
+        case ARCH_390_IDX: hn = s390_tlb_rmap_find( host_regs, pfra, sets + n ); break;
+        case ARCH_900_IDX: hn = z900_tlb_rmap_find( host_regs, pfra, sets + n ); break;
+        default: CRASH();
+        }
+        n = (hn < 0) ? -1 : n + hn;
+    }
+
+    if (n < 0)
+    {
+        for (i=0; i < TLBN; i++)
+            if (ARCH_DEP( is_tlbe_match )( regs, host_regs, pfra, i ))
+                regs->tlb.TLB_VADDR(i) &= TLBID_PAGEMASK;
+        return;
+    }
+
+    while (n--)
+    {
+        for (way=0; way < TLB_WAYS; way++)
+        {
+            i = sets[n] + way * TLB_SETS;
+
+            if (ARCH_DEP( is_tlbe_match )( regs, host_regs, pfra, i ))
+                regs->tlb.TLB_VADDR(i) &= TLBID_PAGEMASK;
+        }
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -1984,7 +2443,7 @@ int  i;
         memset( &regs->tlb.acc, 0, TLBN );
     else
         for (i=0; i < TLBN; i++)
-            if ((regs->tlb.TLB_VADDR(i) & TLBID_BYTEMASK) == regs->tlbID)
+            if ((regs->tlb.TLB_VADDR(i) & TLBID_BYTEMASK) >= regs->tlbIDlo)
                 regs->tlb.acc[i] &= mask;
 }
 
@@ -2029,7 +2488,6 @@ void ARCH_DEP( do_invalidate_tlbe )( REGS* regs, BYTE* main )
 {
     int     i;                          /* index into TLB            */
     int     shift;                      /* Number of bits to shift   */
-    BYTE*   mainwid;                    /* mainstore with tlbid      */
 
     if (!main)
     {
@@ -2037,23 +2495,26 @@ void ARCH_DEP( do_invalidate_tlbe )( REGS* regs, BYTE* main )
         return;
     }
 
-    mainwid = main + regs->tlbID;
-
     INVALIDATE_AIA_MAIN( regs, main );
 
     shift = (regs->arch_mode == ARCH_370_IDX) ? 11 : 12;
 
     for (i=0; i < TLBN; i++)
     {
-        if (MAINADDR( regs->tlb.main[i], (regs->tlb.TLB_VADDR(i) | (i << shift)) ) == mainwid)
+        if (MAINADDR( regs->tlb.main[i], ((regs->tlb.TLB_VADDR(i) & TLBID_PAGEMASK) | ((i & TLB_MASK) << shift)) ) == main)
         {
             regs->tlb.acc[i] = 0;
 
             // 370?
 #if !defined( FEATURE_S390_DAT ) && !defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
 
+            /* (the other half of the 4K page may be in any way) */
             if ((regs->CR(0) & CR0_PAGE_SIZE) == CR0_PAGE_SZ_4K)
-                regs->tlb.acc[i^1] = 0;
+            {
+                int  adjix;
+                for (adjix = (i ^ 1) & TLB_MASK; adjix < TLBN; adjix += TLB_SETS)
+                    regs->tlb.acc[adjix] = 0;
+            }
 #endif
         }
     }
@@ -2079,8 +2540,9 @@ void ARCH_DEP( do_invalidate_tlbe )( REGS* regs, BYTE* main )
 /*                                                                   */
 /*   TLB_VADDR does not contain all the effective address bits and   */
 /*   must be created on-the-fly using the tlb index (i << shift).    */
-/*   TLB_VADDR also contains the tlbid, so the regs->tlbid is merged */
-/*   with the main input variable before the search is begun.        */
+/*   TLB_VADDR also contains the tlbid, which is masked off so that  */
+/*   entries with any tlbid (such as those of retained SIE guest TLB */
+/*   contexts) are matched.                                          */
 /*                                                                   */
 /*-------------------------------------------------------------------*/
 void ARCH_DEP( invalidate_tlbe )( REGS* regs, BYTE* main )
@@ -2140,7 +2602,7 @@ void ARCH_DEP( invalidate_tlbe )( REGS* regs, BYTE* main )
 /*                     *** IMPORTANT! ***                            */
 /*                                                                   */
 /*           This function expects INTLOCK to be held                */
-/*         and SYNCHRONIZE_CPUS to be called beforehand!             */
+/*           unless only the local TLB is to be cleared!             */
 /*                                                                   */
 /*-------------------------------------------------------------------*/
 void ARCH_DEP( invalidate_pte )( BYTE ibyte, RADR pto, VADR vaddr, REGS* regs, bool local )
@@ -2385,9 +2847,19 @@ int     ix = TLBIX(addr);               /* TLB index                 */
         regs->dat.rpfra = addr & PAGEFRAME_PAGEMASK;
 
         /* Setup `real' TLB entry (for MADDR) */
+        ARCH_DEP( tlb_mru )( addr, TLB_REAL_ASD, false, regs );
+
+        /* (no need to update the reverse map if refreshing the entry) */
+        if (0
+            || regs->tlb.TLB_VADDR(ix) != ((addr & TLBID_PAGEMASK) | regs->tlbID)
+            || regs->tlb.TLB_PTE(ix)   != (addr & TLBID_PAGEMASK)
+        )
+        {
+            regs->tlb.TLB_VADDR(ix) = (addr & TLBID_PAGEMASK) | regs->tlbID;
+            regs->tlb.TLB_PTE(ix)   = addr & TLBID_PAGEMASK;
+            ARCH_DEP( tlb_rmap_add )( regs, ix );
+        }
         regs->tlb.TLB_ASD(ix)   = TLB_REAL_ASD;
-        regs->tlb.TLB_VADDR(ix) = (addr & TLBID_PAGEMASK) | regs->tlbID;
-        regs->tlb.TLB_PTE(ix)   = addr & TLBID_PAGEMASK;
         regs->tlb.acc[ix]       =
         regs->tlb.common[ix]    =
         regs->tlb.protect[ix]   = 0;
@@ -2422,7 +2894,10 @@ int     ix = TLBIX(addr);               /* TLB index                 */
         regs->tlb.protect[ix] |= HOSTREGS->dat.protect;
 
         if ( REAL_MODE(&regs->psw) || (arn == USE_REAL_ADDR) )
+        {
             regs->tlb.TLB_PTE(ix)   = addr & TLBID_PAGEMASK;
+            ARCH_DEP( tlb_rmap_add )( regs, ix );
+        }
 
         /* Indicate a host real space entry for a XC dataspace */
         if (arn > 0 && MULTIPLE_CONTROLLED_DATA_SPACE(regs))
@@ -2634,4 +3109,176 @@ RADR apply_host_prefixing( REGS* regs, RADR raddr )
     return aaddr;
 }
 
+/*-------------------------------------------------------------------*/
+/*                      TLB shootdown                                */
+/*-------------------------------------------------------------------*/
+/*                                                                   */
+/* purge_tlb_all, purge_tlbe_all and purge_alb_all purge the TLBs or */
+/* ALBs of other CPUs without stopping them at a syncpoint. Instead  */
+/* a request (what to purge plus a new generation number) is posted  */
+/* to each target CPU which is running, and the target applies it    */
+/* itself at its next instruction loop boundary, without obtaining   */
+/* intlock, and acknowledges it by updating its tlbshootack. The     */
+/* requesting CPU, which holds intlock, only waits for the targets   */
+/* it posted a request to. Targets which are stopped, waiting, or    */
+/* waiting for intlock cannot use their TLB while the requestor      */
+/* holds intlock, so the requestor purges their TLBs itself.         */
+/*                                                                   */
+/* While waiting, intlock is released between checks (as it is by   */
+/* synchronize_cpus) so that a target which needs intlock to finish */
+/* its current instruction can do so, and so that two CPUs waiting   */
+/* for each other's acknowledgement cannot deadlock, each requestor  */
+/* also applies any request posted to itself.                        */
+/*                                                                   */
+/*-------------------------------------------------------------------*/
+static void tlb_shootdown_apply( REGS* regs, BYTE what, RADR pfra )
+{
+    switch (regs->arch_mode)
+    {
+    case ARCH_370_IDX:
+        if (what & TLB_SHOOT_TLB)  s370_purge_tlb ( regs );
+        else
+        if (what & TLB_SHOOT_TLBE) s370_purge_tlbe( regs, pfra );
+        break;
+    case ARCH_390_IDX:
+        if (what & TLB_SHOOT_TLB)  s390_purge_tlb ( regs );
+        else
+        if (what & TLB_SHOOT_TLBE) s390_purge_tlbe( regs, pfra );
+        if (what & TLB_SHOOT_ALB)  s390_purge_alb ( regs );
+        break;
+    case ARCH_900_IDX:
+        if (what & TLB_SHOOT_TLB)  z900_purge_tlb ( regs );
+        else
+        if (what & TLB_SHOOT_TLBE) z900_purge_tlbe( regs, pfra );
+        if (what & TLB_SHOOT_ALB)  z900_purge_alb ( regs );
+        break;
+    default: CRASH();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* Apply and acknowledge the TLB shootdown request posted to a CPU   */
+/*-------------------------------------------------------------------*/
+void tlb_shootdown_ack( REGS* regs )
+{
+    REGS* hregs = HOSTREGS;
+
+    obtain_lock( &sysblk.tlbshootlock[ hregs->cpuad ]);
+    {
+        if (hregs->tlbshootack != hregs->tlbshootgen)
+        {
+            tlb_shootdown_apply( hregs, hregs->tlbshootwhat, hregs->tlbshootpfra );
+            hregs->tlbshootack = hregs->tlbshootgen;
+        }
+    }
+    release_lock( &sysblk.tlbshootlock[ hregs->cpuad ]);
+}
+
+/*-------------------------------------------------------------------*/
+/* Purge the TLB (or ALB) of CPU 'cpuad', or of all CPUs if 0xFFFF   */
+/* ('regs' is NULL if the requestor is not a CPU, e.g. the panel)    */
+/*-------------------------------------------------------------------*/
+void tlb_shootdown( REGS* regs, U16 cpuad, BYTE what, RADR pfra )
+{
+    CPU_BITMAP  posted = 0;             /* Targets yet to acknowledge*/
+    REGS*       tregs;                  /* Target CPU's host regs    */
+    int         cpu;
+
+    if (0xFFFF == cpuad && !(regs ? IS_INTLOCK_HELD( regs )   // (sanity check)
+                                  : sysblk.intowner == LOCK_OWNER_OTHER))
+        CRASH();                                      // (logic error!)
+
+    for (cpu=0; cpu < sysblk.maxcpu; cpu++)
+    {
+        if (!IS_CPU_ONLINE( cpu ))
+            continue;
+
+        tregs = sysblk.regs[ cpu ];
+
+        if (0
+            || !(tregs->cpubit & sysblk.started_mask)
+            || (0xFFFF != cpuad && tregs->cpuad != cpuad)
+        )
+            continue;
+
+        if (0
+            || (regs && tregs == HOSTREGS)
+            || (tregs->cpubit & sysblk.waiting_mask)
+            || AT_SYNCPOINT( tregs )
+        )
+        {
+            tlb_shootdown_apply( tregs, what, pfra );
+            continue;
+        }
+
+        obtain_lock( &sysblk.tlbshootlock[ cpu ]);
+        {
+            /* Merge with any request another CPU posted while we
+               had released intlock and the target hasn't applied */
+            if (tregs->tlbshootack != tregs->tlbshootgen)
+            {
+                if (what & TLB_SHOOT_TLBE)
+                {
+                    if (!(tregs->tlbshootwhat & TLB_SHOOT_TLBE))
+                        tregs->tlbshootpfra = pfra;
+                    else if (tregs->tlbshootpfra != pfra)
+                        tregs->tlbshootwhat |= TLB_SHOOT_TLB;
+                }
+                tregs->tlbshootwhat |= what;
+            }
+            else
+            {
+                tregs->tlbshootwhat = what;
+                tregs->tlbshootpfra = pfra;
+            }
+            tregs->tlbshootgen++;
+        }
+        release_lock( &sysblk.tlbshootlock[ cpu ]);
+
+        posted |= CPU_BIT( cpu );
+    }
+
+    while (posted)
+    {
+        for (cpu=0; cpu < sysblk.maxcpu; cpu++)
+        {
+            if (!(posted & CPU_BIT( cpu )))
+                continue;
+
+            if (!IS_CPU_ONLINE( cpu ))
+            {
+                posted &= ~CPU_BIT( cpu );
+                continue;
+            }
+
+            tregs = sysblk.regs[ cpu ];
+
+            /* Targets which stopped, started waiting or are waiting
+               for intlock since the request was posted are frozen
+               while we hold intlock, so apply the request for them */
+            if (0
+                || !(tregs->cpubit & sysblk.started_mask)
+                || (tregs->cpubit & sysblk.waiting_mask)
+                || AT_SYNCPOINT( tregs )
+            )
+                tlb_shootdown_ack( tregs );
+
+            if (tregs->tlbshootack == tregs->tlbshootgen)
+                posted &= ~CPU_BIT( cpu );
+        }
+
+        if (posted)
+        {
+            RELEASE_INTLOCK( regs );
+            {
+                sched_yield();
+            }
+            OBTAIN_INTLOCK( regs );
+
+            if (regs && TLB_SHOOTDOWN_PENDING( regs ))
+                tlb_shootdown_ack( regs );
+        }
+    }
+}
+
 #endif /* !defined( _GEN_ARCH ) */
@@ -67,31 +67,7 @@ U16 ARCH_DEP( translate_asn )( U16 asn, REGS* regs, U32* asteo, U32 aste[] );
 /*-------------------------------------------------------------------*/
 inline void ARCH_DEP( purge_tlb_all )( REGS* regs, U16 cpuad )
 {
-    int  cpu;
-
-    if (0xFFFF == cpuad && !IS_INTLOCK_HELD( regs ))  // (sanity check)
-        CRASH();                                      // (logic error!)
-
-    for (cpu=0; cpu < sysblk.maxcpu; cpu++)
-    {
-        if (1
-            && IS_CPU_ONLINE(cpu)
-            && (sysblk.regs[ cpu ]->cpubit & sysblk.started_mask)
-            && (0
-                || 0xFFFF == cpuad
-                || sysblk.regs[ cpu ]->cpuad == cpuad
-               )
-        )
-        {
-            switch (sysblk.regs[ cpu ]->arch_mode)
-            {
-            case ARCH_370_IDX: s370_purge_tlb( sysblk.regs[ cpu ]); break;
-            case ARCH_390_IDX: s390_purge_tlb( sysblk.regs[ cpu ]); break;
-            case ARCH_900_IDX: z900_purge_tlb( sysblk.regs[ cpu ]); break;
-            default: CRASH();
-            }
-        }
-    }
+    tlb_shootdown( regs, cpuad, TLB_SHOOT_TLB, 0 );
 }
 
 
@@ -100,31 +76,7 @@ inline void ARCH_DEP( purge_tlb_all )( REGS* regs, U16 cpuad )
 /*-------------------------------------------------------------------*/
 inline void ARCH_DEP( purge_tlbe_all )( REGS* regs, RADR pfra, U16 cpuad )
 {
-    int  cpu;
-
-    if (0xFFFF == cpuad && !IS_INTLOCK_HELD( regs ))  // (sanity check)
-        CRASH();                                      // (logic error!)
-
-    for (cpu=0; cpu < sysblk.maxcpu; cpu++)
-    {
-        if (1
-            && IS_CPU_ONLINE(cpu)
-            && (sysblk.regs[ cpu ]->cpubit & sysblk.started_mask)
-            && (0
-                || 0xFFFF == cpuad
-                || sysblk.regs[ cpu ]->cpuad == cpuad
-               )
-        )
-        {
-            switch (sysblk.regs[ cpu ]->arch_mode)
-            {
-            case ARCH_370_IDX: s370_purge_tlbe( sysblk.regs[ cpu ], pfra ); break;
-            case ARCH_390_IDX: s390_purge_tlbe( sysblk.regs[ cpu ], pfra ); break;
-            case ARCH_900_IDX: z900_purge_tlbe( sysblk.regs[ cpu ], pfra ); break;
-            default: CRASH();
-            }
-        }
-    }
+    tlb_shootdown( regs, cpuad, TLB_SHOOT_TLBE, pfra );
 }
 
 
@@ -134,26 +86,7 @@ inline void ARCH_DEP( purge_tlbe_all )( REGS* regs, RADR pfra, U16 cpuad )
 /*-------------------------------------------------------------------*/
 inline void ARCH_DEP( purge_alb_all )( REGS* regs )
 {
-    int  cpu;
-
-    if (!IS_INTLOCK_HELD( regs ))   // (sanity check)
-        CRASH();                    // (logic error!)
-
-    for (cpu=0; cpu < sysblk.maxcpu; cpu++)
-    {
-        if (1
-            && IS_CPU_ONLINE(cpu)
-            && (sysblk.regs[ cpu ]->cpubit & sysblk.started_mask)
-        )
-        {
-            switch (sysblk.regs[ cpu ]->arch_mode)
-            {
-            case ARCH_390_IDX: s390_purge_alb( sysblk.regs[ cpu ]); break;
-            case ARCH_900_IDX: z900_purge_alb( sysblk.regs[ cpu ]); break;
-            default: CRASH(); // (370 doesn't have access registers)
-            }
-        }
-    }
+    tlb_shootdown( regs, 0xFFFF, TLB_SHOOT_ALB, 0 );
 }
 #endif /* defined( FEATURE_ACCESS_REGISTERS ) */
 
@@ -357,17 +290,31 @@ inline BYTE* ARCH_DEP( maddr_l )
                             regs->dat.storkey = regs->tlb.storkey[ tlbix ];
 
                         maddr = MAINADDR( regs->tlb.main[tlbix], addr );
+                        regs->tlbhits++;
                     }
                 }
             }
         }
     }
 
+#if TLB_WAYS > 1
+    /* Not in way 0: check the set's other ways */
+    if (1
+        && !maddr
+        && aea_crn
+        && ((addr & TLBID_PAGEMASK) | regs->tlbID) != regs->tlb.TLB_VADDR( tlbix )
+    )
+        maddr = ARCH_DEP( tlb_assoc_hit )( addr, aea_crn, regs, acctype, akey );
+#endif
+
     /*---------------------------------------*/
     /* TLB miss: do full address translation */
     /*---------------------------------------*/
     if (!maddr)
+    {
+        regs->tlbmisses++;
         maddr = ARCH_DEP( logical_to_main_l )( addr, arn, regs, acctype, akey, len );
+    }
 
 #if defined( FEATURE_073_TRANSACT_EXEC_FACILITY )
     if (FACILITY_ENABLED( 073_TRANSACT_EXEC, regs ))
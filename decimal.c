@@ -563,6 +563,451 @@ int     temp3, temp4, temp5, qtest;     /* Work areas for algorithm  */
 
 } /* end function divide_decimal */
 
+
+#if defined( _FEATURE_134_ZVECTOR_PACK_DEC_FACILITY )
+/*-------------------------------------------------------------------*/
+/* Binary arithmetic for the vector packed decimal instructions      */
+/*                                                                   */
+/* The vector decimal instructions operate on a signed packed        */
+/* decimal number of 31 digits held in a vector register. Instead    */
+/* of working one digit at a time like the storage-to-storage        */
+/* instructions above, they convert the digits to a binary integer,  */
+/* do the arithmetic in binary, and convert the result back.         */
+/*                                                                   */
+/* 10**31 is less than 2**104 so an operand fits in 128 bits, but a  */
+/* product (VMP, VMSP) or a shifted dividend (VSDP) can need up to   */
+/* 207. The integers are therefore held as eight 32-bit limbs, which */
+/* also lets every operation, including the conversions that divide  */
+/* by 10**8, be done portably with 64-bit intermediate results.      */
+/*-------------------------------------------------------------------*/
+#define VDEC_LIMBS      8               /* Limbs in a binary integer */
+#define VDEC_DIGITS     31              /* Digits in a vector operand*/
+
+typedef struct
+{
+    int     n;                          /* Number of significant limbs
+                                           (zero if the value is 0)  */
+    U32     w[ VDEC_LIMBS ];            /* Magnitude, low limb first */
+}
+VDEC;
+
+/* Fields of the I3/I4 and M5 controls of the arithmetic instructions */
+#define VDEC_IOM( _i )      ((_i) & 0x80)   /* Instruction overflow mask */
+#define VDEC_RDC( _i )      ((_i) & 0x1F)   /* Result digits count       */
+#define VDEC_SHAMT( _i )    ((_i) & 0x1F)   /* Shift amount (VMSP, VSDP) */
+#define VDEC_P2( _m )       ((_m) & 0x08)   /* Operand 2 positive        */
+#define VDEC_P3( _m )       ((_m) & 0x04)   /* Operand 3 positive        */
+#define VDEC_P1( _m )       ((_m) & 0x02)   /* Result positive           */
+#define VDEC_CS( _m )       ((_m) & 0x01)   /* Condition code set        */
+
+static const U32 vdec_pow10_u32[ 10 ] =
+{
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000,
+    100000000, 1000000000
+};
+
+/*-------------------------------------------------------------------*/
+/* Convert 16 packed decimal digits to binary                        */
+/*-------------------------------------------------------------------*/
+/* Each step combines adjacent groups of digits in parallel: first  */
+/* into 2-digit values in each byte, then 4-digit values in each     */
+/* halfword, 8-digit values in each word, and finally the result.    */
+/*-------------------------------------------------------------------*/
+static inline U64 bcd16_to_binary( U64 x )
+{
+    x = (x & 0x0F0F0F0F0F0F0F0FULL) + ((x >>  4) & 0x0F0F0F0F0F0F0F0FULL) * 10;
+    x = (x & 0x00FF00FF00FF00FFULL) + ((x >>  8) & 0x00FF00FF00FF00FFULL) * 100;
+    x = (x & 0x0000FFFF0000FFFFULL) + ((x >> 16) & 0x0000FFFF0000FFFFULL) * 10000;
+    return (x & 0x00000000FFFFFFFFULL) + (x >> 32) * 100000000;
+}
+
+/*-------------------------------------------------------------------*/
+/* Convert a binary value less than 10**8 to 8 packed decimal digits */
+/*-------------------------------------------------------------------*/
+/* The reverse of the above: the value is split into two 4-digit    */
+/* halves, each of those into two 2-digit halves, and so on, with    */
+/* the divisions done in all of the lanes at once by multiplying by  */
+/* a reciprocal (n/100 == (n*5243)>>19 for n < 10000, and n/10 ==    */
+/* (n*103)>>10 for n < 100). The digits (one per byte) are finally   */
+/* squeezed together into one per nibble.                            */
+/*-------------------------------------------------------------------*/
+static inline U32 binary_to_bcd8( U32 v )
+{
+U64     x, q;                           /* Lanes and lane quotients  */
+
+    x = ((U64)(v / 10000) << 32) | (v % 10000);
+    q = ((x * 5243) >> 19) & 0x0000007F0000007FULL;
+    x = (q << 16) | (x - q * 100);
+    q = ((x * 103) >> 10) & 0x000F000F000F000FULL;
+    x = (q <<  8) | (x - q * 10);
+
+    x = (x | (x >>  4)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x >>  8)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+    return (U32) x;
+}
+
+/*-------------------------------------------------------------------*/
+/* Nonzero if any of the 16 digits is not a valid decimal digit      */
+/*-------------------------------------------------------------------*/
+/* A digit is invalid (A-F) if its 8 bit is on together with its 4   */
+/* or 2 bit.                                                         */
+/*-------------------------------------------------------------------*/
+static inline U64 bcd16_invalid( U64 x )
+{
+    return (x >> 3) & ((x >> 2) | (x >> 1)) & 0x1111111111111111ULL;
+}
+
+/*-------------------------------------------------------------------*/
+/* Basic operations on binary integers                               */
+/*-------------------------------------------------------------------*/
+static inline void vdec_norm( VDEC* a )
+{
+    while (a->n && !a->w[ a->n - 1 ])
+        a->n--;
+}
+
+static inline void vdec_set( VDEC* a, U64 v )
+{
+    memset( a->w, 0, sizeof( a->w ));
+    a->w[0] = (U32) v;
+    a->w[1] = (U32)(v >> 32);
+    a->n = a->w[1] ? 2 : a->w[0] ? 1 : 0;
+}
+
+/* a = a * m + add */
+static void vdec_mul_small( VDEC* a, U32 m, U32 add )
+{
+U64     t = add;                        /* Product and carry         */
+int     i;                              /* Limb index                */
+
+    for (i=0; i < a->n; i++)
+    {
+        t += (U64) a->w[i] * m;
+        a->w[i] = (U32) t;
+        t >>= 32;
+    }
+    if (t && a->n < VDEC_LIMBS)
+        a->w[ a->n++ ] = (U32) t;
+    vdec_norm( a );
+}
+
+/* a = a / d, returning the remainder */
+static U32 vdec_div_small( VDEC* a, U32 d )
+{
+U64     r = 0;                          /* Partial remainder         */
+int     i;                              /* Limb index                */
+
+    for (i = a->n - 1; i >= 0; i--)
+    {
+        r = (r << 32) | a->w[i];
+        a->w[i] = (U32)(r / d);
+        r %= d;
+    }
+    vdec_norm( a );
+    return (U32) r;
+}
+
+/* r = 10**n (n <= 62) */
+static void vdec_pow10( VDEC* r, int n )
+{
+    vdec_set( r, 1 );
+    for (; n > 9; n -= 9)
+        vdec_mul_small( r, vdec_pow10_u32[9], 0 );
+    vdec_mul_small( r, vdec_pow10_u32[n], 0 );
+}
+
+static int vdec_cmp( const VDEC* a, const VDEC* b )
+{
+int     i;                              /* Limb index                */
+
+    if (a->n != b->n)
+        return a->n < b->n ? -1 : 1;
+
+    for (i = a->n - 1; i >= 0; i--)
+        if (a->w[i] != b->w[i])
+            return a->w[i] < b->w[i] ? -1 : 1;
+
+    return 0;
+}
+
+/* r = a + b (r may be the same as a or b) */
+static void vdec_add( VDEC* r, const VDEC* a, const VDEC* b )
+{
+U64     t = 0;                          /* Sum and carry             */
+int     n = a->n > b->n ? a->n : b->n;  /* Limbs to add              */
+int     i;                              /* Limb index                */
+
+    for (i=0; i < n; i++)
+    {
+        t += (U64) a->w[i] + b->w[i];
+        r->w[i] = (U32) t;
+        t >>= 32;
+    }
+    for (; i < VDEC_LIMBS; i++)
+    {
+        r->w[i] = (U32) t;
+        t = 0;
+    }
+    r->n = n < VDEC_LIMBS ? n + 1 : n;
+    vdec_norm( r );
+}
+
+/* r = a - b where a >= b (r may be the same as a or b) */
+static void vdec_sub( VDEC* r, const VDEC* a, const VDEC* b )
+{
+U64     t;                              /* Difference                */
+U32     borrow = 0;                     /* Borrow indicator          */
+int     i;                              /* Limb index                */
+
+    for (i=0; i < a->n; i++)
+    {
+        t = (U64) a->w[i] - b->w[i] - borrow;
+        r->w[i] = (U32) t;
+        borrow = (U32)(t >> 63);
+    }
+    for (; i < VDEC_LIMBS; i++)
+        r->w[i] = 0;
+    r->n = a->n;
+    vdec_norm( r );
+}
+
+/* r = a * b where the product has no more than VDEC_LIMBS limbs */
+static void vdec_mul( VDEC* r, const VDEC* a, const VDEC* b )
+{
+U32     w[ VDEC_LIMBS ] = {0};          /* Product                   */
+U64     t;                              /* Partial product and carry */
+int     i, j;                           /* Limb indexes              */
+
+    for (i=0; i < a->n; i++)
+    {
+        for (t=0, j=0; j < b->n; j++)
+        {
+            t += (U64) a->w[i] * b->w[j] + w[i+j];
+            w[i+j] = (U32) t;
+            t >>= 32;
+        }
+        if (i + j < VDEC_LIMBS)
+            w[i+j] = (U32) t;
+    }
+    memcpy( r->w, w, sizeof( w ));
+    r->n = VDEC_LIMBS;
+    vdec_norm( r );
+}
+
+/*-------------------------------------------------------------------*/
+/* Divide binary integers: q = a / b and r = a % b (b nonzero)       */
+/*-------------------------------------------------------------------*/
+/* Knuth's Algorithm D (TAOCP Vol.2 4.3.1) with 32-bit limbs, as in  */
+/* H.S.Warren's 'Hacker's Delight' divmnu.                            */
+/*-------------------------------------------------------------------*/
+static void vdec_divmod( VDEC* q, VDEC* r, const VDEC* a, const VDEC* b )
+{
+U32     un[ VDEC_LIMBS + 1 ];           /* Normalized dividend       */
+U32     vn[ VDEC_LIMBS ];               /* Normalized divisor        */
+U64     qhat, rhat;                     /* Estimated quotient digit  */
+U64     p;                              /* Product                   */
+S64     t, k;                           /* Difference and borrow     */
+int     m = a->n, n = b->n;             /* Dividend and divisor size */
+int     s;                              /* Normalization shift       */
+int     i, j;                           /* Limb indexes              */
+U32     d;                              /* Divisor high limb         */
+
+    /* Quotient is zero if the dividend is less than the divisor */
+    if (vdec_cmp( a, b ) < 0)
+    {
+        *r = *a;
+        vdec_set( q, 0 );
+        return;
+    }
+
+    /* Short division if the divisor is a single limb */
+    if (n == 1)
+    {
+        *q = *a;
+        vdec_set( r, vdec_div_small( q, b->w[0] ));
+        return;
+    }
+
+    /* Shift the divisor left so that its high bit is one */
+    for (s=0, d = b->w[n-1]; !(d & 0x80000000); s++)
+        d <<= 1;
+
+    for (i = n - 1; i > 0; i--)
+        vn[i] = (b->w[i] << s) | (s ? b->w[i-1] >> (32 - s) : 0);
+    vn[0] = b->w[0] << s;
+
+    un[m] = s ? a->w[m-1] >> (32 - s) : 0;
+    for (i = m - 1; i > 0; i--)
+        un[i] = (a->w[i] << s) | (s ? a->w[i-1] >> (32 - s) : 0);
+    un[0] = a->w[0] << s;
+
+    memset( q->w, 0, sizeof( q->w ));
+
+    for (j = m - n; j >= 0; j--)
+    {
+        /* Estimate the quotient digit, at most two too big */
+        p    = ((U64) un[j+n] << 32) | un[j+n-1];
+        qhat = p / vn[n-1];
+        rhat = p % vn[n-1];
+
+        while (qhat > 0xFFFFFFFFULL
+            || qhat * vn[n-2] > ((rhat << 32) | un[j+n-2]))
+        {
+            qhat--;
+            rhat += vn[n-1];
+            if (rhat > 0xFFFFFFFFULL)
+                break;
+        }
+
+        /* Multiply and subtract */
+        for (k=0, i=0; i < n; i++)
+        {
+            p = qhat * vn[i];
+            t = (S64) un[i+j] - k - (S64)(p & 0xFFFFFFFF);
+            un[i+j] = (U32) t;
+            k = (S64)(p >> 32) - (t >> 32);
+        }
+        t = (S64) un[j+n] - k;
+        un[j+n] = (U32) t;
+
+        q->w[j] = (U32) qhat;
+
+        /* Add back if the estimate was one too big */
+        if (t < 0)
+        {
+            q->w[j]--;
+            for (k=0, i=0; i < n; i++)
+            {
+                t = (S64) un[i+j] + vn[i] + k;
+                un[i+j] = (U32) t;
+                k = t >> 32;
+            }
+            un[j+n] += (U32) k;
+        }
+    }
+
+    q->n = m - n + 1;
+    vdec_norm( q );
+
+    /* Unnormalize the remainder */
+    memset( r->w, 0, sizeof( r->w ));
+    for (i=0; i < n; i++)
+        r->w[i] = (un[i] >> s) | (s ? un[i+1] << (32 - s) : 0);
+    r->n = n;
+    vdec_norm( r );
+}
+
+/*-------------------------------------------------------------------*/
+/* Check a packed decimal vector operand                             */
+/*                                                                   */
+/* Returns the VTP condition code: 0 if the operand is valid, or     */
+/* 1 if its sign, 2 if one of its digits, or 3 if both are invalid.  */
+/*-------------------------------------------------------------------*/
+static int vdec_check( const VR* vr )
+{
+U64     hi = VR_D( *vr, 0 );            /* Digits 1-16               */
+U64     lo = VR_D( *vr, 1 );            /* Digits 17-31 and sign     */
+int     cc = 0;                         /* Condition code            */
+
+    if ((lo & 0x0F) < 0x0A)
+        cc |= 1;
+
+    if (bcd16_invalid( hi ) || bcd16_invalid( lo >> 4 ))
+        cc |= 2;
+
+    return cc;
+}
+
+/* Nonzero if a packed decimal vector operand has a minus sign */
+static inline int vdec_minus( const VR* vr )
+{
+BYTE    sign = VR_D( *vr, 1 ) & 0x0F;   /* Sign code                 */
+
+    return sign == 0x0B || sign == 0x0D;
+}
+
+/*-------------------------------------------------------------------*/
+/* Convert the digits of a packed decimal vector operand to binary   */
+/*-------------------------------------------------------------------*/
+/* The digits must be valid. The sign is ignored.                    */
+/*-------------------------------------------------------------------*/
+static void vdec_from_packed( VDEC* a, const VR* vr )
+{
+U64     hi = bcd16_to_binary( VR_D( *vr, 0 ));      /* Digits 1-16   */
+U64     lo = bcd16_to_binary( VR_D( *vr, 1 ) >> 4 );/* Digits 17-31  */
+
+    /* Most operands have no more than 15 digits */
+    vdec_set( a, hi );
+    if (a->n)
+    {
+        vdec_mul_small( a, vdec_pow10_u32[7], (U32)(lo / 100000000) );
+        vdec_mul_small( a, vdec_pow10_u32[8], (U32)(lo % 100000000) );
+    }
+    else
+        vdec_set( a, lo );
+}
+
+/*-------------------------------------------------------------------*/
+/* Convert a binary integer to the digits of a packed decimal vector */
+/*                                                                   */
+/* Input:                                                            */
+/*      a       Binary integer to be converted                       */
+/*      rdc     Number of digits in the result (1-31)                */
+/* Output:                                                           */
+/*      vr      Rightmost rdc digits of the integer, with zeroes to  */
+/*              the left and a sign code of zero                     */
+/*                                                                   */
+/*      Returns nonzero if any nonzero digits were lost, that is if  */
+/*      the integer has more than rdc significant digits.            */
+/*-------------------------------------------------------------------*/
+static int vdec_to_packed( VR* vr, const VDEC* a, int rdc )
+{
+VDEC    t = *a;                         /* Work copy of integer      */
+U32     c[4];                           /* 8-digit chunks, low first */
+U64     hi, lo;                         /* Digits 1-16 and 17-32     */
+U64     lost;                           /* Digits beyond rdc         */
+int     i;                              /* Chunk index               */
+
+    /* Split the integer into 8-digit chunks */
+    if (t.n <= 2)
+    {
+        U64 v = ((U64) t.w[1] << 32) | t.w[0];
+        for (i=0; i < 4; i++, v /= 100000000)
+            c[i] = (U32)(v % 100000000);
+        t.n = 0;
+    }
+    else
+    {
+        for (i=0; i < 4; i++)
+            c[i] = vdec_div_small( &t, 100000000 );
+    }
+
+    hi = ((U64) binary_to_bcd8( c[3] ) << 32) | binary_to_bcd8( c[2] );
+    lo = ((U64) binary_to_bcd8( c[1] ) << 32) | binary_to_bcd8( c[0] );
+
+    /* Keep the rightmost rdc digits */
+    if (rdc <= 16)
+    {
+        lost = hi | (rdc < 16 ? lo >> (rdc * 4) : 0);
+        hi = 0;
+        if (rdc < 16)
+            lo &= (1ULL << (rdc * 4)) - 1;
+    }
+    else
+    {
+        lost = hi >> ((rdc - 16) * 4);
+        hi &= (1ULL << ((rdc - 16) * 4)) - 1;
+    }
+
+    /* Shift the 31 digits left over the sign */
+    VR_D( *vr, 0 ) = (hi << 4) | (lo >> 60);
+    VR_D( *vr, 1 ) = lo << 4;
+
+    return lost != 0 || t.n != 0;
+}
+#endif /* defined( _FEATURE_134_ZVECTOR_PACK_DEC_FACILITY ) */
+
 #endif /*!defined(_DECIMAL_C)*/
 
 /*-------------------------------------------------------------------*/
@@ -1426,6 +1871,754 @@ BYTE    pack[MAX_DECIMAL_LENGTH];       /* Packed decimal work area  */
 #endif /*defined(FEATURE_016_EXT_TRANSL_FACILITY_2)*/
 
 
+#if defined( FEATURE_134_ZVECTOR_PACK_DEC_FACILITY )
+/*-------------------------------------------------------------------*/
+/* Load a packed decimal vector register operand                     */
+/*                                                                   */
+/* Input:                                                            */
+/*      v       Vector register number                               */
+/*      pos     Nonzero if the operand is to be treated as positive  */
+/*              (P2 or P3 control), in which case its sign code is   */
+/*              not checked                                          */
+/*      regs    CPU register context                                 */
+/* Output:                                                           */
+/*      val     Magnitude of the operand as a binary integer         */
+/*      sign    -1 if the operand is negative, or +1 if positive     */
+/*                                                                   */
+/*      A program check may be generated if the operand causes a     */
+/*      data exception because of invalid decimal digits or sign.    */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( load_vector_decimal )( int v, int pos, REGS* regs,
+                        VDEC* val, int* sign )
+{
+VR      vr;                             /* Operand                   */
+
+    vr_fetch( regs, v, &vr );
+
+    if (vdec_check( &vr ) & (pos ? 2 : 3))
+    {
+        regs->dxc = DXC_DECIMAL;
+        ARCH_DEP( program_interrupt )( regs, PGM_DATA_EXCEPTION );
+    }
+
+    vdec_from_packed( val, &vr );
+    *sign = (!pos && vdec_minus( &vr )) ? -1 : +1;
+
+} /* end function ARCH_DEP( load_vector_decimal ) */
+
+/*-------------------------------------------------------------------*/
+/* Store a binary integer into a packed decimal vector register      */
+/*                                                                   */
+/* Input:                                                            */
+/*      v       Vector register number                               */
+/*      val     Magnitude of the result                              */
+/*      sign    -1 if the result is negative, or +1 if positive      */
+/*      rdc     Result digits count (1-31)                           */
+/*      p1      Nonzero if the result is forced positive (P1 control)*/
+/*              in which case the sign code is 1111                  */
+/*      regs    CPU register context                                 */
+/*                                                                   */
+/*      Returns 0 if the result is zero, 1 if it is negative, 2 if   */
+/*      positive, or 3 if significant digits were lost. A zero       */
+/*      result is made positive unless digits were lost.             */
+/*-------------------------------------------------------------------*/
+static int ARCH_DEP( store_vector_decimal )( int v, const VDEC* val,
+                        int sign, int rdc, int p1, REGS* regs )
+{
+VR      vr;                             /* Result                    */
+int     ovf;                            /* 1=Significant digits lost */
+int     zero;                           /* 1=Result is zero          */
+
+    ovf  = vdec_to_packed( &vr, val, rdc );
+    zero = !VR_D( vr, 0 ) && !VR_D( vr, 1 );
+
+    if (p1 || (zero && !ovf))
+        sign = +1;
+
+    VR_D( vr, 1 ) |= p1 ? 0x0F : (sign < 0) ? 0x0D : 0x0C;
+    vr_store( regs, v, &vr );
+
+    return ovf ? 3 : zero ? 0 : (sign < 0) ? 1 : 2;
+
+} /* end function ARCH_DEP( store_vector_decimal ) */
+
+/*-------------------------------------------------------------------*/
+/* Complete a vector decimal instruction                             */
+/*                                                                   */
+/* Sets the condition code if the CS control is one, and recognizes  */
+/* a decimal overflow exception if significant digits were lost      */
+/* unless it is masked by the IOM control or the PSW program mask.   */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_decimal_cc )( int cc, int cs, int iom,
+                        REGS* regs )
+{
+    if (cs)
+        regs->psw.cc = cc;
+
+    if (cc == 3 && !iom && DOMASK( &regs->psw ))
+        ARCH_DEP( program_interrupt )( regs, PGM_DECIMAL_OVERFLOW_EXCEPTION );
+}
+
+/*-------------------------------------------------------------------*/
+/* Program check if the result digits count is zero                  */
+/*-------------------------------------------------------------------*/
+#define VDEC_RDC_CHECK( _i, _regs )                                     \
+                                                                        \
+    if (!VDEC_RDC( _i ))                                                \
+        ARCH_DEP( program_interrupt )( (_regs), PGM_SPECIFICATION_EXCEPTION )
+
+/*-------------------------------------------------------------------*/
+/* Common processing for VAP and VSP                                 */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_add_subtract_decimal )( BYTE inst[],
+                        REGS* regs, int subtract )
+{
+int     v1, v2, v3, i4, m5;             /* Instruction fields        */
+VDEC    a, b;                           /* Operand magnitudes        */
+int     sign2, sign3;                   /* Operand signs             */
+int     cc;                             /* Condition code            */
+
+    VRI_F( inst, regs, v1, v2, v3, i4, m5 );
+    ZVECTOR_CHECK( regs );
+    VDEC_RDC_CHECK( i4, regs );
+
+    ARCH_DEP( load_vector_decimal )( v2, VDEC_P2( m5 ), regs, &a, &sign2 );
+    ARCH_DEP( load_vector_decimal )( v3, VDEC_P3( m5 ), regs, &b, &sign3 );
+
+    if (subtract)
+        sign3 = -sign3;
+
+    /* Add the magnitudes if the signs are equal, otherwise subtract
+       the smaller one from the larger, whose sign is the result's */
+    if (sign2 == sign3)
+        vdec_add( &a, &a, &b );
+    else if (vdec_cmp( &a, &b ) >= 0)
+        vdec_sub( &a, &a, &b );
+    else
+    {
+        vdec_sub( &a, &b, &a );
+        sign2 = sign3;
+    }
+
+    cc = ARCH_DEP( store_vector_decimal )( v1, &a, sign2, VDEC_RDC( i4 ),
+                                           VDEC_P1( m5 ), regs );
+
+    ARCH_DEP( vector_decimal_cc )( cc, VDEC_CS( m5 ), VDEC_IOM( i4 ), regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* Common processing for VDP, VRP and VSDP                           */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_divide_decimal_common )( BYTE inst[],
+                        REGS* regs, int remainder, int shift )
+{
+int     v1, v2, v3, i4, m5;             /* Instruction fields        */
+VDEC    a, b;                           /* Operand magnitudes        */
+VDEC    q, r;                           /* Quotient and remainder    */
+int     sign2, sign3;                   /* Operand signs             */
+int     rdc;                            /* Result digits count       */
+int     cc;                             /* Condition code            */
+
+    VRI_F( inst, regs, v1, v2, v3, i4, m5 );
+    ZVECTOR_CHECK( regs );
+
+    /* VSDP has a shift amount in place of the result digits count */
+    if (shift)
+        rdc = VDEC_DIGITS;
+    else
+    {
+        VDEC_RDC_CHECK( i4, regs );
+        rdc = VDEC_RDC( i4 );
+    }
+
+    ARCH_DEP( load_vector_decimal )( v2, VDEC_P2( m5 ), regs, &a, &sign2 );
+    ARCH_DEP( load_vector_decimal )( v3, VDEC_P3( m5 ), regs, &b, &sign3 );
+
+    /* Program check if the divisor is zero */
+    if (!b.n)
+        ARCH_DEP( program_interrupt )( regs, PGM_DECIMAL_DIVIDE_EXCEPTION );
+
+    /* Shift the dividend left for VSDP */
+    if (shift && VDEC_SHAMT( i4 ))
+    {
+        vdec_pow10( &q, VDEC_SHAMT( i4 ));
+        vdec_mul( &a, &a, &q );
+    }
+
+    vdec_divmod( &q, &r, &a, &b );
+
+    /* The remainder has the sign of the dividend, the quotient is
+       positive if the signs of the operands are equal */
+    if (remainder)
+        cc = ARCH_DEP( store_vector_decimal )( v1, &r, sign2, rdc,
+                                               VDEC_P1( m5 ), regs );
+    else
+        cc = ARCH_DEP( store_vector_decimal )( v1, &q, sign2 * sign3, rdc,
+                                               VDEC_P1( m5 ), regs );
+
+    ARCH_DEP( vector_decimal_cc )( cc, VDEC_CS( m5 ), VDEC_IOM( i4 ), regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* Common processing for VMP and VMSP                                */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_multiply_decimal_common )( BYTE inst[],
+                        REGS* regs, int shift )
+{
+int     v1, v2, v3, i4, m5;             /* Instruction fields        */
+VDEC    a, b;                           /* Operand magnitudes        */
+VDEC    r;                              /* Remainder (discarded)     */
+int     sign2, sign3;                   /* Operand signs             */
+int     rdc;                            /* Result digits count       */
+int     cc;                             /* Condition code            */
+
+    VRI_F( inst, regs, v1, v2, v3, i4, m5 );
+    ZVECTOR_CHECK( regs );
+
+    /* VMSP has a shift amount in place of the result digits count */
+    if (shift)
+        rdc = VDEC_DIGITS;
+    else
+    {
+        VDEC_RDC_CHECK( i4, regs );
+        rdc = VDEC_RDC( i4 );
+    }
+
+    ARCH_DEP( load_vector_decimal )( v2, VDEC_P2( m5 ), regs, &a, &sign2 );
+    ARCH_DEP( load_vector_decimal )( v3, VDEC_P3( m5 ), regs, &b, &sign3 );
+
+    /* Both magnitudes are less than 2**104 so the product fits */
+    vdec_mul( &a, &a, &b );
+
+    /* Shift the product right for VMSP */
+    if (shift && VDEC_SHAMT( i4 ))
+    {
+        vdec_pow10( &b, VDEC_SHAMT( i4 ));
+        vdec_divmod( &a, &r, &a, &b );
+    }
+
+    cc = ARCH_DEP( store_vector_decimal )( v1, &a, sign2 * sign3, rdc,
+                                           VDEC_P1( m5 ), regs );
+
+    ARCH_DEP( vector_decimal_cc )( cc, VDEC_CS( m5 ), VDEC_IOM( i4 ), regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* Common processing for VCVB and VCVBG                              */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_convert_to_binary )( BYTE inst[],
+                        REGS* regs, int g )
+{
+int     r1, v2, m3, m4;                 /* Instruction fields        */
+VDEC    a;                              /* Operand magnitude         */
+int     sign;                           /* Operand sign              */
+U64     mag;                            /* Magnitude as 64-bit value */
+U64     max;                            /* Largest magnitude allowed */
+
+    VRR_I( inst, regs, r1, v2, m3, m4 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m4 );
+
+    ARCH_DEP( load_vector_decimal )( v2, m3 & 0x08, regs, &a, &sign );
+
+    /* Program check if the result does not fit the register */
+    mag = ((U64) a.w[1] << 32) | a.w[0];
+    max = g ? (sign < 0 ? 0x8000000000000000ULL : 0x7FFFFFFFFFFFFFFFULL)
+            : (sign < 0 ? 0x0000000080000000ULL : 0x000000007FFFFFFFULL);
+
+    if (a.n > 2 || mag > max)
+        ARCH_DEP( program_interrupt )( regs, PGM_FIXED_POINT_DIVIDE_EXCEPTION );
+
+    if (sign < 0)
+        mag = 0 - mag;
+
+    if (g)
+        regs->GR_G( r1 ) = mag;
+    else
+        regs->GR_L( r1 ) = (U32) mag;
+
+    if (m3 & 0x01)
+        regs->psw.cc = !a.n ? 0 : (sign < 0) ? 1 : 2;
+}
+
+/*-------------------------------------------------------------------*/
+/* Common processing for VCVD and VCVDG                              */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_convert_to_decimal )( BYTE inst[],
+                        REGS* regs, int g )
+{
+int     v1, r2, i3, m4;                 /* Instruction fields        */
+VDEC    a;                              /* Result magnitude          */
+S64     bin;                            /* Signed binary operand     */
+int     cc;                             /* Condition code            */
+
+    VRI_I( inst, regs, v1, r2, i3, m4 );
+    ZVECTOR_CHECK( regs );
+    VDEC_RDC_CHECK( i3, regs );
+    UNREFERENCED( m4 );
+
+    bin = g ? (S64) regs->GR_G( r2 ) : (S32) regs->GR_L( r2 );
+    vdec_set( &a, bin < 0 ? 0 - (U64) bin : (U64) bin );
+
+    cc = ARCH_DEP( store_vector_decimal )( v1, &a, bin < 0 ? -1 : +1,
+                                           VDEC_RDC( i3 ), 0, regs );
+
+    /* The condition code is unchanged */
+    ARCH_DEP( vector_decimal_cc )( cc, 0, VDEC_IOM( i3 ), regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* Common processing for VLRL and VLRLR                              */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_load_rightmost )( VADR addr, int len,
+                        int b2, int v1, REGS* regs )
+{
+BYTE    buf[16];                        /* Storage operand           */
+VR      vr;                             /* Result                    */
+int     i;                              /* Byte index                */
+
+    memset( buf, 0, sizeof( buf ));
+    ARCH_DEP( vfetchc )( buf + 15 - len, len, addr, b2, regs );
+
+    for (i=0; i < 16; i++)
+        VR_B( vr, i ) = buf[i];
+
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* Common processing for VSTRL and VSTRLR                            */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_store_rightmost )( VADR addr, int len,
+                        int b2, int v1, REGS* regs )
+{
+BYTE    buf[16];                        /* Storage operand           */
+VR      vr;                             /* Operand                   */
+int     i;                              /* Byte index                */
+
+    vr_fetch( regs, v1, &vr );
+
+    for (i=0; i < 16; i++)
+        buf[i] = VR_B( vr, i );
+
+    ARCH_DEP( vstorec )( buf + 15 - len, len, addr, b2, regs );
+}
+
+
+/*-------------------------------------------------------------------*/
+/* E634 VPKZ  - Vector Pack Zoned                              [VSI] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_pack_zoned )
+{
+int     i3, b2, v1;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+int     l2;                             /* Length minus one          */
+BYTE    zoned[ VDEC_DIGITS ];           /* Zoned decimal operand     */
+U64     hi = 0, lo = 0;                 /* Packed digits             */
+VR      vr;                             /* Result                    */
+int     i;                              /* Byte index                */
+
+    VSI( inst, regs, i3, b2, effective_addr2, v1 );
+    PER_ZEROADDR_XCHECK( regs, b2 );
+    ZVECTOR_CHECK( regs );
+
+    /* Program check if the operand is longer than 31 digits */
+    if ((l2 = i3 & 0x1F) > VDEC_DIGITS - 1)
+        ARCH_DEP( program_interrupt )( regs, PGM_SPECIFICATION_EXCEPTION );
+
+    ARCH_DEP( vfetchc )( zoned, l2, effective_addr2, b2, regs );
+
+    /* Pack the numeric digits, the zones are ignored */
+    for (i=0; i <= l2; i++)
+    {
+        if ((zoned[i] & 0x0F) > 9)
+        {
+            regs->dxc = DXC_DECIMAL;
+            ARCH_DEP( program_interrupt )( regs, PGM_DATA_EXCEPTION );
+        }
+        hi = (hi << 4) | (lo >> 60);
+        lo = (lo << 4) | (zoned[i] & 0x0F);
+    }
+
+    /* The zone of the rightmost byte is the sign */
+    VR_D( vr, 0 ) = (hi << 4) | (lo >> 60);
+    VR_D( vr, 1 ) = (lo << 4) | (zoned[ l2 ] >> 4);
+    vr_store( regs, v1, &vr );
+
+} /* end DEF_INST( vector_pack_zoned ) */
+
+/*-------------------------------------------------------------------*/
+/* E635 VLRL  - Vector Load Rightmost with Length              [VSI] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_rightmost_with_length )
+{
+int     i3, b2, v1;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+
+    VSI( inst, regs, i3, b2, effective_addr2, v1 );
+    PER_ZEROADDR_XCHECK( regs, b2 );
+    ZVECTOR_CHECK( regs );
+
+    ARCH_DEP( vector_load_rightmost )( effective_addr2, i3 & 0x0F, b2, v1, regs );
+
+} /* end DEF_INST( vector_load_rightmost_with_length ) */
+
+/*-------------------------------------------------------------------*/
+/* E637 VLRLR - Vector Load Rightmost with Length            [VRS-d] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_rightmost_with_length_reg )
+{
+int     v1, r3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+
+    VRS_D( inst, regs, v1, r3, b2, effective_addr2 );
+    PER_ZEROADDR_XCHECK( regs, b2 );
+    ZVECTOR_CHECK( regs );
+
+    ARCH_DEP( vector_load_rightmost )( effective_addr2,
+        regs->GR_L( r3 ) > 15 ? 15 : (int) regs->GR_L( r3 ), b2, v1, regs );
+
+} /* end DEF_INST( vector_load_rightmost_with_length_reg ) */
+
+/*-------------------------------------------------------------------*/
+/* E63C VUPKZ - Vector Unpack Zoned                            [VSI] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_unpack_zoned )
+{
+int     i3, b2, v1;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+int     l1;                             /* Length minus one          */
+BYTE    zoned[ VDEC_DIGITS ];           /* Zoned decimal result      */
+VR      vr;                             /* Operand                   */
+int     i, j;                           /* Byte and nibble indexes   */
+
+    VSI( inst, regs, i3, b2, effective_addr2, v1 );
+    PER_ZEROADDR_XCHECK( regs, b2 );
+    ZVECTOR_CHECK( regs );
+
+    /* Program check if the result is longer than 31 digits */
+    if ((l1 = i3 & 0x1F) > VDEC_DIGITS - 1)
+        ARCH_DEP( program_interrupt )( regs, PGM_SPECIFICATION_EXCEPTION );
+
+    vr_fetch( regs, v1, &vr );
+
+    /* Unpack the rightmost digits with zones of 1111 (nibble j
+       counts from the right, the sign being nibble zero) */
+    for (i = l1, j = 1; i >= 0; i--, j++)
+        zoned[i] = 0xF0 | ((VR_B( vr, 15 - j/2 ) >> ((j & 1) ? 4 : 0)) & 0x0F);
+
+    /* The zone of the rightmost byte is the sign */
+    zoned[ l1 ] = (zoned[ l1 ] & 0x0F) | (VR_B( vr, 15 ) << 4);
+
+    ARCH_DEP( vstorec )( zoned, l1, effective_addr2, b2, regs );
+
+} /* end DEF_INST( vector_unpack_zoned ) */
+
+/*-------------------------------------------------------------------*/
+/* E63D VSTRL - Vector Store Rightmost with Length             [VSI] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_store_rightmost_with_length )
+{
+int     i3, b2, v1;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+
+    VSI( inst, regs, i3, b2, effective_addr2, v1 );
+    PER_ZEROADDR_XCHECK( regs, b2 );
+    ZVECTOR_CHECK( regs );
+
+    ARCH_DEP( vector_store_rightmost )( effective_addr2, i3 & 0x0F, b2, v1, regs );
+
+} /* end DEF_INST( vector_store_rightmost_with_length ) */
+
+/*-------------------------------------------------------------------*/
+/* E63F VSTRLR - Vector Store Rightmost with Length          [VRS-d] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_store_rightmost_with_length_reg )
+{
+int     v1, r3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+
+    VRS_D( inst, regs, v1, r3, b2, effective_addr2 );
+    PER_ZEROADDR_XCHECK( regs, b2 );
+    ZVECTOR_CHECK( regs );
+
+    ARCH_DEP( vector_store_rightmost )( effective_addr2,
+        regs->GR_L( r3 ) > 15 ? 15 : (int) regs->GR_L( r3 ), b2, v1, regs );
+
+} /* end DEF_INST( vector_store_rightmost_with_length_reg ) */
+
+/*-------------------------------------------------------------------*/
+/* E649 VLIP  - Vector Load Immediate Decimal                [VRI-h] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_immediate_decimal )
+{
+int     v1, i2, i3;                     /* Instruction fields        */
+int     shift;                          /* Bit position of i2 digits */
+VR      vr;                             /* Result                    */
+
+    VRI_H( inst, regs, v1, i2, i3 );
+    ZVECTOR_CHECK( regs );
+
+    /* Program check if the immediate digits are invalid */
+    if (bcd16_invalid( (U64) i2 ))
+    {
+        regs->dxc = DXC_DECIMAL;
+        ARCH_DEP( program_interrupt )( regs, PGM_DATA_EXCEPTION );
+    }
+
+    /* The four digits are shifted left over the sign by the shift
+       amount times four digits; any digit beyond 31 digits is lost */
+    shift = 4 + (i3 & 0x07) * 16;
+
+    if (shift < 64)
+    {
+        VR_D( vr, 0 ) = shift > 48 ? (U64) i2 >> (64 - shift) : 0;
+        VR_D( vr, 1 ) = (U64) i2 << shift;
+    }
+    else
+    {
+        VR_D( vr, 0 ) = (U64) i2 << (shift - 64);
+        VR_D( vr, 1 ) = 0;
+    }
+
+    VR_D( vr, 1 ) |= (i3 & 0x08) ? 0x0D : 0x0C;
+    vr_store( regs, v1, &vr );
+
+} /* end DEF_INST( vector_load_immediate_decimal ) */
+
+/*-------------------------------------------------------------------*/
+/* E650 VCVB  - Vector Convert to Binary                     [VRR-i] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_convert_to_binary_32 )
+{
+    ARCH_DEP( vector_convert_to_binary )( inst, regs, 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E652 VCVBG - Vector Convert to Binary                     [VRR-i] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_convert_to_binary_64 )
+{
+    ARCH_DEP( vector_convert_to_binary )( inst, regs, 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E658 VCVD  - Vector Convert to Decimal                    [VRI-i] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_convert_to_decimal_32 )
+{
+    ARCH_DEP( vector_convert_to_decimal )( inst, regs, 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E65A VCVDG - Vector Convert to Decimal                    [VRI-i] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_convert_to_decimal_64 )
+{
+    ARCH_DEP( vector_convert_to_decimal )( inst, regs, 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E659 VSRP  - Vector Shift and Round Decimal               [VRI-g] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_shift_and_round_decimal )
+{
+int     v1, v2, i3, i4, m5;             /* Instruction fields        */
+VDEC    a, p, r;                        /* Operand, power of 10, rem */
+int     sign;                           /* Operand sign              */
+int     shift;                          /* Digits to shift (+ left)  */
+int     cc;                             /* Condition code            */
+
+    VRI_G( inst, regs, v1, v2, i3, i4, m5 );
+    ZVECTOR_CHECK( regs );
+    VDEC_RDC_CHECK( i3, regs );
+
+    ARCH_DEP( load_vector_decimal )( v2, VDEC_P2( m5 ), regs, &a, &sign );
+
+    /* Bits 1-7 of i4 are a signed shift amount, bit 0 is the
+       decimal rounding control */
+    shift = (i4 & 0x40) ? (i4 & 0x7F) - 128 : (i4 & 0x7F);
+
+    if (shift > 0)
+    {
+        /* Digits shifted beyond 31 digits are lost in any case */
+        vdec_pow10( &p, shift > VDEC_DIGITS ? VDEC_DIGITS : shift );
+        vdec_mul( &a, &a, &p );
+    }
+    else if (shift < 0)
+    {
+        /* Nothing is left after shifting right 32 digits or more */
+        shift = -shift > VDEC_DIGITS + 1 ? VDEC_DIGITS + 1 : -shift;
+
+        /* Round by adding 5 to the leftmost digit shifted out */
+        if (i4 & 0x80)
+        {
+            vdec_pow10( &p, shift - 1 );
+            vdec_mul_small( &p, 5, 0 );
+            vdec_add( &a, &a, &p );
+        }
+
+        vdec_pow10( &p, shift );
+        vdec_divmod( &a, &r, &a, &p );
+    }
+
+    cc = ARCH_DEP( store_vector_decimal )( v1, &a, sign, VDEC_RDC( i3 ),
+                                           VDEC_P1( m5 ), regs );
+
+    ARCH_DEP( vector_decimal_cc )( cc, VDEC_CS( m5 ), VDEC_IOM( i3 ), regs );
+
+} /* end DEF_INST( vector_shift_and_round_decimal ) */
+
+/*-------------------------------------------------------------------*/
+/* E65B VPSOP - Vector Perform Sign Operation Decimal        [VRI-g] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_perform_sign_operation_decimal )
+{
+int     v1, v2, i3, i4, m5;             /* Instruction fields        */
+VR      vr;                             /* Operand                   */
+VDEC    a;                              /* Operand magnitude         */
+int     check;                          /* Operand validity          */
+int     sign;                           /* Operand/result sign       */
+int     cc;                             /* Condition code            */
+
+    VRI_G( inst, regs, v1, v2, i3, i4, m5 );
+    ZVECTOR_CHECK( regs );
+    VDEC_RDC_CHECK( i3, regs );
+
+    /* The sign is not checked if the NV control is one, an invalid
+       sign is then treated as positive */
+    vr_fetch( regs, v2, &vr );
+    check = vdec_check( &vr );
+
+    if (check & ((i4 & 0x80) ? 2 : 3))
+    {
+        regs->dxc = DXC_DECIMAL;
+        ARCH_DEP( program_interrupt )( regs, PGM_DATA_EXCEPTION );
+    }
+
+    vdec_from_packed( &a, &vr );
+    sign = (!(check & 1) && vdec_minus( &vr )) ? -1 : +1;
+
+    /* Perform the sign operation */
+    switch (i4 & 0x03)
+    {
+        case 0: /* maintain */                      break;
+        case 1: /* complement */    sign = -sign;   break;
+        case 2: /* force positive */sign = +1;      break;
+        case 3: /* force negative */sign = -1;      break;
+    }
+
+    cc = ARCH_DEP( store_vector_decimal )( v1, &a, sign, VDEC_RDC( i3 ),
+                                           0, regs );
+
+    ARCH_DEP( vector_decimal_cc )( cc, VDEC_CS( m5 ), VDEC_IOM( i3 ), regs );
+
+} /* end DEF_INST( vector_perform_sign_operation_decimal ) */
+
+/*-------------------------------------------------------------------*/
+/* E65F VTP   - Vector Test Decimal                          [VRR-g] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_test_decimal )
+{
+int     v1;                             /* Instruction fields        */
+VR      vr;                             /* Operand                   */
+
+    VRR_G( inst, regs, v1 );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v1, &vr );
+    regs->psw.cc = vdec_check( &vr );
+
+} /* end DEF_INST( vector_test_decimal ) */
+
+/*-------------------------------------------------------------------*/
+/* E671 VAP   - Vector Add Decimal                           [VRI-f] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_add_decimal )
+{
+    ARCH_DEP( vector_add_subtract_decimal )( inst, regs, 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E673 VSP   - Vector Subtract Decimal                      [VRI-f] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_subtract_decimal )
+{
+    ARCH_DEP( vector_add_subtract_decimal )( inst, regs, 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E677 VCP   - Vector Compare Decimal                       [VRR-h] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_compare_decimal )
+{
+int     v1, v2, m3;                     /* Instruction fields        */
+VDEC    a, b;                           /* Operand magnitudes        */
+int     sign1, sign2;                   /* Operand signs             */
+int     rc;                             /* Comparison result         */
+
+    VRR_H( inst, regs, v1, v2, m3 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m3 );
+
+    ARCH_DEP( load_vector_decimal )( v1, 0, regs, &a, &sign1 );
+    ARCH_DEP( load_vector_decimal )( v2, 0, regs, &b, &sign2 );
+
+    /* Positive and negative zero are equal */
+    if (!a.n) sign1 = +1;
+    if (!b.n) sign2 = +1;
+
+    if (sign1 != sign2)
+        rc = sign1;
+    else
+        rc = vdec_cmp( &a, &b ) * sign1;
+
+    regs->psw.cc = (rc == 0) ? 0 : (rc < 0) ? 1 : 2;
+
+} /* end DEF_INST( vector_compare_decimal ) */
+
+/*-------------------------------------------------------------------*/
+/* E678 VMP   - Vector Multiply Decimal                      [VRI-f] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_multiply_decimal )
+{
+    ARCH_DEP( vector_multiply_decimal_common )( inst, regs, 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E679 VMSP  - Vector Multiply and Shift Decimal            [VRI-f] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_multiply_and_shift_decimal )
+{
+    ARCH_DEP( vector_multiply_decimal_common )( inst, regs, 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E67A VDP   - Vector Divide Decimal                        [VRI-f] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_divide_decimal )
+{
+    ARCH_DEP( vector_divide_decimal_common )( inst, regs, 0, 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E67B VRP   - Vector Remainder Decimal                     [VRI-f] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_remainder_decimal )
+{
+    ARCH_DEP( vector_divide_decimal_common )( inst, regs, 1, 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E67E VSDP  - Vector Shift and Divide Decimal              [VRI-f] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_shift_and_divide_decimal )
+{
+    ARCH_DEP( vector_divide_decimal_common )( inst, regs, 0, 1 );
+}
+#endif /* defined( FEATURE_134_ZVECTOR_PACK_DEC_FACILITY ) */
+
+
 #if !defined(_GEN_ARCH)
 
 #if defined(_ARCH_NUM_1)
@@ -0,0 +1,944 @@
+/* DFLTCC.C     (C) and others 2026                                  */
+/*              DEFLATE-Conversion Facility                          */
+/*                                                                   */
+/*   Released under "The Q Public License Version 1"                 */
+/*   (http://www.hercules-390.org/herclic.html) as modifications to  */
+/*   Hercules.                                                       */
+
+/*-------------------------------------------------------------------*/
+/* This module implements the DEFLATE CONVERSION CALL instruction of */
+/* the DEFLATE-Conversion Facility (facility bit 151) as described   */
+/* in SA22-7832-12 z/Architecture Principles of Operation.           */
+/*                                                                   */
+/* The compression and expansion proper is done by the host's zlib.  */
+/* Everything needed to resume an interrupted operation is kept in   */
+/* the guest's parameter block and history buffer, so that a guest   */
+/* may freely mix DFLTCC with its own software DEFLATE code.         */
+/*                                                                   */
+/* Compression (CMPR) feeds the input to a raw zlib deflate stream   */
+/* primed with the guest's history as dictionary, and closes a block */
+/* at each chunk boundary so that the output may be cut at whichever */
+/* chunk still fits into the first operand.  The Huffman tables are */
+/* chosen by zlib: the guest's CDHT is not used.  Each execution     */
+/* ends by opening an empty fixed-Huffman block which is left open   */
+/* (BCF set) for the guest, or the next execution, to close using    */
+/* the EOBS/EOBL fields, just as the real facility leaves its block  */
+/* open for software to continue or close.                           */
+/*                                                                   */
+/* Expansion (XPND) decodes with a raw zlib inflate stream stepped   */
+/* through the block structure with Z_TREES.  When it must stop in   */
+/* the middle of a block, the block header and the bits of the code  */
+/* being decoded are saved in the continuation state buffer (CSB),   */
+/* together with the number of bytes of a partly delivered match,    */
+/* and are decoded again in front of the remaining input next time.  */
+/*                                                                   */
+/*   CSB +0  U16  number of saved prefix bits                        */
+/*       +2  U16  bytes of the first decoded code to be skipped      */
+/*       +8       the saved prefix bits, least significant first     */
+/*-------------------------------------------------------------------*/
+
+#include "hstdinc.h"
+
+#define _DFLTCC_C_
+#define _HENGINE_DLL_
+
+#include "hercules.h"
+#include "opcode.h"
+#include "inline.h"
+
+#if !defined( _DFLTCC_C )
+#define _DFLTCC_C
+
+#if defined( _FEATURE_151_DEFLATE_CONV_FACILITY )
+
+/*-------------------------------------------------------------------*/
+/* Function codes and general register 0 fields                      */
+/*-------------------------------------------------------------------*/
+#define DFLTCC_QAF          0           /* Query Available Functions */
+#define DFLTCC_GDHT         1           /* Generate Dynamic-Huffman  */
+#define DFLTCC_CMPR         2           /* Compress                  */
+#define DFLTCC_XPND         4           /* Expand                    */
+
+#define DFLTCC_GR0_HBT      0x80        /* History-buffer type       */
+#define DFLTCC_GR0_FC       0x7F        /* Function code             */
+
+/*-------------------------------------------------------------------*/
+/* Parameter block format 0                                          */
+/*-------------------------------------------------------------------*/
+#define DFLTCC_QAF_LEN      32          /* QAF parameter block length*/
+#define DFLTCC_PB_LEN       1536        /* Parameter block length    */
+
+#define DFLTCC_PB_CF        7           /* Continuation flag byte    */
+#define DFLTCC_CF           0x01        /*  Continuation flag        */
+#define DFLTCC_PB_FLAGS     16          /* Control flags byte        */
+#define DFLTCC_NT           0x80        /*  New task                 */
+#define DFLTCC_CVT          0x20        /*  Check value type Adler-32*/
+#define DFLTCC_HTT          0x08        /*  Huffman table dynamic    */
+#define DFLTCC_BCF          0x04        /*  Block continuation flag  */
+#define DFLTCC_BCC          0x02        /*  Block closing control    */
+#define DFLTCC_BHF          0x01        /*  Block header final       */
+#define DFLTCC_PB_SBB       18          /* Sub-byte boundary         */
+#define DFLTCC_PB_OESC      19          /* Operation-ending suppl.   */
+#define DFLTCC_PB_IFS       21          /* Incomplete-function status*/
+#define DFLTCC_PB_IFL       22          /* Incomplete-function length*/
+#define DFLTCC_PB_HL        44          /* History length            */
+#define DFLTCC_PB_HO        46          /* History offset            */
+#define DFLTCC_PB_CV        48          /* Check value               */
+#define DFLTCC_PB_EOBS      52          /* End-of-block symbol       */
+#define DFLTCC_PB_EOBL      54          /* End-of-block length       */
+#define DFLTCC_PB_CDHTL     56          /* CDHT length in bits       */
+#define DFLTCC_PB_CDHT      64          /* Compressed DHT            */
+#define DFLTCC_CDHT_LEN     288
+#define DFLTCC_PB_CSB       384         /* Continuation state buffer */
+#define DFLTCC_CSB_LEN      1152
+#define DFLTCC_CSB_BITS     ((DFLTCC_CSB_LEN - 8) * 8)
+
+#define DFLTCC_OESC_DATA    0x11        /* Invalid compressed data   */
+
+/*-------------------------------------------------------------------*/
+/* Limits of this implementation                                     */
+/*-------------------------------------------------------------------*/
+#define DFLTCC_HB_LEN       32768       /* Circular history buffer   */
+#define DFLTCC_MAX_MATCH    258         /* Longest DEFLATE match     */
+#define DFLTCC_LEVEL        1           /* zlib compression level    */
+#define DFLTCC_CMPR_CHUNK   32768       /* Bytes per CMPR block      */
+#define DFLTCC_CMPR_MAX     (8 * DFLTCC_CMPR_CHUNK) /* CMPR input max*/
+#define DFLTCC_XPND_IN      65536       /* XPND input per execution  */
+#define DFLTCC_XPND_OUT     262144      /* XPND output per execution */
+
+/*-------------------------------------------------------------------*/
+/* Bit string helpers; DEFLATE packs bits least significant first    */
+/*-------------------------------------------------------------------*/
+static inline U32 dfltcc_getbit( const BYTE* buf, U32 pos )
+{
+    return (buf[ pos >> 3 ] >> (pos & 7)) & 1;
+}
+
+static inline void dfltcc_putbits( BYTE* buf, U32* pos, U32 val, int n )
+{
+    for (; n > 0; n--, val >>= 1, (*pos)++)
+    {
+        if (val & 1)
+            buf[ *pos >> 3 ] |=  (BYTE) (1 << (*pos & 7));
+        else
+            buf[ *pos >> 3 ] &= (BYTE) ~(1 << (*pos & 7));
+    }
+}
+
+static void dfltcc_copybits( BYTE* dst, U32* dpos,
+                             const BYTE* src, U32 spos, U32 n )
+{
+    for (; n > 0; n--, spos++)
+        dfltcc_putbits( dst, dpos, dfltcc_getbit( src, spos ), 1 );
+}
+
+/* Write a Huffman code, which DEFLATE stores most significant first */
+static void dfltcc_putcode( BYTE* buf, U32* pos, U32 code, int n )
+{
+    while (n-- > 0)
+        dfltcc_putbits( buf, pos, code >> n, 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/* Build the Dynamic-Huffman Table returned by GDHT                  */
+/*-------------------------------------------------------------------*/
+/* The table is a universal one which can code any input: it is a    */
+/* fixed-Huffman code with the literal codes split according to the  */
+/* bytes' likelihood in text.  Every code is complete as zlib's      */
+/* inflate requires.  Returns the table's length in bits.            */
+/*-------------------------------------------------------------------*/
+static U32 dfltcc_universal_dht( BYTE* cdht )
+{
+    static const BYTE  order[ 19 ] =
+        { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+    static const BYTE  runs[][2] =      /* { code length, count }    */
+        { {8,144}, {9,108}, {8,4}, {7,24}, {8,6}, {4,2}, {5,28} };
+
+    BYTE  clcode[ 19 ];                 /* Code length code codes    */
+    U32   pos = 0;
+    int   i, sym, code;
+
+    memset( cdht, 0, DFLTCC_CDHT_LEN );
+
+    /* The code length code uses eight symbols of three bits each   */
+    memset( clcode, 0xFF, sizeof( clcode ));
+    for (code = 0, sym = 0; sym < 19; sym++)
+        if (0
+            || sym == 4 || sym == 5 || sym == 7 || sym == 8
+            || sym == 9 || sym == 16 || sym == 17 || sym == 18
+        )
+            clcode[ sym ] = code++;
+
+    dfltcc_putbits( cdht, &pos, 286 - 257, 5 );     /* HLIT          */
+    dfltcc_putbits( cdht, &pos,  30 -   1, 5 );     /* HDIST         */
+    dfltcc_putbits( cdht, &pos,  12 -   4, 4 );     /* HCLEN         */
+
+    for (i = 0; i < 12; i++)
+        dfltcc_putbits( cdht, &pos, clcode[ order[i] ] != 0xFF ? 3 : 0, 3 );
+
+    /* Literal/length and distance code lengths, repeats using 16    */
+    for (i = 0; i < (int) _countof( runs ); i++)
+    {
+        int len   = runs[i][0];
+        int count = runs[i][1];
+
+        dfltcc_putcode( cdht, &pos, clcode[ len ], 3 );
+        count--;
+
+        while (count >= 3)
+        {
+            int rep = count > 6 ? 6 : count;
+            dfltcc_putcode( cdht, &pos, clcode[ 16 ], 3 );
+            dfltcc_putbits( cdht, &pos, rep - 3, 2 );
+            count -= rep;
+        }
+        while (count-- > 0)
+            dfltcc_putcode( cdht, &pos, clcode[ len ], 3 );
+    }
+    return pos;
+}
+
+/*-------------------------------------------------------------------*/
+/* Check value helpers: CRC-32 is kept byte reversed in the block    */
+/*-------------------------------------------------------------------*/
+static U32 dfltcc_get_cv( const BYTE* pb )
+{
+    U32 cv = fetch_fw( pb + DFLTCC_PB_CV );
+    return (pb[ DFLTCC_PB_FLAGS ] & DFLTCC_CVT) ? cv : bswap_32( cv );
+}
+
+static void dfltcc_set_cv( BYTE* pb, U32 cv )
+{
+    if (!(pb[ DFLTCC_PB_FLAGS ] & DFLTCC_CVT))
+        cv = bswap_32( cv );
+    store_fw( pb + DFLTCC_PB_CV, cv );
+}
+
+static U32 dfltcc_update_cv( const BYTE* pb, U32 cv, const BYTE* buf, size_t len )
+{
+    if (!len)
+        return cv;
+    return (pb[ DFLTCC_PB_FLAGS ] & DFLTCC_CVT)
+        ? (U32) adler32( cv, buf, (uInt) len )
+        : (U32) crc32  ( cv, buf, (uInt) len );
+}
+
+/*-------------------------------------------------------------------*/
+/* Set the new history length and offset after appending 'len' bytes */
+static void dfltcc_update_hist( BYTE* pb, U32 hl, U32 ho, size_t len, bool hbt )
+{
+    size_t  total = hl + len;
+
+    if (total > DFLTCC_HB_LEN)
+    {
+        if (hbt)
+            ho = (U32) ((ho + (total - DFLTCC_HB_LEN)) % DFLTCC_HB_LEN);
+        total = DFLTCC_HB_LEN;
+    }
+    store_hw( pb + DFLTCC_PB_HL, (U16) total );
+    store_hw( pb + DFLTCC_PB_HO, (U16) ho );
+}
+
+/*-------------------------------------------------------------------*/
+/* Fetch the history length and offset, honouring New Task           */
+/*-------------------------------------------------------------------*/
+static void dfltcc_get_hist( BYTE* pb, U32* hl, U32* ho )
+{
+    if (pb[ DFLTCC_PB_FLAGS ] & DFLTCC_NT)
+    {
+        *hl = *ho = 0;
+        memset( pb + DFLTCC_PB_CSB, 0, 8 );
+        store_fw( pb + DFLTCC_PB_CV,
+                  (pb[ DFLTCC_PB_FLAGS ] & DFLTCC_CVT) ? 1 : 0 );
+    }
+    else
+    {
+        *hl = min( (U32) fetch_hw( pb + DFLTCC_PB_HL ), (U32) DFLTCC_HB_LEN );
+        *ho = fetch_hw( pb + DFLTCC_PB_HO ) & (DFLTCC_HB_LEN - 1);
+    }
+}
+
+#endif /* defined( _FEATURE_151_DEFLATE_CONV_FACILITY ) */
+
+#endif /* !defined( _DFLTCC_C ) */
+
+#if defined( FEATURE_151_DEFLATE_CONV_FACILITY )
+
+/*-------------------------------------------------------------------*/
+/* Guest storage helpers, one page at a time                         */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( dfltcc_fetch )( BYTE* dst, VADR addr, size_t len,
+                                      int arn, REGS* regs )
+{
+    while (len)
+    {
+        size_t n = PAGEFRAME_PAGESIZE - (addr & PAGEFRAME_BYTEMASK);
+        if (n > len)
+            n = len;
+        memcpy( dst, MADDRL( addr, n, arn, regs, ACCTYPE_READ,
+                             regs->psw.pkey ), n );
+        dst  += n;
+        len  -= n;
+        addr  = (addr + n) & ADDRESS_MAXWRAP( regs );
+    }
+}
+
+/* Recognize any access exception before anything is stored          */
+static void ARCH_DEP( dfltcc_validate )( VADR addr, size_t len,
+                                         int arn, REGS* regs )
+{
+    while (len)
+    {
+        size_t n = PAGEFRAME_PAGESIZE - (addr & PAGEFRAME_BYTEMASK);
+        if (n > len)
+            n = len;
+        MADDRL( addr, n, arn, regs, ACCTYPE_WRITE_SKP, regs->psw.pkey );
+        len  -= n;
+        addr  = (addr + n) & ADDRESS_MAXWRAP( regs );
+    }
+}
+
+static void ARCH_DEP( dfltcc_store )( const BYTE* src, VADR addr, size_t len,
+                                      int arn, REGS* regs )
+{
+    while (len)
+    {
+        size_t n = PAGEFRAME_PAGESIZE - (addr & PAGEFRAME_BYTEMASK);
+        if (n > len)
+            n = len;
+        memcpy( MADDRL( addr, n, arn, regs, ACCTYPE_WRITE,
+                        regs->psw.pkey ), src, n );
+        src  += n;
+        len  -= n;
+        addr  = (addr + n) & ADDRESS_MAXWRAP( regs );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* History helpers                                                   */
+/*-------------------------------------------------------------------*/
+/* The in-line history immediately precedes 'addr'; the circular one */
+/* is 'hl' bytes at offset 'ho' of the 32K buffer addressed by R3.   */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( dfltcc_fetch_hist )( BYTE* dst, U32 hl, U32 ho,
+                                           bool hbt, VADR addr, int r,
+                                           int r3, REGS* regs )
+{
+    if (!hl)
+        return;
+
+    if (!hbt)
+        ARCH_DEP( dfltcc_fetch )( dst, (addr - hl) & ADDRESS_MAXWRAP( regs ),
+                                  hl, r, regs );
+    else
+    {
+        U32 n = min( hl, DFLTCC_HB_LEN - ho );
+        ARCH_DEP( dfltcc_fetch )( dst, (GR_A( r3, regs ) + ho)
+                                  & ADDRESS_MAXWRAP( regs ), n, r3, regs );
+        if (n < hl)
+            ARCH_DEP( dfltcc_fetch )( dst + n, GR_A( r3, regs ),
+                                      hl - n, r3, regs );
+    }
+}
+
+/* Append 'len' bytes to the circular history buffer; 'store' false  */
+/* only validates the areas which would be stored into.               */
+static void ARCH_DEP( dfltcc_store_hist )( const BYTE* src, size_t len,
+                                           U32 hl, U32 ho, int r3,
+                                           bool store, REGS* regs )
+{
+    U32  pos = (ho + hl) % DFLTCC_HB_LEN;
+    U32  n;
+
+    /* Only the last 32K are kept, where they would have ended up   */
+    if (len > DFLTCC_HB_LEN)
+    {
+        pos  = (U32) ((pos + (len - DFLTCC_HB_LEN)) % DFLTCC_HB_LEN);
+        src += len - DFLTCC_HB_LEN;
+        len  = DFLTCC_HB_LEN;
+    }
+    n   = (U32) min( len, (size_t) (DFLTCC_HB_LEN - pos) );
+
+    if (store)
+    {
+        ARCH_DEP( dfltcc_store )( src, (GR_A( r3, regs ) + pos)
+                                  & ADDRESS_MAXWRAP( regs ), n, r3, regs );
+        if (n < len)
+            ARCH_DEP( dfltcc_store )( src + n, GR_A( r3, regs ),
+                                      len - n, r3, regs );
+    }
+    else
+    {
+        ARCH_DEP( dfltcc_validate )( (GR_A( r3, regs ) + pos)
+                                     & ADDRESS_MAXWRAP( regs ), n, r3, regs );
+        if (n < len)
+            ARCH_DEP( dfltcc_validate )( GR_A( r3, regs ),
+                                         len - n, r3, regs );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* DFLTCC-QAF  Query Available Functions                             */
+/*-------------------------------------------------------------------*/
+static int ARCH_DEP( dfltcc_qaf )( REGS* regs )
+{
+    BYTE  qaf[ DFLTCC_QAF_LEN ];
+
+    memset( qaf, 0, sizeof( qaf ));
+
+    qaf[0]  = 0x80 >> DFLTCC_QAF        /* Installed functions       */
+            | 0x80 >> DFLTCC_GDHT
+            | 0x80 >> DFLTCC_CMPR
+            | 0x80 >> DFLTCC_XPND;
+    qaf[24] = 0x80;                     /* Parameter block format 0  */
+
+    ARCH_DEP( vstorec )( qaf, DFLTCC_QAF_LEN - 1,
+                         GR_A( 1, regs ) & ADDRESS_MAXWRAP( regs ), 1, regs );
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* DFLTCC-GDHT  Generate Dynamic-Huffman Table                       */
+/*-------------------------------------------------------------------*/
+static int ARCH_DEP( dfltcc_gdht )( BYTE* pb )
+{
+    U32  bits = dfltcc_universal_dht( pb + DFLTCC_PB_CDHT );
+
+    store_hw( pb + DFLTCC_PB_CDHTL, (U16) bits );
+    pb[ DFLTCC_PB_OESC ] = 0;
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* DFLTCC-CMPR  Compress                                             */
+/*-------------------------------------------------------------------*/
+static int ARCH_DEP( dfltcc_cmpr )( int r1, int r2, int r3, BYTE* pb,
+                                    bool hbt, REGS* regs )
+{
+    VADR      addr1 = GR_A( r1,     regs ) & ADDRESS_MAXWRAP( regs );
+    GREG      len1  = GR_A( r1 + 1, regs );
+    VADR      addr2 = GR_A( r2,     regs ) & ADDRESS_MAXWRAP( regs );
+    GREG      len2  = GR_A( r2 + 1, regs );
+    BYTE      flags = pb[ DFLTCC_PB_FLAGS ];
+    U32       sbb   = pb[ DFLTCC_PB_SBB ] & 0x07;
+    U32       endbit[ DFLTCC_CMPR_MAX / DFLTCC_CMPR_CHUNK ];
+    U32       hl, ho, cv, bits, pos, nchunks, k, i;
+    size_t    total, chunk, used, outlen;
+    BYTE      partial = 0;
+    BYTE     *in, *out, *hist;
+    z_stream  zs;
+    int       cc;
+
+    if (!len2)
+        return 0;
+    if (!len1)
+        return 1;
+
+    dfltcc_get_hist( pb, &hl, &ho );
+
+    /* Fetch everything this execution may need first */
+    total = (size_t) min( len2, (GREG) DFLTCC_CMPR_MAX );
+
+    in   = malloc( total );
+    hist = malloc( DFLTCC_HB_LEN );
+    memset( &zs, 0, sizeof( zs ));
+
+    if (0
+        || !in
+        || !hist
+        || deflateInit2( &zs, DFLTCC_LEVEL, Z_DEFLATED, -15, 8,
+                         (flags & DFLTCC_HTT) ? Z_DEFAULT_STRATEGY
+                                              : Z_FIXED ) != Z_OK
+    )
+    {
+        /* Host storage shortage: nothing done, try again */
+        free( in );
+        free( hist );
+        return 3;
+    }
+
+    if (sbb)
+        partial = ARCH_DEP( vfetchb )( addr1, r1, regs );
+    ARCH_DEP( dfltcc_fetch )( in, addr2, total, r2, regs );
+    ARCH_DEP( dfltcc_fetch_hist )( hist, hl, ho, hbt, addr2, r2, r3, regs );
+
+    out = malloc( deflateBound( &zs, (uLong) total )
+                  + 16 * _countof( endbit ) + 16 );
+    if (!out)
+    {
+        deflateEnd( &zs );
+        free( in );
+        free( hist );
+        return 3;
+    }
+
+    /* Compress chunk by chunk, closing a block after each one, then */
+    /* keep as many chunks as fit.  If not even the first one fits,  */
+    /* try again with ever smaller first chunks.                     */
+    for (chunk = DFLTCC_CMPR_CHUNK, used = total;; )
+    {
+        U32  pending;
+        int  pbits;
+
+        deflateReset( &zs );
+        if (hl)
+            deflateSetDictionary( &zs, hist, hl );
+        if (sbb)
+            deflatePrime( &zs, sbb, partial );
+
+        /* Close the block left open by the previous execution */
+        if (flags & DFLTCC_BCF)
+        {
+            U32 eobl = pb[ DFLTCC_PB_EOBL ] >> 4;
+            U32 eobs = fetch_hw( pb + DFLTCC_PB_EOBS ) >> 1;
+            U32 code = 0;
+
+            for (i = 0; i < eobl; i++)
+                code |= ((eobs >> (14 - i)) & 1) << i;
+            if (eobl)
+                deflatePrime( &zs, eobl, code );
+        }
+
+        zs.next_out  = out;
+        zs.avail_out = (uInt) (deflateBound( &zs, (uLong) total )
+                              + 16 * _countof( endbit ) + 16);
+
+        nchunks = (U32) ((used + chunk - 1) / chunk);
+        for (i = 0; i < nchunks; i++)
+        {
+            zs.next_in  = in + i * chunk;
+            zs.avail_in = (uInt) min( chunk, used - i * chunk );
+
+            while (zs.avail_in)
+                if (deflate( &zs, Z_BLOCK ) != Z_OK)
+                    break;
+
+            deflatePending( &zs, &pending, &pbits );
+            endbit[i] = (U32) ((zs.total_out + pending) * 8 + pbits);
+        }
+
+        /* Pad and flush the final partial byte into the output */
+        deflatePending( &zs, &pending, &pbits );
+        if (pbits)
+        {
+            deflatePrime( &zs, 8 - pbits, 0 );
+            deflate( &zs, Z_NO_FLUSH );
+        }
+
+        /* Each chunk is followed by the 3 bit open block header */
+        for (k = 0; k < nchunks; k++)
+            if ((endbit[k] + 3 + 7) / 8 > len1)
+                break;
+
+        if (k)
+            break;
+
+        if (used == 1)
+        {
+            /* Operand 1 is too short for any progress */
+            deflateEnd( &zs );
+            free( out );
+            free( in );
+            free( hist );
+            return 1;
+        }
+
+        chunk = min( chunk, used ) / 2;
+        used  = chunk;
+    }
+    deflateEnd( &zs );
+
+    used = (k == nchunks) ? used : k * chunk;
+
+    /* Open an empty fixed-Huffman block, final if BHF and all input */
+    /* has been compressed, and leave it for the guest to close      */
+    pos = endbit[ k - 1 ];
+    dfltcc_putbits( out, &pos, (flags & DFLTCC_BHF) && used == len2, 1 );
+    dfltcc_putbits( out, &pos, 1, 2 );
+
+    bits   = pos;
+    outlen = (bits + 7) / 8;
+    if (bits & 7)
+        out[ bits / 8 ] &= (1 << (bits & 7)) - 1;
+
+    cv = dfltcc_update_cv( pb, dfltcc_get_cv( pb ), in, used );
+
+    /* Recognize all access exceptions, then store the results */
+    ARCH_DEP( dfltcc_validate )( addr1, outlen, r1, regs );
+    if (hbt)
+        ARCH_DEP( dfltcc_store_hist )( in, used, hl, ho, r3, false, regs );
+    ARCH_DEP( dfltcc_validate )( GR_A( 1, regs ) & ADDRESS_MAXWRAP( regs ),
+                                 DFLTCC_PB_LEN, 1, regs );
+
+    ARCH_DEP( dfltcc_store )( out, addr1, outlen, r1, regs );
+    if (hbt)
+        ARCH_DEP( dfltcc_store_hist )( in, used, hl, ho, r3, true, regs );
+
+    pb[ DFLTCC_PB_FLAGS ] = (flags & ~DFLTCC_NT) | DFLTCC_BCF;
+    pb[ DFLTCC_PB_SBB ]   = (pb[ DFLTCC_PB_SBB ] & 0xF8) | (bits & 7);
+    pb[ DFLTCC_PB_OESC ]  = 0;
+    store_hw( pb + DFLTCC_PB_EOBS, 0 );     /* Fixed-Huffman EOB is  */
+    pb[ DFLTCC_PB_EOBL ]  = (pb[ DFLTCC_PB_EOBL ] & 0x0F) | (7 << 4);
+    dfltcc_set_cv( pb, cv );                /*  seven zero bits      */
+    dfltcc_update_hist( pb, hl, ho, used, hbt );
+
+    SET_GR_A( r1,     regs, (addr1 + bits / 8) & ADDRESS_MAXWRAP( regs ));
+    SET_GR_A( r1 + 1, regs, len1 - bits / 8 );
+    SET_GR_A( r2,     regs, (addr2 + used) & ADDRESS_MAXWRAP( regs ));
+    SET_GR_A( r2 + 1, regs, len2 - used );
+
+    if (used == len2)
+        cc = 0;
+    else if (k < nchunks || used < total)
+        cc = 1;
+    else
+        cc = 3;
+
+    free( out );
+    free( in );
+    free( hist );
+    return cc;
+}
+
+/*-------------------------------------------------------------------*/
+/* DFLTCC-XPND  Expand                                               */
+/*-------------------------------------------------------------------*/
+static int ARCH_DEP( dfltcc_xpnd )( int r1, int r2, int r3, BYTE* pb,
+                                    bool hbt, REGS* regs )
+{
+    VADR      addr1 = GR_A( r1,     regs ) & ADDRESS_MAXWRAP( regs );
+    GREG      len1  = GR_A( r1 + 1, regs );
+    VADR      addr2 = GR_A( r2,     regs ) & ADDRESS_MAXWRAP( regs );
+    GREG      len2  = GR_A( r2 + 1, regs );
+    BYTE*     csb   = pb + DFLTCC_PB_CSB;
+    BYTE      newcsb[ DFLTCC_CSB_LEN - 8 ] = {0};
+    U32       sbb   = pb[ DFLTCC_PB_SBB ] & 0x07;
+    U32       hl, ho, pbits, skip, npbits, nskip = 0, npos;
+    U32       T, lead, primed, p, from, cut, hs = 0, he = 0;
+    U32       blk_start = 0, hdr_end = 0, last_p = ~0U;
+    uInt      last_out = 0;
+    size_t    n, vlen, ocap, produced, outlen, histlen;
+    GREG      avail, consumed;
+    BYTE     *vbuf, *out, *hist;
+    z_stream  zs;
+    int       rc, cc, dt, last_dt = -1, partial;
+
+    if (!len1)
+        return 1;
+
+    dfltcc_get_hist( pb, &hl, &ho );
+    pbits = fetch_hw( csb + 0 );
+    skip  = fetch_hw( csb + 2 );
+
+    if (pbits > DFLTCC_CSB_BITS || skip > DFLTCC_MAX_MATCH)
+    {
+        pb[ DFLTCC_PB_OESC ] = DFLTCC_OESC_DATA;
+        return 2;
+    }
+
+    partial = (sbb && len2) ? 1 : 0;
+    if (!partial)
+        sbb = 0;
+    avail = len2 - partial;
+
+    if (!pbits && !len2)
+        return 2;
+
+    /* The saved prefix and the rest of the partial byte are placed */
+    /* so that the remaining input bytes are byte aligned in vbuf   */
+    n      = (size_t) min( avail, (GREG) DFLTCC_XPND_IN );
+    T      = pbits + (partial ? 8 - sbb : 0);
+    lead   = (8 - (T & 7)) & 7;
+    vlen   = (lead + T) / 8 + n;
+    ocap   = skip + (size_t) min( len1, (GREG) DFLTCC_XPND_OUT );
+
+    vbuf = calloc( 1, vlen + 1 );
+    out  = malloc( ocap );
+    hist = malloc( DFLTCC_HB_LEN );
+    memset( &zs, 0, sizeof( zs ));
+
+    if (!vbuf || !out || !hist || inflateInit2( &zs, -15 ) != Z_OK)
+    {
+        /* Host storage shortage: nothing done, try again */
+        free( vbuf );
+        free( out );
+        free( hist );
+        return 3;
+    }
+
+    npos = lead;
+    dfltcc_copybits( vbuf, &npos, csb + 8, 0, pbits );
+    if (partial)
+    {
+        BYTE b = ARCH_DEP( vfetchb )( addr2, r2, regs );
+        dfltcc_copybits( vbuf, &npos, &b, sbb, 8 - sbb );
+    }
+    ARCH_DEP( dfltcc_fetch )( vbuf + npos / 8,
+                              (addr2 + partial) & ADDRESS_MAXWRAP( regs ),
+                              n, r2, regs );
+
+    /* The history ends where the partly delivered match started */
+    ARCH_DEP( dfltcc_fetch_hist )( hist, hl, ho, hbt,
+                                   (addr1 - skip) & ADDRESS_MAXWRAP( regs ),
+                                   r1, r3, regs );
+    if (hl)
+        inflateSetDictionary( &zs, hist, hl );
+
+    primed = lead ? 8 - lead : 0;
+    if (lead)
+    {
+        inflatePrime( &zs, primed, vbuf[0] >> lead );
+        zs.next_in  = vbuf + 1;
+        zs.avail_in = (uInt) (vlen - 1);
+    }
+    else
+    {
+        zs.next_in  = vbuf;
+        zs.avail_in = (uInt) vlen;
+    }
+    zs.next_out  = out;
+    zs.avail_out = (uInt) ocap;
+
+    /* Step through the blocks noting where the current block and    */
+    /* its codes begin; p is the bit position in the prefixed input  */
+    for (;;)
+    {
+        rc = inflate( &zs, Z_TREES );
+        dt = zs.data_type;
+        p  = primed + 8 * (U32) zs.total_in - (dt & 63);
+
+        if (rc != Z_OK && rc != Z_BUF_ERROR)
+            break;
+        if (dt & 128)
+            blk_start = p;
+        if (dt & 256)
+            hdr_end = p;
+
+        /* Z_BUF_ERROR may still have decoded bits already held, so */
+        /* stop only when nothing at all has changed.  A full first */
+        /* operand does not stop the end of the last block, or any  */
+        /* block header, from being decoded.                        */
+        if (1
+            && rc == Z_BUF_ERROR
+            && p  == last_p
+            && dt == last_dt
+            && zs.avail_out == last_out
+        )
+            break;
+
+        last_p   = p;
+        last_dt  = dt;
+        last_out = zs.avail_out;
+    }
+
+    if (rc != Z_OK && rc != Z_BUF_ERROR && rc != Z_STREAM_END)
+    {
+        inflateEnd( &zs );
+        free( vbuf );
+        free( out );
+        free( hist );
+        if (rc != Z_DATA_ERROR)
+            return 3;
+        pb[ DFLTCC_PB_OESC ] = DFLTCC_OESC_DATA;
+        return 2;
+    }
+
+    produced = ocap - zs.avail_out;
+    npbits   = 0;
+
+    /* The end of the last block is the end of the stream */
+    if (rc == Z_STREAM_END || (dt & (128 | 64)) == (128 | 64))
+    {
+        /* Consume through the end of the byte holding the last bit */
+        U32 g = (max( p, pbits ) - pbits) + sbb;
+        consumed = (g + 7) / 8;
+        sbb = 0;
+        cc  = 0;
+    }
+    else
+    {
+        long  mark  = inflateMark( &zs );
+        int   back  = mark < 0 ? -1 : (int) (mark >> 16);
+        U32   lower = (U32) (mark & 0xFFFF);
+        bool  full  = !zs.avail_out;
+
+        if (dt & 128)                   /* Between blocks            */
+            from = p;
+        else if (dt & 256)              /* Just after a block header */
+            from = blk_start;
+        else if (back < 0 && lower)     /* Within stored block data  */
+        {
+            /* Synthesize a header for the rest of the stored block;  */
+            /* the five padding bits keep the data byte aligned       */
+            npos = 0;
+            dfltcc_putbits( newcsb, &npos, (dt & 64) ? 1 : 0, 1 );
+            dfltcc_putbits( newcsb, &npos, 0, 2 + 5 );
+            dfltcc_putbits( newcsb, &npos,  lower, 16 );
+            dfltcc_putbits( newcsb, &npos, ~lower, 16 );
+            npbits = npos;
+            from   = p;
+        }
+        else if (back >= 0)             /* Within a Huffman block    */
+        {
+            hs    = blk_start;
+            he    = hdr_end;
+            from  = p - back;
+            nskip = lower;
+        }
+        else                            /* Within a block header     */
+            from = blk_start;
+
+        cut = full ? max( from, T ) : T + 8 * (U32) n;
+
+        if (npbits + (he - hs) + (cut - from) > DFLTCC_CSB_BITS)
+        {
+            inflateEnd( &zs );
+            free( vbuf );
+            free( out );
+            free( hist );
+            pb[ DFLTCC_PB_OESC ] = DFLTCC_OESC_DATA;
+            return 2;
+        }
+
+        npos = npbits;
+        dfltcc_copybits( newcsb, &npos, vbuf, lead + hs, he - hs );
+        dfltcc_copybits( newcsb, &npos, vbuf, lead + from, cut - from );
+        npbits = npos;
+
+        if (full)
+        {
+            U32 g = cut - pbits + sbb;
+            consumed = g / 8;
+            sbb = g & 7;
+            cc  = (ocap - skip == len1) ? 1 : 3;
+        }
+        else
+        {
+            consumed = partial + n;
+            sbb = 0;
+            cc  = (n == avail) ? 2 : 3;
+        }
+    }
+    inflateEnd( &zs );
+
+    /* Bytes already delivered last time are not stored again, and   */
+    /* those of a partly delivered match are not yet history         */
+    outlen  = produced > skip  ? produced - skip  : 0;
+    histlen = produced > nskip ? produced - nskip : 0;
+
+    ARCH_DEP( dfltcc_validate )( addr1, outlen, r1, regs );
+    if (hbt)
+        ARCH_DEP( dfltcc_store_hist )( out, histlen, hl, ho, r3, false, regs );
+    ARCH_DEP( dfltcc_validate )( GR_A( 1, regs ) & ADDRESS_MAXWRAP( regs ),
+                                 DFLTCC_PB_LEN, 1, regs );
+
+    ARCH_DEP( dfltcc_store )( out + skip, addr1, outlen, r1, regs );
+    if (hbt)
+        ARCH_DEP( dfltcc_store_hist )( out, histlen, hl, ho, r3, true, regs );
+
+    dfltcc_set_cv( pb, dfltcc_update_cv( pb, dfltcc_get_cv( pb ),
+                                         out + skip, outlen ));
+    dfltcc_update_hist( pb, hl, ho, histlen, hbt );
+
+    pb[ DFLTCC_PB_FLAGS ] &= ~DFLTCC_NT;
+    pb[ DFLTCC_PB_SBB ]    = (pb[ DFLTCC_PB_SBB ] & 0xF8) | sbb;
+    pb[ DFLTCC_PB_OESC ]   = 0;
+    store_hw( csb + 0, (U16) npbits );
+    store_hw( csb + 2, (U16) nskip );
+    memcpy( csb + 8, newcsb, (npbits + 7) / 8 );
+
+    SET_GR_A( r1,     regs, (addr1 + outlen) & ADDRESS_MAXWRAP( regs ));
+    SET_GR_A( r1 + 1, regs, len1 - outlen );
+    SET_GR_A( r2,     regs, (addr2 + consumed) & ADDRESS_MAXWRAP( regs ));
+    SET_GR_A( r2 + 1, regs, len2 - consumed );
+
+    free( vbuf );
+    free( out );
+    free( hist );
+    return cc;
+}
+
+/*-------------------------------------------------------------------*/
+/* B939 DFLTCC - Deflate Conversion Call                     [RRF-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( deflate_conversion_call )
+{
+    int   r1, r2, r3;                   /* Operand register numbers  */
+    BYTE  pb[ DFLTCC_PB_LEN ];          /* Parameter block           */
+    BYTE  fc;                           /* Function code             */
+    bool  hbt;                          /* Circular history buffer   */
+    VADR  addr;                         /* Parameter block address   */
+
+    RRR( inst, regs, r1, r2, r3 );
+
+    TXF_INSTR_CHECK( regs );
+
+#if defined( FEATURE_PER_ZERO_ADDRESS_DETECTION_FACILITY )
+    if (0
+        || GR_A( 1,  regs ) == 0
+        || GR_A( r1, regs ) == 0
+        || GR_A( r2, regs ) == 0
+    )
+        ARCH_DEP( per3_zero )( regs );
+#endif
+
+    fc   = regs->GR_L( 0 ) & DFLTCC_GR0_FC;
+    hbt  = (regs->GR_L( 0 ) & DFLTCC_GR0_HBT) ? true : false;
+    addr = GR_A( 1, regs ) & ADDRESS_MAXWRAP( regs );
+
+    if (fc == DFLTCC_QAF)
+    {
+        regs->psw.cc = ARCH_DEP( dfltcc_qaf )( regs );
+        return;
+    }
+
+    /* Operands 1 and 2 are even-odd pairs other than 0 and the     */
+    /* parameter block is on a doubleword boundary                  */
+    if (0
+        || (fc != DFLTCC_GDHT && fc != DFLTCC_CMPR && fc != DFLTCC_XPND)
+        || !r1 || (r1 & 1)
+        || !r2 || (r2 & 1)
+        || (addr & 7)
+    )
+        ARCH_DEP( program_interrupt )( regs, PGM_SPECIFICATION_EXCEPTION );
+
+    ARCH_DEP( dfltcc_fetch )( pb, addr, DFLTCC_PB_LEN, 1, regs );
+
+    switch (fc)
+    {
+    case DFLTCC_GDHT:
+        regs->psw.cc = ARCH_DEP( dfltcc_gdht )( pb );
+        break;
+    case DFLTCC_CMPR:
+        regs->psw.cc = ARCH_DEP( dfltcc_cmpr )( r1, r2, r3, pb, hbt, regs );
+        break;
+    default:
+        regs->psw.cc = ARCH_DEP( dfltcc_xpnd )( r1, r2, r3, pb, hbt, regs );
+        break;
+    }
+
+    /* The operation is always completed within this execution */
+    pb[ DFLTCC_PB_CF ] &= ~DFLTCC_CF;
+    ARCH_DEP( dfltcc_store )( pb, addr, DFLTCC_PB_LEN, 1, regs );
+}
+
+#endif /* defined( FEATURE_151_DEFLATE_CONV_FACILITY ) */
+
+/*-------------------------------------------------------------------*/
+/*          (delineates ARCH_DEP from non-arch_dep)                  */
+/*-------------------------------------------------------------------*/
+
+#if !defined( _GEN_ARCH )
+
+  #if defined(              _ARCH_NUM_1 )
+    #define   _GEN_ARCH     _ARCH_NUM_1
+    #include "dfltcc.c"
+  #endif
+
+  #if defined(              _ARCH_NUM_2 )
+    #undef    _GEN_ARCH
+    #define   _GEN_ARCH     _ARCH_NUM_2
+    #include "dfltcc.c"
+  #endif
+
+#endif /* !defined( _GEN_ARCH ) */
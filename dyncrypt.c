@@ -159,6 +159,13 @@ static const int kmctr_pblens[32] =
 /*----------------------------------------------------------------------------*/
 #define TRUEFALSE(boolean)  ((boolean) ? "True" : "False")
 
+/*----------------------------------------------------------------------------*/
+/* True if output out starts within input in of len bytes past its first      */
+/* byte, where the host kernels, which work on several blocks at a time,      */
+/* would not give the same result as processing one block after the other     */
+/*----------------------------------------------------------------------------*/
+#define OVERLAPS(out, in, len)  ((out) > (in) && (out) < (in) + (len))
+
 #ifndef __STATIC_FUNCTIONS__
 #define __STATIC_FUNCTIONS__
 
@@ -286,6 +293,17 @@ void xts_gf_mult(const unsigned char *a, const unsigned char *b, unsigned char *
       c[i] = reverse_bits( c_r[i] );
 }
 
+/*----------------------------------------------------------------------------*/
+/* Round keys in the byte order the host AES kernels take them                */
+/*----------------------------------------------------------------------------*/
+static void aes_round_keys(BYTE *rk, const u32 *schedule, int nr)
+{
+  int i;
+
+  for(i = 0; i < 4 * (nr + 1); i++)
+    store_fw(&rk[i * 4], schedule[i]);
+}
+
 /*----------------------------------------------------------------------------*/
 /* Message Security Assist Extension query                                    */
 /*----------------------------------------------------------------------------*/
@@ -830,6 +848,25 @@ static BYTE exp_table[128][16] =
 };
 #endif /* #ifndef __STATIC_FUNCTIONS__ */
 
+/*----------------------------------------------------------------------------*/
+/* Length of the data that can be processed in one go in main storage: the    */
+/* whole blocks up to the CPU-determined amount left, the operand length and  */
+/* the nearest page end of any of the operands. Zero means that the next      */
+/* block crosses a page boundary and must be fetched and stored separately.   */
+/*----------------------------------------------------------------------------*/
+static int ARCH_DEP(crypt_span)(VADR addr1, VADR addr2, VADR addr3, VADR len, int max, int blocklen)
+{
+  int span;
+
+  span = max;
+  if(len < (VADR) span)
+    span = (int) len;
+  span = min(span, (int) (PAGEFRAME_PAGESIZE - (addr1 & PAGEFRAME_BYTEMASK)));
+  span = min(span, (int) (PAGEFRAME_PAGESIZE - (addr2 & PAGEFRAME_BYTEMASK)));
+  span = min(span, (int) (PAGEFRAME_PAGESIZE - (addr3 & PAGEFRAME_BYTEMASK)));
+  return span - span % blocklen;
+}
+
 /*----------------------------------------------------------------------------*/
 /* Compute intermediate message digest (KIMD) FC 1-3                          */
 /*----------------------------------------------------------------------------*/
@@ -845,8 +882,12 @@ static void ARCH_DEP(kimd_sha)(int r1, int r2, REGS *regs, int klmd)
   SHA2_CTX sha512_ctx;
 #endif /* defined( FEATURE_MSA_EXTENSION_FACILITY_2 ) */
 
+  VADR addr2;
   int crypted;
   int fc;
+  int i;
+  BYTE *in;
+  int len;
   BYTE message_block[128];
   int message_blocklen = 0;
   BYTE parameter_block[64];
@@ -940,20 +981,34 @@ static void ARCH_DEP(kimd_sha)(int r1, int r2, REGS *regs, int klmd)
   }
 
   /* Try to process the CPU-determined amount of data */
-  for(crypted = 0; crypted < PROCESS_MAX; crypted += message_blocklen)
+  for(crypted = 0; crypted < PROCESS_MAX; crypted += len)
   {
-    /* Fetch and process a block of data */
-    ARCH_DEP(vfetchc)(message_block, message_blocklen - 1, GR_A(r2, regs) & ADDRESS_MAXWRAP(regs), r2, regs);
+    /* Process the blocks up to the page end in main storage */
+    addr2 = GR_A(r2, regs) & ADDRESS_MAXWRAP(regs);
+    len = ARCH_DEP(crypt_span)(addr2, addr2, addr2, GR_A(r2 + 1, regs), PROCESS_MAX - crypted, message_blocklen);
+    if(likely(len))
+      in = MADDRL(addr2, len, r2, regs, ACCTYPE_READ, regs->psw.pkey);
+    else
+    {
+      /* Fetch a block of data which crosses a page boundary */
+      len = message_blocklen;
+      ARCH_DEP(vfetchc)(message_block, message_blocklen - 1, addr2, r2, regs);
+      in = message_block;
+    }
 
 #ifdef OPTION_KIMD_DEBUG
-    LOGBYTE2("input :", message_block, 16, message_blocklen / 16);
+    LOGBYTE2("input :", in, 16, message_blocklen / 16);
 #endif /* #ifdef OPTION_KIMD_DEBUG */
 
     switch(fc)
     {
       case 1: /* sha-1 */
       {
-        SHA1Transform(sha1_ctx.state, message_block);
+        if(hsimd_sha1)
+          hsimd_sha1(sha1_ctx.state, in, len / message_blocklen);
+        else
+          for(i = 0; i < len; i += message_blocklen)
+            SHA1Transform(sha1_ctx.state, &in[i]);
         sha1_getcv(&sha1_ctx, parameter_block);
         break;
       }
@@ -961,7 +1016,11 @@ static void ARCH_DEP(kimd_sha)(int r1, int r2, REGS *regs, int klmd)
 #if defined( FEATURE_MSA_EXTENSION_FACILITY_1 )
       case 2: /* sha-256 */
       {
-        SHA256Transform(sha2_ctx.state.st32, message_block);
+        if(hsimd_sha256)
+          hsimd_sha256(sha2_ctx.state.st32, in, len / message_blocklen);
+        else
+          for(i = 0; i < len; i += message_blocklen)
+            SHA256Transform(sha2_ctx.state.st32, &in[i]);
         sha256_getcv(&sha2_ctx, parameter_block);
         break;
       }
@@ -970,7 +1029,8 @@ static void ARCH_DEP(kimd_sha)(int r1, int r2, REGS *regs, int klmd)
 #if defined( FEATURE_MSA_EXTENSION_FACILITY_2 )
       case 3: /* sha-512 */
       {
-        SHA512Transform(sha512_ctx.state.st64, message_block);
+        for(i = 0; i < len; i += message_blocklen)
+          SHA512Transform(sha512_ctx.state.st64, &in[i]);
         sha512_getcv(&sha512_ctx, parameter_block);
         break;
       }
@@ -993,8 +1053,8 @@ static void ARCH_DEP(kimd_sha)(int r1, int r2, REGS *regs, int klmd)
 #endif /* #ifdef OPTION_KIMD_DEBUG */
 
     /* Update the registers */
-    SET_GR_A(r2, regs, GR_A(r2, regs) + message_blocklen);
-    SET_GR_A(r2 + 1, regs, GR_A(r2 + 1, regs) - message_blocklen);
+    SET_GR_A(r2, regs, GR_A(r2, regs) + len);
+    SET_GR_A(r2 + 1, regs, GR_A(r2 + 1, regs) - len);
 
 #ifdef OPTION_KIMD_DEBUG
     WRMSG(HHC90108, "D", r2, (regs)->GR(r2));
@@ -1021,8 +1081,12 @@ static void ARCH_DEP(kimd_sha)(int r1, int r2, REGS *regs, int klmd)
 /*----------------------------------------------------------------------------*/
 static void ARCH_DEP(kimd_ghash)(int r1, int r2, REGS *regs)
 {
+  VADR addr2;
   int crypted;
   int i;
+  int j;
+  BYTE *in;
+  int len;
   BYTE message_block[16];
   BYTE parameter_block[32];
 
@@ -1051,19 +1115,37 @@ static void ARCH_DEP(kimd_ghash)(int r1, int r2, REGS *regs)
 #endif /* #ifdef OPTION_KIMD_DEBUG */
 
   /* Try to process the CPU-determined amount of data */
-  for(crypted = 0; crypted < PROCESS_MAX; crypted += 16)
+  for(crypted = 0; crypted < PROCESS_MAX; crypted += len)
   {
-    /* Fetch and process a block of data */
-    ARCH_DEP(vfetchc)(message_block, 15, GR_A(r2, regs) & ADDRESS_MAXWRAP(regs), r2, regs);
+    /* Process the blocks up to the page end in main storage */
+    addr2 = GR_A(r2, regs) & ADDRESS_MAXWRAP(regs);
+    len = ARCH_DEP(crypt_span)(addr2, addr2, addr2, GR_A(r2 + 1, regs), PROCESS_MAX - crypted, 16);
+    if(likely(len))
+      in = MADDRL(addr2, len, r2, regs, ACCTYPE_READ, regs->psw.pkey);
+    else
+    {
+      /* Fetch a block of data which crosses a page boundary */
+      len = 16;
+      ARCH_DEP(vfetchc)(message_block, 15, addr2, r2, regs);
+      in = message_block;
+    }
 
 #ifdef OPTION_KIMD_DEBUG
-    LOGBYTE("input :", message_block, 16);
+    LOGBYTE("input :", in, 16);
 #endif /* #ifdef OPTION_KIMD_DEBUG */
 
     /* XOR and multiply */
-    for(i = 0; i < 16; i++)
-      parameter_block[i] ^= message_block[i];
-    gcm_gf_mult(parameter_block, &parameter_block[16], parameter_block);
+    if(hsimd_ghash)
+      hsimd_ghash(parameter_block, &parameter_block[16], in, len / 16);
+    else
+    {
+      for(j = 0; j < len; j += 16)
+      {
+        for(i = 0; i < 16; i++)
+          parameter_block[i] ^= in[j + i];
+        gcm_gf_mult(parameter_block, &parameter_block[16], parameter_block);
+      }
+    }
 
     /* Store the output chaining value */
     ARCH_DEP(vstorec)(parameter_block, 15, GR_A(1, regs) & ADDRESS_MAXWRAP(regs), 1, regs);
@@ -1073,8 +1155,8 @@ static void ARCH_DEP(kimd_ghash)(int r1, int r2, REGS *regs)
 #endif /* #ifdef OPTION_KIMD_DEBUG */
 
     /* Update the registers */
-    SET_GR_A(r2, regs, GR_A(r2, regs) + 16);
-    SET_GR_A(r2 + 1, regs, GR_A(r2 + 1, regs) - 16);
+    SET_GR_A(r2, regs, GR_A(r2, regs) + len);
+    SET_GR_A(r2 + 1, regs, GR_A(r2 + 1, regs) - len);
 
 #ifdef OPTION_KIMD_DEBUG
     WRMSG(HHC90108, "D", r2, (regs)->GR(r2));
@@ -1492,14 +1574,22 @@ static void ARCH_DEP(km_dea)(int r1, int r2, REGS *regs)
 /*----------------------------------------------------------------------------*/
 static void ARCH_DEP(km_aes)(int r1, int r2, REGS *regs)
 {
+  VADR addr1;
+  VADR addr2;
   rijndael_ctx context;
   int crypted;
+  int i;
+  BYTE *in;
+  HSIMDAES *kernel;
   int keylen;
+  int len;
   BYTE message_block[16];
   int modifier_bit;
+  BYTE *out;
   BYTE parameter_block[64];
   int parameter_blocklen;
   int r1_is_not_r2;
+  BYTE round_keys[16 * (AES_MAXROUNDS + 1)];
   int tfc;
   int wrap;
 
@@ -1551,33 +1641,59 @@ static void ARCH_DEP(km_aes)(int r1, int r2, REGS *regs)
   /* Try to process the CPU-determined amount of data */
   modifier_bit = GR0_m(regs);
   r1_is_not_r2 = r1 != r2;
-  for(crypted = 0; crypted < PROCESS_MAX; crypted += 16)
+  kernel = modifier_bit ? hsimd_aes_dec : hsimd_aes_enc;
+  if(kernel)
+    aes_round_keys(round_keys, modifier_bit ? context.dk : context.ek, context.Nr);
+  for(crypted = 0; crypted < PROCESS_MAX; crypted += len)
   {
-    /* Fetch a block of data */
-    ARCH_DEP(vfetchc)(message_block, 15, GR_A(r2, regs) & ADDRESS_MAXWRAP(regs), r2, regs);
+    /* Process the blocks up to the nearest page end in main storage */
+    addr1 = GR_A(r1, regs) & ADDRESS_MAXWRAP(regs);
+    addr2 = GR_A(r2, regs) & ADDRESS_MAXWRAP(regs);
+    len = ARCH_DEP(crypt_span)(addr1, addr2, addr2, GR_A(r2 + 1, regs), PROCESS_MAX - crypted, 16);
+    if(likely(len))
+    {
+      in = MADDRL(addr2, len, r2, regs, ACCTYPE_READ, regs->psw.pkey);
+      out = MADDRL(addr1, len, r1, regs, ACCTYPE_WRITE, regs->psw.pkey);
+    }
+    else
+    {
+      /* Fetch a block of data which crosses a page boundary */
+      len = 16;
+      ARCH_DEP(vfetchc)(message_block, 15, addr2, r2, regs);
+      in = out = message_block;
+    }
 
 #ifdef OPTION_KM_DEBUG
-    LOGBYTE("input :", message_block, 16);
+    LOGBYTE("input :", in, 16);
 #endif /* #ifdef OPTION_KM_DEBUG */
 
     /* Do the job */
-    if(modifier_bit)
-      rijndael_decrypt(&context, message_block, message_block);
+    if(kernel && !OVERLAPS(out, in, len))
+      kernel(round_keys, context.Nr, in, out, len / 16);
     else
-      rijndael_encrypt(&context, message_block, message_block);
+    {
+      for(i = 0; i < len; i += 16)
+      {
+        if(modifier_bit)
+          rijndael_decrypt(&context, &in[i], &out[i]);
+        else
+          rijndael_encrypt(&context, &in[i], &out[i]);
+      }
+    }
 
-    /* Store the output */
-    ARCH_DEP(vstorec)(message_block, 15, GR_A(r1, regs) & ADDRESS_MAXWRAP(regs), r1, regs);
+    /* Store the output of a block which crosses a page boundary */
+    if(unlikely(out == message_block))
+      ARCH_DEP(vstorec)(message_block, 15, addr1, r1, regs);
 
 #ifdef OPTION_KM_DEBUG
-    LOGBYTE("output:", message_block, 16);
+    LOGBYTE("output:", out, 16);
 #endif /* #ifdef OPTION_KM_DEBUG */
 
     /* Update the registers */
-    SET_GR_A(r1, regs, GR_A(r1, regs) + 16);
+    SET_GR_A(r1, regs, GR_A(r1, regs) + len);
     if(likely(r1_is_not_r2))
-      SET_GR_A(r2, regs, GR_A(r2, regs) + 16);
-    SET_GR_A(r2 + 1, regs, GR_A(r2 + 1, regs) - 16);
+      SET_GR_A(r2, regs, GR_A(r2, regs) + len);
+    SET_GR_A(r2 + 1, regs, GR_A(r2 + 1, regs) - len);
 
 #ifdef OPTION_KM_DEBUG
     WRMSG(HHC90108, "D", r1, (regs)->GR(r1));
@@ -2250,16 +2366,24 @@ static void ARCH_DEP(kmc_dea)(int r1, int r2, REGS *regs)
 /*----------------------------------------------------------------------------*/
 static void ARCH_DEP(kmc_aes)(int r1, int r2, REGS *regs)
 {
+  VADR addr1;
+  VADR addr2;
   rijndael_ctx context;
   int crypted;
   int i;
+  BYTE *in;
+  int j;
+  HSIMDAESC *kernel;
   int keylen;
+  int len;
   BYTE message_block[16];
   int modifier_bit;
   BYTE ocv[16];
+  BYTE *out;
   BYTE parameter_block[80];
   int parameter_blocklen;
   int r1_is_not_r2;
+  BYTE round_keys[16 * (AES_MAXROUNDS + 1)];
   int tfc;
   int wrap;
 
@@ -2315,53 +2439,82 @@ static void ARCH_DEP(kmc_aes)(int r1, int r2, REGS *regs)
   /* Try to process the CPU-determined amount of data */
   modifier_bit = GR0_m(regs);
   r1_is_not_r2 = r1 != r2;
-  for(crypted = 0; crypted < PROCESS_MAX; crypted += 16)
+  kernel = modifier_bit ? hsimd_aes_cbcd : hsimd_aes_cbce;
+  if(kernel)
+    aes_round_keys(round_keys, modifier_bit ? context.dk : context.ek, context.Nr);
+  for(crypted = 0; crypted < PROCESS_MAX; crypted += len)
   {
-    /* Fetch a block of data */
-    ARCH_DEP(vfetchc)(message_block, 15, GR_A(r2, regs) & ADDRESS_MAXWRAP(regs), r2, regs);
+    /* Process the blocks up to the nearest page end in main storage */
+    addr1 = GR_A(r1, regs) & ADDRESS_MAXWRAP(regs);
+    addr2 = GR_A(r2, regs) & ADDRESS_MAXWRAP(regs);
+    len = ARCH_DEP(crypt_span)(addr1, addr2, addr2, GR_A(r2 + 1, regs), PROCESS_MAX - crypted, 16);
+    if(likely(len))
+    {
+      in = MADDRL(addr2, len, r2, regs, ACCTYPE_READ, regs->psw.pkey);
+      out = MADDRL(addr1, len, r1, regs, ACCTYPE_WRITE, regs->psw.pkey);
+    }
+    else
+    {
+      /* Fetch a block of data which crosses a page boundary */
+      len = 16;
+      ARCH_DEP(vfetchc)(message_block, 15, addr2, r2, regs);
+      in = out = message_block;
+    }
 
 #ifdef OPTION_KMC_DEBUG
-    LOGBYTE("input :", message_block, 16);
+    LOGBYTE("input :", in, 16);
 #endif /* #ifdef OPTION_KMC_DEBUG */
 
-    /* Do the job */
-    if(modifier_bit)
-    {
-
-      /* Save, decrypt and XOR */
-      memcpy(ocv, message_block, 16);
-      rijndael_decrypt(&context, message_block, message_block);
-      for(i = 0; i < 16; i++)
-        message_block[i] ^= parameter_block[i];
-    }
+    /* Do the job, leaving the output chaining value in the parameter block */
+    if(kernel && !OVERLAPS(out, in, len))
+      kernel(round_keys, context.Nr, parameter_block, in, out, len / 16);
     else
     {
-      /* XOR, encrypt and save */
-      for(i = 0; i < 16; i++)
-        message_block[i] ^= parameter_block[i];
-      rijndael_encrypt(&context, message_block, message_block);
-      memcpy(ocv, message_block, 16);
+      for(j = 0; j < len; j += 16)
+      {
+        if(modifier_bit)
+        {
+
+          /* Save, decrypt and XOR */
+          memcpy(ocv, &in[j], 16);
+          rijndael_decrypt(&context, &in[j], &out[j]);
+          for(i = 0; i < 16; i++)
+            out[j + i] ^= parameter_block[i];
+        }
+        else
+        {
+          /* XOR, encrypt and save */
+          for(i = 0; i < 16; i++)
+            ocv[i] = in[j + i] ^ parameter_block[i];
+          rijndael_encrypt(&context, ocv, &out[j]);
+          memcpy(ocv, &out[j], 16);
+        }
+
+        /* Set cv for next 16 bytes */
+        memcpy(parameter_block, ocv, 16);
+      }
     }
 
-    /* Store the output */
-    ARCH_DEP(vstorec)(message_block, 15, GR_A(r1, regs) & ADDRESS_MAXWRAP(regs), r1, regs);
+    /* Store the output of a block which crosses a page boundary */
+    if(unlikely(out == message_block))
+      ARCH_DEP(vstorec)(message_block, 15, addr1, r1, regs);
 
 #ifdef OPTION_KMC_DEBUG
-    LOGBYTE("output:", message_block, 16);
+    LOGBYTE("output:", out, 16);
 #endif /* #ifdef OPTION_KMC_DEBUG */
 
     /* Store the output chaining value */
-    ARCH_DEP(vstorec)(ocv, 15, GR_A(1, regs) & ADDRESS_MAXWRAP(regs), 1, regs);
+    ARCH_DEP(vstorec)(parameter_block, 15, GR_A(1, regs) & ADDRESS_MAXWRAP(regs), 1, regs);
 
 #ifdef OPTION_KMC_DEBUG
-    LOGBYTE("ocv   :", ocv, 16);
+    LOGBYTE("ocv   :", parameter_block, 16);
 #endif /* #ifdef OPTION_KMC_DEBUG */
 
     /* Update the registers */
-    SET_GR_A(r1, regs, GR_A(r1, regs) + 16);
+    SET_GR_A(r1, regs, GR_A(r1, regs) + len);
     if(likely(r1_is_not_r2))
-      SET_GR_A(r2, regs, GR_A(r2, regs) + 16);
-    SET_GR_A(r2 + 1, regs, GR_A(r2 + 1, regs) - 16);
+      SET_GR_A(r2, regs, GR_A(r2, regs) + len);
+    SET_GR_A(r2 + 1, regs, GR_A(r2 + 1, regs) - len);
 
 #ifdef OPTION_KMC_DEBUG
     WRMSG(HHC90108, "D", r1, (regs)->GR(r1));
@@ -2376,8 +2529,6 @@ static void ARCH_DEP(kmc_aes)(int r1, int r2, REGS *regs)
       return;
     }
 
-    /* Set cv for next 16 bytes */
-    memcpy(parameter_block, ocv, 16);
   }
 
   /* CPU-determined amount of data processed */
@@ -2699,17 +2850,26 @@ static void ARCH_DEP(kmctr_dea)(int r1, int r2, int r3, REGS *regs)
 /*----------------------------------------------------------------------------*/
 static void ARCH_DEP(kmctr_aes)(int r1, int r2, int r3, REGS *regs)
 {
+  VADR addr1;
+  VADR addr2;
+  VADR addr3;
   rijndael_ctx context;
   BYTE countervalue_block[16];
   int crypted;
+  BYTE *ctr;
   int i;
+  BYTE *in;
+  int j;
   int keylen;
+  int len;
   BYTE message_block[16];
+  BYTE *out;
   BYTE parameter_block[64];
   int parameter_blocklen;
   int r1_is_not_r2;
   int r1_is_not_r3;
   int r2_is_not_r3;
+  BYTE round_keys[16 * (AES_MAXROUNDS + 1)];
   int fc;
   int tfc;
   int wrap;
@@ -2763,37 +2923,65 @@ static void ARCH_DEP(kmctr_aes)(int r1, int r2, int r3, REGS *regs)
   r1_is_not_r2 = r1 != r2;
   r1_is_not_r3 = r1 != r3;
   r2_is_not_r3 = r1 != r2;
-  for(crypted = 0; crypted < PROCESS_MAX; crypted += 16)
+  if(hsimd_aes_ctr)
+    aes_round_keys(round_keys, context.ek, context.Nr);
+  for(crypted = 0; crypted < PROCESS_MAX; crypted += len)
   {
-    /* Fetch a block of data and counter-value */
-    ARCH_DEP(vfetchc)(message_block, 15, GR_A(r2, regs) & ADDRESS_MAXWRAP(regs), r2, regs);
-    ARCH_DEP(vfetchc)(countervalue_block, 15, GR_A(r3, regs) & ADDRESS_MAXWRAP(regs), r3, regs);
+    /* Process the blocks up to the nearest page end in main storage */
+    addr1 = GR_A(r1, regs) & ADDRESS_MAXWRAP(regs);
+    addr2 = GR_A(r2, regs) & ADDRESS_MAXWRAP(regs);
+    addr3 = GR_A(r3, regs) & ADDRESS_MAXWRAP(regs);
+    len = ARCH_DEP(crypt_span)(addr1, addr2, addr3, GR_A(r2 + 1, regs), PROCESS_MAX - crypted, 16);
+    if(likely(len))
+    {
+      in = MADDRL(addr2, len, r2, regs, ACCTYPE_READ, regs->psw.pkey);
+      ctr = MADDRL(addr3, len, r3, regs, ACCTYPE_READ, regs->psw.pkey);
+      out = MADDRL(addr1, len, r1, regs, ACCTYPE_WRITE, regs->psw.pkey);
+    }
+    else
+    {
+      /* Fetch a block of data and counter-value which cross a page boundary */
+      len = 16;
+      ARCH_DEP(vfetchc)(message_block, 15, addr2, r2, regs);
+      ARCH_DEP(vfetchc)(countervalue_block, 15, addr3, r3, regs);
+      in = out = message_block;
+      ctr = countervalue_block;
+    }
 
 #ifdef OPTION_KMCTR_DEBUG
-    LOGBYTE("input :", message_block, 16);
-    LOGBYTE("cv    :", countervalue_block, 16);
+    LOGBYTE("input :", in, 16);
+    LOGBYTE("cv    :", ctr, 16);
 #endif /* #ifdef OPTION_KMCTR_DEBUG */
 
     /* Do the job */
-    /* Encrypt and XOR */
-    rijndael_encrypt(&context, countervalue_block, countervalue_block);
-    for(i = 0; i < 16; i++)
-      countervalue_block[i] ^= message_block[i];
+    if(hsimd_aes_ctr && !OVERLAPS(out, in, len) && !OVERLAPS(out, ctr, len))
+      hsimd_aes_ctr(round_keys, context.Nr, ctr, in, out, len / 16);
+    else
+    {
+      for(j = 0; j < len; j += 16)
+      {
+        /* Encrypt and XOR */
+        rijndael_encrypt(&context, &ctr[j], countervalue_block);
+        for(i = 0; i < 16; i++)
+          out[j + i] = in[j + i] ^ countervalue_block[i];
+      }
+    }
 
-    /* Store the output */
-    ARCH_DEP(vstorec)(countervalue_block, 15, GR_A(r1, regs) & ADDRESS_MAXWRAP(regs), r1, regs);
+    /* Store the output of a block which crosses a page boundary */
+    if(unlikely(out == message_block))
+      ARCH_DEP(vstorec)(message_block, 15, addr1, r1, regs);
 
 #ifdef OPTION_KMCTR_DEBUG
-    LOGBYTE("output:", countervalue_block, 16);
+    LOGBYTE("output:", out, 16);
 #endif /* #ifdef OPTION_KMCTR_DEBUG */
 
     /* Update the registers */
-    SET_GR_A(r1, regs, GR_A(r1, regs) + 16);
+    SET_GR_A(r1, regs, GR_A(r1, regs) + len);
     if(likely(r1_is_not_r2))
-      SET_GR_A(r2, regs, GR_A(r2, regs) + 16);
-    SET_GR_A(r2 + 1, regs, GR_A(r2 + 1, regs) - 16);
+      SET_GR_A(r2, regs, GR_A(r2, regs) + len);
+    SET_GR_A(r2 + 1, regs, GR_A(r2 + 1, regs) - len);
     if(likely(r1_is_not_r3 && r2_is_not_r3))
-      SET_GR_A(r3, regs, GR_A(r3, regs) + 16);
+      SET_GR_A(r3, regs, GR_A(r3, regs) + len);
 
 #ifdef OPTION_KMCTR_DEBUG
     WRMSG(HHC90108, "D", r1, (regs)->GR(r1));
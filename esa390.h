@@ -72,6 +72,34 @@
 
 #endif
 
+/*-------------------------------------------------------------------*/
+/* z/Architecture vector register contents. The 128 bits are held   */
+/* as a host-endian 128-bit integer, so that the elements of every  */
+/* size are host-endian integers lying in host SIMD lane order. The */
+/* VR_x macros select element i numbered from the left, as in the   */
+/* Principles of Operation.                                          */
+/*-------------------------------------------------------------------*/
+
+typedef union {
+                 QW   Q;
+                 U64  D[2];
+                 U32  F[4];
+                 U16  H[8];
+                 BYTE B[16];
+               } VR;
+
+#if defined( WORDS_BIGENDIAN )
+ #define VR_B( _vr, _i )    (_vr).B[ (_i) ]
+ #define VR_H( _vr, _i )    (_vr).H[ (_i) ]
+ #define VR_F( _vr, _i )    (_vr).F[ (_i) ]
+ #define VR_D( _vr, _i )    (_vr).D[ (_i) ]
+#else
+ #define VR_B( _vr, _i )    (_vr).B[ 15 - (_i) ]
+ #define VR_H( _vr, _i )    (_vr).H[  7 - (_i) ]
+ #define VR_F( _vr, _i )    (_vr).F[  3 - (_i) ]
+ #define VR_D( _vr, _i )    (_vr).D[  1 - (_i) ]
+#endif
+
 /*-------------------------------------------------------------------*/
 
 typedef union {
@@ -216,10 +244,36 @@ typedef struct PSW  PSW;
 /*      main, storkey, skey, read and write,                         */
 /*      and are used for accelerated address lookup (formerly AEA).  */
 /*                                                                   */
+/*  The TLB is TLB_WAYS-way set associative with TLB_SETS sets. Set  */
+/*  'n' is selected by TLBIX() and its ways are entries n, n +       */
+/*  TLB_SETS, n + 2*TLB_SETS etc, so a 1-way TLB is direct mapped.   */
+/*  The ways of a set are kept in most recently used order: entries  */
+/*  are always created in way 0 (n), and an entry found in another   */
+/*  way is moved to way 0, so the inline maddr_l lookup only checks  */
+/*  way 0, and the least recently used entry is the one replaced.    */
+/*  TLB_SETS and TLB_WAYS may be overridden at build time (e.g. with */
+/*  CPPFLAGS="-DTLB_SETS=4096 -DTLB_WAYS=4"). TLB_SETS must be a     */
+/*  power of 2 no smaller than 1024 since the tag kept in each       */
+/*  'vaddr' entry (TLBID_PAGEMASK) omits the page index bits of a    */
+/*  1024 set TLB.                                                    */
+/*                                                                   */
 /*-------------------------------------------------------------------*/
 
-#define TLBN            1024            /* Number TLB entries        */
-#define TLB_MASK        0x3FF           /* Mask for 1024 entries     */
+#if !defined( TLB_SETS )
+  #define TLB_SETS      1024            /* Number of TLB sets        */
+#endif
+#if !defined( TLB_WAYS )
+  #define TLB_WAYS      2               /* Entries per TLB set       */
+#endif
+#if TLB_SETS < 1024 || (TLB_SETS & (TLB_SETS - 1))
+  #error TLB_SETS must be a power of 2 no smaller than 1024
+#endif
+#if TLB_WAYS < 1 || TLB_WAYS > 8
+  #error TLB_WAYS must be from 1 to 8
+#endif
+
+#define TLBN            (TLB_SETS * TLB_WAYS)   /* Number TLB entries*/
+#define TLB_MASK        (TLB_SETS - 1)  /* Mask for TLB set index    */
 #define TLB_REAL_ASD_L  0xFFFFFFFF      /* ASD values for real mode  */
 #define TLB_REAL_ASD_G  0xFFFFFFFFFFFFFFFFULL
 #define TLB_HOST_ASD    0x800           /* Host entry for XC guest   */
@@ -249,6 +303,104 @@ struct  TLB {
 };
 typedef struct TLB  TLB;
 
+/*-------------------------------------------------------------------*/
+/*   TLB reverse map: page frame to TLB sets                         */
+/*-------------------------------------------------------------------*/
+/*                                                                   */
+/*  Lets purge_tlbe (IPTE etc) find the TLB entries for a page frame */
+/*  without scanning the whole TLB. The frame (the 'pte' field of a  */
+/*  TLB entry) is hashed to a bucket listing the sets which have had */
+/*  an entry for a frame with that hash created in them. A bucket is */
+/*  only valid while its 'id' equals the TLB's current tlbID, so     */
+/*  purging the whole TLB also empties the map. The listed sets are  */
+/*  only candidates whose entries must still be checked: a set stays */
+/*  listed after its entry is replaced until the bucket fills up and */
+/*  is compacted. A bucket which still overflows is marked as such   */
+/*  and a purge of any frame hashing to it scans the whole TLB.      */
+/*                                                                   */
+/*-------------------------------------------------------------------*/
+
+#define TLB_RMAP_BUCKETS    1024        /* Number of buckets (2**n)  */
+#define TLB_RMAP_SETS       6           /* Sets listed per bucket    */
+#define TLB_RMAP_OVERFLOW   0xFFFF      /* 'n' value if overflowed   */
+
+#define TLB_RMAP_HASH(_frame) \
+    ((U32)((((U64)(_frame)) * 0x9E3779B97F4A7C15ULL) >> 40) & (TLB_RMAP_BUCKETS - 1))
+
+struct  TLBRMAP {
+    U32                 id;             /* tlbID when bucket was used*/
+    U16                 n;              /* Number of sets listed     */
+    U16                 set[ TLB_RMAP_SETS ];   /* TLB set numbers   */
+};
+typedef struct TLBRMAP  TLBRMAP;
+
+/*-------------------------------------------------------------------*/
+/*   Large frame TLB                                                 */
+/*-------------------------------------------------------------------*/
+/*                                                                   */
+/*  Caches the segment table translation of EDAT-1 1M frames (STE    */
+/*  format control bit on) so that a TLB miss for any other 4K page  */
+/*  of the same frame can create its TLB entry without fetching the  */
+/*  region and segment table entries again. Direct mapped by segment */
+/*  index. An entry is only valid while its 'id' equals the current  */
+/*  tlbID, so purging the whole TLB purges it too. purge_tlbe (IPTE  */
+/*  and IESBE) purges any entry whose frame includes the page frame. */
+/*                                                                   */
+/*-------------------------------------------------------------------*/
+
+#define TLB_LARGE_N         256         /* Number of entries (2**n)  */
+#define TLB_LARGE_SHIFT     20          /* Segment index shift       */
+
+#define TLB_LARGE_IX(_vaddr) \
+    ((U32)((_vaddr) >> TLB_LARGE_SHIFT) & (TLB_LARGE_N - 1))
+
+struct  TLBLARGE {
+    U64                 asd;            /* Address space designator  */
+    U64                 vaddr;          /* Virtual segment address   */
+    U64                 frame;          /* Segment frame real address*/
+    U32                 id;             /* tlbID when entry was made */
+    BYTE                common;         /* 1=Common segment          */
+    BYTE                protect;        /* 1=Protected segment       */
+};
+typedef struct TLBLARGE  TLBLARGE;
+
+/*-------------------------------------------------------------------*/
+/*   TLB shootdown request flags (see tlb_shootdown in dat.c)        */
+/*-------------------------------------------------------------------*/
+
+#define TLB_SHOOT_TLB       0x01        /* Purge the whole TLB       */
+#define TLB_SHOOT_TLBE      0x02        /* Purge a page frame's TLBEs*/
+#define TLB_SHOOT_ALB       0x04        /* Purge the ART lookaside   */
+
+/*-------------------------------------------------------------------*/
+/*   SIE guest TLB context                                           */
+/*-------------------------------------------------------------------*/
+/*                                                                   */
+/*  Each host CPU's guest REGS remembers which tlbID it last used    */
+/*  for each of the TLB_CONTEXTS state descriptors it most recently  */
+/*  dispatched. Entries with any tlbID from tlbIDlo up to tlbIDmax   */
+/*  are kept up to date by the purge and invalidate functions, so    */
+/*  when a state descriptor is dispatched again, on the same host    */
+/*  CPU and for the same guest storage, the TLB entries it left are  */
+/*  reused by simply switching back to its tlbID. Purging the whole  */
+/*  TLB (raising tlbIDlo) discards all of the contexts.              */
+/*                                                                   */
+/*-------------------------------------------------------------------*/
+
+#define TLB_CONTEXTS        4           /* Contexts per host CPU     */
+
+struct  TLBCTX {
+    RADR                sd;             /* State descriptor address  */
+    RADR                mso;            /* Guest main storage origin */
+    RADR                mainlim;        /* Guest main storage limit  */
+    RADR                px;             /* Guest prefix              */
+    U64                 lastuse;        /* Dispatch number last used */
+    U32                 tlbID;          /* Guest tlbID               */
+    BYTE                arch_mode;      /* Guest architecture mode   */
+    BYTE                pref;           /* Preferred storage mode    */
+};
+typedef struct TLBCTX  TLBCTX;
+
 /*-------------------------------------------------------------------*/
 /*   Structure definition for DAT (Dynamic Address Translation)      */
 /*-------------------------------------------------------------------*/
@@ -319,7 +471,7 @@ typedef struct DAT  DAT;
 #define CR0_SEG_SZ_1M           0x00100000      /* ...1M segments             */
 #define CR0_ASN_LX_REUS         0x00080000      /* ASN-and-LX-reuse control   */
 #define CR0_AFP                 0x00040000      /* AFP register control       */
-#define CR0_VOP                 0x00020000      /* Vector control         390 */
+#define CR0_VOP                 0x00020000      /* Vector control     390/900 */
 #define CR0_ASF                 0x00010000      /* AS function control    390 */
 #define CR0_XM_MALFALT          0x00008000      /* Malfunction alert mask     */
 #define CR0_XM_EMERSIG          0x00004000      /* Emergency signal mask      */
@@ -2719,6 +2871,13 @@ typedef struct PTFFQSI PTFFQSI;
 #define DXC_VECTOR_INSTRUCTION  0xFE    /* Vector instruction        */
 #define DXC_COMPARE_AND_TRAP    0xFF    /* Compare-and-trap exception*/
 
+/* Vector exception codes (bits 0-3 are the element index)         */
+#define VXC_IEEE_INVALID_OP     0x01    /* IEEE invalid operation    */
+#define VXC_IEEE_DIV_ZERO       0x02    /* IEEE division by zero     */
+#define VXC_IEEE_OVERFLOW       0x03    /* IEEE overflow             */
+#define VXC_IEEE_UNDERFLOW      0x04    /* IEEE underflow            */
+#define VXC_IEEE_INEXACT        0x05    /* IEEE inexact              */
+
 /*       (*) "IISE" = "IEEE-interruption-simulation event"           */
 
 /*-------------------------------------------------------------------*/
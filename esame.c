@@ -1028,8 +1028,6 @@ bool    local = false;                  /* true == m4 bit 3 is on    */
     {
         if (!local) OBTAIN_INTLOCK( regs );
         {
-            if (!local) SYNCHRONIZE_CPUS( regs );
-
 #if defined( _FEATURE_SIE )
             if (SIE_MODE( regs ) && regs->sie_scao)
             {
@@ -1569,7 +1567,7 @@ ALIGN_16 U64 old[2] = { 0, 0 } ;        /* ALIGNED Quadword workarea */
     /* Store R1 and R1+1 registers to second operand
        Provide storage consistancy by means of obtaining
        the main storage access lock */
-    OBTAIN_MAINLOCK( regs );
+    OBTAIN_MAINLOCK( regs, main2 );
     {
         // The cmpxchg16 either swaps the desired values immediately,
         // if not then certainly on the second iteration.
@@ -1609,7 +1607,7 @@ ALIGN_16 U64 old[2] = { 0, 0 } ;        /* ALIGNED Quadword workarea */
     /* Load R1 and R1+1 registers contents from second operand
        Provide storage consistancy by means of obtaining
        the main storage access lock */
-    OBTAIN_MAINLOCK( regs );
+    OBTAIN_MAINLOCK( regs, main2 );
     {
         // We use the 2nd cmpxchg16 trick, which will write a zero only if the
         // main2 quadword is already zero, effectively a NO-OP.  As we have
@@ -2499,7 +2497,7 @@ U64     new;                            /* new value                 */
         new = CSWAP64(regs->GR_G(r3+0));
 
         /* MAINLOCK may be required if cmpxchg assists unavailable */
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK( regs, main2 );
         {
             /* Attempt to exchange the values */
             regs->psw.cc = cmpxchg8( &old, new, main2 );
@@ -2561,7 +2559,7 @@ U64     newhi, newlo;                   /* new value                 */
         newlo  = CSWAP64( regs->GR_G( r3+1 ));
 
         /* MAINLOCK may be required if cmpxchg assists unavailable */
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK( regs, main2 );
         {
             /* Attempt to exchange the values */
             regs->psw.cc = cmpxchg16( &old[0], &old[1], newhi, newlo, main2 );
@@ -7331,7 +7329,7 @@ BYTE   *dest;                           /* Pointer to target byte    */
     dest = MADDR (effective_addr1, b1, regs, ACCTYPE_WRITE, regs->psw.pkey );
 
     /* MAINLOCK may be required if cmpxchg assists unavailable */
-    OBTAIN_MAINLOCK( regs );
+    OBTAIN_MAINLOCK( regs, dest );
     {
         /* AND byte with immediate operand, setting condition code */
         regs->psw.cc = (H_ATOMIC_OP( dest, i2, and, And, & ) != 0);
@@ -7544,7 +7542,7 @@ U32     old;                            /* old value                 */
         old = CSWAP32(regs->GR_L(r1));
 
         /* MAINLOCK may be required if cmpxchg assists unavailable */
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK( regs, main2 );
         {
             /* Attempt to exchange the values */
             regs->psw.cc = cmpxchg4( &old, CSWAP32( regs->GR_L( r3 )), main2 );
@@ -7604,7 +7602,7 @@ U64     old, new;                       /* old, new values           */
         new = CSWAP64(((U64)(regs->GR_L(r3)) << 32) | regs->GR_L(r3+1));
 
         /* MAINLOCK may be required if cmpxchg assists unavailable */
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK( regs, main2 );
         {
             /* Attempt to exchange the values */
             regs->psw.cc = cmpxchg8( &old, new, main2 );
@@ -7734,7 +7732,7 @@ BYTE   *dest;                           /* Pointer to target byte    */
     dest = MADDR (effective_addr1, b1, regs, ACCTYPE_WRITE, regs->psw.pkey );
 
     /* MAINLOCK may be required if cmpxchg assists unavailable */
-    OBTAIN_MAINLOCK( regs );
+    OBTAIN_MAINLOCK( regs, dest );
     {
         /* XOR byte with immediate operand, setting condition code */
         regs->psw.cc = (H_ATOMIC_OP( dest, i2, xor, Xor, ^ ) != 0);
@@ -8135,7 +8133,7 @@ BYTE   *dest;                           /* Pointer to target byte    */
     dest = MADDR (effective_addr1, b1, regs, ACCTYPE_WRITE, regs->psw.pkey );
 
     /* MAINLOCK may be required if cmpxchg assists unavailable */
-    OBTAIN_MAINLOCK( regs );
+    OBTAIN_MAINLOCK( regs, dest );
     {
         /* OR byte with immediate operand, setting condition code */
         regs->psw.cc = (H_ATOMIC_OP( dest, i2, or, Or, | ) != 0);
@@ -554,7 +554,7 @@ FT( NONE, NONE, NONE, 127_UNDEFINED )
 FT( NONE, NONE, NONE, 128_IBM_INTERNAL )
 
 #if defined(  FEATURE_129_ZVECTOR_FACILITY )
-FT( NONE, NONE, NONE, 129_ZVECTOR )
+FT( Z900, Z900, NONE, 129_ZVECTOR )
 #endif
 
 #if defined(  FEATURE_130_INSTR_EXEC_PROT_FACILITY )
@@ -576,7 +576,7 @@ FT( NONE, NONE, NONE, 133_GUARDED_STORAGE )
 #endif
 
 #if defined(  FEATURE_134_ZVECTOR_PACK_DEC_FACILITY )
-FT( NONE, NONE, NONE, 134_ZVECTOR_PACK_DEC )
+FT( Z900, Z900, NONE, 134_ZVECTOR_PACK_DEC )
 #endif
 
 #if defined(  FEATURE_135_ZVECTOR_ENH_FACILITY_1 )
@@ -626,11 +626,11 @@ FT( NONE, NONE, NONE, 149_MOVEPAGE_SETKEY )
 #endif
 
 #if defined(  FEATURE_150_ENH_SORT_FACILITY )
-FT( NONE, NONE, NONE, 150_ENH_SORT )
+FT( Z900, Z900, NONE, 150_ENH_SORT )
 #endif
 
 #if defined(  FEATURE_151_DEFLATE_CONV_FACILITY )
-FT( NONE, NONE, NONE, 151_DEFLATE_CONV )
+FT( Z900, Z900, NONE, 151_DEFLATE_CONV )
 #endif
 
 #if defined(  FEATURE_152_VECT_PACKDEC_ENH_FACILITY )
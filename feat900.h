@@ -114,12 +114,12 @@
 //efine FEATURE_078_ENHANCED_DAT_FACILITY_2
 #define FEATURE_080_DFP_PACK_CONV_FACILITY
 #define FEATURE_081_PPA_IN_ORDER_FACILITY
-//efine FEATURE_129_ZVECTOR_FACILITY
+#define FEATURE_129_ZVECTOR_FACILITY
 //efine FEATURE_130_INSTR_EXEC_PROT_FACILITY
 //efine FEATURE_131_SIDE_EFFECT_ACCESS_FACILITY
 //efine FEATURE_131_ENH_SUPP_ON_PROT_2_FACILITY
 //efine FEATURE_133_GUARDED_STORAGE_FACILITY
-//efine FEATURE_134_ZVECTOR_PACK_DEC_FACILITY
+#define FEATURE_134_ZVECTOR_PACK_DEC_FACILITY
 //efine FEATURE_135_ZVECTOR_ENH_FACILITY_1
 //efine FEATURE_138_CONFIG_ZARCH_MODE_FACILITY
 //efine FEATURE_139_MULTIPLE_EPOCH_FACILITY
@@ -129,8 +129,10 @@
 //efine FEATURE_146_MSA_EXTENSION_FACILITY_8
 //efine FEATURE_148_VECTOR_ENH_FACILITY_2
 //efine FEATURE_149_MOVEPAGE_SETKEY_FACILITY
-//efine FEATURE_150_ENH_SORT_FACILITY
-//efine FEATURE_151_DEFLATE_CONV_FACILITY
+#define FEATURE_150_ENH_SORT_FACILITY
+#if defined( HAVE_ZLIB )
+#define FEATURE_151_DEFLATE_CONV_FACILITY
+#endif
 //efine FEATURE_152_VECT_PACKDEC_ENH_FACILITY
 //efine FEATURE_155_MSA_EXTENSION_FACILITY_9
 //efine FEATURE_158_ULTRAV_CALL_FACILITY
@@ -48,6 +48,8 @@
 #define OPTION_MVS_TELNET_WORKAROUND    // Handle non-std MVS telnet
 #define OPTION_SIE_PURGE_DAT_ALWAYS     // Ivan 2016-07-30: purge DAT
                                         // ALWAYS at start SIE mode
+#define OPTION_SIE_TLB_CONTEXTS         // Retain guest TLB contexts
+                                        // (overrides the above)
 #define OPTION_NOASYNC_SF_CMDS          // Bypass bug in cache logic
                                         // (see GitHub Issue #618!)
 
@@ -90,6 +92,7 @@
 #define OPTION_OPTINST                  /* Optimized instructions    */
 #endif
 #define OPTION_NO_E3_OPTINST            /* Problematic!              */
+//efine OPTION_COMPACT_OPCODE_DISPATCH  /* Two-level opcode dispatch */
 
 #if defined( HAVE_FULL_KEEPALIVE )
   #if !defined( HAVE_PARTIAL_KEEPALIVE ) || !defined( HAVE_BASIC_KEEPALIVE )
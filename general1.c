@@ -278,7 +278,7 @@ BYTE   *dest;                           /* Pointer to target byte    */
     dest = MADDR (effective_addr1, b1, regs, ACCTYPE_WRITE, regs->psw.pkey );
 
     /* MAINLOCK may be required if cmpxchg assists unavailable */
-    OBTAIN_MAINLOCK( regs );
+    OBTAIN_MAINLOCK( regs, dest );
     {
         /* AND byte with immediate operand, setting condition code */
         regs->psw.cc = (H_ATOMIC_OP( dest, i2, and, And, & ) != 0);
@@ -2043,6 +2043,17 @@ BYTE    *main2;                         /* Operand-2 mainstor addr   */
         i = cpu_length / 4;
         cpu_length = i * 4;
 
+        /* A host SIMD kernel sums the fullwords without carrying each
+           overflow into bit 31 as it goes. Folding the overflows in
+           afterwards gives the same result, since neither way yields
+           zero unless every fullword (and the initial value) is zero */
+        if (hsimd_cksm)
+        {
+            dreg += hsimd_cksm( main2, i );
+            while (dreg > 0xFFFFFFFFULL)
+                dreg = (dreg & 0xFFFFFFFFULL) + (dreg >> 32);
+        }
+        else
         for (j=0; j < i; j++)
         {
             /* Fetch fullword from second operand */
@@ -2341,7 +2352,7 @@ U32     new;                            /* new value                 */
         new = CSWAP32(regs->GR_L(r3));
 
         /* MAINLOCK may be required if cmpxchg assists unavailable */
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK( regs, main2 );
         {
             /* Attempt to exchange the values */
             regs->psw.cc = cmpxchg4( &old, new, main2 );
@@ -2409,7 +2420,7 @@ U64     old, new;                       /* old, new values           */
         new = CSWAP64(((U64)(regs->GR_L(r3)) << 32) | regs->GR_L(r3+1));
 
         /* MAINLOCK may be required if cmpxchg assists unavailable */
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK( regs, main2 );
         {
             /* Attempt to exchange the values */
             regs->psw.cc = cmpxchg8( &old, new, main2 );
@@ -2461,6 +2472,7 @@ VADR    effective_addr1;                /* Effective address         */
 VADR    effective_addr2;                /* Effective address         */
 VADR    addrp;                          /* Parameter list address    */
 BYTE   *main1;                          /* Mainstor address of op1   */
+BYTE   *main2;                          /* Mainstor address of op2   */
 int     ln2;                            /* Second operand length - 1 */
 #if defined( FEATURE_033_CSS_FACILITY_2 )
 ALIGN_16 U64 old[2] = { 0, 0 };         /* old values for cmpxchg16  */
@@ -2560,11 +2572,12 @@ BYTE    sc;                             /* Store characteristic      */
         /* Obtain main storage address of first operand */
         main1 = MADDRL (effective_addr1, 4, b1, regs, ACCTYPE_WRITE, regs->psw.pkey);
 
-        /* Ensure second operand storage is writable */
-        ARCH_DEP(validate_operand) (effective_addr2, b2, ln2, ACCTYPE_WRITE_SKP, regs);
+        /* Ensure second operand storage is writable. Being aligned
+           on its own length it lies within one page and one line */
+        main2 = MADDRL (effective_addr2, ln2+1, b2, regs, ACCTYPE_WRITE_SKP, regs->psw.pkey);
 
         /* MAINLOCK may be required if cmpxchg assists unavailable */
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK2( regs, main1, main2 );
         {
             /* Load the compare value from the r3 register and also */
             /* load replacement value from bytes 0-3, 0-7 or 0-15 of parameter list */
@@ -2877,6 +2890,8 @@ BYTE    rbyte[4],                       /* Register bytes            */
 static INLINE U32 memneq( const BYTE* m1, const BYTE* m2, U32 len )
 {
     U32  i;
+    if (len >= HSIMD_SCAN_MIN && hsimd_memneq)
+        return (U32) hsimd_memneq( m1, m2, len );
     for (i=0; i < len; i++)
         if (m1[i] != m2[i])
             break;
@@ -3940,6 +3955,7 @@ int ARCH_DEP( mem_cmp_first_equ )
     BYTE   *m1,   *m2;          // operand mainstor addresses
     BYTE   *m1pg, *m2pg;        // operand page
     U32    i;                   // loop index
+    U32    n, k;                // host SIMD scan length, result
 
     /* fast exit */
     if (len == 0) return MEM_CMP_NPOS;
@@ -3953,6 +3969,22 @@ int ARCH_DEP( mem_cmp_first_equ )
 
     for (i = 0; i < len ; i++)
     {
+        /* Let a host SIMD kernel scan what is left of both pages,
+           leaving the last byte to move on to the next page */
+        if (hsimd_memeq)
+        {
+            n = MIN( m1pg + PAGEFRAME_PAGESIZE - m1, m2pg + PAGEFRAME_PAGESIZE - m2 );
+            n = MIN( n, len - i );
+            if (n >= HSIMD_SCAN_MIN)
+            {
+                if ((k = (U32) hsimd_memeq( m1, m2, n )) < n)
+                    return i + k;
+                i  += n-1;
+                m1 += n-1;
+                m2 += n-1;
+            }
+        }
+
         /* compare bytes */
         if (*m1 == *m2)
             return i;
@@ -4155,6 +4187,7 @@ int ARCH_DEP( mem_cmp_last_neq )
     BYTE   *m1,   *m2;          // operand mainstor addresses
     BYTE   *m1pg, *m2pg;        // operand page
     int    i;                   // loop index
+    int    n, k;                // host SIMD scan length, result
 
     /* fast exit */
     if (len <= 0) return MEM_CMP_NPOS;
@@ -4168,6 +4201,22 @@ int ARCH_DEP( mem_cmp_last_neq )
 
     for (i = (len-1); i >= 0 ; i--)
     {
+        /* Let a host SIMD kernel scan back to the start of both pages,
+           leaving the first byte to move on to the previous page */
+        if (hsimd_memneqr)
+        {
+            n = (int) MIN( m1 - m1pg, m2 - m2pg ) + 1;
+            n = MIN( n, i+1 );
+            if (n >= HSIMD_SCAN_MIN)
+            {
+                if ((k = (int) hsimd_memneqr( m1 - (n-1), m2 - (n-1), n )) < n)
+                    return i - k;
+                i  -= n-1;
+                m1 -= n-1;
+                m2 -= n-1;
+            }
+        }
+
         /* compare bytes */
         if (*m1 != *m2)
             return i;
@@ -5531,7 +5580,7 @@ BYTE   *dest;                           /* Pointer to target byte    */
     dest = MADDR (effective_addr1, b1, regs, ACCTYPE_WRITE, regs->psw.pkey );
 
     /* MAINLOCK may be required if cmpxchg assists unavailable */
-    OBTAIN_MAINLOCK( regs );
+    OBTAIN_MAINLOCK( regs, dest );
     {
         /* XOR byte with immediate operand, setting condition code */
         regs->psw.cc = (H_ATOMIC_OP( dest, i2, xor, Xor, ^ ) != 0);
@@ -5777,7 +5826,7 @@ BYTE   *ip;                             /* -> executed instruction   */
     regs->exrl = 0;
     regs->ip -= ILC(regs->exinst[0]);
 
-    EXECUTE_INSTRUCTION(regs->ARCH_DEP(runtime_opcode_xxxx), regs->exinst, regs);
+    EXECUTE_INSTRUCTION( RUNTIME_OPCODE_TABLE( regs ), regs->exinst, regs );
     regs->instcount++;
     UPDATE_SYSBLK_INSTCOUNT( 1 );
 
@@ -5881,7 +5930,7 @@ DEF_INST(execute_relative_long)
     regs->exrl     = 1;
     regs->ip      -= ILC( regs->exinst[0] );
 
-    EXECUTE_INSTRUCTION( regs->ARCH_DEP( runtime_opcode_xxxx ), regs->exinst, regs );
+    EXECUTE_INSTRUCTION( RUNTIME_OPCODE_TABLE( regs ), regs->exinst, regs );
     regs->instcount++;
     UPDATE_SYSBLK_INSTCOUNT( 1 );
 
@@ -7188,6 +7237,31 @@ BYTE    termchar;                       /* Terminating character     */
     main1 = MADDRL( addr1, cpu_length, r1, regs, ACCTYPE_WRITE, regs->psw.pkey );
     main2 = MADDRL( addr2, cpu_length, r2, regs, ACCTYPE_READ,  regs->psw.pkey );
 
+    /* Unless the operands overlap, let a host SIMD kernel find the
+       terminating character and then move everything up to it */
+    if (1
+        && hsimd_memchr
+        && cpu_length >= HSIMD_SCAN_MIN
+        && (main1 + cpu_length <= main2 || main2 + cpu_length <= main1)
+    )
+    {
+        i = (int) hsimd_memchr( main2, termchar, cpu_length );
+        if (i < cpu_length)
+        {
+            memcpy( main1, main2, i + 1 );
+            regs->psw.cc = 1;
+            SET_GR_A( r1, regs, (addr1 + i) & ADDRESS_MAXWRAP( regs ));
+            return;
+        }
+        memcpy( main1, main2, cpu_length );
+
+        addr1 += cpu_length;
+        addr1 &= ADDRESS_MAXWRAP( regs );
+
+        addr2 += cpu_length;
+        addr2 &= ADDRESS_MAXWRAP( regs );
+    }
+    else
     for (i=0; i < cpu_length; i++)
     {
         /* Move a single byte */
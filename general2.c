@@ -108,7 +108,7 @@ BYTE   *dest;                           /* Pointer to target byte    */
     dest = MADDR (effective_addr1, b1, regs, ACCTYPE_WRITE, regs->psw.pkey );
 
     /* MAINLOCK may be required if cmpxchg assists unavailable */
-    OBTAIN_MAINLOCK( regs );
+    OBTAIN_MAINLOCK( regs, dest );
     {
         /* OR byte with immediate operand, setting condition code */
         regs->psw.cc = (H_ATOMIC_OP( dest, i2, or, Or, | ) != 0);
@@ -413,10 +413,10 @@ VADR    effective_addr2,
     {
         /* gpr1/ar1 indentify the program lock token, which is used
            to select a lock from the model dependent number of locks
-           in the configuration.  We simply use 1 lock which is the
-           main storage access lock which is also used by CS, CDS
-           and TS.                                               *JJ */
-        OBTAIN_MAINLOCK_UNCONDITIONAL( regs );
+           in the configuration.  We use the main storage interlock
+           table entry selected by the token, so PLOs using the same
+           token serialize while unrelated ones run in parallel. *JJ */
+        OBTAIN_MAINLOCK_UNCONDITIONAL( regs, regs->GR(1) & ADDRESS_MAXWRAP( regs ));
         {
             switch(regs->GR_L(0) & PLO_GPR0_FC)
             {
@@ -662,6 +662,30 @@ BYTE    termchar;                       /* Terminating character     */
     }
 
     main2 = MADDRL(addr2, cpu_length, r2, regs, ACCTYPE_READ, regs->psw.pkey );
+
+    /* Let a host SIMD kernel search up to the end of the page or the
+       end of the operand, whichever comes first (the operand cannot
+       wrap around within the page) */
+    if (hsimd_memchr && cpu_length >= HSIMD_SCAN_MIN)
+    {
+        dist = (addr1 > addr2 && addr1 - addr2 < (VADR) cpu_length)
+             ? (int) (addr1 - addr2) : cpu_length;
+
+        if ((i = (int) hsimd_memchr( main2, termchar, dist )) < dist)
+        {
+            SET_GR_A( r1, regs, addr2 + i );
+            regs->psw.cc = 1;
+            return;
+        }
+        if (dist < cpu_length)
+        {
+            regs->psw.cc = 2;
+            return;
+        }
+        addr2 += cpu_length;
+        addr2 &= ADDRESS_MAXWRAP( regs );
+    }
+    else
     for (i=0; i < cpu_length; i++)
     {
         /* If operand end address has been reached, return
@@ -1638,7 +1662,7 @@ BYTE    old;                            /* Old value                 */
         main2 = MADDR (effective_addr2, b2, regs, ACCTYPE_WRITE, regs->psw.pkey);
 
         /* MAINLOCK may be required if cmpxchg assists unavailable */
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK( regs, main2 );
         {
             /* Get old value */
             old = *main2;
@@ -1844,6 +1868,22 @@ BYTE   *dest, *dest2 = NULL, *tab, *tab2; /* Mainstor pointers       */
     if (NOCROSSPAGE( effective_addr2, 255 ))
     {
         tab = MADDRL(effective_addr2, 256, b2, regs, ACCTYPE_READ, regs->psw.pkey );
+
+        /* Let a host SIMD kernel translate a long enough operand,
+           provided the table does not overlap it */
+        if (1
+            && hsimd_tr
+            && len + len2 + 2 >= HSIMD_SCAN_MIN
+            && (tab + 256 <= dest  || dest  + len  + 1 <= tab)
+            && (!dest2 || tab + 256 <= dest2 || dest2 + len2 + 1 <= tab)
+        )
+        {
+            hsimd_tr( dest, tab, len + 1 );
+            if (dest2)
+                hsimd_tr( dest2, tab, len2 + 1 );
+            return;
+        }
+
         /* Perform translate function */
         for (i=0; i <= len;  i++) dest [i] = tab[dest [i]];
         for (i=0; i <= len2; i++) dest2[i] = tab[dest2[i]];
@@ -1943,6 +1983,12 @@ bool    op1crosses, op2crosses;         /* Operand crosses Page Bdy  */
        }
        else /* BEST case: NEITHER operand crosses a page boundary */
        {
+            if (hsimd_trt && len + 1 >= HSIMD_SCAN_MIN)
+            {
+                i = (int) hsimd_trt( op1, op2, len + 1 );
+                sbyte = i <= len ? op2[ op1[i] ] : 0;
+            }
+            else
             for (i=0; i <= len; i++)
                 if ((sbyte = op2[ op1[i] ]))
                     break;
@@ -2058,6 +2104,16 @@ BYTE   *main1;                      /* Mainstor addresses            */
     /* Get operand 1 on page address */
     main1 = MADDRL( addr1, len, r1, regs, ACCTYPE_WRITE, regs->psw.pkey );
 
+    /* Let host SIMD kernels find the test byte and then translate
+       everything up to it */
+    if (hsimd_memchr && hsimd_tr && len >= HSIMD_SCAN_MIN)
+    {
+        translen = (int) hsimd_memchr( main1, tbyte, len );
+        hsimd_tr( main1, trtab, translen );
+        if (translen < (int) len)
+            cc = 1;
+    }
+    else
     /* translate on page data */
     for (i = 0; i < len; i++)
     {
@@ -3033,6 +3089,8 @@ DEF_INST( search_string_unicode )
     int r1, r2;                         /* Values of R fields        */
     U16 sbyte;                          /* String character          */
     U16 termchar;                       /* Terminating character     */
+    U32 n, k;                           /* Host SIMD scan length     */
+    BYTE* main2;                        /* Operand-2 mainstor addr   */
 
     RRE( inst, regs, r1, r2 );
     PER_ZEROADDR_CHECK2( regs, r1, r2 );
@@ -3081,6 +3139,31 @@ DEF_INST( search_string_unicode )
             return;
         }
 
+        /* Unless the next character straddles a page boundary, let a
+           host SIMD kernel search up to the end of the page or of the
+           operand, whichever comes first (both addresses are even or
+           both are odd, so the operand ends on a character boundary) */
+        if (hsimd_memchr2 && (addr2 & PAGEFRAME_BYTEMASK) != PAGEFRAME_BYTEMASK)
+        {
+            n = (PAGEFRAME_PAGESIZE - (addr2 & PAGEFRAME_BYTEMASK)) / 2;
+            n = MIN( n, (U32) (SRSTU_MAX - i) );
+            if (addr1 > addr2 && (addr1 - addr2) / 2 < n)
+                n = (U32) (addr1 - addr2) / 2;
+
+            main2 = MADDRL( addr2, n*2, r2, regs, ACCTYPE_READ, regs->psw.pkey );
+            if ((k = (U32) hsimd_memchr2( main2, termchar, n )) < n)
+            {
+                SET_GR_A( r1, regs, addr2 + k*2 );
+                regs->psw.cc = 1;
+                return;
+            }
+
+            addr2 += n*2;
+            addr2 &= ADDRESS_MAXWRAP( regs );
+            i += n-1;
+            continue;
+        }
+
         /* Fetch 2 bytes from the operand */
         sbyte = ARCH_DEP( vfetch2 )( addr2, r2, regs );
 
@@ -3127,6 +3210,7 @@ DEF_INST(translate_and_test_reverse)
     BYTE*   p_fct;                     // ptr to FC Table
     BYTE*   m1;                        // operand mainstor addresses
     BYTE   *m1pg;                      // operand page
+    int     n, k;                      // host SIMD scan length, result
 
     SS_L(inst, regs, len, b1, effective_addr1, b2, effective_addr2);
     PER_ZEROADDR_XCHECK2( regs, b1, b2 );
@@ -3151,6 +3235,22 @@ DEF_INST(translate_and_test_reverse)
     /* Process first operand from right to left*/
     for(i = 0; i <= len; i++)
     {
+        /* Let a host SIMD kernel scan back to the start of the page,
+           leaving the first byte to move on to the previous page */
+        if (hsimd_trtr)
+        {
+            n = MIN( len - i + 1, (int) (m1 - m1pg) + 1 );
+            if (n >= HSIMD_SCAN_MIN)
+            {
+                if ((k = (int) hsimd_trtr( m1 - (n-1), p_fct, n )) == n)
+                    k = n-1;
+                i  += k;
+                m1 -= k;
+                effective_addr1 -= k;
+                effective_addr1 &= ADDRESS_MAXWRAP(regs);
+            }
+        }
+
         /* Fetch argument byte from first operand */
         // dbyte = ARCH_DEP(vfetchb)(effective_addr1, b1, regs);
 
@@ -3262,6 +3362,11 @@ DEF_INST( translate_and_test_xxx_extended )
     VADR  fct_work_page_addr;   /* Work                              */
     VADR  fct_work_end_addr;    /* Work                              */
 
+    BYTE* fct_tab;              /* FC table for host SIMD kernel     */
+    CACHE_ALIGN                 /* FC table copy if it crosses page  */
+    BYTE  fct_copy[ 256 ];
+    int   n, k;                 /* Host SIMD scan length, result     */
+
     CACHE_ALIGN                 /* FC Table - direct mainstor addrs  */
     BYTE* fct_main_page_addr[ FCT_REAL_MAX_PAGES ];
 
@@ -3350,6 +3455,42 @@ DEF_INST( translate_and_test_xxx_extended )
 
     fc = 0;
     processed = 0;
+
+    /* With one byte arguments and function codes, let a host SIMD
+       kernel pass over the bytes whose function code is zero */
+    if (!a_bit && !f_bit && (isReverse ? hsimd_trtr : hsimd_trt))
+    {
+        n = (int) MIN( buf_len, (GREG) max_process );
+        if (n >= HSIMD_SCAN_MIN)
+        {
+            if ((fct_addr & PAGEFRAME_BYTEMASK) <= PAGEFRAME_PAGESIZE - 256)
+                fct_tab = fct_main_page_addr[0] + (fct_addr & PAGEFRAME_BYTEMASK);
+            else
+            {
+                k = PAGEFRAME_PAGESIZE - (fct_addr & PAGEFRAME_BYTEMASK);
+                memcpy( fct_copy,     fct_main_page_addr[0] + (fct_addr & PAGEFRAME_BYTEMASK), k );
+                memcpy( fct_copy + k, fct_main_page_addr[1], 256 - k );
+                fct_tab = fct_copy;
+            }
+
+            if (isReverse)
+            {
+                k = (int) hsimd_trtr( buf_main_addr - (n-1), fct_tab, n );
+                buf_main_addr -= k;
+                buf_addr      -= k;
+            }
+            else
+            {
+                k = (int) hsimd_trt( buf_main_addr, fct_tab, n );
+                buf_main_addr += k;
+                buf_addr      += k;
+            }
+            buf_addr  &= ADDRESS_MAXWRAP( regs );
+            processed += k;
+            buf_len   -= k;
+        }
+    }
+
     while (buf_len && !fc && processed < max_process)
     {
         if (a_bit)
@@ -89,7 +89,7 @@ int     rc;                             /* Return code               */
         new = CSWAP32(result);
 
         /* MAINLOCK may be required if cmpxchg assists unavailable */
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK( regs, m1 );
         {
             rc = cmpxchg4( &old, new, m1 );
         }
@@ -162,7 +162,7 @@ int     rc;                             /* Return code               */
         new = CSWAP64(result);
 
         /* MAINLOCK may be required if cmpxchg assists unavailable */
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK( regs, m1 );
         {
             rc = cmpxchg8( &old, new, m1 );
         }
@@ -2944,7 +2944,7 @@ BYTE    opcode;                         /* 2nd byte of opcode        */
         new = CSWAP32(result);
 
         /* MAINLOCK may be required if cmpxchg assists unavailable */
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK( regs, m2 );
         {
             rc = cmpxchg4( &old, new, m2 );
         }
@@ -3036,7 +3036,7 @@ BYTE    opcode;                         /* 2nd byte of opcode        */
         new = CSWAP64(result);
 
         /* MAINLOCK may be required if cmpxchg assists unavailable */
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK( regs, m2 );
         {
             rc = cmpxchg8( &old, new, m2 );
         }
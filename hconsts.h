@@ -34,6 +34,8 @@
                                            MAX_CPU_ENGS default      */
 
 #define MAX_CPU_LOOPS         256       /* UNROLLED_EXECUTE loops    */
+#define MIN_ADAPT_CPU_LOOPS    16       /* Adaptive interval minimum */
+#define MAX_ADAPT_CPU_LOOPS  8192       /* Adaptive interval maximum */
 
 /*-------------------------------------------------------------------*/
 /*               Some handy quantity definitions                     */
@@ -130,6 +132,26 @@
 #define MIN_ARCH_MAINSIZE_BYTES     0   // (slot 0 = minimum for arch)
 #define MAX_ARCH_MAINSIZE_BYTES     1   // (slot 1 = maximum for arch)
 
+#define MAINPAGES_DEFAULT           0   // (normal host pages)
+#define MAINPAGES_THP               1   // (transparent huge pages)
+#define MAINPAGES_HUGETLB           2   // (explicit hugetlb pages)
+
+#define MAINNODE_ANY              (-1)  // (host's default NUMA policy)
+#define MAINNODE_INTERLEAVE       (-2)  // (interleave across nodes)
+
+/* Consecutive expanded storage blocks moved by PGIN or PGOUT after
+   which file backed expanded storage is given a host paging hint    */
+#define XSTORE_SEQ_BLOCKS          64   // (256K of blocks)
+
+/* Size of the changed frame bitmap for 'size' bytes of main storage
+   (one bit per 4K frame, in whole U64s for fast scanning)           */
+#define DIRTYMAP_BYTES( size )  (((((U64)(size) >> SHIFT_4K) + 63) >> 6) << 3)
+
+/* Main storage interlock table: operands are serialized by one of
+   MAINLOCK_STRIPES locks chosen by their 2^MAINLOCK_SHIFT byte line */
+#define MAINLOCK_STRIPES        256     // (must be a power of 2)
+#define MAINLOCK_SHIFT          6       // (64-byte cache line)
+
 /*-------------------------------------------------------------------*/
 /* Miscellaneous system related constants we could be missing...     */
 /*-------------------------------------------------------------------*/
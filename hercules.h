@@ -77,6 +77,7 @@
 #include "version.h"
 #include "esa390.h"       /* ESA/390 structure definitions           */
 #include "hscutl.h"       /* utility functions                       */
+#include "hsimd.h"        /* host SIMD kernels                       */
 #include "w32util.h"      /* win32 porting functions                 */
 #include "clock.h"        /* TOD definitions                         */
 #include "qeth.h"         /* QETH device definitions                 */
@@ -66,7 +66,12 @@ int  configure_maxcpu (int maxcpu);
 int  configure_memlock(int);
 int  configure_memfree(int);
 int  configure_storage( U64 /* number of 4K pages */ );
+void clear_mainstor();
+U64  mainstor_resident();
+U64  get_dirty_frames( U64 abs, U64 len, BYTE* map, bool clear );
 int  configure_xstorage(U64);
+void clear_xpndstor();
+void xpndstor_advise( REGS* regs, U32 xaddr, bool pgout );
 U64  adjust_mainsize( int archnum, U64 mainsize );
 
 int  configure_shrdport(U16 shrdport);
@@ -512,6 +517,18 @@ bool s370_is_tlbe_match( REGS* regs, REGS* host_regs, U64 pfra, int i );
 bool s390_is_tlbe_match( REGS* regs, REGS* host_regs, U64 pfra, int i );
 bool z900_is_tlbe_match( REGS* regs, REGS* host_regs, U64 pfra, int i );
 
+void s370_tlb_rmap_add( REGS* regs, int ix );
+void s390_tlb_rmap_add( REGS* regs, int ix );
+void z900_tlb_rmap_add( REGS* regs, int ix );
+
+int  s370_tlb_rmap_find( REGS* regs, U64 pfra, U16* sets );
+int  s390_tlb_rmap_find( REGS* regs, U64 pfra, U16* sets );
+int  z900_tlb_rmap_find( REGS* regs, U64 pfra, U16* sets );
+
+void s370_sie_tlb_context( REGS* regs, RADR sd, bool same_cpu );
+void s390_sie_tlb_context( REGS* regs, RADR sd, bool same_cpu );
+void z900_sie_tlb_context( REGS* regs, RADR sd, bool same_cpu );
+
 void s370_do_purge_tlbe( REGS* regs, REGS* host_regs, U64 pfra );
 void s390_do_purge_tlbe( REGS* regs, REGS* host_regs, U64 pfra );
 void z900_do_purge_tlbe( REGS* regs, REGS* host_regs, U64 pfra );
@@ -529,6 +546,8 @@ void s390_invalidate_tlbe( REGS* regs, BYTE* main );
 void z900_invalidate_tlbe( REGS* regs, BYTE* main );
 
 RADR apply_host_prefixing( REGS* regs, RADR raddr );
+void tlb_shootdown( REGS* regs, U16 cpuad, BYTE what, RADR pfra );
+void tlb_shootdown_ack( REGS* regs );
 
 CPU_DLL_IMPORT void (ATTR_REGPARM(2) s370_program_interrupt)( REGS* regs, int code );
 CPU_DLL_IMPORT void (ATTR_REGPARM(2) s390_program_interrupt)( REGS* regs, int code );
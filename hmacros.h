@@ -410,33 +410,83 @@ typedef int CMPFUNC(const void*, const void*);
 /*-------------------------------------------------------------------*/
 /*                  Obtain/Release mainlock                          */
 /*-------------------------------------------------------------------*/
-/*  mainlock is only obtained by a CPU thread. PROGRAMMING NOTE:     */
-/*  The below #defines for OBTAIN_MAINLOCK and RELEASE_MAINLOCK      */
-/*  MIGHT be overridden/nullified by machdep.h if atomic assists     */
-/*  are available, since normally, that is the only reason for       */
-/*  needing to obtain mainlock in the first place: because you       */
-/*  need to do something atomically (e.g. need to do cmpxchg).       */
+/*  mainlock is a table of MAINLOCK_STRIPES locks rather than one    */
+/*  lock for all of main storage. An interlocked update obtains the  */
+/*  lock selected by hashing the cache line of its operand's main-   */
+/*  stor address (_key), so unrelated updates proceed in parallel.   */
+/*  Two-operand forms obtain both locks in ascending stripe order    */
+/*  to avoid deadlock. The held stripes are remembered in the host   */
+/*  REGS so RELEASE_MAINLOCK and program_interrupt can drop them.    */
+/*                                                                   */
+/*  A CPU only obtains mainlock when other CPUs are started. The     */
+/*  OBTAIN_DEVMAINLOCK variant is for non-CPU (device) threads.      */
+/*                                                                   */
+/*  PROGRAMMING NOTE: The below #defines for OBTAIN_MAINLOCK and     */
+/*  RELEASE_MAINLOCK MIGHT be overridden/nullified by machdep.h if   */
+/*  atomic assists are available, since normally, that is the only  */
+/*  reason for needing to obtain mainlock in the first place:        */
+/*  because you need to do something atomically (e.g. cmpxchg).     */
 /*-------------------------------------------------------------------*/
 
-#define OBTAIN_MAINLOCK_UNCONDITIONAL(_regs) \
+#define MAINLOCK_STRIPE(_key) \
+ ((U16)((((uintptr_t)(_key) >> MAINLOCK_SHIFT) \
+       ^ ((uintptr_t)(_key) >> (MAINLOCK_SHIFT + 8))) \
+       & (MAINLOCK_STRIPES - 1)))
+
+#define OBTAIN_MAINLOCK2_UNCONDITIONAL(_regs,_key1,_key2) \
  do { \
   if (HOST(_regs)->cpubit != (_regs)->sysblk->started_mask) { \
-   obtain_lock(&(_regs)->sysblk->mainlock); \
-   (_regs)->sysblk->mainowner = HOST(_regs)->cpuad; \
+   U16 _lo = MAINLOCK_STRIPE((_key1)); \
+   U16 _hi = MAINLOCK_STRIPE((_key2)); \
+   if (_lo > _hi) { U16 _tmp = _lo; _lo = _hi; _hi = _tmp; } \
+   obtain_lock(&(_regs)->sysblk->mainlock[_lo]); \
+   HOST(_regs)->mainstripe[0] = _lo; \
+   HOST(_regs)->mainstripes = 1; \
+   if (_hi != _lo) { \
+    obtain_lock(&(_regs)->sysblk->mainlock[_hi]); \
+    HOST(_regs)->mainstripe[1] = _hi; \
+    HOST(_regs)->mainstripes = 2; \
+   } \
   } \
  } while (0)
 
+#define OBTAIN_MAINLOCK_UNCONDITIONAL(_regs,_key) \
+        OBTAIN_MAINLOCK2_UNCONDITIONAL((_regs),(_key),(_key))
+
 #define RELEASE_MAINLOCK_UNCONDITIONAL(_regs) \
  do { \
-   if ((_regs)->sysblk->mainowner == HOST(_regs)->cpuad) { \
-     (_regs)->sysblk->mainowner = LOCK_OWNER_NONE; \
-     release_lock(&(_regs)->sysblk->mainlock); \
+   while (HOST(_regs)->mainstripes) { \
+     HOST(_regs)->mainstripes--; \
+     release_lock(&(_regs)->sysblk->mainlock \
+       [HOST(_regs)->mainstripe[HOST(_regs)->mainstripes]]); \
    } \
  } while (0)
 
-#define  OBTAIN_MAINLOCK(_regs)  OBTAIN_MAINLOCK_UNCONDITIONAL((_regs))
+#define  OBTAIN_MAINLOCK(_regs,_key) \
+         OBTAIN_MAINLOCK_UNCONDITIONAL((_regs),(_key))
+#define  OBTAIN_MAINLOCK2(_regs,_key1,_key2) \
+         OBTAIN_MAINLOCK2_UNCONDITIONAL((_regs),(_key1),(_key2))
 #define RELEASE_MAINLOCK(_regs) RELEASE_MAINLOCK_UNCONDITIONAL((_regs))
 
+#define OBTAIN_DEVMAINLOCK(_key1,_key2) \
+ do { \
+  U16 _lo = MAINLOCK_STRIPE((_key1)); \
+  U16 _hi = MAINLOCK_STRIPE((_key2)); \
+  if (_lo > _hi) { U16 _tmp = _lo; _lo = _hi; _hi = _tmp; } \
+  obtain_lock(&sysblk.mainlock[_lo]); \
+  if (_hi != _lo) \
+   obtain_lock(&sysblk.mainlock[_hi]); \
+ } while (0)
+
+#define RELEASE_DEVMAINLOCK(_key1,_key2) \
+ do { \
+  U16 _lo = MAINLOCK_STRIPE((_key1)); \
+  U16 _hi = MAINLOCK_STRIPE((_key2)); \
+  if (_hi != _lo) \
+   release_lock(&sysblk.mainlock[_hi]); \
+  release_lock(&sysblk.mainlock[_lo]); \
+ } while (0)
+
 /*-------------------------------------------------------------------*/
 /*      Obtain/Release crwlock                                       */
 /*      crwlock can be obtained by any thread                        */
@@ -464,6 +514,12 @@ typedef int CMPFUNC(const void*, const void*);
 /*-------------------------------------------------------------------*/
 #define AT_SYNCPOINT(_regs) (HOST(_regs)->intwait)
 
+/*-------------------------------------------------------------------*/
+/* Return whether another CPU has asked this CPU to purge its TLB    */
+/*-------------------------------------------------------------------*/
+#define TLB_SHOOTDOWN_PENDING(_regs) \
+    (HOST(_regs)->tlbshootgen != HOST(_regs)->tlbshootack)
+
 /*-------------------------------------------------------------------*/
 /*      Macro to check if DEVBLK is for an existing device           */
 /*-------------------------------------------------------------------*/
@@ -213,6 +213,20 @@ DLL_EXPORT void init_hostinfo ( HOST_INFO* pHostInfo )
     }
 #endif /* #if defined( __APPLE__ ) || defined( FREEBSD_OR_NETBSD ) */
 
+#if defined( __GNUC__ ) && (defined( __x86_64__ ) || defined( __i386__ ))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports( "sse2" ))
+        pHostInfo->cpu_sse2 = pHostInfo->vector_unit = 1;
+    if (__builtin_cpu_supports( "avx2" ))
+        pHostInfo->cpu_avx2 = 1;
+    if (__builtin_cpu_supports( "aes" ))
+        pHostInfo->cpu_aes_extns = 1;
+    if (__builtin_cpu_supports( "pclmul" ))
+        pHostInfo->cpu_pclmul = 1;
+    if (__builtin_cpu_supports( "sha" ))
+        pHostInfo->cpu_sha_extns = 1;
+#endif
+
     pHostInfo->hostpagesz = (U64) HPAGESIZE();
 
     if ( pHostInfo->cachelinesz == 0 )
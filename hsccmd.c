@@ -3607,6 +3607,53 @@ int qstor_cmd(int argc, char *argv[], char *cmdline);
 int mainsize_cmd(int argc, char *argv[], char *cmdline);
 int xpndsize_cmd(int argc, char *argv[], char *cmdline);
 
+/*-------------------------------------------------------------------*/
+/* qstor_main  --  display main storage (helper for qstor/mainsize)  */
+/*-------------------------------------------------------------------*/
+static void qstor_main( bool resident )
+{
+    char  memsize[128];
+    char  resdsize[128];
+    U64   resdbytes;
+
+    fmt_memsize_KB( sysblk.mainsize >> SHIFT_KIBIBYTE,
+        memsize, sizeof( memsize ));
+
+    // "%-8s storage is %s (%ssize); storage is %slocked"
+    WRMSG( HHC17003, "I", "MAIN", memsize, "main",
+        sysblk.mainstor_locked ? "" : "not " );
+
+    if (sysblk.mainstor && (0
+        || sysblk.mainpages != MAINPAGES_DEFAULT
+        || sysblk.mainnode  != MAINNODE_ANY
+    ))
+    {
+        char numa[64] = "";
+        char pagesz[32];
+
+        if (sysblk.mainnode == MAINNODE_INTERLEAVE)
+            STRLCPY( numa, "; interleaved across NUMA nodes" );
+        else if (sysblk.mainnode != MAINNODE_ANY)
+            MSGBUF( numa, "; bound to NUMA node %d", sysblk.mainnode );
+
+        fmt_memsize( sysblk.mainpagesz, pagesz, sizeof( pagesz ));
+
+        // "%-8s storage uses %s %s host pages%s"
+        WRMSG( HHC17016, "I", "MAIN", pagesz,
+            sysblk.mainpagetype, numa );
+    }
+
+    /* (storage just obtained by mainsize is not resident yet) */
+    if (resident && (resdbytes = mainstor_resident()) != ~0ULL)
+    {
+        fmt_memsize_KB( resdbytes >> SHIFT_KIBIBYTE,
+            resdsize, sizeof( resdsize ));
+
+        // "%-8s storage has %s of %s resident in host memory"
+        WRMSG( HHC17018, "I", "MAIN", resdsize, memsize );
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /* mainsize command                                                  */
 /*-------------------------------------------------------------------*/
@@ -3630,6 +3677,8 @@ int mainsize_cmd( int argc, char* argv[], char* cmdline )
 
     char   lockopt[16];             // (LOCKED/UNLOCKED work)
     bool   lock_mainstor = false;   // (true == "LOCKED" given)
+    BYTE   mainpages = MAINPAGES_DEFAULT;  // (host page backing)
+    int    mainnode  = MAINNODE_ANY;       // (NUMA placement)
     int    i, rc;                   // (work)
 
     UNREFERENCED( cmdline );
@@ -3745,6 +3794,22 @@ int mainsize_cmd( int argc, char* argv[], char* cmdline )
 #endif
         if (strabbrev( "UNLOCKED", lockopt, 3 ))
             lock_mainstor = false;
+        else if (strabbrev( "HUGEPAGES", lockopt, 4 ))
+            mainpages = MAINPAGES_HUGETLB;
+        else if (strcmp( "THP", lockopt ) == 0)
+            mainpages = MAINPAGES_THP;
+        else if (strabbrev( "NOHUGEPAGES", lockopt, 6 ))
+            mainpages = MAINPAGES_DEFAULT;
+        else if (strabbrev( "INTERLEAVE", lockopt, 5 ))
+            mainnode = MAINNODE_INTERLEAVE;
+        else if (strabbrev( "ANYNODE", lockopt, 3 ))
+            mainnode = MAINNODE_ANY;
+        else if (1
+            && strncmp( "NODE=", lockopt, 5 ) == 0
+            && sscanf( lockopt + 5, "%d%c", &mainnode, &c ) == 1
+            && mainnode >= 0
+        )
+            ; // (mainnode already set)
         else
         {
             // "Invalid value %s specified for %s"
@@ -3757,6 +3822,10 @@ int mainsize_cmd( int argc, char* argv[], char* cmdline )
     if (!mainsize_numpages) lock_mainstor = false;
     sysblk.lock_mainstor =  lock_mainstor;
 
+    /* Set host page backing and NUMA placement requests */
+    sysblk.mainpages = mainpages;
+    sysblk.mainnode  = mainnode;
+
     /* Update main storage size */
     rc = configure_storage( mainsize_numpages );
 
@@ -3764,7 +3833,7 @@ int mainsize_cmd( int argc, char* argv[], char* cmdline )
     {
         if (MLVL( VERBOSE ))
             // Show them the results
-            qstor_cmd( 2, qstor_args, qstor_cmdline );
+            qstor_main( false );
     }
     else if (HERRCPUONL == rc)
     {
@@ -3793,6 +3862,8 @@ char    check[16];
 char   *q_argv[2] = { "qstor", "xpnd" };
 u_int   lockreq = 0;
 u_int   locktype = 0;
+u_int   filereq = 0;
+char   *xpndfile = NULL;
 
     UNREFERENCED(cmdline);
 
@@ -3890,6 +3961,22 @@ u_int   locktype = 0;
             lockreq = 1;
             locktype = 0;
         }
+        else if (strncasecmp("FILE=", argv[i], 5) == 0 && argv[i][5])
+        {
+#if defined( _MSVC_ )
+            // "%s support not included in this engine build"
+            WRMSG( HHC17015, "E", "File backed expanded storage" );
+            return -1;
+#else
+            filereq = 1;
+            xpndfile = argv[i] + 5;
+#endif
+        }
+        else if (strabbrev("NOFILE", check, 3))
+        {
+            filereq = 1;
+            xpndfile = NULL;
+        }
         else
         {
             // "Invalid value %s specified for %s"
@@ -3902,6 +3989,13 @@ u_int   locktype = 0;
     else if (lockreq)
         sysblk.lock_xpndstor = locktype;
 
+    /* Set backing file request */
+    if (filereq)
+    {
+        free( sysblk.xpndfile );
+        sysblk.xpndfile = xpndfile ? strdup( xpndfile ) : NULL;
+    }
+
     rc = configure_xstorage( xpndsize );
     if (rc >= 0)
     {
@@ -9135,6 +9229,53 @@ int herclogo_cmd(int argc,char *argv[], char *cmdline)
     return rc;
 }
 
+/*-------------------------------------------------------------------*/
+/* simd - display or set the host SIMD kernels                       */
+/*-------------------------------------------------------------------*/
+int simd_cmd( int argc, char* argv[], char* cmdline )
+{
+    int  level  = HSIMD_BEST;
+
+    UNREFERENCED( cmdline );
+    UPPER_ARGV_0( argv );
+
+    if (argc > 2)
+    {
+        // "Invalid command usage. Type 'help %s' for assistance."
+        WRMSG( HHC02299, "E", argv[0] );
+        return -1;
+    }
+
+    if (argc == 2)
+    {
+        if      (CMD( argv[1], NONE, 4 )) level = HSIMD_NONE;
+        else if (CMD( argv[1], SSE2, 4 )) level = HSIMD_SSE2;
+        else if (CMD( argv[1], AVX2, 4 )) level = HSIMD_AVX2;
+        else if (!CMD( argv[1], BEST, 4 ))
+        {
+            // "Invalid argument %s%s"
+            WRMSG( HHC02205, "E", argv[1], "" );
+            return -1;
+        }
+
+        if (hsimd_init( level ) < 0)
+        {
+            // "Host does not support %s SIMD kernels"
+            WRMSG( HHC17022, "E", hsimd_name( level ));
+            return -1;
+        }
+    }
+
+    // "Host SIMD kernels %s in use; host supports %s"
+    WRMSG( HHC17021, "I", hsimd_name( hsimd_level ),
+        hsimd_name( hostinfo.cpu_avx2 ? HSIMD_AVX2 :
+                    hostinfo.cpu_sse2 ? HSIMD_SSE2 : HSIMD_NONE ));
+
+    // "Host crypto kernels %s in use"
+    WRMSG( HHC17024, "I", hsimd_crypto_name());
+    return 0;
+}
+
 /*-------------------------------------------------------------------*/
 /* sizeof - Display sizes of various structures/tables               */
 /*-------------------------------------------------------------------*/
@@ -9844,14 +9985,7 @@ int qstor_cmd( int argc, char* argv[], char* cmdline )
     }
 
     if (display_main)
-    {
-        fmt_memsize_KB( sysblk.mainsize >> SHIFT_KIBIBYTE,
-            memsize, sizeof( memsize ));
-
-        // "%-8s storage is %s (%ssize); storage is %slocked"
-        WRMSG( HHC17003, "I", "MAIN", memsize, "main",
-            sysblk.mainstor_locked ? "" : "not " );
-    }
+        qstor_main( true );
 
     if (display_xpnd)
     {
@@ -9861,8 +9995,48 @@ int qstor_cmd( int argc, char* argv[], char* cmdline )
         // "%-8s storage is %s (%ssize); storage is %slocked"
         WRMSG( HHC17003, "I", "EXPANDED", memsize, "xpnd",
             sysblk.xpndstor_locked ? "" : "not " );
+
+        if (sysblk.xpndstor_mapped)
+            // "%-8s storage is backed by file %s"
+            WRMSG( HHC17023, "I", "EXPANDED", sysblk.xpndfile );
+    }
+
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* dirty command  --  display or reset changed frame statistics      */
+/*-------------------------------------------------------------------*/
+int dirty_cmd( int argc, char* argv[], char* cmdline )
+{
+    bool  reset  = false;
+    U64   frames, changed, usecs, now;
+
+    UNREFERENCED( cmdline );
+    UPPER_ARGV_0( argv );
+
+    if (argc > 2 || (argc == 2 && !(reset = CMD( argv[1], RESET, 5 ))))
+    {
+        // "Invalid command usage. Type 'help %s' for assistance."
+        WRMSG( HHC02299, "E", argv[0] );
+        return -1;
     }
 
+    frames  = sysblk.mainsize >> SHIFT_4K;
+    now     = host_tod();
+    changed = get_dirty_frames( 0, sysblk.mainsize, NULL, reset );
+    usecs   = (now - sysblk.dirtytime) / ETOD_USEC;
+
+    if (reset)
+        sysblk.dirtytime = now;
+
+    // "%-8s storage has %"PRIu64" of %"PRIu64" 4K frames changed"
+    WRMSG( HHC17019, "I", "MAIN", changed, frames );
+
+    // "Changed frames interval %"PRIu64".%03u seconds; %"PRIu64" frames per second"
+    WRMSG( HHC17020, "I", usecs / 1000000, (unsigned) (usecs % 1000000) / 1000,
+        usecs ? (changed * 1000000) / usecs : 0 );
+
     return 0;
 }
 
@@ -399,10 +399,88 @@ DLL_EXPORT int aia_cmd( int argc, char* argv[], char* cmdline )
 /*   The "tlbid" field is part of TLB_VADDR so it must be extracted  */
 /*   whenever it's used or displayed. The TLB_VADDR does not contain */
 /*   all of the effective address bits so they are created on-the-fly*/
-/*   with (i << shift) The "main" field of the tlb contains an XOR   */
-/*   hash of effective address. So MAINADDR() macro is used to remove*/
-/*   the hash before it's displayed.                                 */
+/*   with ((i & TLB_MASK) << shift). The "main" field of the tlb     */
+/*   contains an XOR hash of effective address. So MAINADDR() macro  */
+/*   is used to remove the hash before it's displayed.               */
 /*                                                                   */
+/*   "tlb stats" instead displays the TLB geometry and each CPU's    */
+/*   maddr_l TLB hit and miss counts, and how many TLB misses were   */
+/*   resolved by large (EDAT-1 1M) frame entries without walking the */
+/*   DAT tables. "tlb reset" resets them.                            */
+/*                                                                   */
+static void tlb_stats_line( const char* what, int cpu, REGS* regs )
+{
+    char    buf[128];
+    U64     total = regs->tlbhits + regs->tlbmisses;
+
+    MSGBUF( buf, "%s%02X%s: hits %"PRIu64", misses %"PRIu64", hit ratio %.2f%%",
+        PTYPSTR( cpu ), cpu, what, regs->tlbhits, regs->tlbmisses,
+        total ? (100.0 * regs->tlbhits) / total : 0.0 );
+    WRMSG( HHC02284, "I", buf );
+
+    if (regs->tlblargefills)
+    {
+        MSGBUF( buf, "%s%02X%s: large frame entries %"PRIu64", TLB misses resolved %"PRIu64,
+            PTYPSTR( cpu ), cpu, what, regs->tlblargefills, regs->tlblargehits );
+        WRMSG( HHC02284, "I", buf );
+    }
+}
+
+static int tlb_stats( bool reset )
+{
+    REGS   *regs;
+    char    buf[128];
+    int     cpu;
+
+    if (!reset)
+    {
+        MSGBUF( buf, "TLB: %d entries, %d sets of %d way%s",
+            TLBN, TLB_SETS, TLB_WAYS, TLB_WAYS > 1 ? "s" : "" );
+        WRMSG( HHC02284, "I", buf );
+    }
+
+    for (cpu=0; cpu < sysblk.maxcpu; cpu++)
+    {
+        obtain_lock( &sysblk.cpulock[ cpu ]);
+
+        if (IS_CPU_ONLINE( cpu ))
+        {
+            regs = sysblk.regs[ cpu ];
+
+            if (reset)
+            {
+                regs->tlbhits = regs->tlbmisses = 0;
+                regs->tlblargefills = regs->tlblargehits = 0;
+                if (GUESTREGS)
+                {
+                    GUESTREGS->tlbhits = GUESTREGS->tlbmisses = 0;
+                    GUESTREGS->tlblargefills = GUESTREGS->tlblargehits = 0;
+                    GUESTREGS->tlbctxuse = GUESTREGS->tlbctxhits = 0;
+                }
+            }
+            else
+            {
+                tlb_stats_line( "", cpu, regs );
+                if (GUESTREGS)
+                {
+                    tlb_stats_line( " SIE", cpu, GUESTREGS );
+                    MSGBUF( buf, "%s%02X SIE: dispatches %"PRIu64", TLB context reused %"PRIu64,
+                        PTYPSTR( cpu ), cpu, GUESTREGS->tlbctxuse, GUESTREGS->tlbctxhits );
+                    WRMSG( HHC02284, "I", buf );
+                }
+            }
+        }
+
+        release_lock( &sysblk.cpulock[ cpu ]);
+    }
+
+    if (reset)
+        // "%s"
+        WRMSG( HHC02268, "I", "Done!" );
+
+    return 0;
+}
+
 int tlb_cmd(int argc, char *argv[], char *cmdline)
 {
     int     i;                          /* Index                     */
@@ -414,10 +492,23 @@ int tlb_cmd(int argc, char *argv[], char *cmdline)
     char    buf[128];
 
 
-    UNREFERENCED(argc);
-    UNREFERENCED(argv);
     UNREFERENCED(cmdline);
 
+    UPPER_ARGV_0( argv );
+
+    if (argc > 1)
+    {
+        if (argc == 2 && CMD( argv[1], STATS, 4 ))
+            return tlb_stats( false );
+
+        if (argc == 2 && CMD( argv[1], RESET, 5 ))
+            return tlb_stats( true );
+
+        // "Invalid command usage. Type 'help %s' for assistance."
+        WRMSG( HHC02299, "E", argv[0] );
+        return -1;
+    }
+
     obtain_lock(&sysblk.cpulock[sysblk.pcpu]);
 
     if (!IS_CPU_ONLINE(sysblk.pcpu))
@@ -441,13 +532,13 @@ int tlb_cmd(int argc, char *argv[], char *cmdline)
         MSGBUF( buf, "%s%3.3X %16.16"PRIX64" %16.16"PRIX64" %16.16"PRIX64" %4.4X %1d %1d %1d %1d %2.2X %8.8X",
          ((regs->tlb.TLB_VADDR_G(i) & bytemask) == regs->tlbID ? "*" : " "),
          i,regs->tlb.TLB_ASD_G(i),
-         ((regs->tlb.TLB_VADDR_G(i) & pagemask) | (i << shift)),
+         ((regs->tlb.TLB_VADDR_G(i) & pagemask) | ((i & TLB_MASK) << shift)),
          regs->tlb.TLB_PTE_G(i),(int)(regs->tlb.TLB_VADDR_G(i) & bytemask),
          regs->tlb.common[i],regs->tlb.protect[i],
          (regs->tlb.acc[i] & ACC_READ) != 0,(regs->tlb.acc[i] & ACC_WRITE) != 0,
          regs->tlb.skey[i],
          (unsigned int)(MAINADDR(regs->tlb.main[i],
-                  ((regs->tlb.TLB_VADDR_G(i) & pagemask) | (unsigned int)(i << shift)))
+                  ((regs->tlb.TLB_VADDR_G(i) & pagemask) | (unsigned int)((i & TLB_MASK) << shift)))
                   - regs->mainstor));
         matches += ((regs->tlb.TLB_VADDR(i) & bytemask) == regs->tlbID);
        WRMSG(HHC02284, "I", buf);
@@ -472,13 +563,13 @@ int tlb_cmd(int argc, char *argv[], char *cmdline)
             MSGBUF( buf, "%s%3.3X %16.16"PRIX64" %16.16"PRIX64" %16.16"PRIX64" %4.4X %1d %1d %1d %1d %2.2X %8.8X",
              ((regs->tlb.TLB_VADDR_G(i) & bytemask) == regs->tlbID ? "*" : " "),
              i,regs->tlb.TLB_ASD_G(i),
-             ((regs->tlb.TLB_VADDR_G(i) & pagemask) | (i << shift)),
+             ((regs->tlb.TLB_VADDR_G(i) & pagemask) | ((i & TLB_MASK) << shift)),
              regs->tlb.TLB_PTE_G(i),(int)(regs->tlb.TLB_VADDR_G(i) & bytemask),
              regs->tlb.common[i],regs->tlb.protect[i],
              (regs->tlb.acc[i] & ACC_READ) != 0,(regs->tlb.acc[i] & ACC_WRITE) != 0,
              regs->tlb.skey[i],
              (unsigned int) (MAINADDR(regs->tlb.main[i],
-                     ((regs->tlb.TLB_VADDR_G(i) & pagemask) | (unsigned int)(i << shift)))
+                     ((regs->tlb.TLB_VADDR_G(i) & pagemask) | (unsigned int)((i & TLB_MASK) << shift)))
                     - regs->mainstor));
             matches += ((regs->tlb.TLB_VADDR(i) & bytemask) == regs->tlbID);
            WRMSG(HHC02284, "I", buf);
@@ -2087,7 +2178,7 @@ int ipending_cmd(int argc, char *argv[], char *cmdline)
         WRMSG( HHC00860, "I", PTYPSTR(sysblk.regs[i]->cpuad), sysblk.regs[i]->cpuad,
                               IS_IC_SERVSIG ? "" : "not ");
         WRMSG( HHC00861, "I", PTYPSTR(sysblk.regs[i]->cpuad), sysblk.regs[i]->cpuad,
-                              sysblk.regs[i]->cpuad == sysblk.mainowner ? "yes" : "no");
+                              sysblk.regs[i]->mainstripes ? "yes" : "no");
         WRMSG( HHC00862, "I", PTYPSTR(sysblk.regs[i]->cpuad), sysblk.regs[i]->cpuad,
                               sysblk.regs[i]->cpuad == sysblk.intowner ? "yes" : "no");
         WRMSG( HHC00863, "I", PTYPSTR(sysblk.regs[i]->cpuad), sysblk.regs[i]->cpuad,
@@ -2203,7 +2294,14 @@ int ipending_cmd(int argc, char *argv[], char *cmdline)
 
     WRMSG( HHC00872, "I", test_lock(&sysblk.sigplock) ? "" : "not ");
     WRMSG( HHC00873, "I", test_lock(&sysblk.todlock) ? "" : "not ");
-    WRMSG( HHC00874, "I", test_lock(&sysblk.mainlock) ? "" : "not ", sysblk.mainowner);
+    {
+        int i, held = 0;
+        for (i=0; i < MAINLOCK_STRIPES; i++)
+            if (test_lock( &sysblk.mainlock[i] ))
+                held++;
+        // "mainlock %d of %d stripes held"
+        WRMSG( HHC00874, "I", held, MAINLOCK_STRIPES );
+    }
     WRMSG( HHC00875, "I", test_lock(&sysblk.intlock) ? "" : "not ", sysblk.intowner);
     WRMSG( HHC00876, "I", test_lock(&sysblk.ioqlock) ? "" : "not ");
 
@@ -2687,6 +2785,38 @@ int i_cmd( int argc, char* argv[], char* cmdline )
 
 
 #if defined( OPTION_INSTR_COUNT_AND_TIME )
+/*-------------------------------------------------------------------*/
+/* Extended opcode groups of the IMAPS slots (see hstructs.h)        */
+/*-------------------------------------------------------------------*/
+static const struct {
+    BYTE opcode1;          // Operation code, first byte
+    U8   opc2pos;          // Opcode2 position in Instr
+    U16  slot;             // First IMAPS slot of group
+    U16  nn;               // Number of slots in group
+} icount_groups[] =
+{
+    { 0x01, 1, IMAP_01, 256 },
+    { 0xA4, 1, IMAP_A4, 256 },
+    { 0xA5, 1, IMAP_A5,  16 },
+    { 0xA6, 1, IMAP_A6, 256 },
+    { 0xA7, 1, IMAP_A7,  16 },
+    { 0xB2, 1, IMAP_B2, 256 },
+    { 0xB3, 1, IMAP_B3, 256 },
+    { 0xB9, 1, IMAP_B9, 256 },
+    { 0xC0, 1, IMAP_C0,  16 },
+    { 0xC2, 1, IMAP_C2,  16 },
+    { 0xC4, 1, IMAP_C4,  16 },
+    { 0xC6, 1, IMAP_C6,  16 },
+    { 0xC8, 1, IMAP_C8,  16 },
+    { 0xE3, 5, IMAP_E3, 256 },
+    { 0xE4, 1, IMAP_E4, 256 },
+    { 0xE5, 1, IMAP_E5, 256 },
+    { 0xE7, 5, IMAP_E7, 256 },
+    { 0xEB, 5, IMAP_EB, 256 },
+    { 0xEC, 5, IMAP_EC, 256 },
+    { 0xED, 5, IMAP_ED, 256 },
+};
+
 /*-------------------------------------------------------------------*/
 /* Definition of opcode execution count entries                      */
 /*-------------------------------------------------------------------*/
@@ -2694,16 +2824,190 @@ typedef struct {
     unsigned char opcode1; // Operation code, first byte
     unsigned char opcode2; // Operation code, second byte
     U8 opc2pos;            // Opcode2 position in Instr
-    U64 count;             // Execution count from sysblk.imaps.imap??
-    U64 time;              // Execution time
+    U64 count;             // Execution count, all CPUs
+    U64 samples;           // Number of timed executions
+    U64 cycles;            // Host cycles of timed executions
+    U64 hist[ IMAP_HIST ]; // log2 histogram of timed executions
 } ICOUNT_INSTR;
 
 /*-------------------------------------------------------------------*/
 /* icount command sort callback (Descending by exec count)           */
 /*-------------------------------------------------------------------*/
-static int icount_cmd_sort(const ICOUNT_INSTR *x, const ICOUNT_INSTR *y)
+static int icount_cmd_sort( const void* a, const void* b )
+{
+    const ICOUNT_INSTR* x = a;
+    const ICOUNT_INSTR* y = b;
+    return (x->count < y->count) ? +1 : (x->count > y->count) ? -1 : 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* Merge one IMAPS slot of all CPUs into an ICOUNT_INSTR entry       */
+/*-------------------------------------------------------------------*/
+static bool icount_merge_slot( ICOUNT_INSTR* ic, int slot )
+{
+    IMAPS*  imaps;
+    int     cpu, n;
+
+    memset( ic, 0, sizeof( ICOUNT_INSTR ));
+
+    for (cpu=0; cpu < MAX_CPU_ENGS; cpu++)
+    {
+        if (!(imaps = sysblk.imaps[ cpu ]))
+            continue;
+
+        ic->count   += imaps->count  [ slot ];
+        ic->samples += imaps->samples[ slot ];
+        ic->cycles  += imaps->cycles [ slot ];
+
+        for (n=0; n < IMAP_HIST; n++)
+            ic->hist[n] += imaps->hist[ slot ][n];
+    }
+    return ic->count != 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* Collect all executed opcodes, sorted by descending count          */
+/*-------------------------------------------------------------------*/
+static ICOUNT_INSTR* icount_collect( int* num, U64* total )
+{
+    ICOUNT_INSTR*  icount;
+    int  g, i, i1, i2;
+
+    if (!(icount = malloc( IMAP_SLOTS * sizeof( ICOUNT_INSTR ))))
+        return NULL;
+
+    i = 0;
+    *total = 0;
+
+    for (g=0; g < (int) _countof( icount_groups ); g++)
+    {
+        for (i2=0; i2 < icount_groups[g].nn; i2++)
+        {
+            if (icount_merge_slot( &icount[i], icount_groups[g].slot + i2 ))
+            {
+                icount[i].opcode1 = icount_groups[g].opcode1;
+                icount[i].opcode2 = i2;
+                icount[i].opc2pos = icount_groups[g].opc2pos;
+                *total += icount[i++].count;
+            }
+        }
+    }
+
+    for (i1=0; i1 < 256; i1++)
+    {
+        if (icount_merge_slot( &icount[i], IMAP_XX + i1 ))
+        {
+            icount[i].opcode1 = i1;
+            icount[i].opcode2 = 0;
+            icount[i].opc2pos = 0;
+            *total += icount[i++].count;
+        }
+    }
+
+    qsort( icount, i, sizeof( ICOUNT_INSTR ), icount_cmd_sort );
+
+    *num = i;
+    return icount;
+}
+
+/*-------------------------------------------------------------------*/
+/* Format opcode and mnemonic of an ICOUNT_INSTR entry               */
+/*-------------------------------------------------------------------*/
+static void icount_opcode( const ICOUNT_INSTR* ic, char* hex, size_t hexlen,
+                                                   char* mnem, size_t mnemlen )
 {
-    return (x->count < y->count) ? +1 : -1;
+    BYTE  fakeinst[6];
+    char  prtbuf[ 128 ] = {0};
+    char* p;
+
+    memset( fakeinst, 0, sizeof( fakeinst ));
+    fakeinst[0] = ic->opcode1;
+
+    if (ic->opc2pos)
+    {
+        fakeinst[ ic->opc2pos ] = ic->opcode2;
+        snprintf( hex, hexlen, "%2.2X%2.2X", ic->opcode1, ic->opcode2 );
+    }
+    else
+        snprintf( hex, hexlen, "%2.2X", ic->opcode1 );
+
+    PRINT_INST( sysblk.arch_mode, fakeinst, prtbuf );
+
+    /* Mnemonic is the first word of the disassembled instruction */
+    for (p = prtbuf; *p && !isspace( (unsigned char) *p ); p++);
+    *p = 0;
+    strlcpy( mnem, prtbuf, mnemlen );
+}
+
+/*-------------------------------------------------------------------*/
+/* icount CSV|JSON filename  -  export instruction counts            */
+/*-------------------------------------------------------------------*/
+static int icount_export( const char* filename, bool json )
+{
+    ICOUNT_INSTR*  icount;
+    FILE*  f;
+    U64    total;
+    int    i, n, num;
+    char   hex[8];
+    char   mnem[16];
+
+    if (!(icount = icount_collect( &num, &total )))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC02219, "E", "malloc()", strerror( errno ));
+        return -1;
+    }
+
+    if (!(f = fopen( filename, "w" )))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC02219, "E", "fopen()", strerror( errno ));
+        free( icount );
+        return -1;
+    }
+
+    if (json)
+        fprintf( f, "{\n  \"total\": %"PRIu64",\n  \"sample\": %u,\n"
+                    "  \"instructions\": [", total, sysblk.icount_sample );
+    else
+    {
+        fprintf( f, "opcode,mnemonic,count,samples,cycles" );
+        for (n=0; n < IMAP_HIST; n++)
+            fprintf( f, ",hist%d", n );
+        fprintf( f, "\n" );
+    }
+
+    for (i=0; i < num; i++)
+    {
+        icount_opcode( &icount[i], hex, sizeof( hex ), mnem, sizeof( mnem ));
+
+        if (json)
+        {
+            fprintf( f, "%s\n    { \"opcode\": \"%s\", \"mnemonic\": \"%s\","
+                        " \"count\": %"PRIu64", \"samples\": %"PRIu64","
+                        " \"cycles\": %"PRIu64", \"histogram\": [",
+                        i ? "," : "", hex, mnem, icount[i].count,
+                        icount[i].samples, icount[i].cycles );
+            for (n=0; n < IMAP_HIST; n++)
+                fprintf( f, "%s%"PRIu64, n ? ", " : "", icount[i].hist[n] );
+            fprintf( f, "] }" );
+        }
+        else
+        {
+            fprintf( f, "%s,%s,%"PRIu64",%"PRIu64",%"PRIu64, hex, mnem,
+                     icount[i].count, icount[i].samples, icount[i].cycles );
+            for (n=0; n < IMAP_HIST; n++)
+                fprintf( f, ",%"PRIu64, icount[i].hist[n] );
+            fprintf( f, "\n" );
+        }
+    }
+
+    if (json)
+        fprintf( f, "\n  ]\n}\n" );
+
+    fclose( f );
+    free( icount );
+    return 0;
 }
 
 /*-------------------------------------------------------------------*/
@@ -2711,20 +3015,13 @@ static int icount_cmd_sort(const ICOUNT_INSTR *x, const ICOUNT_INSTR *y)
 /*-------------------------------------------------------------------*/
 int icount_cmd( int argc, char* argv[], char* cmdline )
 {
-    int i, i1, i2;
-    REGS *regs;
-    BYTE fakeinst[6];
-
-#define  MAX_ICOUNT_INSTR   1000    /* Maximum number of instructions
-                                     in architecture instruction set */
+    ICOUNT_INSTR* icount;
+    int  i, num, cpu;
     U64  total;
 
-    ICOUNT_INSTR icount[MAX_ICOUNT_INSTR];
-
     char buf[ 192 ];
-    char instText[ 7 ];
-
-    regs = sysblk.regs[sysblk.pcpu];
+    char hex[ 8 ];
+    char mnem[ 16 ];
 
     UNREFERENCED( cmdline );
 
@@ -2732,6 +3029,34 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
 
     if (argc > 1)
     {
+        if (argc == 3)
+        {
+            if (CMD( argv[1], SAMPLE, 2 ))
+            {
+                U32  sample;
+                BYTE c;
+
+                if (sscanf( argv[2], "%u%c", &sample, &c ) != 1 || !sample)
+                {
+                    // "Invalid argument %s%s"
+                    WRMSG( HHC02205, "E", argv[2], ": must be 1 or greater" );
+                    return -1;
+                }
+                sysblk.icount_sample = sample;
+                // "%-14s set to %s"
+                WRMSG( HHC02204, "I", "ICOUNT SAMPLE", argv[2] );
+                return 0;
+            }
+            if (CMD( argv[1], CSV, 3 ) || CMD( argv[1], JSON, 4 ))
+            {
+                if (icount_export( argv[2], CMD( argv[1], JSON, 4 )) != 0)
+                    return -1;
+                MSGBUF( buf, "Instruction counts exported to \"%s\"", argv[2] );
+                // "%s"
+                WRMSG( HHC02292, "I", buf );
+                return 0;
+            }
+        }
         if (argc > 2)
         {
             // "Invalid argument(s). Type 'help %s' for assistance."
@@ -2744,7 +3069,15 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
             || CMD( argv[1], ZERO,  1 )
         )
         {
-            memset( &sysblk.imaps, 0, sizeof sysblk.imaps );
+            for (cpu=0; cpu < MAX_CPU_ENGS; cpu++)
+            {
+                if (sysblk.imaps[ cpu ])
+                {
+                    memset( sysblk.imaps[ cpu ], 0, sizeof( IMAPS ));
+                    sysblk.imaps[ cpu ]->slot      = -1;
+                    sysblk.imaps[ cpu ]->countdown = sysblk.icount_sample;
+                }
+            }
             // "%-14s set to %s"
             WRMSG( HHC02204, "I", argv[0], "ZERO" );
             return 0;
@@ -2754,6 +3087,21 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
             || CMD( argv[1], START,  3 )
         )
         {
+            /* Per-CPU counts are allocated on first use and then kept
+               (never freed) since a CPU may still be counting into it */
+            for (cpu=0; cpu < MAX_CPU_ENGS; cpu++)
+            {
+                if (sysblk.imaps[ cpu ])
+                    continue;
+                if (!(sysblk.imaps[ cpu ] = calloc( 1, sizeof( IMAPS ))))
+                {
+                    // "Error in function %s: %s"
+                    WRMSG( HHC02219, "E", "calloc()", strerror( errno ));
+                    return -1;
+                }
+                sysblk.imaps[ cpu ]->slot      = -1;
+                sysblk.imaps[ cpu ]->countdown = sysblk.icount_sample;
+            }
             sysblk.icount = true;
             // "%-14s set to %s"
             WRMSG( HHC02204, "I", argv[0], "ENABLE" );
@@ -2774,91 +3122,14 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
         return -1;
     }
 
-    /* (collect...) */
-
-    i = 0;
-    total = 0;
-
-    for (i1 = 0; i1 < 256; i1++)
-    {
-        switch (i1)
-        {
-#define ICOUNT_COLLECT_CASE( _case, _map, _mapT, _nn, _pos )        \
-                                                                    \
-            case _case:                                             \
-            {                                                       \
-                for (i2=0; i2 < _nn; i2++)                          \
-                {                                                   \
-                    if (sysblk.imaps._map[ i2 ])                    \
-                    {                                               \
-                        icount[i].opcode1 = i1;                     \
-                        icount[i].opcode2 = i2;                     \
-                        icount[i].opc2pos = _pos;                   \
-                        icount[i].time = sysblk.imaps._mapT[ i2 ];  \
-                        icount[i++].count = sysblk.imaps._map[ i2 ];\
-                        total += sysblk.imaps._map[ i2 ];           \
-                                                                    \
-                        if (i == (MAX_ICOUNT_INSTR - 1))            \
-                        {                                           \
-                            /* "Too many instructions! (Sorry!)" */ \
-                            WRMSG( HHC02252, "E" );                 \
-                            return -1;                              \
-                        }                                           \
-                    }                                               \
-                }                                                   \
-                break;                                              \
-            }
+    /* (collect and sort...) */
 
-            ICOUNT_COLLECT_CASE( 0x01, imap01, imap01T, 256, 1 )
-            ICOUNT_COLLECT_CASE( 0xA4, imapa4, imapa4T, 256, 1 )
-            ICOUNT_COLLECT_CASE( 0xA5, imapa5, imapa5T,  16, 1 )
-            ICOUNT_COLLECT_CASE( 0xA6, imapa6, imapa6T, 256, 1 )
-            ICOUNT_COLLECT_CASE( 0xA7, imapa7, imapa7T,  16, 1 )
-            ICOUNT_COLLECT_CASE( 0xB2, imapb2, imapb2T, 256, 1 )
-            ICOUNT_COLLECT_CASE( 0xB3, imapb3, imapb3T, 256, 1 )
-            ICOUNT_COLLECT_CASE( 0xB9, imapb9, imapb9T, 256, 1 )
-            ICOUNT_COLLECT_CASE( 0xC0, imapc0, imapc0T,  16, 1 )
-            ICOUNT_COLLECT_CASE( 0xC2, imapc2, imapc2T,  16, 1 )
-            ICOUNT_COLLECT_CASE( 0xC4, imapc4, imapc4T,  16, 1 )
-            ICOUNT_COLLECT_CASE( 0xC6, imapc6, imapc6T,  16, 1 )
-            ICOUNT_COLLECT_CASE( 0xC8, imapc8, imapc8T,  16, 1 )
-            ICOUNT_COLLECT_CASE( 0xE3, imape3, imape3T, 256, 5 )
-            ICOUNT_COLLECT_CASE( 0xE4, imape4, imape4T, 256, 1 )
-            ICOUNT_COLLECT_CASE( 0xE5, imape5, imape5T, 256, 1 )
-            ICOUNT_COLLECT_CASE( 0xE7, imape7, imape7T, 256, 5 )
-            ICOUNT_COLLECT_CASE( 0xEB, imapeb, imapebT, 256, 5 )
-            ICOUNT_COLLECT_CASE( 0xEC, imapec, imapecT, 256, 5 )
-            ICOUNT_COLLECT_CASE( 0xED, imaped, imapedT, 256, 5 )
-
-            default:
-            {
-
-                if (sysblk.imaps.imapxx[ i1 ])
-                {
-                    icount[i].opcode1 = i1;
-                    icount[i].opcode2 = 0;
-                    icount[i].opc2pos = 0;
-                    icount[i].time = sysblk.imaps.imapxxT[ i1 ];
-                    icount[i++].count = sysblk.imaps.imapxx[i1];
-
-                    total += sysblk.imaps.imapxx[ i1 ];
-
-                    if (i == (MAX_ICOUNT_INSTR - 1))
-                    {
-                        // "Too many instructions! (Sorry!)"
-                        WRMSG( HHC02252, "E" );
-                        return -1;
-                    }
-                }
-                break;
-            }
-        }
-        /* end switch() */
+    if (!(icount = icount_collect( &num, &total )))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC02219, "E", "malloc()", strerror( errno ));
+        return -1;
     }
-    /* end for() */
-
-    /* (sort...) */
-    qsort(icount, i, sizeof(ICOUNT_INSTR), icount_cmd_sort);
 
 #define  ICOUNT_WIDTH  "12"     /* Print field width */
 
@@ -2867,62 +3138,26 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
     // "%s"
     WRMSG( HHC02292, "I", "Sorted icount display:" );
 
-    for (i1 = 0; i1 < i; i1++)
-    {
-        memset(fakeinst, 0, sizeof(fakeinst));
-        int bufl = 0;
-
-        switch (icount[i1].opcode1)
-        {
-            case 0x01:
-            case 0xA4:
-            case 0xA5:
-            case 0xA6:
-            case 0xA7:
-            case 0xB2:
-            case 0xB3:
-            case 0xB9:
-            case 0xC0:
-            case 0xC2:
-            case 0xC4:
-            case 0xC6:
-            case 0xC8:
-            case 0xE3:
-            case 0xE4:
-            case 0xE5:
-            case 0xE7:
-            case 0xEB:
-            case 0xEC:
-            case 0xED:
-            {
-                MSGBUF( instText, "'%2.2X%2.2X'", icount[i1].opcode1, icount[i1].opcode2 );
-                fakeinst[icount[i1].opc2pos] = icount[i1].opcode2;
-                break;
-            }
-            default:
-            {
-                MSGBUF( instText, "'%2.2X'  ", icount[i1].opcode1 );
-                break;
-            }
-        }
+    for (i = 0; i < num; i++)
+    {
+        icount_opcode( &icount[i], hex, sizeof( hex ), mnem, sizeof( mnem ));
 
-        bufl = MSGBUF
+        MSGBUF
         (
             buf,
-            "Inst %s count %" ICOUNT_WIDTH PRIu64 " (%2d%%) time %" ICOUNT_WIDTH PRIu64 " (%10f) ",
-            instText,
-            icount[i1].count,
-            (int)(icount[i1].count * 100 / total),
-            icount[i1].time,
-            ((float)icount[i1].time / icount[i1].count)
+            "Inst '%-4s' count %" ICOUNT_WIDTH PRIu64 " (%2d%%) cycles %10.1f (%" PRIu64 " samples) %s",
+            hex,
+            icount[i].count,
+            (int)(icount[i].count * 100 / total),
+            icount[i].samples ? (double)icount[i].cycles / icount[i].samples : 0.0,
+            icount[i].samples,
+            mnem
         );
-
-        fakeinst[0] = icount[i1].opcode1;
-        bufl += PRINT_INST(regs->arch_mode, fakeinst, buf + bufl);
         WRMSG( HHC02292, "I", buf );
     }
     /* end for() */
 
+    free( icount );
     return 0;
 }
 #endif /* defined( OPTION_INSTR_COUNT_AND_TIME ) */
@@ -2334,8 +2334,12 @@ DLL_EXPORT REGS* copy_regs( REGS* regs )
     /* Perform partial copy and clear the TLB */
     memcpy(  newregs, regs, sysblk.regs_copy_len );
     memset( &newregs->tlb.vaddr, 0, TLBN * sizeof( DW ));
+    memset( &newregs->tlbrmap, 0, sizeof( newregs->tlbrmap ));
+    memset( &newregs->tlblarge, 0, sizeof( newregs->tlblarge ));
 
     newregs->tlbID      = 1;
+    newregs->tlbIDlo    = 1;
+    newregs->tlbIDmax   = 1;
     newregs->ghostregs  = 1;      /* indicate these aren't real regs */
     HOST(  newregs )    = newregs;
     GUEST( newregs )    = NULL;
@@ -2348,8 +2352,12 @@ DLL_EXPORT REGS* copy_regs( REGS* regs )
 
         memcpy(  hostregs, HOSTREGS, sysblk.regs_copy_len );
         memset( &hostregs->tlb.vaddr, 0, TLBN * sizeof( DW ));
+        memset( &hostregs->tlbrmap, 0, sizeof( hostregs->tlbrmap ));
+        memset( &hostregs->tlblarge, 0, sizeof( hostregs->tlblarge ));
 
         hostregs->tlbID     = 1;
+        hostregs->tlbIDlo   = 1;
+        hostregs->tlbIDmax  = 1;
         hostregs->ghostregs = 1;  /* indicate these aren't real regs */
 
         HOST(  hostregs )   = hostregs;
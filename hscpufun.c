@@ -782,6 +782,386 @@ int timerint_cmd( int argc, char *argv[], char *cmdline )
     return rc;
 }
 
+/*-------------------------------------------------------------------*/
+/* cpuloops - display or set adaptive interrupt check interval       */
+/*-------------------------------------------------------------------*/
+int cpuloops_cmd( int argc, char *argv[], char *cmdline )
+{
+    REGS*  regs;
+    char   buf[64];
+    int    i;
+
+    UNREFERENCED( cmdline );
+
+    UPPER_ARGV_0( argv );
+
+    if (argc > 2)
+    {
+        // "Invalid command usage. Type 'help %s' for assistance."
+        WRMSG( HHC02299, "E", argv[0] );
+        return -1;
+    }
+
+    if (argc == 2)
+    {
+        U32  target = 0;
+
+        if (CMD( argv[1], RESET, 5 ))
+        {
+            OBTAIN_INTLOCK( NULL );
+            for (i=0; i < sysblk.maxcpu; i++)
+            {
+                if (!(regs = sysblk.regs[i]))
+                    continue;
+                regs->intlat_count = 0;
+                regs->intlat_total = 0;
+                regs->intlat_max   = 0;
+            }
+            RELEASE_INTLOCK( NULL );
+            // "%s"
+            WRMSG( HHC02268, "I", "Done!" );
+            return 0;
+        }
+
+        if (!CMD( argv[1], OFF, 3 ))
+        {
+            BYTE  c;
+
+            if (0
+                || sscanf( argv[1], "%u%c", &target, &c ) != 1
+                || target < 1
+                || target > 1000000
+            )
+            {
+                // "Invalid argument %s%s"
+                WRMSG( HHC02205, "E", argv[1], ": must be 'off' or n where 1 <= n <= 1000000" );
+                return -1;
+            }
+        }
+
+        OBTAIN_INTLOCK( NULL );
+        sysblk.cpuloops_target = target;
+        for (i=0; i < sysblk.maxcpu; i++)
+        {
+            if (!(regs = sysblk.regs[i]))
+                continue;
+            regs->intpend_tod = 0;
+            if (!target)
+                regs->cpuloops = MAX_CPU_LOOPS/2;
+        }
+        RELEASE_INTLOCK( NULL );
+
+        if (MLVL( VERBOSE ))
+        {
+            if (target)
+                MSGBUF( buf, "%u usecs", target );
+            else
+                STRLCPY( buf, "OFF" );
+            // "%-14s set to %s"
+            WRMSG( HHC02204, "I", argv[0], buf );
+        }
+        return 0;
+    }
+
+    /* Display the current target and per-CPU statistics */
+    if (sysblk.cpuloops_target)
+        MSGBUF( buf, "%u usecs", sysblk.cpuloops_target );
+    else
+        MSGBUF( buf, "OFF (fixed interval of %d)", MAX_CPU_LOOPS );
+    // "%-14s: %s"
+    WRMSG( HHC02203, "I", argv[0], buf );
+
+    OBTAIN_INTLOCK( NULL );
+    for (i=0; i < sysblk.maxcpu; i++)
+    {
+        if (!IS_CPU_ONLINE( i ))
+            continue;
+        regs = sysblk.regs[i];
+        // "Processor %s%02X: interval %5d, interrupts %"PRIu64", latency avg %"PRIu64" max %"PRIu64" usecs"
+        WRMSG( HHC02288, "I", PTYPSTR( i ), i, regs->cpuloops * 2,
+            regs->intlat_count,
+            regs->intlat_count ? regs->intlat_total / regs->intlat_count : 0,
+            regs->intlat_max );
+    }
+    RELEASE_INTLOCK( NULL );
+
+    return 0;
+}
+
+
+/*-------------------------------------------------------------------*/
+/* pswprof helper: copy and sort the used PSW sample table entries   */
+/*-------------------------------------------------------------------*/
+static int pswprof_sort_cmp( const void* a, const void* b )
+{
+    const PSWSAMP*  sa = (const PSWSAMP*) a;
+    const PSWSAMP*  sb = (const PSWSAMP*) b;
+
+    if (sa->count != sb->count)
+        return sa->count < sb->count ? 1 : -1;
+    if (sa->key != sb->key)
+        return sa->key < sb->key ? -1 : 1;
+    return sa->ia < sb->ia ? -1 : sa->ia > sb->ia ? 1 : 0;
+}
+
+static PSWSAMP* pswprof_collect( int* num, PSWPROF* totals )
+{
+    PSWSAMP*  samp;
+    int       i, n = 0;
+
+    obtain_lock( &sysblk.pswproflock );
+
+    if (!sysblk.pswprof
+     || !(samp = malloc( (sysblk.pswprof->used + 1) * sizeof( PSWSAMP ))))
+    {
+        release_lock( &sysblk.pswproflock );
+        return NULL;
+    }
+
+    for (i=0; i < PSWPROF_SLOTS; i++)
+        if (sysblk.pswprof->tab[i].count)
+            samp[ n++ ] = sysblk.pswprof->tab[i];
+
+    totals->samples = sysblk.pswprof->samples;
+    totals->waits   = sysblk.pswprof->waits;
+    totals->drops   = sysblk.pswprof->drops;
+    totals->used    = sysblk.pswprof->used;
+
+    release_lock( &sysblk.pswproflock );
+
+    qsort( samp, n, sizeof( PSWSAMP ), pswprof_sort_cmp );
+    *num = n;
+    return samp;
+}
+
+/*-------------------------------------------------------------------*/
+/* pswprof helper: format one sample as flame graph stack frames     */
+/*-------------------------------------------------------------------*/
+static void pswprof_frames( PSWSAMP* samp, char* buf, size_t bufsz )
+{
+    BYTE  flags = PSWPROF_FLAGS( samp->key );
+
+    snprintf( buf, bufsz, "%s%02X;%s%s;ASN_%04X;IA_%0*"PRIX64,
+        PTYPSTR( PSWPROF_CPU( samp->key )), PSWPROF_CPU( samp->key ),
+        (flags & PSWPROF_SIE)  ? "SIE;" : "",
+        (flags & PSWPROF_PROB) ? "PROB" : "SUP",
+        PSWPROF_ASN( samp->key ),
+        samp->ia > 0xFFFFFFFF ? 16 : 8, samp->ia );
+}
+
+/*-------------------------------------------------------------------*/
+/* pswprof helper: write the samples to a file                       */
+/*                                                                   */
+/* 'folded' writes one "frame;frame;... count" line per sample, the  */
+/* input expected by flamegraph.pl and speedscope. Otherwise writes  */
+/* the gperftools legacy binary CPU profile read by pprof, with the  */
+/* guest instruction address standing in for the program counter.   */
+/*-------------------------------------------------------------------*/
+static int pswprof_export( const char* filename, bool folded )
+{
+    PSWSAMP*  samp;
+    PSWPROF   totals;
+    FILE*     f;
+    U64       rec[5];
+    char      buf[64];
+    int       i, num;
+
+    if (!(samp = pswprof_collect( &num, &totals )))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC02219, "E", "pswprof_collect()",
+            sysblk.pswprof ? strerror( errno ) : "no samples" );
+        return -1;
+    }
+
+    if (!(f = fopen( filename, folded ? "w" : "wb" )))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC02219, "E", "fopen()", strerror( errno ));
+        free( samp );
+        return -1;
+    }
+
+    if (folded)
+    {
+        for (i=0; i < num; i++)
+        {
+            pswprof_frames( &samp[i], buf, sizeof( buf ));
+            fprintf( f, "%s %"PRIu32"\n", buf, samp[i].count );
+        }
+        if (totals.waits)
+            fprintf( f, "WAIT %"PRIu64"\n", totals.waits );
+    }
+    else
+    {
+        /* Header: 0, header words, version, period (usecs), 0 */
+        rec[0] = 0; rec[1] = 3; rec[2] = 0;
+        rec[3] = sysblk.pswprof_intv ? sysblk.pswprof_intv
+                                     : DEF_PSWPROF_INTV;
+        rec[4] = 0;
+        fwrite( rec, sizeof( U64 ), 5, f );
+
+        /* Records: count, stack depth, pc */
+        for (i=0; i < num; i++)
+        {
+            rec[0] = samp[i].count; rec[1] = 1; rec[2] = samp[i].ia;
+            fwrite( rec, sizeof( U64 ), 3, f );
+        }
+
+        /* Trailer */
+        rec[0] = 0; rec[1] = 1; rec[2] = 0;
+        fwrite( rec, sizeof( U64 ), 3, f );
+    }
+
+    if (ferror( f ) | fclose( f ))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC02219, "E", "fwrite()", strerror( errno ));
+        free( samp );
+        return -1;
+    }
+
+    free( samp );
+
+    // "%s"
+    MSGBUF( buf, "%d entries written to %s", num, filename );
+    WRMSG( HHC02295, "I", buf );
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* pswprof command - PSW sampling profiler                           */
+/*-------------------------------------------------------------------*/
+int pswprof_cmd( int argc, char *argv[], char *cmdline )
+{
+    PSWSAMP*  samp;
+    PSWPROF   totals;
+    char      buf[128];
+    char      frames[64];
+    int       i, num;
+
+    UNREFERENCED( cmdline );
+
+    UPPER_ARGV_0( argv );
+
+    if (argc > 3)
+    {
+        // "Invalid command usage. Type 'help %s' for assistance."
+        WRMSG( HHC02299, "E", argv[0] );
+        return -1;
+    }
+
+    if (argc >= 2)
+    {
+        if (CMD( argv[1], ON, 2 ))
+        {
+            U32   intv = DEF_PSWPROF_INTV;
+            BYTE  c;
+
+            if (argc == 3
+                && (0
+                    || sscanf( argv[2], "%u%c", &intv, &c ) != 1
+                    || intv < 1
+                    || intv > 1000000
+                   )
+            )
+            {
+                // "Invalid argument %s%s"
+                WRMSG( HHC02205, "E", argv[2], ": must be n where 1 <= n <= 1000000" );
+                return -1;
+            }
+
+            obtain_lock( &sysblk.pswproflock );
+            if (!sysblk.pswprof && !(sysblk.pswprof = calloc( 1, sizeof( PSWPROF ))))
+            {
+                release_lock( &sysblk.pswproflock );
+                // "Error in function %s: %s"
+                WRMSG( HHC02219, "E", "calloc()", strerror( errno ));
+                return -1;
+            }
+            sysblk.pswprof->next = 0;
+            sysblk.pswprof_intv  = intv;
+            release_lock( &sysblk.pswproflock );
+
+            if (MLVL( VERBOSE ))
+            {
+                MSGBUF( buf, "ON, every %u usecs", intv );
+                // "%-14s set to %s"
+                WRMSG( HHC02204, "I", argv[0], buf );
+            }
+            return 0;
+        }
+
+        if (argc == 2 && CMD( argv[1], OFF, 3 ))
+        {
+            sysblk.pswprof_intv = 0;
+            if (MLVL( VERBOSE ))
+                // "%-14s set to %s"
+                WRMSG( HHC02204, "I", argv[0], "OFF" );
+            return 0;
+        }
+
+        if (argc == 2 && CMD( argv[1], RESET, 5 ))
+        {
+            obtain_lock( &sysblk.pswproflock );
+            if (sysblk.pswprof)
+            {
+                if (sysblk.pswprof_intv)
+                    memset( sysblk.pswprof, 0, sizeof( PSWPROF ));
+                else
+                {
+                    free( sysblk.pswprof );
+                    sysblk.pswprof = NULL;
+                }
+            }
+            release_lock( &sysblk.pswproflock );
+            // "%s"
+            WRMSG( HHC02268, "I", "Done!" );
+            return 0;
+        }
+
+        if (argc == 3 && CMD( argv[1], FOLDED, 4 ))
+            return pswprof_export( argv[2], true );
+
+        if (argc == 3 && CMD( argv[1], PPROF, 5 ))
+            return pswprof_export( argv[2], false );
+
+        // "Invalid command usage. Type 'help %s' for assistance."
+        WRMSG( HHC02299, "E", argv[0] );
+        return -1;
+    }
+
+    /* Display the current state and the hottest addresses */
+    if (sysblk.pswprof_intv)
+        MSGBUF( buf, "ON, every %u usecs", sysblk.pswprof_intv );
+    else
+        STRLCPY( buf, "OFF" );
+    // "%-14s: %s"
+    WRMSG( HHC02203, "I", argv[0], buf );
+
+    if (!(samp = pswprof_collect( &num, &totals )))
+        return 0;
+
+    MSGBUF( buf, "%"PRIu64" samples, %"PRIu64" waiting, %"PRIu64" dropped,"
+        " %"PRIu32" distinct", totals.samples, totals.waits, totals.drops,
+        totals.used );
+    // "%s"
+    WRMSG( HHC02295, "I", buf );
+
+    for (i=0; i < num && i < 10; i++)
+    {
+        pswprof_frames( &samp[i], frames, sizeof( frames ));
+        MSGBUF( buf, "%10"PRIu32" %5.1f%%  %s", samp[i].count,
+            (100.0 * samp[i].count) / (totals.samples ? totals.samples : 1),
+            frames );
+        // "%s"
+        WRMSG( HHC02295, "I", buf );
+    }
+
+    free( samp );
+    return 0;
+}
+
 
 /* format_tod - generate displayable date from TOD value */
 /* always uses epoch of 1900 */
@@ -0,0 +1,990 @@
+/* HSIMD.C      (C) and others 2026                                  */
+/*              Host SIMD kernels                                    */
+/*                                                                   */
+/*   Released under "The Q Public License Version 1"                 */
+/*   (http://www.hercules-390.org/herclic.html) as modifications to  */
+/*   Hercules.                                                       */
+
+/*-------------------------------------------------------------------*/
+/* This module contains the SSE2 and AVX2 versions of the bulk data  */
+/* loops used by the instruction emulation, and hsimd_init which     */
+/* selects the set to be used according to the host CPU's features.  */
+/* Each kernel is compiled for its own instruction set by way of a   */
+/* target attribute, so the build needs no special compiler options  */
+/* and the kernels are never called on a host which lacks them.      */
+/*-------------------------------------------------------------------*/
+
+#include "hstdinc.h"
+
+#define _HSIMD_C_
+#define _HENGINE_DLL_
+
+#include "hercules.h"
+
+#if defined( HSIMD_X86 )
+  #include <immintrin.h>
+#endif
+
+DLL_EXPORT int        hsimd_level   = HSIMD_NONE;
+DLL_EXPORT HSIMDCPY*  hsimd_concpy  = NULL;
+DLL_EXPORT HSIMDCMP*  hsimd_memneq  = NULL;
+DLL_EXPORT HSIMDCMP*  hsimd_memeq   = NULL;
+DLL_EXPORT HSIMDCMP*  hsimd_memneqr = NULL;
+DLL_EXPORT HSIMDCHR*  hsimd_memchr  = NULL;
+DLL_EXPORT HSIMDCHR*  hsimd_memchr2 = NULL;
+DLL_EXPORT HSIMDTRT*  hsimd_trt     = NULL;
+DLL_EXPORT HSIMDTRT*  hsimd_trtr    = NULL;
+DLL_EXPORT HSIMDTR*   hsimd_tr      = NULL;
+DLL_EXPORT HSIMDSUM*  hsimd_cksm    = NULL;
+
+DLL_EXPORT HSIMDAES*    hsimd_aes_enc   = NULL;
+DLL_EXPORT HSIMDAES*    hsimd_aes_dec   = NULL;
+DLL_EXPORT HSIMDAESC*   hsimd_aes_cbce  = NULL;
+DLL_EXPORT HSIMDAESC*   hsimd_aes_cbcd  = NULL;
+DLL_EXPORT HSIMDAESCTR* hsimd_aes_ctr   = NULL;
+DLL_EXPORT HSIMDSHA*    hsimd_sha1      = NULL;
+DLL_EXPORT HSIMDSHA*    hsimd_sha256    = NULL;
+DLL_EXPORT HSIMDGHASH*  hsimd_ghash     = NULL;
+
+#if defined( HSIMD_X86 )
+
+/*-------------------------------------------------------------------*/
+/* Position of the lowest / highest one bit of a nonzero mask        */
+/*-------------------------------------------------------------------*/
+#if defined( _MSVC_ )
+static INLINE int lowbit( U32 m )
+{
+    unsigned long  i;
+    _BitScanForward( &i, m );
+    return (int) i;
+}
+static INLINE int highbit( U32 m )
+{
+    unsigned long  i;
+    _BitScanReverse( &i, m );
+    return (int) i;
+}
+#else
+#define lowbit( _m )    __builtin_ctz( _m )
+#define highbit( _m )   (31 - __builtin_clz( _m ))
+#endif
+
+/*-------------------------------------------------------------------*/
+/* concpy kernels. The destination is 8-byte aligned on entry and is */
+/* brought to the vector width with single doubleword moves, so that */
+/* every vector store is aligned and no doubleword is ever split.    */
+/* Each vector is loaded before it is stored, which together with    */
+/* the HSIMD_CONCPY_DIST restriction preserves MVC ripple semantics. */
+/*-------------------------------------------------------------------*/
+HSIMD_TARGET( "sse2" )
+static size_t concpy_sse2( BYTE* d, const BYTE* s, size_t n )
+{
+    size_t  done  = 0;
+
+    while (((uintptr_t) d & 15) && n >= 8)
+    {
+        _mm_storel_epi64( (__m128i*) d, _mm_loadl_epi64( (const __m128i*) s ));
+        d += 8; s += 8; n -= 8; done += 8;
+    }
+
+    while (n >= 64)
+    {
+        _mm_store_si128( (__m128i*) (d +  0), _mm_loadu_si128( (const __m128i*) (s +  0) ));
+        _mm_store_si128( (__m128i*) (d + 16), _mm_loadu_si128( (const __m128i*) (s + 16) ));
+        _mm_store_si128( (__m128i*) (d + 32), _mm_loadu_si128( (const __m128i*) (s + 32) ));
+        _mm_store_si128( (__m128i*) (d + 48), _mm_loadu_si128( (const __m128i*) (s + 48) ));
+        d += 64; s += 64; n -= 64; done += 64;
+    }
+
+    while (n >= 16)
+    {
+        _mm_store_si128( (__m128i*) d, _mm_loadu_si128( (const __m128i*) s ));
+        d += 16; s += 16; n -= 16; done += 16;
+    }
+
+    return done;
+}
+
+HSIMD_TARGET( "avx2" )
+static size_t concpy_avx2( BYTE* d, const BYTE* s, size_t n )
+{
+    size_t  done  = 0;
+
+    while (((uintptr_t) d & 31) && n >= 8)
+    {
+        _mm_storel_epi64( (__m128i*) d, _mm_loadl_epi64( (const __m128i*) s ));
+        d += 8; s += 8; n -= 8; done += 8;
+    }
+
+    while (n >= 128)
+    {
+        _mm256_store_si256( (__m256i*) (d +  0), _mm256_loadu_si256( (const __m256i*) (s +  0) ));
+        _mm256_store_si256( (__m256i*) (d + 32), _mm256_loadu_si256( (const __m256i*) (s + 32) ));
+        _mm256_store_si256( (__m256i*) (d + 64), _mm256_loadu_si256( (const __m256i*) (s + 64) ));
+        _mm256_store_si256( (__m256i*) (d + 96), _mm256_loadu_si256( (const __m256i*) (s + 96) ));
+        d += 128; s += 128; n -= 128; done += 128;
+    }
+
+    while (n >= 32)
+    {
+        _mm256_store_si256( (__m256i*) d, _mm256_loadu_si256( (const __m256i*) s ));
+        d += 32; s += 32; n -= 32; done += 32;
+    }
+
+    return done;
+}
+
+/*-------------------------------------------------------------------*/
+/* Compare and search kernels. Each vector yields a mask with one    */
+/* bit per byte that is set where the byte is what is searched for;  */
+/* the first (or for the reverse scans the last) set bit locates it. */
+/* The bytes short of a whole vector are done one at a time.         */
+/*-------------------------------------------------------------------*/
+HSIMD_TARGET( "sse2" )
+static size_t memneq_sse2( const BYTE* a, const BYTE* b, size_t n )
+{
+    size_t  i  = 0;
+    U32     m;
+
+    for (; n - i >= 16; i += 16)
+    {
+        m = 0xFFFF ^ _mm_movemask_epi8( _mm_cmpeq_epi8(
+            _mm_loadu_si128( (const __m128i*) (a + i) ),
+            _mm_loadu_si128( (const __m128i*) (b + i) )));
+        if (m)
+            return i + lowbit( m );
+    }
+    while (i < n && a[i] == b[i])
+        i++;
+    return i;
+}
+
+HSIMD_TARGET( "sse2" )
+static size_t memeq_sse2( const BYTE* a, const BYTE* b, size_t n )
+{
+    size_t  i  = 0;
+    U32     m;
+
+    for (; n - i >= 16; i += 16)
+    {
+        m = _mm_movemask_epi8( _mm_cmpeq_epi8(
+            _mm_loadu_si128( (const __m128i*) (a + i) ),
+            _mm_loadu_si128( (const __m128i*) (b + i) )));
+        if (m)
+            return i + lowbit( m );
+    }
+    while (i < n && a[i] != b[i])
+        i++;
+    return i;
+}
+
+HSIMD_TARGET( "sse2" )
+static size_t memneqr_sse2( const BYTE* a, const BYTE* b, size_t n )
+{
+    size_t  k  = 0;
+    U32     m;
+
+    for (; n - k >= 16; k += 16)
+    {
+        m = 0xFFFF ^ _mm_movemask_epi8( _mm_cmpeq_epi8(
+            _mm_loadu_si128( (const __m128i*) (a + n - k - 16) ),
+            _mm_loadu_si128( (const __m128i*) (b + n - k - 16) )));
+        if (m)
+            return k + 15 - highbit( m );
+    }
+    while (k < n && a[n-1-k] == b[n-1-k])
+        k++;
+    return k;
+}
+
+HSIMD_TARGET( "sse2" )
+static size_t memchr_sse2( const BYTE* p, U32 c, size_t n )
+{
+    __m128i  v  = _mm_set1_epi8( (char) c );
+    size_t   i  = 0;
+    U32      m;
+
+    for (; n - i >= 16; i += 16)
+    {
+        m = _mm_movemask_epi8( _mm_cmpeq_epi8( v,
+            _mm_loadu_si128( (const __m128i*) (p + i) )));
+        if (m)
+            return i + lowbit( m );
+    }
+    while (i < n && p[i] != (BYTE) c)
+        i++;
+    return i;
+}
+
+HSIMD_TARGET( "sse2" )
+static size_t memchr2_sse2( const BYTE* p, U32 c, size_t n )
+{
+    /* The halfwords are compared as loaded, i.e. byte swapped */
+    __m128i  v  = _mm_set1_epi16( (short) (((c & 0xFF) << 8) | ((c >> 8) & 0xFF)) );
+    size_t   i  = 0;
+    U32      m;
+
+    for (; n - i >= 8; i += 8)
+    {
+        m = _mm_movemask_epi8( _mm_cmpeq_epi16( v,
+            _mm_loadu_si128( (const __m128i*) (p + 2*i) )));
+        if (m)
+            return i + lowbit( m ) / 2;
+    }
+    while (i < n && fetch_hw( p + 2*i ) != (U16) c)
+        i++;
+    return i;
+}
+
+/*-------------------------------------------------------------------*/
+/* Checksum kernel: the fullwords are byte swapped and widened into  */
+/* 64-bit lanes, which cannot overflow for any operand that fits in  */
+/* storage, so the end-around carry is left to the caller.           */
+/*-------------------------------------------------------------------*/
+HSIMD_TARGET( "sse2" )
+static U64 cksm_sse2( const BYTE* p, size_t n )
+{
+    __m128i  zero  = _mm_setzero_si128();
+    __m128i  acc   = zero;
+    __m128i  v;
+    U64      sum[2];
+    size_t   i     = 0;
+
+    for (; n - i >= 4; i += 4)
+    {
+        v = _mm_loadu_si128( (const __m128i*) (p + 4*i) );
+        v = _mm_or_si128(
+                _mm_or_si128( _mm_slli_epi32( v, 24 ), _mm_srli_epi32( v, 24 )),
+                _mm_or_si128( _mm_and_si128( _mm_slli_epi32( v, 8 ), _mm_set1_epi32( 0x00FF0000 )),
+                              _mm_and_si128( _mm_srli_epi32( v, 8 ), _mm_set1_epi32( 0x0000FF00 ))));
+        acc = _mm_add_epi64( acc, _mm_unpacklo_epi32( v, zero ));
+        acc = _mm_add_epi64( acc, _mm_unpackhi_epi32( v, zero ));
+    }
+    _mm_storeu_si128( (__m128i*) sum, acc );
+    sum[0] += sum[1];
+    for (; i < n; i++)
+        sum[0] += fetch_fw( p + 4*i );
+    return sum[0];
+}
+
+HSIMD_TARGET( "avx2" )
+static size_t memneq_avx2( const BYTE* a, const BYTE* b, size_t n )
+{
+    size_t  i  = 0;
+    U32     m;
+
+    for (; n - i >= 32; i += 32)
+    {
+        m = ~(U32) _mm256_movemask_epi8( _mm256_cmpeq_epi8(
+            _mm256_loadu_si256( (const __m256i*) (a + i) ),
+            _mm256_loadu_si256( (const __m256i*) (b + i) )));
+        if (m)
+            return i + lowbit( m );
+    }
+    while (i < n && a[i] == b[i])
+        i++;
+    return i;
+}
+
+HSIMD_TARGET( "avx2" )
+static size_t memeq_avx2( const BYTE* a, const BYTE* b, size_t n )
+{
+    size_t  i  = 0;
+    U32     m;
+
+    for (; n - i >= 32; i += 32)
+    {
+        m = (U32) _mm256_movemask_epi8( _mm256_cmpeq_epi8(
+            _mm256_loadu_si256( (const __m256i*) (a + i) ),
+            _mm256_loadu_si256( (const __m256i*) (b + i) )));
+        if (m)
+            return i + lowbit( m );
+    }
+    while (i < n && a[i] != b[i])
+        i++;
+    return i;
+}
+
+HSIMD_TARGET( "avx2" )
+static size_t memneqr_avx2( const BYTE* a, const BYTE* b, size_t n )
+{
+    size_t  k  = 0;
+    U32     m;
+
+    for (; n - k >= 32; k += 32)
+    {
+        m = ~(U32) _mm256_movemask_epi8( _mm256_cmpeq_epi8(
+            _mm256_loadu_si256( (const __m256i*) (a + n - k - 32) ),
+            _mm256_loadu_si256( (const __m256i*) (b + n - k - 32) )));
+        if (m)
+            return k + 31 - highbit( m );
+    }
+    while (k < n && a[n-1-k] == b[n-1-k])
+        k++;
+    return k;
+}
+
+HSIMD_TARGET( "avx2" )
+static size_t memchr_avx2( const BYTE* p, U32 c, size_t n )
+{
+    __m256i  v  = _mm256_set1_epi8( (char) c );
+    size_t   i  = 0;
+    U32      m;
+
+    for (; n - i >= 32; i += 32)
+    {
+        m = (U32) _mm256_movemask_epi8( _mm256_cmpeq_epi8( v,
+            _mm256_loadu_si256( (const __m256i*) (p + i) )));
+        if (m)
+            return i + lowbit( m );
+    }
+    while (i < n && p[i] != (BYTE) c)
+        i++;
+    return i;
+}
+
+HSIMD_TARGET( "avx2" )
+static size_t memchr2_avx2( const BYTE* p, U32 c, size_t n )
+{
+    /* The halfwords are compared as loaded, i.e. byte swapped */
+    __m256i  v  = _mm256_set1_epi16( (short) (((c & 0xFF) << 8) | ((c >> 8) & 0xFF)) );
+    size_t   i  = 0;
+    U32      m;
+
+    for (; n - i >= 16; i += 16)
+    {
+        m = (U32) _mm256_movemask_epi8( _mm256_cmpeq_epi16( v,
+            _mm256_loadu_si256( (const __m256i*) (p + 2*i) )));
+        if (m)
+            return i + lowbit( m ) / 2;
+    }
+    while (i < n && fetch_hw( p + 2*i ) != (U16) c)
+        i++;
+    return i;
+}
+
+/*-------------------------------------------------------------------*/
+/* Translate and test kernels. The table is first reduced to a 256   */
+/* bit map of its nonzero entries, held as two 16-byte rows indexed  */
+/* by the low four bits of an argument byte, with one bit for each   */
+/* value of the high four bits (0-7 in the first row, 8-15 in the    */
+/* second). Each vector of argument bytes is then tested with three  */
+/* byte shuffles: one into each row and one for the bit to test.     */
+/*-------------------------------------------------------------------*/
+typedef struct TRTMAP
+{
+    __m256i  lorow;                     /* Bits for high nibble 0-7  */
+    __m256i  hirow;                     /* Bits for high nibble 8-15 */
+    __m256i  bit;                       /* 1 << (high nibble & 7)    */
+}
+TRTMAP;
+
+HSIMD_TARGET( "avx2" )
+static void trt_map( TRTMAP* map, const BYTE* tab )
+{
+    __m128i  zero   = _mm_setzero_si128();
+    __m128i  lorow  = zero;
+    __m128i  hirow  = zero;
+    __m128i  nz;
+    int      h;
+
+    for (h=0; h < 16; h++)
+    {
+        nz = _mm_cmpeq_epi8( _mm_loadu_si128( (const __m128i*) (tab + 16*h) ), zero );
+        nz = _mm_andnot_si128( nz, _mm_set1_epi8( (char) (1 << (h & 7)) ));
+        if (h < 8) lorow = _mm_or_si128( lorow, nz );
+        else       hirow = _mm_or_si128( hirow, nz );
+    }
+    map->lorow = _mm256_broadcastsi128_si256( lorow );
+    map->hirow = _mm256_broadcastsi128_si256( hirow );
+    map->bit   = _mm256_setr_epi8( 1, 2, 4, 8, 16, 32, 64, -128,
+                                   1, 2, 4, 8, 16, 32, 64, -128,
+                                   1, 2, 4, 8, 16, 32, 64, -128,
+                                   1, 2, 4, 8, 16, 32, 64, -128 );
+}
+
+/* Return the mask of the bytes at p whose table entry is nonzero */
+HSIMD_TARGET( "avx2" )
+static INLINE U32 trt_test( const TRTMAP* map, const BYTE* p )
+{
+    __m256i  nib  = _mm256_set1_epi8( 0x0F );
+    __m256i  v    = _mm256_loadu_si256( (const __m256i*) p );
+    __m256i  lo   = _mm256_and_si256( v, nib );
+    __m256i  hi   = _mm256_and_si256( _mm256_srli_epi16( v, 4 ), nib );
+    __m256i  row;
+
+    row = _mm256_blendv_epi8( _mm256_shuffle_epi8( map->lorow, lo ),
+                              _mm256_shuffle_epi8( map->hirow, lo ),
+                              _mm256_cmpgt_epi8( hi, _mm256_set1_epi8( 7 )));
+    row = _mm256_and_si256( row, _mm256_shuffle_epi8( map->bit, hi ));
+    return ~(U32) _mm256_movemask_epi8( _mm256_cmpeq_epi8( row, _mm256_setzero_si256() ));
+}
+
+HSIMD_TARGET( "avx2" )
+static size_t trt_avx2( const BYTE* p, const BYTE* tab, size_t n )
+{
+    TRTMAP  map;
+    size_t  i  = 0;
+    U32     m;
+
+    trt_map( &map, tab );
+
+    for (; n - i >= 32; i += 32)
+        if ((m = trt_test( &map, p + i )))
+            return i + lowbit( m );
+
+    while (i < n && !tab[ p[i] ])
+        i++;
+    return i;
+}
+
+HSIMD_TARGET( "avx2" )
+static size_t trtr_avx2( const BYTE* p, const BYTE* tab, size_t n )
+{
+    TRTMAP  map;
+    size_t  k  = 0;
+    U32     m;
+
+    trt_map( &map, tab );
+
+    for (; n - k >= 32; k += 32)
+        if ((m = trt_test( &map, p + n - k - 32 )))
+            return k + 31 - highbit( m );
+
+    while (k < n && !tab[ p[n-1-k] ])
+        k++;
+    return k;
+}
+
+/*-------------------------------------------------------------------*/
+/* Translate kernel. Each 16-byte slice of the table is a shuffle    */
+/* control for the argument bytes' low four bits; adding X'70' with  */
+/* unsigned saturation to an argument byte less the slice's origin   */
+/* leaves the high bit off only for the bytes within that slice, so  */
+/* that the shuffle zeroes all the others and the sixteen results    */
+/* can simply be ORed together.                                      */
+/*-------------------------------------------------------------------*/
+HSIMD_TARGET( "avx2" )
+static void tr_avx2( BYTE* p, const BYTE* tab, size_t n )
+{
+    __m256i  slice[16];
+    __m256i  bias  = _mm256_set1_epi8( 0x70 );
+    __m256i  step  = _mm256_set1_epi8( 0x10 );
+    __m256i  v, x, r;
+    size_t   i     = 0;
+    int      k;
+
+    for (k=0; k < 16; k++)
+        slice[k] = _mm256_broadcastsi128_si256(
+                       _mm_loadu_si128( (const __m128i*) (tab + 16*k) ));
+
+    for (; n - i >= 32; i += 32)
+    {
+        v = _mm256_loadu_si256( (const __m256i*) (p + i) );
+        r = _mm256_setzero_si256();
+        for (k=0; k < 16; k++)
+        {
+            x = _mm256_adds_epu8( v, bias );
+            r = _mm256_or_si256( r, _mm256_shuffle_epi8( slice[k], x ));
+            v = _mm256_sub_epi8( v, step );
+        }
+        _mm256_storeu_si256( (__m256i*) (p + i), r );
+    }
+
+    for (; i < n; i++)
+        p[i] = tab[ p[i] ];
+}
+
+HSIMD_TARGET( "avx2" )
+static U64 cksm_avx2( const BYTE* p, size_t n )
+{
+    __m256i  swap  = _mm256_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                       3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+    __m256i  zero  = _mm256_setzero_si256();
+    __m256i  acc   = zero;
+    __m256i  v;
+    U64      sum[4];
+    size_t   i     = 0;
+
+    for (; n - i >= 8; i += 8)
+    {
+        v   = _mm256_shuffle_epi8( _mm256_loadu_si256( (const __m256i*) (p + 4*i) ), swap );
+        acc = _mm256_add_epi64( acc, _mm256_unpacklo_epi32( v, zero ));
+        acc = _mm256_add_epi64( acc, _mm256_unpackhi_epi32( v, zero ));
+    }
+    _mm256_storeu_si256( (__m256i*) sum, acc );
+    sum[0] += sum[1] + sum[2] + sum[3];
+    for (; i < n; i++)
+        sum[0] += fetch_fw( p + 4*i );
+    return sum[0];
+}
+
+/*-------------------------------------------------------------------*/
+/* AES kernels. The round keys are loaded once per call; ECB, CTR    */
+/* and CBC decryption run four independent blocks through the rounds */
+/* together to hide the latency of AESENC/AESDEC, while CBC          */
+/* encryption is serial by nature.                                   */
+/*-------------------------------------------------------------------*/
+#define AES_ROUNDS4( _op, _k, _nr, _b0, _b1, _b2, _b3 )              \
+    do {                                                              \
+        int  _r;                                                      \
+        _b0 = _mm_xor_si128( _b0, (_k)[0] );                          \
+        _b1 = _mm_xor_si128( _b1, (_k)[0] );                          \
+        _b2 = _mm_xor_si128( _b2, (_k)[0] );                          \
+        _b3 = _mm_xor_si128( _b3, (_k)[0] );                          \
+        for (_r = 1; _r < (_nr); _r++)                                \
+        {                                                             \
+            _b0 = _mm_##_op##_si128( _b0, (_k)[_r] );                 \
+            _b1 = _mm_##_op##_si128( _b1, (_k)[_r] );                 \
+            _b2 = _mm_##_op##_si128( _b2, (_k)[_r] );                 \
+            _b3 = _mm_##_op##_si128( _b3, (_k)[_r] );                 \
+        }                                                             \
+        _b0 = _mm_##_op##last_si128( _b0, (_k)[_nr] );                \
+        _b1 = _mm_##_op##last_si128( _b1, (_k)[_nr] );                \
+        _b2 = _mm_##_op##last_si128( _b2, (_k)[_nr] );                \
+        _b3 = _mm_##_op##last_si128( _b3, (_k)[_nr] );                \
+    } while (0)
+
+#define AES_ROUNDS1( _op, _k, _nr, _b )                               \
+    do {                                                              \
+        int  _r;                                                      \
+        _b = _mm_xor_si128( _b, (_k)[0] );                            \
+        for (_r = 1; _r < (_nr); _r++)                                \
+            _b = _mm_##_op##_si128( _b, (_k)[_r] );                   \
+        _b = _mm_##_op##last_si128( _b, (_k)[_nr] );                  \
+    } while (0)
+
+#define LOAD( _p )          _mm_loadu_si128( (const __m128i*) (_p) )
+#define STORE( _p, _v )     _mm_storeu_si128( (__m128i*) (_p), (_v) )
+
+HSIMD_TARGET( "aes" )
+static void aes_load_keys( __m128i* k, const BYTE* rk, int nr )
+{
+    int  r;
+
+    for (r = 0; r <= nr; r++)
+        k[r] = LOAD( rk + 16*r );
+}
+
+HSIMD_TARGET( "aes" )
+static void aes_enc_ni( const BYTE* rk, int nr, const BYTE* in, BYTE* out, size_t n )
+{
+    __m128i  k[15], b0, b1, b2, b3;
+
+    aes_load_keys( k, rk, nr );
+    for (; n >= 4; n -= 4, in += 64, out += 64)
+    {
+        b0 = LOAD( in      ); b1 = LOAD( in + 16 );
+        b2 = LOAD( in + 32 ); b3 = LOAD( in + 48 );
+        AES_ROUNDS4( aesenc, k, nr, b0, b1, b2, b3 );
+        STORE( out,      b0 ); STORE( out + 16, b1 );
+        STORE( out + 32, b2 ); STORE( out + 48, b3 );
+    }
+    for (; n; n--, in += 16, out += 16)
+    {
+        b0 = LOAD( in );
+        AES_ROUNDS1( aesenc, k, nr, b0 );
+        STORE( out, b0 );
+    }
+}
+
+HSIMD_TARGET( "aes" )
+static void aes_dec_ni( const BYTE* rk, int nr, const BYTE* in, BYTE* out, size_t n )
+{
+    __m128i  k[15], b0, b1, b2, b3;
+
+    aes_load_keys( k, rk, nr );
+    for (; n >= 4; n -= 4, in += 64, out += 64)
+    {
+        b0 = LOAD( in      ); b1 = LOAD( in + 16 );
+        b2 = LOAD( in + 32 ); b3 = LOAD( in + 48 );
+        AES_ROUNDS4( aesdec, k, nr, b0, b1, b2, b3 );
+        STORE( out,      b0 ); STORE( out + 16, b1 );
+        STORE( out + 32, b2 ); STORE( out + 48, b3 );
+    }
+    for (; n; n--, in += 16, out += 16)
+    {
+        b0 = LOAD( in );
+        AES_ROUNDS1( aesdec, k, nr, b0 );
+        STORE( out, b0 );
+    }
+}
+
+HSIMD_TARGET( "aes" )
+static void aes_cbce_ni( const BYTE* rk, int nr, BYTE* cv, const BYTE* in, BYTE* out, size_t n )
+{
+    __m128i  k[15], b;
+
+    aes_load_keys( k, rk, nr );
+    b = LOAD( cv );
+    for (; n; n--, in += 16, out += 16)
+    {
+        b = _mm_xor_si128( b, LOAD( in ));
+        AES_ROUNDS1( aesenc, k, nr, b );
+        STORE( out, b );
+    }
+    STORE( cv, b );
+}
+
+HSIMD_TARGET( "aes" )
+static void aes_cbcd_ni( const BYTE* rk, int nr, BYTE* cv, const BYTE* in, BYTE* out, size_t n )
+{
+    __m128i  k[15], c, c0, c1, c2, c3, b0, b1, b2, b3;
+
+    aes_load_keys( k, rk, nr );
+    c = LOAD( cv );
+    for (; n >= 4; n -= 4, in += 64, out += 64)
+    {
+        b0 = c0 = LOAD( in      ); b1 = c1 = LOAD( in + 16 );
+        b2 = c2 = LOAD( in + 32 ); b3 = c3 = LOAD( in + 48 );
+        AES_ROUNDS4( aesdec, k, nr, b0, b1, b2, b3 );
+        STORE( out,      _mm_xor_si128( b0, c  ));
+        STORE( out + 16, _mm_xor_si128( b1, c0 ));
+        STORE( out + 32, _mm_xor_si128( b2, c1 ));
+        STORE( out + 48, _mm_xor_si128( b3, c2 ));
+        c = c3;
+    }
+    for (; n; n--, in += 16, out += 16)
+    {
+        b0 = c0 = LOAD( in );
+        AES_ROUNDS1( aesdec, k, nr, b0 );
+        STORE( out, _mm_xor_si128( b0, c ));
+        c = c0;
+    }
+    STORE( cv, c );
+}
+
+HSIMD_TARGET( "aes" )
+static void aes_ctr_ni( const BYTE* rk, int nr, const BYTE* ctr, const BYTE* in, BYTE* out, size_t n )
+{
+    __m128i  k[15], b0, b1, b2, b3;
+
+    aes_load_keys( k, rk, nr );
+    for (; n >= 4; n -= 4, ctr += 64, in += 64, out += 64)
+    {
+        b0 = LOAD( ctr      ); b1 = LOAD( ctr + 16 );
+        b2 = LOAD( ctr + 32 ); b3 = LOAD( ctr + 48 );
+        AES_ROUNDS4( aesenc, k, nr, b0, b1, b2, b3 );
+        b0 = _mm_xor_si128( b0, LOAD( in      ));
+        b1 = _mm_xor_si128( b1, LOAD( in + 16 ));
+        b2 = _mm_xor_si128( b2, LOAD( in + 32 ));
+        b3 = _mm_xor_si128( b3, LOAD( in + 48 ));
+        STORE( out,      b0 ); STORE( out + 16, b1 );
+        STORE( out + 32, b2 ); STORE( out + 48, b3 );
+    }
+    for (; n; n--, ctr += 16, in += 16, out += 16)
+    {
+        b0 = LOAD( ctr );
+        AES_ROUNDS1( aesenc, k, nr, b0 );
+        STORE( out, _mm_xor_si128( b0, LOAD( in )));
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* SHA kernels. The message words are big-endian; SHA-1 keeps a, b,  */
+/* c and d in one register in reverse order and e in the top lane of */
+/* another, SHA-256 keeps the state as ABEF and CDGH halves as the   */
+/* SHA256RNDS2 instruction wants it. The SHA instructions only have  */
+/* legacy SSE encodings, so when the compiler emits VEX code the     */
+/* upper register halves are cleared first, else every switch        */
+/* between the two encodings costs a state transition.               */
+/*-------------------------------------------------------------------*/
+#if defined( __AVX__ )
+  #define SHA_ENTRY()       _mm256_zeroupper()
+#else
+  #define SHA_ENTRY()       do {} while (0)
+#endif
+
+HSIMD_TARGET( "sha,sse4.1" )
+static void sha1_ni( U32* state, const BYTE* p, size_t n )
+{
+    __m128i  swap  = _mm_set_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+    __m128i  abcd, e, prev, abcd_save, e_save, m[4];
+    int      i;
+
+    SHA_ENTRY();
+    abcd = _mm_shuffle_epi32( LOAD( state ), 0x1B );
+    e    = _mm_set_epi32( (int) state[4], 0, 0, 0 );
+
+    for (; n; n--, p += 64)
+    {
+        abcd_save = abcd;
+        e_save    = e;
+        prev      = abcd;
+
+        for (i = 0; i < 20; i++)
+        {
+            if (i < 4)
+                m[i] = _mm_shuffle_epi8( LOAD( p + 16*i ), swap );
+            else
+                m[i & 3] = _mm_sha1msg2_epu32(
+                           _mm_xor_si128( _mm_sha1msg1_epu32( m[i & 3], m[(i+1) & 3] ),
+                                          m[(i+2) & 3] ),
+                           m[(i+3) & 3] );
+
+            e    = i ? _mm_sha1nexte_epu32( prev, m[i & 3] )
+                     : _mm_add_epi32( e, m[0] );
+            prev = abcd;
+
+            /* (the round function must be an immediate operand) */
+            switch (i / 5)
+            {
+                case 0:  abcd = _mm_sha1rnds4_epu32( abcd, e, 0 ); break;
+                case 1:  abcd = _mm_sha1rnds4_epu32( abcd, e, 1 ); break;
+                case 2:  abcd = _mm_sha1rnds4_epu32( abcd, e, 2 ); break;
+                default: abcd = _mm_sha1rnds4_epu32( abcd, e, 3 ); break;
+            }
+        }
+
+        e    = _mm_sha1nexte_epu32( prev, e_save );
+        abcd = _mm_add_epi32( abcd, abcd_save );
+    }
+
+    STORE( state, _mm_shuffle_epi32( abcd, 0x1B ));
+    state[4] = (U32) _mm_extract_epi32( e, 3 );
+}
+
+static const U32 sha256_k[64] =
+{
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+
+HSIMD_TARGET( "sha,sse4.1" )
+static void sha256_ni( U32* state, const BYTE* p, size_t n )
+{
+    __m128i  swap  = _mm_set_epi8( 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3 );
+    __m128i  abef, cdgh, abef_save, cdgh_save, t, m[4];
+    int      i;
+
+    SHA_ENTRY();
+    t    = _mm_shuffle_epi32( LOAD( state     ), 0xB1 );     /* CDAB */
+    cdgh = _mm_shuffle_epi32( LOAD( state + 4 ), 0x1B );     /* EFGH */
+    abef = _mm_alignr_epi8( t, cdgh, 8 );                    /* ABEF */
+    cdgh = _mm_blend_epi16( cdgh, t, 0xF0 );                 /* CDGH */
+
+    for (; n; n--, p += 64)
+    {
+        abef_save = abef;
+        cdgh_save = cdgh;
+
+        for (i = 0; i < 16; i++)
+        {
+            if (i < 4)
+                m[i] = _mm_shuffle_epi8( LOAD( p + 16*i ), swap );
+            else
+                m[i & 3] = _mm_sha256msg2_epu32(
+                           _mm_add_epi32( _mm_sha256msg1_epu32( m[i & 3], m[(i+1) & 3] ),
+                                          _mm_alignr_epi8( m[(i+3) & 3], m[(i+2) & 3], 4 )),
+                           m[(i+3) & 3] );
+
+            t    = _mm_add_epi32( m[i & 3], LOAD( sha256_k + 4*i ));
+            cdgh = _mm_sha256rnds2_epu32( cdgh, abef, t );
+            abef = _mm_sha256rnds2_epu32( abef, cdgh, _mm_shuffle_epi32( t, 0x0E ));
+        }
+
+        abef = _mm_add_epi32( abef, abef_save );
+        cdgh = _mm_add_epi32( cdgh, cdgh_save );
+    }
+
+    t    = _mm_shuffle_epi32( abef, 0x1B );                  /* FEBA */
+    cdgh = _mm_shuffle_epi32( cdgh, 0xB1 );                  /* DCHG */
+    STORE( state,     _mm_blend_epi16( t, cdgh, 0xF0 ));     /* DCBA */
+    STORE( state + 4, _mm_alignr_epi8( cdgh, t, 8 ));        /* HGFE */
+}
+
+/*-------------------------------------------------------------------*/
+/* GHASH kernel. GCM numbers the bits of a block from the left, so   */
+/* the blocks are byte reversed to make the carry-less product come  */
+/* out one bit short of the reflected result, which is then shifted  */
+/* left one bit and reduced modulo x^128 + x^7 + x^2 + x + 1.        */
+/*-------------------------------------------------------------------*/
+HSIMD_TARGET( "pclmul,ssse3" )
+static __m128i ghash_mult( __m128i a, __m128i b )
+{
+    __m128i  lo, hi, mid, t1, t2, t3;
+
+    lo  = _mm_clmulepi64_si128( a, b, 0x00 );
+    hi  = _mm_clmulepi64_si128( a, b, 0x11 );
+    mid = _mm_xor_si128( _mm_clmulepi64_si128( a, b, 0x10 ),
+                         _mm_clmulepi64_si128( a, b, 0x01 ));
+    lo  = _mm_xor_si128( lo, _mm_slli_si128( mid, 8 ));
+    hi  = _mm_xor_si128( hi, _mm_srli_si128( mid, 8 ));
+
+    /* Shift the 256-bit product hi:lo left one bit */
+    t1 = _mm_srli_epi32( lo, 31 );
+    t2 = _mm_srli_epi32( hi, 31 );
+    lo = _mm_slli_epi32( lo, 1 );
+    hi = _mm_slli_epi32( hi, 1 );
+    t3 = _mm_srli_si128( t1, 12 );
+    t2 = _mm_slli_si128( t2, 4 );
+    t1 = _mm_slli_si128( t1, 4 );
+    lo = _mm_or_si128( lo, t1 );
+    hi = _mm_or_si128( hi, t2 );
+    hi = _mm_or_si128( hi, t3 );
+
+    /* Reduce */
+    t1 = _mm_xor_si128( _mm_xor_si128( _mm_slli_epi32( lo, 31 ),
+                                       _mm_slli_epi32( lo, 30 )),
+                                       _mm_slli_epi32( lo, 25 ));
+    t2 = _mm_srli_si128( t1, 4 );
+    lo = _mm_xor_si128( lo, _mm_slli_si128( t1, 12 ));
+    t3 = _mm_xor_si128( _mm_xor_si128( _mm_srli_epi32( lo, 1 ),
+                                       _mm_srli_epi32( lo, 2 )),
+                                       _mm_srli_epi32( lo, 7 ));
+    t3 = _mm_xor_si128( t3, t2 );
+    lo = _mm_xor_si128( lo, t3 );
+    return _mm_xor_si128( hi, lo );
+}
+
+HSIMD_TARGET( "pclmul,ssse3" )
+static void ghash_clmul( BYTE* x, const BYTE* h, const BYTE* p, size_t n )
+{
+    __m128i  swap  = _mm_set_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+    __m128i  hv    = _mm_shuffle_epi8( LOAD( h ), swap );
+    __m128i  xv    = _mm_shuffle_epi8( LOAD( x ), swap );
+
+    for (; n; n--, p += 16)
+        xv = ghash_mult( _mm_xor_si128( xv, _mm_shuffle_epi8( LOAD( p ), swap )), hv );
+
+    STORE( x, _mm_shuffle_epi8( xv, swap ));
+}
+
+#undef LOAD
+#undef STORE
+#undef SHA_ENTRY
+
+#endif // defined( HSIMD_X86 )
+
+/*-------------------------------------------------------------------*/
+/* Return the name of a HSIMD_xxx kernel set                         */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT const char* hsimd_name( int level )
+{
+    switch (level)
+    {
+        case HSIMD_SSE2:  return "SSE2";
+        case HSIMD_AVX2:  return "AVX2";
+        default:          return "NONE";
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* Select the kernel set to be used: HSIMD_BEST picks the best one   */
+/* the host supports. Returns the level now in effect, or -1 if the  */
+/* host does not support the requested level (nothing is changed).   */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT int hsimd_init( int level )
+{
+#if defined( HSIMD_X86 )
+    int  best  = hostinfo.cpu_avx2 ? HSIMD_AVX2
+               : hostinfo.cpu_sse2 ? HSIMD_SSE2
+               :                     HSIMD_NONE;
+#else
+    int  best  = HSIMD_NONE;
+#endif
+
+    if (level == HSIMD_BEST)
+        level = best;
+    else if (level < HSIMD_NONE || level > best)
+        return -1;
+
+    switch (level)
+    {
+#if defined( HSIMD_X86 )
+        case HSIMD_AVX2:
+            hsimd_concpy  = concpy_avx2;
+            hsimd_memneq  = memneq_avx2;
+            hsimd_memeq   = memeq_avx2;
+            hsimd_memneqr = memneqr_avx2;
+            hsimd_memchr  = memchr_avx2;
+            hsimd_memchr2 = memchr2_avx2;
+            hsimd_trt     = trt_avx2;
+            hsimd_trtr    = trtr_avx2;
+            hsimd_tr      = tr_avx2;
+            hsimd_cksm    = cksm_avx2;
+            break;
+
+        case HSIMD_SSE2:
+            /* (translation needs byte shuffles, which SSE2 lacks) */
+            hsimd_concpy  = concpy_sse2;
+            hsimd_memneq  = memneq_sse2;
+            hsimd_memeq   = memeq_sse2;
+            hsimd_memneqr = memneqr_sse2;
+            hsimd_memchr  = memchr_sse2;
+            hsimd_memchr2 = memchr2_sse2;
+            hsimd_trt     = NULL;
+            hsimd_trtr    = NULL;
+            hsimd_tr      = NULL;
+            hsimd_cksm    = cksm_sse2;
+            break;
+#endif
+        default:
+            hsimd_concpy  = NULL;
+            hsimd_memneq  = NULL;
+            hsimd_memeq   = NULL;
+            hsimd_memneqr = NULL;
+            hsimd_memchr  = NULL;
+            hsimd_memchr2 = NULL;
+            hsimd_trt     = NULL;
+            hsimd_trtr    = NULL;
+            hsimd_tr      = NULL;
+            hsimd_cksm    = NULL;
+            break;
+    }
+
+    /* The crypto kernels go with any of the kernel sets, as far as
+       the host has the instructions they are built around */
+    hsimd_aes_enc  = NULL;
+    hsimd_aes_dec  = NULL;
+    hsimd_aes_cbce = NULL;
+    hsimd_aes_cbcd = NULL;
+    hsimd_aes_ctr  = NULL;
+    hsimd_sha1     = NULL;
+    hsimd_sha256   = NULL;
+    hsimd_ghash    = NULL;
+
+#if defined( HSIMD_X86 )
+    if (level != HSIMD_NONE)
+    {
+        if (hostinfo.cpu_aes_extns)
+        {
+            hsimd_aes_enc  = aes_enc_ni;
+            hsimd_aes_dec  = aes_dec_ni;
+            hsimd_aes_cbce = aes_cbce_ni;
+            hsimd_aes_cbcd = aes_cbcd_ni;
+            hsimd_aes_ctr  = aes_ctr_ni;
+        }
+        if (hostinfo.cpu_sha_extns)
+        {
+            hsimd_sha1     = sha1_ni;
+            hsimd_sha256   = sha256_ni;
+        }
+        if (hostinfo.cpu_pclmul)
+            hsimd_ghash    = ghash_clmul;
+    }
+#endif
+
+    hsimd_level = level;
+    return level;
+}
+
+/*-------------------------------------------------------------------*/
+/* Return the names of the crypto kernels in use                     */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT const char* hsimd_crypto_name( void )
+{
+    static char  name[32];
+
+    name[0] = 0;
+    if (hsimd_aes_enc) STRLCAT( name, " AES" );
+    if (hsimd_sha1)    STRLCAT( name, " SHA" );
+    if (hsimd_ghash)   STRLCAT( name, " GHASH" );
+    return name[0] ? name + 1 : "NONE";
+}
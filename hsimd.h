@@ -0,0 +1,137 @@
+/* HSIMD.H      (C) and others 2026                                  */
+/*              Host SIMD kernels                                    */
+/*                                                                   */
+/*   Released under "The Q Public License Version 1"                 */
+/*   (http://www.hercules-390.org/herclic.html) as modifications to  */
+/*   Hercules.                                                       */
+
+/*-------------------------------------------------------------------*/
+/* The host SIMD kernels are bulk data loops written with SSE2 or    */
+/* AVX2 intrinsics, which the instructions that move, compare, scan  */
+/* or translate long operands call for each page segment. The best   */
+/* set the host CPU supports is selected by hsimd_init at startup    */
+/* (or by the 'simd' command) and called through the function        */
+/* pointers below; a NULL pointer means that no kernel is available  */
+/* and the caller uses its own scalar loop.                          */
+/*-------------------------------------------------------------------*/
+
+#ifndef _HSIMD_H_
+#define _HSIMD_H_
+
+/*-------------------------------------------------------------------*/
+/* Hosts for which the kernels exist. Modules which use intrinsics   */
+/* of their own (the vector facility for one) include <immintrin.h>  */
+/* themselves and mark the functions which use them HSIMD_TARGET.    */
+/*-------------------------------------------------------------------*/
+#if defined( __x86_64__ ) || defined( __i386__ ) || \
+    defined( _M_X64     ) || defined( _M_IX86   )
+  #define HSIMD_X86
+#endif
+
+#if defined( __GNUC__ )
+  #define HSIMD_TARGET( _isa )  __attribute__(( target( _isa )))
+#else
+  #define HSIMD_TARGET( _isa )
+#endif
+
+#define HSIMD_NONE          0           /* Scalar code only          */
+#define HSIMD_SSE2          1           /* 16-byte SSE2 kernels      */
+#define HSIMD_AVX2          2           /* 32-byte AVX2 kernels      */
+#define HSIMD_BEST        (-1)          /* Best the host supports    */
+
+/*-------------------------------------------------------------------*/
+/* concpy kernel: copies the largest multiple of 8 bytes of an 8-byte*/
+/* aligned destination that it can, left to right, with every        */
+/* aligned doubleword stored as a unit. It must only be used when    */
+/* the source is ahead of the destination or HSIMD_CONCPY_DIST or    */
+/* more bytes behind it, so that a destructive overlap still ripples */
+/* exactly as a byte at a time move would. Returns bytes copied.     */
+/*-------------------------------------------------------------------*/
+#define HSIMD_CONCPY_MIN    64          /* Shortest move worth it    */
+#define HSIMD_CONCPY_DIST   32          /* Widest kernel store       */
+
+typedef size_t HSIMDCPY( BYTE* d, const BYTE* s, size_t n );
+
+/*-------------------------------------------------------------------*/
+/* Scan kernels. Each returns the number of bytes (halfwords for     */
+/* memchr2) it passed over before finding what it looks for, or n    */
+/* if it did not find it. The "r" kernels scan from the end of the   */
+/* operand towards its start, so that a result k < n designates the  */
+/* byte at p[n-1-k]. None of them store anything.                    */
+/*                                                                   */
+/*   memneq    first byte where a and b differ                       */
+/*   memeq     first byte where a and b are equal                    */
+/*   memneqr   last byte where a and b differ                        */
+/*   memchr    first byte equal to c                                 */
+/*   memchr2   first big-endian halfword equal to c (any alignment)  */
+/*   trt       first byte whose entry in the 256-byte table is       */
+/*             nonzero                                               */
+/*   trtr      last byte whose entry in the table is nonzero         */
+/*                                                                   */
+/* tr translates n bytes in place through a 256-byte table which     */
+/* must not overlap them. cksm returns the 64-bit sum of the n       */
+/* big-endian fullwords at p, with no end-around carry applied.      */
+/*-------------------------------------------------------------------*/
+#define HSIMD_SCAN_MIN      32          /* Shortest scan worth it    */
+
+typedef size_t HSIMDCMP( const BYTE* a, const BYTE* b, size_t n );
+typedef size_t HSIMDCHR( const BYTE* p, U32 c, size_t n );
+typedef size_t HSIMDTRT( const BYTE* p, const BYTE* tab, size_t n );
+typedef void   HSIMDTR ( BYTE* p, const BYTE* tab, size_t n );
+typedef U64    HSIMDSUM( const BYTE* p, size_t n );
+
+/*-------------------------------------------------------------------*/
+/* Crypto kernels, used by the message-security-assist instructions  */
+/* for each page segment of their operands. They need the host's     */
+/* AES, SHA or PCLMULQDQ instructions besides SSE2, so each one is   */
+/* only set when the host has those too. n counts 16-byte blocks     */
+/* (64-byte blocks for SHA).                                         */
+/*                                                                   */
+/*   aes_enc   ECB encryption with the nr+1 round keys at rk, which  */
+/*             are the rijndael encryption key schedule words stored */
+/*             big-endian                                            */
+/*   aes_dec   ECB decryption with the rijndael decryption schedule  */
+/*             (the equivalent inverse cipher's, as AESDEC needs)    */
+/*   aes_cbce  CBC encryption; cv is updated to the last output      */
+/*   aes_cbcd  CBC decryption; cv is updated to the last input       */
+/*   aes_ctr   encrypts the n counters at ctr and XORs them into in  */
+/*   sha1      SHA-1 compression of state (host order words)         */
+/*   sha256    SHA-256 compression of state (host order words)       */
+/*   ghash     x = (x XOR block) * h in GF(2^128) for each block     */
+/*                                                                   */
+/* The output may be the same as an input, or lie anywhere before it */
+/* or clear of it, but not start within it past its first byte: the  */
+/* kernels work on several blocks at a time.                         */
+/*-------------------------------------------------------------------*/
+typedef void   HSIMDAES  ( const BYTE* rk, int nr, const BYTE* in, BYTE* out, size_t n );
+typedef void   HSIMDAESC ( const BYTE* rk, int nr, BYTE* cv, const BYTE* in, BYTE* out, size_t n );
+typedef void   HSIMDAESCTR( const BYTE* rk, int nr, const BYTE* ctr, const BYTE* in, BYTE* out, size_t n );
+typedef void   HSIMDSHA  ( U32* state, const BYTE* p, size_t n );
+typedef void   HSIMDGHASH( BYTE* x, const BYTE* h, const BYTE* p, size_t n );
+
+HSIMD_DLL_IMPORT int        hsimd_level;    /* HSIMD_xxx in use      */
+HSIMD_DLL_IMPORT HSIMDCPY*  hsimd_concpy;   /* concpy kernel or NULL */
+HSIMD_DLL_IMPORT HSIMDCMP*  hsimd_memneq;   /* CLCL, CLCLE           */
+HSIMD_DLL_IMPORT HSIMDCMP*  hsimd_memeq;    /* CUSE                  */
+HSIMD_DLL_IMPORT HSIMDCMP*  hsimd_memneqr;  /* CUSE                  */
+HSIMD_DLL_IMPORT HSIMDCHR*  hsimd_memchr;   /* SRST, MVST, TRE       */
+HSIMD_DLL_IMPORT HSIMDCHR*  hsimd_memchr2;  /* SRSTU                 */
+HSIMD_DLL_IMPORT HSIMDTRT*  hsimd_trt;      /* TRT, TRTE             */
+HSIMD_DLL_IMPORT HSIMDTRT*  hsimd_trtr;     /* TRTR, TRTRE           */
+HSIMD_DLL_IMPORT HSIMDTR*   hsimd_tr;       /* TR, TRE               */
+HSIMD_DLL_IMPORT HSIMDSUM*  hsimd_cksm;     /* CKSM                  */
+
+HSIMD_DLL_IMPORT HSIMDAES*    hsimd_aes_enc;    /* KM                  */
+HSIMD_DLL_IMPORT HSIMDAES*    hsimd_aes_dec;    /* KM                  */
+HSIMD_DLL_IMPORT HSIMDAESC*   hsimd_aes_cbce;   /* KMC                 */
+HSIMD_DLL_IMPORT HSIMDAESC*   hsimd_aes_cbcd;   /* KMC                 */
+HSIMD_DLL_IMPORT HSIMDAESCTR* hsimd_aes_ctr;    /* KMCTR               */
+HSIMD_DLL_IMPORT HSIMDSHA*    hsimd_sha1;       /* KIMD, KLMD          */
+HSIMD_DLL_IMPORT HSIMDSHA*    hsimd_sha256;     /* KIMD, KLMD          */
+HSIMD_DLL_IMPORT HSIMDGHASH*  hsimd_ghash;      /* KIMD                */
+
+HSIMD_DLL_IMPORT int         hsimd_init( int level );
+HSIMD_DLL_IMPORT const char* hsimd_name( int level );
+HSIMD_DLL_IMPORT const char* hsimd_crypto_name( void );
+
+#endif // _HSIMD_H_
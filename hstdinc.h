@@ -179,6 +179,9 @@
 #ifdef HAVE_SYS_RESOURCE_H
   #include <sys/resource.h>
 #endif
+#ifdef HAVE_SYS_SYSCALL_H
+  #include <sys/syscall.h>
+#endif
 #ifdef HAVE_SYS_UN_H
   #include <sys/un.h>
 #endif
@@ -187,6 +187,11 @@ struct REGS {                           /* Processor registers       */
         U32     ar[16];                 /* Access registers          */
         U32     fpr[32];                /* FP registers              */
         U32     fpc;                    /* FP Control register       */
+#if defined( _FEATURE_129_ZVECTOR_FACILITY )
+        U64     vrl[32];                /* Vector regs bits 64-127   */
+        U64     vrh[16];                /* VR16-31 bits 0-63; those  */
+                                        /* of VR0-15 are the FPRs    */
+#endif
 
 #define GR_G(_r)     gr[(_r)].D
 #define GR_H(_r)     gr[(_r)].F.H.F       /* Fullword bits 0-31      */
@@ -286,6 +291,17 @@ struct REGS {                           /* Processor registers       */
         U64     waittime;               /* Wait time in interval     */
         U64     waittime_accumulated;   /* Wait time accumulated     */
 
+        int     cpuloops;               /* UNROLLED_EXECUTE pairs per
+                                           interrupt check; adjusted
+                                           by cpuloops_update() when
+                                           sysblk.cpuloops_target    */
+        U64     intpend_tod;            /* host_tod when an enabled
+                                           I/O or SIGP interrupt was
+                                           made pending; 0 = none    */
+        U64     intlat_count;           /* Latency samples taken     */
+        U64     intlat_total;           /* Total latency (us)        */
+        U64     intlat_max;             /* Maximum latency (us)      */
+
         CACHE_ALIGN
         DAT     dat;                    /* Fields for DAT use        */
 
@@ -361,6 +377,10 @@ struct REGS {                           /* Processor registers       */
 
         bool    sie_fld;                /* SIE2BK fld field provided */
 
+        U32     xpndnext;               /* Next sequential xstore blk*/
+        U16     xpndrun;                /* Sequential blocks moved   */
+        bool    xpndout;                /* Sequence is PGOUT's       */
+
         ALIGN_16
         U16     perc;                   /* PER code                  */
         RADR    peradr;                 /* PER address               */
@@ -532,22 +552,37 @@ struct REGS {                           /* Processor registers       */
 
         const INSTR_FUNC    *s370_runtime_opcode_xxxx,
                             *s370_runtime_opcode_e3________xx,
+                            *s370_runtime_opcode_e6________xx,
+                            *s370_runtime_opcode_e7________xx,
                             *s370_runtime_opcode_eb________xx,
                             *s370_runtime_opcode_ec________xx,
                             *s370_runtime_opcode_ed________xx;
 
         const INSTR_FUNC    *s390_runtime_opcode_xxxx,
                             *s390_runtime_opcode_e3________xx,
+                            *s390_runtime_opcode_e6________xx,
+                            *s390_runtime_opcode_e7________xx,
                             *s390_runtime_opcode_eb________xx,
                             *s390_runtime_opcode_ec________xx,
                             *s390_runtime_opcode_ed________xx;
 
         const INSTR_FUNC    *z900_runtime_opcode_xxxx,
                             *z900_runtime_opcode_e3________xx,
+                            *z900_runtime_opcode_e6________xx,
+                            *z900_runtime_opcode_e7________xx,
                             *z900_runtime_opcode_eb________xx,
                             *z900_runtime_opcode_ec________xx,
                             *z900_runtime_opcode_ed________xx;
 
+#if defined( OPTION_COMPACT_OPCODE_DISPATCH )
+        const INSTR_FUNC    *s370_runtime_opcode_xx,
+                            *s390_runtime_opcode_xx,
+                            *z900_runtime_opcode_xx;
+        const INSTR_FUNC* const *s370_runtime_opcode_xx_2nd,
+                            * const *s390_runtime_opcode_xx_2nd,
+                            * const *z900_runtime_opcode_xx_2nd;
+#endif
+
 #if !defined( OPTION_NO_E3_OPTINST )
         const INSTR_FUNC    *s370_runtime_opcode_e3_0______xx,
                             *s390_runtime_opcode_e3_0______xx,
@@ -556,7 +591,28 @@ struct REGS {                           /* Processor registers       */
 
      /* TLB - Translation lookaside buffer                           */
         unsigned int tlbID;             /* Validation identifier     */
+        unsigned int tlbIDlo;           /* Lowest still valid tlbID  */
+        unsigned int tlbIDmax;          /* Highest tlbID yet used    */
+        U64     tlbhits;                /* maddr_l TLB hits          */
+        U64     tlbmisses;              /* maddr_l TLB misses        */
         TLB     tlb;                    /* Translation lookaside buf */
+        TLBRMAP tlbrmap[ TLB_RMAP_BUCKETS ];  /* TLB reverse map     */
+        TLBLARGE tlblarge[ TLB_LARGE_N ];     /* Large frame TLB     */
+        unsigned int tlblargeID;        /* tlbID of newest large ent */
+        U64     tlblargefills;          /* Large frame entries made  */
+        U64     tlblargehits;           /* ... and TLB misses they   */
+                                        /*     resolved              */
+        volatile U32 tlbshootgen;       /* Shootdown request number  */
+        volatile U32 tlbshootack;       /* ... last one applied      */
+        RADR    tlbshootpfra;           /* ... page frame to purge   */
+        BYTE    tlbshootwhat;           /* ... TLB_SHOOT_xxx flags   */
+        BYTE    mainstripes;            /* Number of mainlocks held  */
+        U16     mainstripe[2];          /* ... and their indexes     */
+#if defined( _FEATURE_SIE )
+        TLBCTX  tlbctx[ TLB_CONTEXTS ]; /* SIE guest TLB contexts    */
+        U64     tlbctxuse;              /* SIE dispatches            */
+        U64     tlbctxhits;             /* ... reusing a TLB context */
+#endif
 
         BLOCK_TRAILER;                  /* Name of block  END        */
 };
@@ -627,6 +683,58 @@ enum OPERATION_MODE
     typedef unsigned qos_class_t;
 #endif
 
+#if defined( OPTION_INSTR_COUNT_AND_TIME )
+/*-------------------------------------------------------------------*/
+/* Per-CPU instruction counts (icount command, BEG_COUNT_INSTR)      */
+/*-------------------------------------------------------------------*/
+/* Slots are numbered by the IMAP_xx values in opcode.h             */
+/*-------------------------------------------------------------------*/
+struct IMAPS {
+        U64     count  [ IMAP_SLOTS ];  /* Execution count           */
+        U64     cycles [ IMAP_SLOTS ];  /* Sampled host cycles       */
+        U64     samples[ IMAP_SLOTS ];  /* Number of timed samples   */
+        U32     hist   [ IMAP_SLOTS ][ IMAP_HIST ]; /* Sampled cycles
+                                           histogram: bucket n counts
+                                           2**n to 2**(n+1)-1 cycles,
+                                           last bucket everything
+                                           above                     */
+        U64     start;                  /* host_cycles() at start    */
+        int     slot;                   /* Slot being timed or -1    */
+        U32     countdown;              /* Instrs until next sample  */
+};
+#endif // defined( OPTION_INSTR_COUNT_AND_TIME )
+
+/*-------------------------------------------------------------------*/
+/* PSW sampling profiler table (pswprof command, timer thread)       */
+/*-------------------------------------------------------------------*/
+/* Fixed size open addressing hash table keyed on the sampled        */
+/* instruction address plus the PSWSAMP 'key' (CPU number, state     */
+/* flags and primary ASN). A slot with a zero count is unused.       */
+/*-------------------------------------------------------------------*/
+struct PSWSAMP {
+        U64     ia;                     /* Sampled instruction addr  */
+        U32     key;                    /* CPU, flags and ASN        */
+#define PSWPROF_KEY( _cpu, _flags, _asn )                             \
+        (((U32)(_cpu) << 24) | ((U32)(_flags) << 16) | (U32)(_asn))
+#define PSWPROF_CPU( _key )     ((int)((_key) >> 24))
+#define PSWPROF_FLAGS( _key )   ((BYTE)((_key) >> 16))
+#define PSWPROF_ASN( _key )     ((U16)(_key))
+#define PSWPROF_PROB    0x01            /* Problem state             */
+#define PSWPROF_SIE     0x02            /* SIE guest                 */
+        U32     count;                  /* Number of samples         */
+};
+
+struct PSWPROF {
+#define PSWPROF_SLOTS   65536           /* Table size (power of 2)   */
+#define PSWPROF_PROBES  32              /* Max probes before drop    */
+        U64     samples;                /* Samples recorded          */
+        U64     waits;                  /* Samples of waiting CPUs   */
+        U64     drops;                  /* Samples lost (table full) */
+        U64     next;                   /* host_tod() of next sample */
+        U32     used;                   /* Slots in use              */
+        PSWSAMP tab[ PSWPROF_SLOTS ];   /* Sample table              */
+};
+
 /*-------------------------------------------------------------------*/
 /* System configuration block                                        */
 /*-------------------------------------------------------------------*/
@@ -659,10 +767,18 @@ struct SYSBLK {
         BYTE   *storkeys;               /* -> Main storage key array */
         u_int   lock_mainstor:1;        /* Request mainstor to lock  */
         u_int   mainstor_locked:1;      /* Main storage locked       */
+        BYTE    mainpages;              /* MAINPAGES_xxx requested   */
+        int     mainnode;               /* NUMA node or MAINNODE_xxx */
+        U64     mainpagesz;             /* Host page size obtained   */
+        const char* mainpagetype;       /* ... and its kind          */
+        BYTE   *dirtymap;               /* -> Changed 4K frame bitmap*/
+        U64     dirtytime;              /* TOD when dirtymap cleared */
         U32     xpndsize;               /* Expanded size in 4K pages */
         BYTE   *xpndstor;               /* -> Expanded storage       */
         u_int   lock_xpndstor:1;        /* Request xpndstor to lock  */
         u_int   xpndstor_locked:1;      /* Expanded storage locked   */
+        u_int   xpndstor_mapped:1;      /* Expanded storage is file  */
+        char   *xpndfile;               /* Expanded storage file     */
         U64     todstart;               /* Time of initialisation    */
         U64     cpuid;                  /* CPU identifier for STIDP  */
         U32     cpuserial;              /* CPU serial number         */
@@ -716,6 +832,7 @@ struct SYSBLK {
 
         COND    cpucond;                /* CPU config/deconfig cond  */
         LOCK    cpulock[ MAX_CPU_ENGS ];/* CPU lock               */
+        LOCK    tlbshootlock[ MAX_CPU_ENGS ]; /* TLB shootdown lock  */
 
 #if defined( _FEATURE_073_TRANSACT_EXEC_FACILITY )
 
@@ -824,10 +941,9 @@ atomic_update64( &sysblk.txf_stats[ contran ? 1 : 0 ].txf_ ## ctr, +1 )
 #endif
 #define LOCK_OWNER_NONE  0xFFFF
 #define LOCK_OWNER_OTHER 0xFFFE
-        U16     mainowner;              /* Mainlock owner            */
         U16     intowner;               /* Intlock owner             */
 
-        LOCK    mainlock;               /* Main storage lock         */
+        LOCK    mainlock[ MAINLOCK_STRIPES ]; /* Main storage locks  */
         LOCK    intlock;                /* Interrupt lock            */
         LOCK    iointqlk;               /* I/O Interrupt Queue lock  */
         LOCK    sigplock;               /* Signal processor lock     */
@@ -911,6 +1027,11 @@ atomic_update64( &sysblk.txf_stats[ contran ? 1 : 0 ].txf_ ## ctr, +1 )
 
         int     timerint;               /* microsecs timer interval  */
         int     cfg_timerint;           /* (value defined in config) */
+        U32     pswprof_intv;           /* PSW sampling interval in
+                                           microseconds (0 = off)    */
+#define DEF_PSWPROF_INTV        1000    /* Default pswprof interval  */
+        PSWPROF *pswprof;               /* PSW sample table or NULL  */
+        LOCK    pswproflock;            /* LOCK for pswprof table    */
         char   *pantitle;               /* Alt console panel title   */
 #if defined( OPTION_SCSI_TAPE )
         /* Access to all SCSI fields controlled by sysblk.stape_lock */
@@ -1020,6 +1141,10 @@ atomic_update64( &sysblk.txf_stats[ contran ? 1 : 0 ].txf_ ## ctr, +1 )
                 config_processed;       /* config file processed     */
         int     quitmout;               /* quit timeout value        */
         U32     ints_state;             /* Common Interrupts Status  */
+        U32     cpuloops_target;        /* Interrupt latency target
+                                           (us) for adaptive interrupt
+                                           check interval; 0 = fixed
+                                           MAX_CPU_LOOPS interval    */
         CPU_BITMAP config_mask;         /* Configured CPUs           */
         CPU_BITMAP started_mask;        /* Started CPUs              */
         CPU_BITMAP waiting_mask;        /* Waiting CPUs              */
@@ -1093,53 +1218,9 @@ atomic_update64( &sysblk.txf_stats[ contran ? 1 : 0 ].txf_ ## ctr, +1 )
 #if defined( OPTION_INSTR_COUNT_AND_TIME )
 
         bool    icount;                 /* true = enabled, else not. */
-        struct timeval start_time;      /* OPCODE start time         */
-
-        struct IMAPS {
-            U64 imap01[256];
-            U64 imapa4[256];
-            U64 imapa5[16];
-            U64 imapa6[256];
-            U64 imapa7[16];
-            U64 imapb2[256];
-            U64 imapb3[256];
-            U64 imapb9[256];
-            U64 imapc0[16];
-            U64 imapc2[16];
-            U64 imapc4[16];
-            U64 imapc6[16];
-            U64 imapc8[16];
-            U64 imape3[256];
-            U64 imape4[256];
-            U64 imape5[256];
-            U64 imape7[256];
-            U64 imapeb[256];
-            U64 imapec[256];
-            U64 imaped[256];
-            U64 imapxx[256];
-
-            U64 imap01T[256];
-            U64 imapa4T[256];
-            U64 imapa5T[16];
-            U64 imapa6T[256];
-            U64 imapa7T[16];
-            U64 imapb2T[256];
-            U64 imapb3T[256];
-            U64 imapb9T[256];
-            U64 imapc0T[16];
-            U64 imapc2T[16];
-            U64 imapc4T[16];
-            U64 imapc6T[16];
-            U64 imapc8T[16];
-            U64 imape3T[256];
-            U64 imape4T[256];
-            U64 imape5T[256];
-            U64 imape7T[256];
-            U64 imapebT[256];
-            U64 imapecT[256];
-            U64 imapedT[256];
-            U64 imapxxT[256];
-        } imaps;
+        U32     icount_sample;          /* Time one in every n instrs*/
+#define DEF_ICOUNT_SAMPLE       64      /* Default icount_sample     */
+        IMAPS*  imaps[ MAX_CPU_ENGS ];  /* Per-CPU instruction counts*/
 
 #endif // defined( OPTION_INSTR_COUNT_AND_TIME )
 
@@ -185,6 +185,9 @@ typedef struct SYSBLK    SYSBLK;    // System configuration block
 typedef struct REGS      REGS;      // CPU register context
 typedef struct VFREGS    VFREGS;    // Vector Facility Registers
 typedef struct ZPBLK     ZPBLK;     // Zone Parameter Block
+typedef struct IMAPS     IMAPS;     // Per-CPU instruction counts
+typedef struct PSWSAMP   PSWSAMP;   // PSW sampling profiler entry
+typedef struct PSWPROF   PSWPROF;   // PSW sampling profiler table
 typedef struct TELNET    TELNET;    // Telnet Control Block
 typedef struct DEVBLK    DEVBLK;    // Device configuration block
 typedef struct CHPBLK    CHPBLK;    // Channel Path config block
@@ -5555,6 +5555,590 @@ DEF_INST( divide_integer_bfp_short_reg )
     ieee_cond_trap( regs, ieee_trap_conds );
 }
 
+/*********************************************************************/
+/*        z/Architecture Vector Facility BFP instructions            */
+/*                                                                   */
+/*  The vector BFP instructions operate on the two long BFP elements */
+/*  of a vector register, or with the single element control (SE)    */
+/*  on element 0 only, in which case the rest of the result is zero. */
+/*  An IEEE exception enabled in the FPC masks is reported as a      */
+/*  vector processing exception whose VXC identifies the element;    */
+/*  the whole instruction is then suppressed. The flags of the other */
+/*  exceptions are set in the FPC once every element is done.        */
+/*********************************************************************/
+
+#if defined( _FEATURE_129_ZVECTOR_FACILITY ) && !defined( _IEEE_NONARCHDEP_ )
+
+#define VFP_SE( _m )    ((_m) & 0x08)   /* Single element control    */
+#define VFP_XC( _m )    ((_m) & 0x04)   /* IEEE inexact suppression  */
+
+static void vector_ieee_trap( REGS* regs, int element, BYTE vxc )
+{
+    regs->dxc = (element << 4) | vxc;
+    regs->fpc &= ~FPC_DXC;
+    regs->fpc |= ((U32)regs->dxc << FPC_DXC_SHIFT);
+    regs->program_interrupt( regs, PGM_VECTOR_PROCESSING_EXCEPTION );
+}
+
+/* Check the Softfloat exceptions of one element; traps if any is    */
+/* enabled, otherwise returns them for vector_ieee_flags to set.     */
+static U32 vector_ieee_element( REGS* regs, int element, bool xc )
+{
+    U32  flags = softfloat_exceptionFlags;
+    U32  traps;
+
+    if ((flags & softfloat_flag_tiny) && (regs->fpc & FPC_MASK_IMU))
+        flags |= softfloat_flag_underflow;
+    if (xc)
+        flags &= ~softfloat_flag_inexact;
+
+    traps = (regs->fpc & FPC_MASKS) & (flags << FPC_MASK_SHIFT);
+    if (traps)
+        vector_ieee_trap( regs, element,
+                traps & FPC_MASK_IMI ? VXC_IEEE_INVALID_OP :
+                traps & FPC_MASK_IMZ ? VXC_IEEE_DIV_ZERO   :
+                traps & FPC_MASK_IMO ? VXC_IEEE_OVERFLOW   :
+                traps & FPC_MASK_IMU ? VXC_IEEE_UNDERFLOW  :
+                                       VXC_IEEE_INEXACT    );
+
+    softfloat_exceptionFlags = 0;
+    return flags;
+}
+
+#define vector_ieee_flags( _regs, _flags )                              \
+                                                                        \
+    (_regs)->fpc |= ((_flags) << FPC_FLAG_SHIFT) & FPC_FLAGS
+
+#endif /* defined( _FEATURE_129_ZVECTOR_FACILITY ) && !defined( _IEEE_NONARCHDEP_ ) */
+
+#if defined( FEATURE_129_ZVECTOR_FACILITY )
+/* Program check unless the format is long BFP */
+#define VFP_FORMAT_CHECK( _fpf, _regs )                                 \
+                                                                        \
+    if ((_fpf) != 3)                                                    \
+        (_regs)->program_interrupt( (_regs), PGM_SPECIFICATION_EXCEPTION )
+
+/* Program check if invalid rounding method */
+#define VFP_RM_CHECK( _m, _regs )                                       \
+                                                                        \
+    if ((_m) > 7 || !map_valid_m3_values_FPX[ (_m) ])                   \
+        (_regs)->program_interrupt( (_regs), PGM_SPECIFICATION_EXCEPTION )
+
+/*-------------------------------------------------------------------*/
+/* E7E2 VFS   - VECTOR FP SUBTRACT                           [VRR-c] */
+/* E7E3 VFA   - VECTOR FP ADD                                [VRR-c] */
+/* E7E5 VFD   - VECTOR FP DIVIDE                             [VRR-c] */
+/* E7E7 VFM   - VECTOR FP MULTIPLY                           [VRR-c] */
+/*-------------------------------------------------------------------*/
+enum { VFP_ADD, VFP_SUB, VFP_MUL, VFP_DIV };
+
+static void ARCH_DEP( vector_fp_arith )( BYTE inst[], REGS* regs, int op )
+{
+    int        v1, v2, v3, m4, m5, m6;
+    int        i, n;
+    float64_t  op1, op2, ans;
+    U32        flags = 0;
+    VR         a, b, r;
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    VFP_FORMAT_CHECK( m4, regs );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    VR_D( r, 0 ) = VR_D( r, 1 ) = 0;
+    n = VFP_SE( m5 ) ? 1 : 2;
+
+    SET_SF_RM_FROM_FPC;
+    softfloat_exceptionFlags = 0;
+
+    for (i=0; i < n; i++)
+    {
+        op1.v = VR_D( a, i );
+        op2.v = VR_D( b, i );
+
+        switch (op)
+        {
+        case VFP_ADD: ans = f64_add( op1, op2 ); break;
+        case VFP_SUB: ans = f64_sub( op1, op2 ); break;
+        case VFP_MUL: ans = f64_mul( op1, op2 ); break;
+        default:      ans = f64_div( op1, op2 ); break;
+        }
+
+        flags |= vector_ieee_element( regs, i, false );
+        VR_D( r, i ) = ans.v;
+    }
+
+    vr_store( regs, v1, &r );
+    vector_ieee_flags( regs, flags );
+}
+
+DEF_INST( vector_fp_subtract ) { ARCH_DEP( vector_fp_arith )( inst, regs, VFP_SUB ); }
+DEF_INST( vector_fp_add )      { ARCH_DEP( vector_fp_arith )( inst, regs, VFP_ADD ); }
+DEF_INST( vector_fp_divide )   { ARCH_DEP( vector_fp_arith )( inst, regs, VFP_DIV ); }
+DEF_INST( vector_fp_multiply ) { ARCH_DEP( vector_fp_arith )( inst, regs, VFP_MUL ); }
+
+/*-------------------------------------------------------------------*/
+/* E78E VFMS  - VECTOR FP MULTIPLY AND SUBTRACT              [VRR-e] */
+/* E78F VFMA  - VECTOR FP MULTIPLY AND ADD                   [VRR-e] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_fp_multiply_add )( BYTE inst[], REGS* regs, bool sub )
+{
+    int        v1, v2, v3, v4, m5, m6;
+    int        i, n;
+    float64_t  op1, op2, op3, ans;
+    U32        flags = 0;
+    VR         a, b, c, r;
+
+    VRR_E( inst, regs, v1, v2, v3, v4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    VFP_FORMAT_CHECK( m6, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    vr_fetch( regs, v4, &c );
+    VR_D( r, 0 ) = VR_D( r, 1 ) = 0;
+    n = VFP_SE( m5 ) ? 1 : 2;
+
+    SET_SF_RM_FROM_FPC;
+    softfloat_exceptionFlags = 0;
+
+    for (i=0; i < n; i++)
+    {
+        op1.v = VR_D( a, i );
+        op2.v = VR_D( b, i );
+        op3.v = VR_D( c, i );
+
+        /* Multiply and subtract adds the negated addend */
+        if (sub && !FLOAT64_ISNAN( op3 ))
+            op3.v ^= 0x8000000000000000ULL;
+
+        ans = f64_mulAdd( op1, op2, op3 );
+
+        flags |= vector_ieee_element( regs, i, false );
+        VR_D( r, i ) = ans.v;
+    }
+
+    vr_store( regs, v1, &r );
+    vector_ieee_flags( regs, flags );
+}
+
+DEF_INST( vector_fp_multiply_and_subtract ) { ARCH_DEP( vector_fp_multiply_add )( inst, regs, true  ); }
+DEF_INST( vector_fp_multiply_and_add )      { ARCH_DEP( vector_fp_multiply_add )( inst, regs, false ); }
+
+/*-------------------------------------------------------------------*/
+/* E7CE VFSQ  - VECTOR FP SQUARE ROOT                        [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_square_root )
+{
+    int        v1, v2, m3, m4, m5;
+    int        i, n;
+    float64_t  op, ans;
+    U32        flags = 0;
+    VR         a, r;
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    VFP_FORMAT_CHECK( m3, regs );
+    UNREFERENCED( m5 );
+
+    vr_fetch( regs, v2, &a );
+    VR_D( r, 0 ) = VR_D( r, 1 ) = 0;
+    n = VFP_SE( m4 ) ? 1 : 2;
+
+    SET_SF_RM_FROM_FPC;
+    softfloat_exceptionFlags = 0;
+
+    for (i=0; i < n; i++)
+    {
+        op.v  = VR_D( a, i );
+        ans   = f64_sqrt( op );
+        flags |= vector_ieee_element( regs, i, false );
+        VR_D( r, i ) = ans.v;
+    }
+
+    vr_store( regs, v1, &r );
+    vector_ieee_flags( regs, flags );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7CC VFPSO - VECTOR FP PERFORM SIGN OPERATION             [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_perform_sign_operation )
+{
+    int        v1, v2, m3, m4, m5;
+    int        i, n;
+    U64        x;
+    VR         a, r;
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    VFP_FORMAT_CHECK( m3, regs );
+
+    if (m5 > 2)
+        regs->program_interrupt( regs, PGM_SPECIFICATION_EXCEPTION );
+
+    vr_fetch( regs, v2, &a );
+    VR_D( r, 0 ) = VR_D( r, 1 ) = 0;
+    n = VFP_SE( m4 ) ? 1 : 2;
+
+    /* No exceptions, even for signaling NaNs */
+    for (i=0; i < n; i++)
+    {
+        x = VR_D( a, i );
+        switch (m5)
+        {
+        case 0:  x ^=  0x8000000000000000ULL; break;  /* complement  */
+        case 1:  x |=  0x8000000000000000ULL; break;  /* negative    */
+        default: x &= ~0x8000000000000000ULL; break;  /* positive    */
+        }
+        VR_D( r, i ) = x;
+    }
+
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E74A VFTCI - VECTOR FP TEST DATA CLASS IMMEDIATE          [VRI-e] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_test_data_class_immediate )
+{
+    int        v1, v2, m4, m5;
+    U16        i3;
+    int        i, n, hits = 0;
+    float64_t  op;
+    VR         a, r;
+
+    VRI_E( inst, regs, v1, v2, i3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    VFP_FORMAT_CHECK( m4, regs );
+
+    vr_fetch( regs, v2, &a );
+    VR_D( r, 0 ) = VR_D( r, 1 ) = 0;
+    n = VFP_SE( m5 ) ? 1 : 2;
+
+    for (i=0; i < n; i++)
+    {
+        op.v = VR_D( a, i );
+        if (float64_class( op ) & i3)
+        {
+            VR_D( r, i ) = 0xFFFFFFFFFFFFFFFFULL;
+            hits++;
+        }
+    }
+
+    vr_store( regs, v1, &r );
+    regs->psw.cc = hits == n ? 0 : hits ? 1 : 3;
+}
+
+/*-------------------------------------------------------------------*/
+/* E7E8 VFCE  - VECTOR FP COMPARE EQUAL                      [VRR-c] */
+/* E7EA VFCHE - VECTOR FP COMPARE HIGH OR EQUAL              [VRR-c] */
+/* E7EB VFCH  - VECTOR FP COMPARE HIGH                       [VRR-c] */
+/*-------------------------------------------------------------------*/
+enum { VFP_CE, VFP_CHE, VFP_CH };
+
+static void ARCH_DEP( vector_fp_compare )( BYTE inst[], REGS* regs, int op )
+{
+    int        v1, v2, v3, m4, m5, m6;
+    int        i, n, hits = 0;
+    float64_t  op1, op2;
+    BYTE       cc;
+    bool       t;
+    U32        flags = 0;
+    VR         a, b, r;
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    VFP_FORMAT_CHECK( m4, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    VR_D( r, 0 ) = VR_D( r, 1 ) = 0;
+    n = VFP_SE( m5 ) ? 1 : 2;
+
+    softfloat_exceptionFlags = 0;
+
+    /* Quiet compares: only signaling NaNs are IEEE invalid */
+    for (i=0; i < n; i++)
+    {
+        op1.v = VR_D( a, i );
+        op2.v = VR_D( b, i );
+        cc    = FLOAT64_COMPARE( op1, op2 );
+        flags |= vector_ieee_element( regs, i, false );
+
+        switch (op)
+        {
+        case VFP_CE:  t = cc == 0;            break;
+        case VFP_CHE: t = cc == 0 || cc == 2; break;
+        default:      t = cc == 2;            break;
+        }
+        if (t)
+        {
+            VR_D( r, i ) = 0xFFFFFFFFFFFFFFFFULL;
+            hits++;
+        }
+    }
+
+    vr_store( regs, v1, &r );
+    vector_ieee_flags( regs, flags );
+
+    if (m6 & 0x1)
+        regs->psw.cc = hits == n ? 0 : hits ? 1 : 3;
+}
+
+DEF_INST( vector_fp_compare_equal )           { ARCH_DEP( vector_fp_compare )( inst, regs, VFP_CE  ); }
+DEF_INST( vector_fp_compare_high_or_equal )   { ARCH_DEP( vector_fp_compare )( inst, regs, VFP_CHE ); }
+DEF_INST( vector_fp_compare_high )            { ARCH_DEP( vector_fp_compare )( inst, regs, VFP_CH  ); }
+
+/*-------------------------------------------------------------------*/
+/* E7CA WFK   - VECTOR FP COMPARE AND SIGNAL SCALAR          [VRR-a] */
+/* E7CB WFC   - VECTOR FP COMPARE SCALAR                     [VRR-a] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_fp_scalar_compare )( BYTE inst[], REGS* regs, bool signal )
+{
+    int        v1, v2, m3, m4, m5;
+    float64_t  op1, op2;
+    BYTE       newcc;
+    U32        flags;
+    VR         a, b;
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    VFP_FORMAT_CHECK( m3, regs );
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    vr_fetch( regs, v1, &a );
+    vr_fetch( regs, v2, &b );
+    op1.v = VR_D( a, 0 );
+    op2.v = VR_D( b, 0 );
+
+    softfloat_exceptionFlags = 0;
+    newcc = signal ? FLOAT64_COMPARE_AND_SIGNAL( op1, op2 )
+                   : FLOAT64_COMPARE( op1, op2 );
+    flags = vector_ieee_element( regs, 0, false );
+
+    vector_ieee_flags( regs, flags );
+    regs->psw.cc = newcc;
+}
+
+DEF_INST( vector_fp_compare_and_signal_scalar ) { ARCH_DEP( vector_fp_scalar_compare )( inst, regs, true  ); }
+DEF_INST( vector_fp_compare_scalar )            { ARCH_DEP( vector_fp_scalar_compare )( inst, regs, false ); }
+
+/*-------------------------------------------------------------------*/
+/* E7C4 VFLL  - VECTOR FP LOAD LENGTHENED                    [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_load_lengthened )
+{
+    int        v1, v2, m3, m4, m5;
+    int        i, n;
+    float32_t  op;
+    float64_t  ans;
+    U32        flags = 0;
+    VR         a, r;
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m5 );
+
+    /* The source elements are short BFP */
+    if (m3 != 2)
+        regs->program_interrupt( regs, PGM_SPECIFICATION_EXCEPTION );
+
+    vr_fetch( regs, v2, &a );
+    VR_D( r, 0 ) = VR_D( r, 1 ) = 0;
+    n = VFP_SE( m4 ) ? 1 : 2;
+
+    softfloat_exceptionFlags = 0;
+
+    /* Word elements 0 and 2 become doubleword elements 0 and 1 */
+    for (i=0; i < n; i++)
+    {
+        op.v = VR_F( a, 2*i );
+        if (f32_isSignalingNaN( op ))
+        {
+            softfloat_exceptionFlags = softfloat_flag_invalid;
+            FLOAT32_MAKE_QNAN( op );
+        }
+        flags |= vector_ieee_element( regs, i, false );
+        ans = f32_to_f64( op );
+        VR_D( r, i ) = ans.v;
+    }
+
+    vr_store( regs, v1, &r );
+    vector_ieee_flags( regs, flags );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7C5 VFLR  - VECTOR FP LOAD ROUNDED                       [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_load_rounded )
+{
+    int        v1, v2, m3, m4, m5;
+    int        i, n;
+    float64_t  op;
+    float32_t  ans;
+    U32        flags = 0;
+    VR         a, r;
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    VFP_FORMAT_CHECK( m3, regs );
+    VFP_RM_CHECK( m5, regs );
+
+    vr_fetch( regs, v2, &a );
+    VR_D( r, 0 ) = VR_D( r, 1 ) = 0;
+    n = VFP_SE( m4 ) ? 1 : 2;
+
+    SET_SF_RM_FROM_MASK( m5 );
+    softfloat_exceptionFlags = 0;
+
+    /* Doubleword elements 0 and 1 become word elements 0 and 2 */
+    for (i=0; i < n; i++)
+    {
+        op.v  = VR_D( a, i );
+        ans   = f64_to_f32( op );
+        flags |= vector_ieee_element( regs, i, VFP_XC( m4 ) != 0 );
+        VR_F( r, 2*i ) = ans.v;
+    }
+
+    vr_store( regs, v1, &r );
+    vector_ieee_flags( regs, flags );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7C7 VFI   - VECTOR LOAD FP INTEGER                       [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_fp_integer )
+{
+    int        v1, v2, m3, m4, m5;
+    int        i, n;
+    float64_t  op;
+    U32        flags = 0;
+    VR         a, r;
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    VFP_FORMAT_CHECK( m3, regs );
+    VFP_RM_CHECK( m5, regs );
+
+    vr_fetch( regs, v2, &a );
+    VR_D( r, 0 ) = VR_D( r, 1 ) = 0;
+    n = VFP_SE( m4 ) ? 1 : 2;
+
+    SET_SF_RM_FROM_MASK( m5 );
+    softfloat_exceptionFlags = 0;
+
+    for (i=0; i < n; i++)
+    {
+        op.v  = VR_D( a, i );
+        op    = f64_roundToInt( op, softfloat_roundingMode, !VFP_XC( m4 ));
+        flags |= vector_ieee_element( regs, i, false );
+        VR_D( r, i ) = op.v;
+    }
+
+    vr_store( regs, v1, &r );
+    vector_ieee_flags( regs, flags );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7C1 VCDLG - VECTOR FP CONVERT FROM LOGICAL 64-BIT        [VRR-a] */
+/* E7C3 VCDG  - VECTOR FP CONVERT FROM FIXED 64-BIT          [VRR-a] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_fp_convert_from_fixed )( BYTE inst[], REGS* regs, bool logical )
+{
+    int        v1, v2, m3, m4, m5;
+    int        i, n;
+    float64_t  ans;
+    U32        flags = 0;
+    VR         a, r;
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    VFP_FORMAT_CHECK( m3, regs );
+    VFP_RM_CHECK( m5, regs );
+
+    vr_fetch( regs, v2, &a );
+    VR_D( r, 0 ) = VR_D( r, 1 ) = 0;
+    n = VFP_SE( m4 ) ? 1 : 2;
+
+    SET_SF_RM_FROM_MASK( m5 );
+    softfloat_exceptionFlags = 0;
+
+    for (i=0; i < n; i++)
+    {
+        ans = logical ? ui64_to_f64( VR_D( a, i ))
+                      : i64_to_f64( (S64) VR_D( a, i ));
+        flags |= vector_ieee_element( regs, i, VFP_XC( m4 ) != 0 );
+        VR_D( r, i ) = ans.v;
+    }
+
+    vr_store( regs, v1, &r );
+    vector_ieee_flags( regs, flags );
+}
+
+DEF_INST( vector_fp_convert_from_logical_64 ) { ARCH_DEP( vector_fp_convert_from_fixed )( inst, regs, true  ); }
+DEF_INST( vector_fp_convert_from_fixed_64 )   { ARCH_DEP( vector_fp_convert_from_fixed )( inst, regs, false ); }
+
+/*-------------------------------------------------------------------*/
+/* E7C0 VCLGD - VECTOR FP CONVERT TO LOGICAL 64-BIT          [VRR-a] */
+/* E7C2 VCGD  - VECTOR FP CONVERT TO FIXED 64-BIT            [VRR-a] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_fp_convert_to_fixed )( BYTE inst[], REGS* regs, bool logical )
+{
+    int        v1, v2, m3, m4, m5;
+    int        i, n;
+    float64_t  op;
+    U64        ans;
+    U32        flags = 0;
+    VR         a, r;
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    VFP_FORMAT_CHECK( m3, regs );
+    VFP_RM_CHECK( m5, regs );
+
+    vr_fetch( regs, v2, &a );
+    VR_D( r, 0 ) = VR_D( r, 1 ) = 0;
+    n = VFP_SE( m4 ) ? 1 : 2;
+
+    SET_SF_RM_FROM_MASK( m5 );
+    softfloat_exceptionFlags = 0;
+
+    for (i=0; i < n; i++)
+    {
+        op.v = VR_D( a, i );
+
+        /* NaN gives the maximum negative integer (zero if logical)  */
+        /* and IEEE invalid, as for the scalar convert instructions  */
+        if (FLOAT64_ISNAN( op ))
+        {
+            ans = logical ? 0 : 0x8000000000000000ULL;
+            softfloat_raiseFlags( softfloat_flag_invalid );
+        }
+        else if (logical)
+            ans = f64_to_ui64( op, softfloat_roundingMode, !VFP_XC( m4 ));
+        else
+            ans = (U64) f64_to_i64( op, softfloat_roundingMode, !VFP_XC( m4 ));
+
+        if ((softfloat_exceptionFlags & softfloat_flag_invalid) && !VFP_XC( m4 ))
+            softfloat_exceptionFlags |= softfloat_flag_inexact;
+
+        flags |= vector_ieee_element( regs, i, false );
+        VR_D( r, i ) = ans;
+    }
+
+    vr_store( regs, v1, &r );
+    vector_ieee_flags( regs, flags );
+}
+
+DEF_INST( vector_fp_convert_to_logical_64 ) { ARCH_DEP( vector_fp_convert_to_fixed )( inst, regs, true  ); }
+DEF_INST( vector_fp_convert_to_fixed_64 )   { ARCH_DEP( vector_fp_convert_to_fixed )( inst, regs, false ); }
+
+#endif /* defined( FEATURE_129_ZVECTOR_FACILITY ) */
+
 /*********************************************************************/
 /*  Some functions are 'generic' functions which are NOT dependent   */
 /*  upon any specific build architecture and thus only need to be    */
@@ -344,6 +344,18 @@
 
 /*----------------------------------------------------*/
 
+#ifndef    _HSIMD_C_
+  #ifndef  _HENGINE_DLL_
+    #define HSIMD_DLL_IMPORT        DLL_IMPORT
+  #else
+    #define HSIMD_DLL_IMPORT        extern
+  #endif
+#else
+  #define   HSIMD_DLL_IMPORT        DLL_EXPORT
+#endif
+
+/*----------------------------------------------------*/
+
 #ifndef    _HTTPSERV_C_
   #ifndef  _HENGINE_DLL_
     #define HTTP_DLL_IMPORT         DLL_IMPORT
@@ -847,6 +847,7 @@ int     rc, maxprio, minprio;
     sysblk.msglvl = DEFAULT_MLVL;
     sysblk.logoptnotime = 0;
     sysblk.logoptnodate = 1;
+    sysblk.mainnode = MAINNODE_ANY;
 
     sysblk.num_pfxs  = (int) strlen( DEF_CMDPREFIXES );
     sysblk.cmd_pfxs  = malloc( sysblk.num_pfxs );
@@ -893,6 +894,9 @@ int     rc, maxprio, minprio;
     /* Initialize 'hostinfo' BEFORE display_version is called */
     init_hostinfo( &hostinfo );
 
+    /* Select the best host SIMD kernels the host CPU supports */
+    hsimd_init( HSIMD_BEST );
+
 #ifdef _MSVC_
     /* Initialize sockets package */
     VERIFY( socket_init() == 0 );
@@ -997,6 +1001,10 @@ int     rc, maxprio, minprio;
     sysblk.txf_timerint = sysblk.timerint;
 #endif
 
+#if defined( OPTION_INSTR_COUNT_AND_TIME )
+    sysblk.icount_sample = DEF_ICOUNT_SAMPLE;
+#endif
+
 #if defined( _FEATURE_ECPSVM )
     sysblk.ecpsvm.available = 0;
     sysblk.ecpsvm.level = 20;
@@ -1046,7 +1054,6 @@ int     rc, maxprio, minprio;
     initialize_lock( &sysblk.bindlock );
     initialize_lock( &sysblk.config   );
     initialize_lock( &sysblk.todlock  );
-    initialize_lock( &sysblk.mainlock );
     initialize_lock( &sysblk.intlock  );
     initialize_lock( &sysblk.iointqlk );
     initialize_lock( &sysblk.sigplock );
@@ -1054,6 +1061,7 @@ int     rc, maxprio, minprio;
     initialize_lock( &sysblk.crwlock  );
     initialize_lock( &sysblk.ioqlock  );
     initialize_lock( &sysblk.dasdcache_lock );
+    initialize_lock( &sysblk.pswproflock );
 #if defined( _FEATURE_073_TRANSACT_EXEC_FACILITY )
     initialize_lock( &sysblk.rublock );
 #endif
@@ -1067,8 +1075,7 @@ int     rc, maxprio, minprio;
     initialize_lock( &sysblk.shrdtracelock );
 #endif
 
-    sysblk.mainowner = LOCK_OWNER_NONE;
-    sysblk.intowner  = LOCK_OWNER_NONE;
+    sysblk.intowner = LOCK_OWNER_NONE;
 
     /* Initialize thread creation attributes so all of hercules
        can use them at any time when they need to create_thread
@@ -1086,6 +1093,10 @@ int     rc, maxprio, minprio;
             initialize_lock( &sysblk.cpulock[i] );
             set_lock_name(   &sysblk.cpulock[i], buf );
 
+            MSGBUF( buf,    "&sysblk.tlbshootlock[%*d]", MAX_CPU_ENGS > 99 ? 3 : 2, i );
+            initialize_lock( &sysblk.tlbshootlock[i] );
+            set_lock_name(   &sysblk.tlbshootlock[i], buf );
+
 #if defined( _FEATURE_073_TRANSACT_EXEC_FACILITY )
             MSGBUF( buf,    "&sysblk.txf_lock[%*d]", MAX_CPU_ENGS > 99 ? 3 : 2, i );
             initialize_lock( &sysblk.txf_lock[i] );
@@ -1094,6 +1105,17 @@ int     rc, maxprio, minprio;
         }
     }
     initialize_condition( &sysblk.all_synced_cond );
+
+    /* Initialize main storage interlock table */
+    {
+        int i; char buf[32];
+        for (i=0; i < MAINLOCK_STRIPES; i++)
+        {
+            MSGBUF( buf,    "&sysblk.mainlock[%3d]", i );
+            initialize_lock( &sysblk.mainlock[i] );
+            set_lock_name(   &sysblk.mainlock[i], buf );
+        }
+    }
     initialize_condition( &sysblk.sync_done_cond );
 
     /* Copy length for regs */
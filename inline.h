@@ -294,6 +294,36 @@ inline int mult_logical_long( U64* high, U64* lo, U64 md, U64 mr )
     return 0;
 }
 
+#if defined( _FEATURE_129_ZVECTOR_FACILITY )
+/*-------------------------------------------------------------------*/
+/*                 Vector register file access                       */
+/*-------------------------------------------------------------------*/
+/* Bits 0-63 of VR0-VR15 are floating point registers 0-15 (a pair   */
+/* of fpr words each, FPR2I being r << 1 in z/Architecture); all the */
+/* other bits of the register file are in vrh and vrl.               */
+/*-------------------------------------------------------------------*/
+static inline void vr_fetch( REGS* regs, int v, VR* vr )
+{
+    VR_D( *vr, 0 ) = v < 16 ? ((U64) regs->fpr[ v << 1 ] << 32)
+                                   | regs->fpr[ (v << 1) + 1 ]
+                            : regs->vrh[ v - 16 ];
+    VR_D( *vr, 1 ) = regs->vrl[ v ];
+}
+
+static inline void vr_store( REGS* regs, int v, const VR* vr )
+{
+    if (v < 16)
+    {
+        regs->fpr[  v << 1      ] = (U32)(VR_D( *vr, 0 ) >> 32);
+        regs->fpr[ (v << 1) + 1 ] = (U32) VR_D( *vr, 0 );
+    }
+    else
+        regs->vrh[ v - 16 ] = VR_D( *vr, 0 );
+
+    regs->vrl[ v ] = VR_D( *vr, 1 );
+}
+#endif /* defined( _FEATURE_129_ZVECTOR_FACILITY ) */
+
 #endif // defined( _INLINE_H )
 
 /*-------------------------------------------------------------------*/
@@ -342,6 +372,12 @@ DAT_DLL_IMPORT BYTE* s370_logical_to_main_l( U32 addr, int arn, REGS* regs, int
 DAT_DLL_IMPORT BYTE* s390_logical_to_main_l( U32 addr, int arn, REGS* regs, int acctype, BYTE akey, size_t len );
 DAT_DLL_IMPORT BYTE* z900_logical_to_main_l( U64 addr, int arn, REGS* regs, int acctype, BYTE akey, size_t len );
 
+#if TLB_WAYS > 1
+DAT_DLL_IMPORT BYTE* s370_tlb_assoc_hit( U32 addr, int aea_crn, REGS* regs, int acctype, BYTE akey );
+DAT_DLL_IMPORT BYTE* s390_tlb_assoc_hit( U32 addr, int aea_crn, REGS* regs, int acctype, BYTE akey );
+DAT_DLL_IMPORT BYTE* z900_tlb_assoc_hit( U64 addr, int aea_crn, REGS* regs, int acctype, BYTE akey );
+#endif
+
 /*-------------------------------------------------------------------*/
 /*                    Miscellaneous functions                        */
 /*-------------------------------------------------------------------*/
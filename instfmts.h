@@ -1734,6 +1734,424 @@
     INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
 }
 
+/*********************************************************************/
+/*********************************************************************/
+/**                                                                 **/
+/**                z/Architecture Vector Facility                   **/
+/**                                                                 **/
+/*********************************************************************/
+/*********************************************************************/
+
+#if defined( FEATURE_129_ZVECTOR_FACILITY )
+
+/*-------------------------------------------------------------------*/
+/* The vector register fields of the instruction are 4 bits wide and */
+/* the RXB field in bits 36-39 supplies their high order bit: RXB    */
+/* bit 0 for the field in bits 8-11, bit 1 for bits 12-15, bit 2 for */
+/* bits 16-19 and bit 3 for bits 32-35. General register fields and  */
+/* the mask fields are not extended.                                 */
+/*-------------------------------------------------------------------*/
+
+#define VR_8_11(  _inst )   (((_inst)[1] >> 4)  | (((_inst)[4] & 0x8) << 1))
+#define VR_12_15( _inst )   (((_inst)[1] & 0xf) | (((_inst)[4] & 0x4) << 2))
+#define VR_16_19( _inst )   (((_inst)[2] >> 4)  | (((_inst)[4] & 0x2) << 3))
+#define VR_32_35( _inst )   (((_inst)[4] >> 4)  | (((_inst)[4] & 0x1) << 4))
+
+/*-------------------------------------------------------------------*/
+/*        RXE_M3 - RXE format including the m3 field                 */
+/*-------------------------------------------------------------------*/
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | r1  | x2  | b2  |       d2        | m3  | /// |    XOP    |    RXE
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define RXE_M3( _inst, _regs, _r1, _x2, _b2, _effective_addr2, _m3 ) \
+{                                                                   \
+    (_m3) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    RXE_DECODER( _inst, _regs, _r1, _x2, _b2, _effective_addr2, 6, 6 ) \
+}
+
+/*-------------------------------------------------------------------*/
+/*        VRX - vector register and indexed storage                  */
+/*-------------------------------------------------------------------*/
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | x2  | b2  |       d2        | m3  | RXB |    XOP    |    VRX
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRX( _inst, _regs, _v1, _x2, _b2, _effective_addr2, _m3 )  \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_v1)              = VR_8_11( _inst );                          \
+    (_m3)              = (_inst)[4] >> 4;                           \
+    (_effective_addr2) = (temp >>  0) & 0xfff;                      \
+    (_x2)              = (temp >> 16) & 0xf;                        \
+    (_b2)              = (temp >> 12) & 0xf;                        \
+                                                                    \
+    if (( _x2 ))                                                    \
+        (_effective_addr2) += (_regs)->GR(( _x2 ));                 \
+                                                                    \
+    if (( _b2 ))                                                    \
+        (_effective_addr2) += (_regs)->GR(( _b2 ));                 \
+                                                                    \
+    (_effective_addr2) &= ADDRESS_MAXWRAP(( _regs ));               \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+/*-------------------------------------------------------------------*/
+/*        VRV - vector register and vector index storage             */
+/*-------------------------------------------------------------------*/
+// The element of v2 which indexes the storage operand is added to
+// the returned address by the instruction itself.
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  | b2  |       d2        | m3  | RXB |    XOP    |    VRV
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRV( _inst, _regs, _v1, _v2, _b2, _effective_addr2, _m3 )  \
+{                                                                   \
+    (_v1)              = VR_8_11( _inst );                          \
+    (_v2)              = VR_12_15( _inst );                         \
+    (_m3)              = (_inst)[4] >> 4;                           \
+    (_b2)              = (_inst)[2] >> 4;                           \
+    (_effective_addr2) = (((_inst)[2] & 0x0f) << 8) | (_inst)[3];   \
+                                                                    \
+    if (( _b2 ))                                                    \
+        (_effective_addr2) += (_regs)->GR(( _b2 ));                 \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+/*-------------------------------------------------------------------*/
+/*        VRS - vector register and storage                          */
+/*-------------------------------------------------------------------*/
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v3  | b2  |       d2        | m4  | RXB |    XOP    |    VRS-a
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | r3  | b2  |       d2        | m4  | RXB |    XOP    |    VRS-b
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | r1  | v3  | b2  |       d2        | m4  | RXB |    XOP    |    VRS-c
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | /// | r3  | b2  |       d2        | v1  | RXB |    XOP    |    VRS-d
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define GR_8_11(  _inst )   ((_inst)[1] >> 4)
+#define GR_12_15( _inst )   ((_inst)[1] & 0xf)
+
+#define VRS_A( _inst, _regs, _v1, _v3, _b2, _effective_addr2, _m4 ) \
+        VRS_DECODER( _inst, _regs, _v1, VR_8_11, _v3, VR_12_15, _b2, _effective_addr2, _m4 )
+#define VRS_B( _inst, _regs, _v1, _r3, _b2, _effective_addr2, _m4 ) \
+        VRS_DECODER( _inst, _regs, _v1, VR_8_11, _r3, GR_12_15, _b2, _effective_addr2, _m4 )
+#define VRS_C( _inst, _regs, _r1, _v3, _b2, _effective_addr2, _m4 ) \
+        VRS_DECODER( _inst, _regs, _r1, GR_8_11, _v3, VR_12_15, _b2, _effective_addr2, _m4 )
+
+#define VRS_D( _inst, _regs, _v1, _r3, _b2, _effective_addr2 )      \
+{                                                                   \
+    (_v1)              = VR_32_35( _inst );                         \
+    (_r3)              = GR_12_15( _inst );                         \
+    (_b2)              = (_inst)[2] >> 4;                           \
+    (_effective_addr2) = (((_inst)[2] & 0x0f) << 8) | (_inst)[3];   \
+                                                                    \
+    if (( _b2 ))                                                    \
+        (_effective_addr2) += (_regs)->GR(( _b2 ));                 \
+                                                                    \
+    (_effective_addr2) &= ADDRESS_MAXWRAP(( _regs ));               \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRS_DECODER( _inst, _regs, _r1, _f1, _r3, _f3, _b2, _effective_addr2, _m4 ) \
+{                                                                   \
+    (_r1)              = _f1( _inst );                              \
+    (_r3)              = _f3( _inst );                              \
+    (_m4)              = (_inst)[4] >> 4;                           \
+    (_b2)              = (_inst)[2] >> 4;                           \
+    (_effective_addr2) = (((_inst)[2] & 0x0f) << 8) | (_inst)[3];   \
+                                                                    \
+    if (( _b2 ))                                                    \
+        (_effective_addr2) += (_regs)->GR(( _b2 ));                 \
+                                                                    \
+    (_effective_addr2) &= ADDRESS_MAXWRAP(( _regs ));               \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+/*-------------------------------------------------------------------*/
+/*        VRI - vector register and immediate                        */
+/*-------------------------------------------------------------------*/
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | /// |          i2           | m3  | RXB |    XOP    |    VRI-a
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | /// |    i2     |    i3     | m4  | RXB |    XOP    |    VRI-b
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v3  |          i2           | m4  | RXB |    XOP    |    VRI-c
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  | v3  | /// |    i4     | m5  | RXB |    XOP    |    VRI-d
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  |       i3        | m5  | m4  | RXB |    XOP    |    VRI-e
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  | v3  | /// | m5  |    i4     | RXB |    XOP    |    VRI-f
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  |    i4     | m5  |    i3     | RXB |    XOP    |    VRI-g
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | /// |          i2           | i3  | RXB |    XOP    |    VRI-h
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | r2  |    ///    | m4  |    i3     | RXB |    XOP    |    VRI-i
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRI_A( _inst, _regs, _v1, _i2, _m3 )                        \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_i2) = fetch_hw( (_inst) + 2 );                                \
+    (_m3) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRI_B( _inst, _regs, _v1, _i2, _i3, _m4 )                   \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_i2) = (_inst)[2];                                             \
+    (_i3) = (_inst)[3];                                             \
+    (_m4) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRI_C( _inst, _regs, _v1, _v3, _i2, _m4 )                   \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_v3) = VR_12_15( _inst );                                      \
+    (_i2) = fetch_hw( (_inst) + 2 );                                \
+    (_m4) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRI_D( _inst, _regs, _v1, _v2, _v3, _i4, _m5 )              \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_v2) = VR_12_15( _inst );                                      \
+    (_v3) = VR_16_19( _inst );                                      \
+    (_i4) = (_inst)[3];                                             \
+    (_m5) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRI_E( _inst, _regs, _v1, _v2, _i3, _m4, _m5 )              \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_v2) = VR_12_15( _inst );                                      \
+    (_i3) = ((_inst)[2] << 4) | ((_inst)[3] >> 4);                  \
+    (_m5) = (_inst)[3] & 0xf;                                       \
+    (_m4) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRI_F( _inst, _regs, _v1, _v2, _v3, _i4, _m5 )              \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_v2) = VR_12_15( _inst );                                      \
+    (_v3) = VR_16_19( _inst );                                      \
+    (_m5) = (_inst)[3] >> 4;                                        \
+    (_i4) = (((_inst)[3] & 0xf) << 4) | ((_inst)[4] >> 4);          \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRI_G( _inst, _regs, _v1, _v2, _i3, _i4, _m5 )              \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_v2) = VR_12_15( _inst );                                      \
+    (_i4) = (_inst)[2];                                             \
+    (_m5) = (_inst)[3] >> 4;                                        \
+    (_i3) = (((_inst)[3] & 0xf) << 4) | ((_inst)[4] >> 4);          \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRI_H( _inst, _regs, _v1, _i2, _i3 )                        \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_i2) = fetch_hw( (_inst) + 2 );                                \
+    (_i3) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRI_I( _inst, _regs, _v1, _r2, _i3, _m4 )                   \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_r2) = GR_12_15( _inst );                                      \
+    (_m4) = (_inst)[3] >> 4;                                        \
+    (_i3) = (((_inst)[3] & 0xf) << 4) | ((_inst)[4] >> 4);          \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+/*-------------------------------------------------------------------*/
+/*        VRR - vector register and register                         */
+/*-------------------------------------------------------------------*/
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  |    ///    | m5  | m4  | m3  | RXB |    XOP    |    VRR-a
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  | v3  | /// | m5  | /// | m4  | RXB |    XOP    |    VRR-b
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  | v3  | /// | m6  | m5  | m4  | RXB |    XOP    |    VRR-c
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  | v3  | m5  | m6  | /// | v4  | RXB |    XOP    |    VRR-d
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  | v3  | m6  | /// | m5  | v4  | RXB |    XOP    |    VRR-e
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | r2  | r3  |       ///       | /// | RXB |    XOP    |    VRR-f
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | /// | v1  |          ///          | RXB |    XOP    |    VRR-g
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | /// | v1  | v2  | /// | m3  |    ///    | RXB |    XOP    |    VRR-h
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | r1  | v2  |    ///    | m3  | m4  | /// | RXB |    XOP    |    VRR-i
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRR_A( _inst, _regs, _v1, _v2, _m3, _m4, _m5 )              \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_v2) = VR_12_15( _inst );                                      \
+    (_m5) = (_inst)[3] >> 4;                                        \
+    (_m4) = (_inst)[3] & 0xf;                                       \
+    (_m3) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRR_B( _inst, _regs, _v1, _v2, _v3, _m4, _m5 )              \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_v2) = VR_12_15( _inst );                                      \
+    (_v3) = VR_16_19( _inst );                                      \
+    (_m5) = (_inst)[3] >> 4;                                        \
+    (_m4) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRR_C( _inst, _regs, _v1, _v2, _v3, _m4, _m5, _m6 )         \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_v2) = VR_12_15( _inst );                                      \
+    (_v3) = VR_16_19( _inst );                                      \
+    (_m6) = (_inst)[3] >> 4;                                        \
+    (_m5) = (_inst)[3] & 0xf;                                       \
+    (_m4) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRR_D( _inst, _regs, _v1, _v2, _v3, _v4, _m5, _m6 )         \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_v2) = VR_12_15( _inst );                                      \
+    (_v3) = VR_16_19( _inst );                                      \
+    (_v4) = VR_32_35( _inst );                                      \
+    (_m5) = (_inst)[2] & 0xf;                                       \
+    (_m6) = (_inst)[3] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRR_E( _inst, _regs, _v1, _v2, _v3, _v4, _m5, _m6 )         \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_v2) = VR_12_15( _inst );                                      \
+    (_v3) = VR_16_19( _inst );                                      \
+    (_v4) = VR_32_35( _inst );                                      \
+    (_m6) = (_inst)[2] & 0xf;                                       \
+    (_m5) = (_inst)[3] & 0xf;                                       \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRR_F( _inst, _regs, _v1, _r2, _r3 )                        \
+{                                                                   \
+    (_v1) = VR_8_11( _inst );                                       \
+    (_r2) = (_inst)[1] & 0xf;                                       \
+    (_r3) = (_inst)[2] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRR_G( _inst, _regs, _v1 )                                  \
+{                                                                   \
+    (_v1) = VR_12_15( _inst );                                      \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRR_H( _inst, _regs, _v1, _v2, _m3 )                        \
+{                                                                   \
+    (_v1) = VR_12_15( _inst );                                      \
+    (_v2) = VR_16_19( _inst );                                      \
+    (_m3) = (_inst)[3] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#define VRR_I( _inst, _regs, _r1, _v2, _m3, _m4 )                   \
+{                                                                   \
+    (_r1) = GR_8_11( _inst );                                       \
+    (_v2) = VR_12_15( _inst );                                      \
+    (_m3) = (_inst)[3] >> 4;                                        \
+    (_m4) = (_inst)[3] & 0xf;                                       \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+/*-------------------------------------------------------------------*/
+/*        VSI - vector register and storage with immediate           */
+/*-------------------------------------------------------------------*/
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    |    i3     | b2  |       d2        | v1  | RXB |    XOP    |    VSI
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VSI( _inst, _regs, _i3, _b2, _effective_addr2, _v1 )        \
+{                                                                   \
+    (_i3)              = (_inst)[1];                                \
+    (_v1)              = VR_32_35( _inst );                         \
+    (_b2)              = (_inst)[2] >> 4;                           \
+    (_effective_addr2) = (((_inst)[2] & 0x0f) << 8) | (_inst)[3];   \
+                                                                    \
+    if (( _b2 ))                                                    \
+        (_effective_addr2) += (_regs)->GR(( _b2 ));                 \
+                                                                    \
+    (_effective_addr2) &= ADDRESS_MAXWRAP(( _regs ));               \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), 6, 6 );                               \
+}
+
+#endif /* defined( FEATURE_129_ZVECTOR_FACILITY ) */
+
 /*********************************************************************/
 /*********************************************************************/
 /**                                                                 **/
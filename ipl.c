@@ -292,6 +292,10 @@ int ARCH_DEP( system_reset )( const int target_mode, const bool clear,
                 memset( regs->ar,  0, sizeof( regs->ar  ));
                 memset( regs->gr,  0, sizeof( regs->gr  ));
                 memset( regs->fpr, 0, sizeof( regs->fpr ));
+#if defined( _FEATURE_129_ZVECTOR_FACILITY )
+                memset( regs->vrl, 0, sizeof( regs->vrl ));
+                memset( regs->vrh, 0, sizeof( regs->vrh ));
+#endif
 
 #if defined( _FEATURE_S370_S390_VECTOR_FACILITY )
                 memset( regs->vf->vr, 0, sizeof( regs->vf->vr ));
@@ -698,6 +702,7 @@ int ARCH_DEP( initial_cpu_reset )( REGS* regs )
     memset ( &regs->psw,           0, sizeof( regs->psw           ));
     memset ( &regs->captured_zpsw, 0, sizeof( regs->captured_zpsw ));
     memset ( &regs->cr_struct,     0, sizeof( regs->cr_struct     ));
+    regs->CR( CR_ASD_REAL ) = TLB_REAL_ASD;   /* (for real mode MADDR) */
     regs->fpc    = 0;
     regs->PX     = 0;
     regs->psw.AMASK_G = AMASK24;
@@ -961,8 +966,7 @@ void storage_clear()
 {
     if (!sysblk.main_clear)
     {
-        if (sysblk.mainstor) memset( sysblk.mainstor, 0x00, sysblk.mainsize );
-        if (sysblk.storkeys) memset( sysblk.storkeys, 0x00, sysblk.mainsize / _STORKEY_ARRAY_UNITSIZE );
+        clear_mainstor();
         sysblk.main_clear = 1;
     }
 }
@@ -974,9 +978,7 @@ void xstorage_clear()
 {
     if (!sysblk.xpnd_clear)
     {
-        if (sysblk.xpndstor)
-            memset( sysblk.xpndstor, 0x00, (size_t)sysblk.xpndsize * XSTORE_PAGESIZE );
-
+        clear_xpndstor();
         sysblk.xpnd_clear = 1;
     }
 }
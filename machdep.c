@@ -421,7 +421,10 @@ extern inline BYTE cmpxchg8_C11(U64 *old, U64 new, volatile void *ptr);
     && defined( cmpxchg8 )         \
     && defined( cmpxchg16 )
   #undef  OBTAIN_MAINLOCK
-  #define OBTAIN_MAINLOCK(_regs)
+  #define OBTAIN_MAINLOCK(_regs,_key)
+  #undef  OBTAIN_MAINLOCK2
+  #define OBTAIN_MAINLOCK2(_regs,_key1,_key2) \
+          do { UNREFERENCED(_key1); UNREFERENCED(_key2); } while (0)
   #undef  RELEASE_MAINLOCK
   #define RELEASE_MAINLOCK(_regs)
 #endif
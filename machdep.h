@@ -698,7 +698,10 @@ inline void store_dw_e2k_noswap ( volatile void* ptr, U64 value )
     && defined( cmpxchg8 )         \
     && defined( cmpxchg16 )
   #undef  OBTAIN_MAINLOCK
-  #define OBTAIN_MAINLOCK(_regs)
+  #define OBTAIN_MAINLOCK(_regs,_key)
+  #undef  OBTAIN_MAINLOCK2
+  #define OBTAIN_MAINLOCK2(_regs,_key1,_key2) \
+          do { UNREFERENCED(_key1); UNREFERENCED(_key2); } while (0)
   #undef  RELEASE_MAINLOCK
   #define RELEASE_MAINLOCK(_regs)
 #endif
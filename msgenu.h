@@ -759,7 +759,7 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC00871 "syncbc mask "F_CPU_BITMAP" %s"
 #define HHC00872 "signaling facility %sbusy"
 #define HHC00873 "TOD lock %sheld"
-#define HHC00874 "mainlock %sheld; owner %4.4x"
+#define HHC00874 "mainlock %d of %d stripes held"
 #define HHC00875 "intlock %sheld; owner %4.4x"
 #define HHC00876 "ioq lock %sheld"
 //efine HHC00877 (available)
@@ -1462,14 +1462,14 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC02285 "Counted %5u %s events"
 #define HHC02286 "Average instructions / SIE invocation: %5u"
 #define HHC02287 "No SIE performance data"
-//efine HHC02288 (available)
+#define HHC02288 "Processor %s%02X: interval %5d, interrupts %"PRIu64", latency avg %"PRIu64" max %"PRIu64" usecs"
 #define HHC02289 "%s" // disasm_stor
 #define HHC02290 "%s" // 'abs', 'r' and 'v' commands, and 'dump_abs_page' function
 #define HHC02291 "%s" // 'abs', 'r' and 'v' commands, and 'dump_abs_page' function
 #define HHC02292 "%s" // icount_cmd
 #define HHC02293 "%s" // history.c: command history
 #define HHC02294 "%s" // cachestats_cmd
-//efine HHC02295 (available)
+#define HHC02295 "%s" // pswprof_cmd
 //efine HHC02296 (available)
 //efine HHC02297 (available)
 #define HHC02298 "%1d:%04X drive is empty"
@@ -2621,7 +2621,16 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC17013 "Process ID = %d"
 #define HHC17014 "%s value is invalid; valid range is %d - %d"
 #define HHC17015 "%s support not included in this engine build"
-//efine HHC17016 - HHC17099 (available)
+#define HHC17016 "%-8s storage uses %s %s host pages%s"
+#define HHC17017 "%s pages for %s storage not available; using %s pages instead"
+#define HHC17018 "%-8s storage has %s of %s resident in host memory"
+#define HHC17019 "%-8s storage has %"PRIu64" of %"PRIu64" 4K frames changed"
+#define HHC17020 "Changed frames interval %"PRIu64".%03u seconds; %"PRIu64" frames per second"
+#define HHC17021 "Host SIMD kernels %s in use; host supports %s"
+#define HHC17022 "Host does not support %s SIMD kernels"
+#define HHC17023 "%-8s storage is backed by file %s"
+#define HHC17024 "Host crypto kernels %s in use"
+//efine HHC17025 - HHC17099 (available)
 
 //efine HHC17100 - HHC17198 (available)
 #define HHC17199 "%.4s %s"
@@ -674,10 +674,185 @@ DISABLE_GCC_UNUSED_FUNCTION_WARNING;
  UNDEF_INST(convert_dfp_ext_to_packed)
 #endif
 
+#if !defined( FEATURE_129_ZVECTOR_FACILITY )
+ UNDEF_INST( vector_load_element_8 )
+ UNDEF_INST( vector_load_element_16 )
+ UNDEF_INST( vector_load_element_64 )
+ UNDEF_INST( vector_load_element_32 )
+ UNDEF_INST( vector_load_logical_element_and_zero )
+ UNDEF_INST( vector_load_and_replicate )
+ UNDEF_INST( vector_load )
+ UNDEF_INST( vector_load_to_block_boundary )
+ UNDEF_INST( vector_store_element_8 )
+ UNDEF_INST( vector_store_element_16 )
+ UNDEF_INST( vector_store_element_64 )
+ UNDEF_INST( vector_store_element_32 )
+ UNDEF_INST( vector_store )
+ UNDEF_INST( vector_gather_element_64 )
+ UNDEF_INST( vector_gather_element_32 )
+ UNDEF_INST( vector_scatter_element_64 )
+ UNDEF_INST( vector_scatter_element_32 )
+ UNDEF_INST( vector_load_gr_from_vr_element )
+ UNDEF_INST( vector_load_vr_element_from_gr )
+ UNDEF_INST( load_count_to_block_boundary )
+ UNDEF_INST( vector_element_shift_left )
+ UNDEF_INST( vector_element_rotate_left_logical )
+ UNDEF_INST( vector_load_multiple )
+ UNDEF_INST( vector_load_with_length )
+ UNDEF_INST( vector_element_shift_right_logical )
+ UNDEF_INST( vector_element_shift_right_arithmetic )
+ UNDEF_INST( vector_store_multiple )
+ UNDEF_INST( vector_store_with_length )
+ UNDEF_INST( vector_load_element_immediate_8 )
+ UNDEF_INST( vector_load_element_immediate_16 )
+ UNDEF_INST( vector_load_element_immediate_64 )
+ UNDEF_INST( vector_load_element_immediate_32 )
+ UNDEF_INST( vector_generate_byte_mask )
+ UNDEF_INST( vector_replicate_immediate )
+ UNDEF_INST( vector_generate_mask )
+ UNDEF_INST( vector_fp_test_data_class_immediate )
+ UNDEF_INST( vector_replicate )
+ UNDEF_INST( vector_population_count )
+ UNDEF_INST( vector_count_trailing_zeros )
+ UNDEF_INST( vector_count_leading_zeros )
+ UNDEF_INST( vector_load_vector )
+ UNDEF_INST( vector_isolate_string )
+ UNDEF_INST( vector_sign_extend_to_doubleword )
+ UNDEF_INST( vector_merge_low )
+ UNDEF_INST( vector_merge_high )
+ UNDEF_INST( vector_load_vr_from_grs_disjoint )
+ UNDEF_INST( vector_sum_across_word )
+ UNDEF_INST( vector_sum_across_doubleword )
+ UNDEF_INST( vector_checksum )
+ UNDEF_INST( vector_sum_across_quadword )
+ UNDEF_INST( vector_and )
+ UNDEF_INST( vector_and_with_complement )
+ UNDEF_INST( vector_or )
+ UNDEF_INST( vector_nor )
+ UNDEF_INST( vector_exclusive_or )
+ UNDEF_INST( vector_element_shift_left_vector )
+ UNDEF_INST( vector_element_rotate_and_insert_under_mask )
+ UNDEF_INST( vector_element_rotate_left_logical_vector )
+ UNDEF_INST( vector_shift_left )
+ UNDEF_INST( vector_shift_left_by_byte )
+ UNDEF_INST( vector_shift_left_double_by_byte )
+ UNDEF_INST( vector_element_shift_right_logical_vector )
+ UNDEF_INST( vector_element_shift_right_arithmetic_vector )
+ UNDEF_INST( vector_shift_right_logical )
+ UNDEF_INST( vector_shift_right_logical_by_byte )
+ UNDEF_INST( vector_shift_right_arithmetic )
+ UNDEF_INST( vector_shift_right_arithmetic_by_byte )
+ UNDEF_INST( vector_find_element_equal )
+ UNDEF_INST( vector_find_element_not_equal )
+ UNDEF_INST( vector_find_any_element_equal )
+ UNDEF_INST( vector_permute_doubleword_immediate )
+ UNDEF_INST( vector_string_range_compare )
+ UNDEF_INST( vector_permute )
+ UNDEF_INST( vector_select )
+ UNDEF_INST( vector_fp_multiply_and_subtract )
+ UNDEF_INST( vector_fp_multiply_and_add )
+ UNDEF_INST( vector_pack )
+ UNDEF_INST( vector_pack_logical_saturate )
+ UNDEF_INST( vector_pack_saturate )
+ UNDEF_INST( vector_multiply_logical_high )
+ UNDEF_INST( vector_multiply_low )
+ UNDEF_INST( vector_multiply_high )
+ UNDEF_INST( vector_multiply_logical_even )
+ UNDEF_INST( vector_multiply_logical_odd )
+ UNDEF_INST( vector_multiply_even )
+ UNDEF_INST( vector_multiply_odd )
+ UNDEF_INST( vector_multiply_and_add_logical_high )
+ UNDEF_INST( vector_multiply_and_add_low )
+ UNDEF_INST( vector_multiply_and_add_high )
+ UNDEF_INST( vector_multiply_and_add_logical_even )
+ UNDEF_INST( vector_multiply_and_add_logical_odd )
+ UNDEF_INST( vector_multiply_and_add_even )
+ UNDEF_INST( vector_multiply_and_add_odd )
+ UNDEF_INST( vector_galois_field_multiply_sum )
+ UNDEF_INST( vector_add_with_carry_compute_carry )
+ UNDEF_INST( vector_add_with_carry )
+ UNDEF_INST( vector_galois_field_multiply_sum_and_accumulate )
+ UNDEF_INST( vector_subtract_with_borrow_compute_borrow_indication )
+ UNDEF_INST( vector_subtract_with_borrow_indication )
+ UNDEF_INST( vector_fp_convert_to_logical_64 )
+ UNDEF_INST( vector_fp_convert_from_logical_64 )
+ UNDEF_INST( vector_fp_convert_to_fixed_64 )
+ UNDEF_INST( vector_fp_convert_from_fixed_64 )
+ UNDEF_INST( vector_fp_load_lengthened )
+ UNDEF_INST( vector_fp_load_rounded )
+ UNDEF_INST( vector_load_fp_integer )
+ UNDEF_INST( vector_fp_compare_and_signal_scalar )
+ UNDEF_INST( vector_fp_compare_scalar )
+ UNDEF_INST( vector_fp_perform_sign_operation )
+ UNDEF_INST( vector_fp_square_root )
+ UNDEF_INST( vector_unpack_logical_low )
+ UNDEF_INST( vector_unpack_logical_high )
+ UNDEF_INST( vector_unpack_low )
+ UNDEF_INST( vector_unpack_high )
+ UNDEF_INST( vector_test_under_mask )
+ UNDEF_INST( vector_element_compare_logical )
+ UNDEF_INST( vector_element_compare )
+ UNDEF_INST( vector_load_complement )
+ UNDEF_INST( vector_load_positive )
+ UNDEF_INST( vector_fp_subtract )
+ UNDEF_INST( vector_fp_add )
+ UNDEF_INST( vector_fp_divide )
+ UNDEF_INST( vector_fp_multiply )
+ UNDEF_INST( vector_fp_compare_equal )
+ UNDEF_INST( vector_fp_compare_high_or_equal )
+ UNDEF_INST( vector_fp_compare_high )
+ UNDEF_INST( vector_average_logical )
+ UNDEF_INST( vector_add_compute_carry )
+ UNDEF_INST( vector_average )
+ UNDEF_INST( vector_add )
+ UNDEF_INST( vector_subtract_compute_borrow_indication )
+ UNDEF_INST( vector_subtract )
+ UNDEF_INST( vector_compare_equal )
+ UNDEF_INST( vector_compare_high_logical )
+ UNDEF_INST( vector_compare_high )
+ UNDEF_INST( vector_minimum_logical )
+ UNDEF_INST( vector_maximum_logical )
+ UNDEF_INST( vector_minimum )
+ UNDEF_INST( vector_maximum )
+#endif
+
+#if !defined( FEATURE_134_ZVECTOR_PACK_DEC_FACILITY )
+ UNDEF_INST( vector_pack_zoned )
+ UNDEF_INST( vector_load_rightmost_with_length )
+ UNDEF_INST( vector_load_rightmost_with_length_reg )
+ UNDEF_INST( vector_unpack_zoned )
+ UNDEF_INST( vector_store_rightmost_with_length )
+ UNDEF_INST( vector_store_rightmost_with_length_reg )
+ UNDEF_INST( vector_load_immediate_decimal )
+ UNDEF_INST( vector_convert_to_binary_32 )
+ UNDEF_INST( vector_convert_to_binary_64 )
+ UNDEF_INST( vector_convert_to_decimal_32 )
+ UNDEF_INST( vector_shift_and_round_decimal )
+ UNDEF_INST( vector_convert_to_decimal_64 )
+ UNDEF_INST( vector_perform_sign_operation_decimal )
+ UNDEF_INST( vector_test_decimal )
+ UNDEF_INST( vector_add_decimal )
+ UNDEF_INST( vector_subtract_decimal )
+ UNDEF_INST( vector_compare_decimal )
+ UNDEF_INST( vector_multiply_decimal )
+ UNDEF_INST( vector_multiply_and_shift_decimal )
+ UNDEF_INST( vector_divide_decimal )
+ UNDEF_INST( vector_remainder_decimal )
+ UNDEF_INST( vector_shift_and_divide_decimal )
+#endif
+
 #if !defined( FEATURE_145_INS_REF_BITS_MULT_FACILITY )
  UNDEF_INST( insert_reference_bits_multiple )
 #endif
 
+#if !defined( FEATURE_150_ENH_SORT_FACILITY )
+ UNDEF_INST( sort_lists )
+#endif
+
+#if !defined( FEATURE_151_DEFLATE_CONV_FACILITY )
+ UNDEF_INST( deflate_conversion_call )
+#endif
+
 #if !defined( FEATURE_193_BEAR_ENH_FACILITY )
  UNDEF_INST( load_bear )
  UNDEF_INST( store_bear )
@@ -1382,6 +1557,22 @@ DEF_INST( E3_0 )
 }
 #endif
 
+/*-------------------------------------------------------------------*/
+/* E6xx ???? - "instruction" to jump to actual instruction    [????] */
+/*-------------------------------------------------------------------*/
+DEF_INST( execute_opcode_e6________xx )
+{
+  regs->ARCH_DEP( runtime_opcode_e6________xx )[inst[5]](inst, regs);
+}
+
+/*-------------------------------------------------------------------*/
+/* E7xx ???? - "instruction" to jump to actual instruction    [????] */
+/*-------------------------------------------------------------------*/
+DEF_INST( execute_opcode_e7________xx )
+{
+  regs->ARCH_DEP( runtime_opcode_e7________xx )[inst[5]](inst, regs);
+}
+
 /*-------------------------------------------------------------------*/
 /* EBxx ???? - "instruction" to jump to actual instruction    [????] */
 /*-------------------------------------------------------------------*/
@@ -1406,6 +1597,32 @@ DEF_INST( execute_opcode_ed________xx )
   regs->ARCH_DEP( runtime_opcode_ed________xx )[inst[5]](inst, regs);
 }
 
+#if defined( OPTION_COMPACT_OPCODE_DISPATCH )
+/*-------------------------------------------------------------------*/
+/* xxyy ???? - "instruction" to jump to actual instruction    [????] */
+/*-------------------------------------------------------------------*/
+/* Used by the compact two-level dispatch mode for those opcodes     */
+/* whose instruction function depends on the second byte of the      */
+/* instruction (e.g. 01xx, B2xx, B3xx, B9xx, E5xx and the optimized  */
+/* instructions such as LA/BC/L/ST when X2 is zero).                 */
+/*-------------------------------------------------------------------*/
+DEF_INST( execute_opcode_xx_yy )
+{
+  regs->ARCH_DEP( runtime_opcode_xx_2nd )[inst[0]][inst[1]](inst, regs);
+}
+
+/*-------------------------------------------------------------------*/
+/* xx_y ???? - "instruction" to jump to actual instruction    [????] */
+/*-------------------------------------------------------------------*/
+/* Same as above but for opcodes whose extended opcode is only the   */
+/* low-order 4 bits of the second byte (A5_x, A7_x, C0_x .. CC_x).   */
+/*-------------------------------------------------------------------*/
+DEF_INST( execute_opcode_xx__y )
+{
+  regs->ARCH_DEP( runtime_opcode_xx_2nd )[inst[0]][inst[1] & 0x0F](inst, regs);
+}
+#endif /* defined( OPTION_COMPACT_OPCODE_DISPATCH ) */
+
 /*-------------------------------------------------------------------*/
 /* 00   ???? - Operation Exception "instruction"              [????] */
 /*-------------------------------------------------------------------*/
@@ -1494,6 +1711,32 @@ FWD_REF_IPRINT_FUNC( ASMFMT_SSE );
 FWD_REF_IPRINT_FUNC( ASMFMT_SSF );
 FWD_REF_IPRINT_FUNC( ASMFMT_SSF_RSS );
 FWD_REF_IPRINT_FUNC( ASMFMT_VS );
+FWD_REF_IPRINT_FUNC( ASMFMT_RXE_M3 );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRX );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRV );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRS_A );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRS_B );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRS_C );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRI_A );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRI_B );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRI_C );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRI_D );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRI_E );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRR_A );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRR_B );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRR_C );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRR_D );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRR_E );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRR_F );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRR_G );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRR_H );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRR_I );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRI_F );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRI_G );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRI_H );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRI_I );
+FWD_REF_IPRINT_FUNC( ASMFMT_VRS_D );
+FWD_REF_IPRINT_FUNC( ASMFMT_VSI );
 
 #endif // COMPILE_THIS_ONLY_ONCE
 
@@ -1832,6 +2075,8 @@ static INSTR_FUNC gen_opcode_cc_x[16][NUM_INSTR_TAB_PTRS];
 static INSTR_FUNC gen_opcode_e3xx[256][NUM_INSTR_TAB_PTRS];
 static INSTR_FUNC gen_opcode_e5xx[256][NUM_INSTR_TAB_PTRS];
 static INSTR_FUNC gen_opcode_e6xx[256][NUM_INSTR_TAB_PTRS];
+static INSTR_FUNC gen_opcode_e6________xx[256][NUM_INSTR_TAB_PTRS];
+static INSTR_FUNC gen_opcode_e7xx[256][NUM_INSTR_TAB_PTRS];
 static INSTR_FUNC gen_opcode_ebxx[256][NUM_INSTR_TAB_PTRS];
 static INSTR_FUNC gen_opcode_ecxx[256][NUM_INSTR_TAB_PTRS];
 static INSTR_FUNC gen_opcode_edxx[256][NUM_INSTR_TAB_PTRS];
@@ -1866,6 +2111,10 @@ static INSTR_FUNC gen_opcode_E3_0______24[1][NUM_INSTR_TAB_PTRS];
 
 #endif /* OPTION_OPTINST */
 
+#if defined( OPTION_COMPACT_OPCODE_DISPATCH )
+static INSTR_FUNC gen_opcode_xx_2nd[2][NUM_INSTR_TAB_PTRS];
+#endif
+
 /*---------------------------------------------------------------------------*/
 /* Following function will be resolved within the runtime opcode tables      */
 /* and set with function init_runtime_opcode_tables.                         */
@@ -1886,7 +2135,6 @@ static INSTR_FUNC gen_opcode_E3_0______24[1][NUM_INSTR_TAB_PTRS];
 #define execute_opcode_cc_x     operation_exception
 #define execute_opcode_e4xx     operation_exception
 #define execute_opcode_e5xx     operation_exception
-#define execute_opcode_e6xx     operation_exception
 
 /*----------------------------------------------------------------------------*/
 /*                   Instruction Disassembly Functions                        */
@@ -1982,6 +2230,35 @@ int iprint_ASMFMT_b2xx( int arch_mode, BYTE inst[], char unused[], char* prtbuf
     return iprt_asmfmt_func( arch_mode, inst, iprt_info_string, prtbuf );
 }
 
+/*----------------------------------------------------------------------------*/
+/*   Second level iprint jump function for the two E6 opcode tables           */
+/*----------------------------------------------------------------------------*/
+int iprint_ASMFMT_e6xx( int arch_mode, BYTE inst[], char unused[], char* prtbuf )
+{
+    /* Same as the IPRINT_ROUT2 code except that the S/370 ECPS:VM assists
+       have their extended opcode in inst[1] whereas the z/Architecture
+       vector decimal instructions have theirs in inst[5].
+    */
+    IPRTFUNC*  iprt_asmfmt_func;        /* Ptr to instr printing function */
+    char*      iprt_info_string;        /* mnemonic + instr function name */
+
+    UNREFERENCED( unused );
+
+    if (ARCH_900_IDX == arch_mode)
+    {
+        iprt_asmfmt_func = (void*) gen_opcode_e6________xx [ inst[5] ][ NUM_INSTR_TAB_PTRS - 2 ];
+        iprt_info_string = (void*) gen_opcode_e6________xx [ inst[5] ][ NUM_INSTR_TAB_PTRS - 1 ];
+    }
+    else
+    {
+        iprt_asmfmt_func = (void*) gen_opcode_e6xx [ inst[1] ][ NUM_INSTR_TAB_PTRS - 2 ];
+        iprt_info_string = (void*) gen_opcode_e6xx [ inst[1] ][ NUM_INSTR_TAB_PTRS - 1 ];
+    }
+
+    /* Trace this instruction */
+    return iprt_asmfmt_func( arch_mode, inst, iprt_info_string, prtbuf );
+}
+
 /*----------------------------------------------------------------------------*/
 /*         The second level instruction printing routing functions            */
 /*----------------------------------------------------------------------------*/
@@ -2000,7 +2277,8 @@ IPRINT_ROUT2( c8_x, [1] & 0x0F )
 IPRINT_ROUT2( cc_x, [1] & 0x0F )
 IPRINT_ROUT2( e3xx, [5] )
 IPRINT_ROUT2( e5xx, [1] )
-IPRINT_ROUT2( e6xx, [1] )
+//IPRINT_ROUT2( e6xx, [1] )         // (see 'iprint_ASMFMT_e6xx' function)
+IPRINT_ROUT2( e7xx, [5] )
 IPRINT_ROUT2( ebxx, [5] )
 IPRINT_ROUT2( ecxx, [5] )
 IPRINT_ROUT2( edxx, [5] )
@@ -2556,6 +2834,251 @@ IPRINT_FUNC( ASMFMT_VS );
     rs2 = inst[3] & 0x0F;
     IPRINT_PRINT("%d",rs2)
 
+IPRINT_FUNC( ASMFMT_RXE_M3 );
+    int r1,x2,b2,d2,m3;
+    UNREFERENCED( regs );
+    r1 = inst[1] >> 4;
+    x2 = inst[1] & 0x0F;
+    b2 = inst[2] >> 4;
+    d2 = (inst[2] & 0x0F) << 8 | inst[3];
+    m3 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d(%d,%d),%d",r1,d2,x2,b2,m3)
+
+IPRINT_FUNC( ASMFMT_VRX );
+    int v1,x2,b2,d2,m3;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    x2 = inst[1] & 0x0F;
+    b2 = inst[2] >> 4;
+    d2 = (inst[2] & 0x0F) << 8 | inst[3];
+    m3 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d(%d,%d),%d",v1,d2,x2,b2,m3)
+
+IPRINT_FUNC( ASMFMT_VRV );
+    int v1,v2,b2,d2,m3;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    v2 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    b2 = inst[2] >> 4;
+    d2 = (inst[2] & 0x0F) << 8 | inst[3];
+    m3 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d(%d,%d),%d",v1,d2,v2,b2,m3)
+
+IPRINT_FUNC( ASMFMT_VRS_A );
+    int v1,v3,b2,d2,m4;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    v3 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    b2 = inst[2] >> 4;
+    d2 = (inst[2] & 0x0F) << 8 | inst[3];
+    m4 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d(%d),%d",v1,v3,d2,b2,m4)
+
+IPRINT_FUNC( ASMFMT_VRS_B );
+    int v1,r3,b2,d2,m4;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    r3 = inst[1] & 0x0F;
+    b2 = inst[2] >> 4;
+    d2 = (inst[2] & 0x0F) << 8 | inst[3];
+    m4 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d(%d),%d",v1,r3,d2,b2,m4)
+
+IPRINT_FUNC( ASMFMT_VRS_C );
+    int r1,v3,b2,d2,m4;
+    UNREFERENCED( regs );
+    r1 = inst[1] >> 4;
+    v3 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    b2 = inst[2] >> 4;
+    d2 = (inst[2] & 0x0F) << 8 | inst[3];
+    m4 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d(%d),%d",r1,v3,d2,b2,m4)
+
+IPRINT_FUNC( ASMFMT_VRI_A );
+    int v1,i2,m3;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    i2 = inst[2] << 8 | inst[3];
+    m3 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d",v1,i2,m3)
+
+IPRINT_FUNC( ASMFMT_VRI_B );
+    int v1,i2,i3,m4;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    i2 = inst[2];
+    i3 = inst[3];
+    m4 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d,%d",v1,i2,i3,m4)
+
+IPRINT_FUNC( ASMFMT_VRI_C );
+    int v1,v3,i2,m4;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    v3 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    i2 = inst[2] << 8 | inst[3];
+    m4 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d,%d",v1,v3,i2,m4)
+
+IPRINT_FUNC( ASMFMT_VRI_D );
+    int v1,v2,v3,i4,m5;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    v2 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    v3 = (inst[2] >> 4)   | ((inst[4] & 0x02) << 3);
+    i4 = inst[3];
+    m5 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d,%d,%d",v1,v2,v3,i4,m5)
+
+IPRINT_FUNC( ASMFMT_VRI_E );
+    int v1,v2,i3,m4,m5;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    v2 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    i3 = inst[2] << 4 | inst[3] >> 4;
+    m5 = inst[3] & 0x0F;
+    m4 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d,%d,%d",v1,v2,i3,m4,m5)
+
+IPRINT_FUNC( ASMFMT_VRR_A );
+    int v1,v2,m3,m4,m5;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    v2 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    m5 = inst[3] >> 4;
+    m4 = inst[3] & 0x0F;
+    m3 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d,%d,%d",v1,v2,m3,m4,m5)
+
+IPRINT_FUNC( ASMFMT_VRR_B );
+    int v1,v2,v3,m4,m5;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    v2 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    v3 = (inst[2] >> 4)   | ((inst[4] & 0x02) << 3);
+    m5 = inst[3] >> 4;
+    m4 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d,%d,%d",v1,v2,v3,m4,m5)
+
+IPRINT_FUNC( ASMFMT_VRR_C );
+    int v1,v2,v3,m4,m5,m6;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    v2 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    v3 = (inst[2] >> 4)   | ((inst[4] & 0x02) << 3);
+    m6 = inst[3] >> 4;
+    m5 = inst[3] & 0x0F;
+    m4 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d,%d,%d,%d",v1,v2,v3,m4,m5,m6)
+
+IPRINT_FUNC( ASMFMT_VRR_D );
+    int v1,v2,v3,v4,m5,m6;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    v2 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    v3 = (inst[2] >> 4)   | ((inst[4] & 0x02) << 3);
+    v4 = (inst[4] >> 4)   | ((inst[4] & 0x01) << 4);
+    m5 = inst[2] & 0x0F;
+    m6 = inst[3] >> 4;
+    IPRINT_PRINT("%d,%d,%d,%d,%d,%d",v1,v2,v3,v4,m5,m6)
+
+IPRINT_FUNC( ASMFMT_VRR_E );
+    int v1,v2,v3,v4,m5,m6;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    v2 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    v3 = (inst[2] >> 4)   | ((inst[4] & 0x02) << 3);
+    v4 = (inst[4] >> 4)   | ((inst[4] & 0x01) << 4);
+    m6 = inst[2] & 0x0F;
+    m5 = inst[3] & 0x0F;
+    IPRINT_PRINT("%d,%d,%d,%d,%d,%d",v1,v2,v3,v4,m5,m6)
+
+IPRINT_FUNC( ASMFMT_VRR_F );
+    int v1,r2,r3;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    r2 = inst[1] & 0x0F;
+    r3 = inst[2] >> 4;
+    IPRINT_PRINT("%d,%d,%d",v1,r2,r3)
+
+IPRINT_FUNC( ASMFMT_VRR_G );
+    int v1;
+    UNREFERENCED( regs );
+    v1 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    IPRINT_PRINT("%d",v1)
+
+IPRINT_FUNC( ASMFMT_VRR_H );
+    int v1,v2,m3;
+    UNREFERENCED( regs );
+    v1 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    v2 = (inst[2] >> 4)   | ((inst[4] & 0x02) << 3);
+    m3 = inst[3] >> 4;
+    IPRINT_PRINT("%d,%d,%d",v1,v2,m3)
+
+IPRINT_FUNC( ASMFMT_VRR_I );
+    int r1,v2,m3,m4;
+    UNREFERENCED( regs );
+    r1 = inst[1] >> 4;
+    v2 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    m3 = inst[3] >> 4;
+    m4 = inst[3] & 0x0F;
+    IPRINT_PRINT("%d,%d,%d,%d",r1,v2,m3,m4)
+
+IPRINT_FUNC( ASMFMT_VRI_F );
+    int v1,v2,v3,i4,m5;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    v2 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    v3 = (inst[2] >> 4)   | ((inst[4] & 0x02) << 3);
+    m5 = inst[3] >> 4;
+    i4 = (inst[3] & 0x0F) << 4 | inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d,%d,%d",v1,v2,v3,i4,m5)
+
+IPRINT_FUNC( ASMFMT_VRI_G );
+    int v1,v2,i3,i4,m5;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    v2 = (inst[1] & 0x0F) | ((inst[4] & 0x04) << 2);
+    i4 = inst[2];
+    m5 = inst[3] >> 4;
+    i3 = (inst[3] & 0x0F) << 4 | inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d,%d,%d",v1,v2,i3,i4,m5)
+
+IPRINT_FUNC( ASMFMT_VRI_H );
+    int v1,i2,i3;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    i2 = inst[2] << 8 | inst[3];
+    i3 = inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d",v1,i2,i3)
+
+IPRINT_FUNC( ASMFMT_VRI_I );
+    int v1,r2,i3,m4;
+    UNREFERENCED( regs );
+    v1 = (inst[1] >> 4)   | ((inst[4] & 0x08) << 1);
+    r2 = inst[1] & 0x0F;
+    m4 = inst[3] >> 4;
+    i3 = (inst[3] & 0x0F) << 4 | inst[4] >> 4;
+    IPRINT_PRINT("%d,%d,%d,%d",v1,r2,i3,m4)
+
+IPRINT_FUNC( ASMFMT_VRS_D );
+    int v1,r3,b2,d2;
+    UNREFERENCED( regs );
+    v1 = (inst[4] >> 4)   | ((inst[4] & 0x01) << 4);
+    r3 = inst[1] & 0x0F;
+    b2 = inst[2] >> 4;
+    d2 = (inst[2] & 0x0F) << 8 | inst[3];
+    IPRINT_PRINT("%d,%d,%d(%d)",v1,r3,d2,b2)
+
+IPRINT_FUNC( ASMFMT_VSI );
+    int v1,b2,d2,i3;
+    UNREFERENCED( regs );
+    v1 = (inst[4] >> 4)   | ((inst[4] & 0x01) << 4);
+    i3 = inst[1];
+    b2 = inst[2] >> 4;
+    d2 = (inst[2] & 0x0F) << 8 | inst[3];
+    IPRINT_PRINT("%d,%d(%d),%d",v1,d2,b2,i3)
+
 /*----------------------------------------------------------------------------*/
 /*          'GENx___x___x900' instruction opcode jump tables                  */
 /*----------------------------------------------------------------------------*/
@@ -2796,8 +3319,8 @@ static INSTR_FUNC gen_opcode_table[256][NUM_INSTR_TAB_PTRS] =
  /*E3*/   GENx370x390x900 ( ""          , e3xx , ASMFMT_e3xx     , execute_opcode_e3________xx                         ),
  /*E4*/   GENx370x390x900 ( ""          , e4xx , ASMFMT_e4xx     , execute_opcode_e4xx                                 ),
  /*E5*/   GENx370x390x900 ( ""          , e5xx , ASMFMT_e5xx     , execute_opcode_e5xx                                 ),
- /*E6*/   GENx370x390x900 ( ""          , e6xx , ASMFMT_e6xx     , execute_opcode_e6xx                                 ),
- /*E7*/   GENx___x___x___ ,
+ /*E6*/   GENx___x___x900 ( ""          , e6xx , ASMFMT_e6xx     , execute_opcode_e6________xx                         ),
+ /*E7*/   GENx___x___x900 ( ""          , e7xx , ASMFMT_e7xx     , execute_opcode_e7________xx                         ),
  /*E8*/   GENx370x390x900 ( "MVCIN"     , SS_a , ASMFMT_SS_L     , move_inverse                                        ),
  /*E9*/   GENx37Xx390x900 ( "PKA"       , SS_f , ASMFMT_SS_L2    , pack_ascii                                          ),
  /*EA*/   GENx37Xx390x900 ( "UNPKA"     , SS_a , ASMFMT_SS_L     , unpack_ascii                                        ),
@@ -3442,8 +3965,8 @@ static INSTR_FUNC gen_opcode_b9xx[256][NUM_INSTR_TAB_PTRS] =
  /*B935*/ GENx___x___x___ ,
  /*B936*/ GENx___x___x___ ,
  /*B937*/ GENx___x___x___ ,
- /*B938*/ GENx___x___x___ ,
- /*B939*/ GENx___x___x___ ,
+ /*B938*/ GENx___x___x900 ( "SORTL"     , RRE  , ASMFMT_RRE      , sort_lists                                          ),
+ /*B939*/ GENx___x___x900 ( "DFLTCC"    , RRF_a, ASMFMT_RRR      , deflate_conversion_call                             ),
  /*B93A*/ GENx___x___x___ ,
  /*B93B*/ GENx___x___x___ ,
  /*B93C*/ GENx___x___x___ ,
@@ -4572,6 +5095,526 @@ static INSTR_FUNC gen_opcode_e6xx[256][NUM_INSTR_TAB_PTRS] =
  /*E6FF*/ GENx___x___x___
 };
 
+static INSTR_FUNC gen_opcode_e6________xx[256][NUM_INSTR_TAB_PTRS] =
+{
+ /*E600*/ GENx___x___x___ ,
+ /*E601*/ GENx___x___x___ ,
+ /*E602*/ GENx___x___x___ ,
+ /*E603*/ GENx___x___x___ ,
+ /*E604*/ GENx___x___x___ ,
+ /*E605*/ GENx___x___x___ ,
+ /*E606*/ GENx___x___x___ ,
+ /*E607*/ GENx___x___x___ ,
+ /*E608*/ GENx___x___x___ ,
+ /*E609*/ GENx___x___x___ ,
+ /*E60A*/ GENx___x___x___ ,
+ /*E60B*/ GENx___x___x___ ,
+ /*E60C*/ GENx___x___x___ ,
+ /*E60D*/ GENx___x___x___ ,
+ /*E60E*/ GENx___x___x___ ,
+ /*E60F*/ GENx___x___x___ ,
+ /*E610*/ GENx___x___x___ ,
+ /*E611*/ GENx___x___x___ ,
+ /*E612*/ GENx___x___x___ ,
+ /*E613*/ GENx___x___x___ ,
+ /*E614*/ GENx___x___x___ ,
+ /*E615*/ GENx___x___x___ ,
+ /*E616*/ GENx___x___x___ ,
+ /*E617*/ GENx___x___x___ ,
+ /*E618*/ GENx___x___x___ ,
+ /*E619*/ GENx___x___x___ ,
+ /*E61A*/ GENx___x___x___ ,
+ /*E61B*/ GENx___x___x___ ,
+ /*E61C*/ GENx___x___x___ ,
+ /*E61D*/ GENx___x___x___ ,
+ /*E61E*/ GENx___x___x___ ,
+ /*E61F*/ GENx___x___x___ ,
+ /*E620*/ GENx___x___x___ ,
+ /*E621*/ GENx___x___x___ ,
+ /*E622*/ GENx___x___x___ ,
+ /*E623*/ GENx___x___x___ ,
+ /*E624*/ GENx___x___x___ ,
+ /*E625*/ GENx___x___x___ ,
+ /*E626*/ GENx___x___x___ ,
+ /*E627*/ GENx___x___x___ ,
+ /*E628*/ GENx___x___x___ ,
+ /*E629*/ GENx___x___x___ ,
+ /*E62A*/ GENx___x___x___ ,
+ /*E62B*/ GENx___x___x___ ,
+ /*E62C*/ GENx___x___x___ ,
+ /*E62D*/ GENx___x___x___ ,
+ /*E62E*/ GENx___x___x___ ,
+ /*E62F*/ GENx___x___x___ ,
+ /*E630*/ GENx___x___x___ ,
+ /*E631*/ GENx___x___x___ ,
+ /*E632*/ GENx___x___x___ ,
+ /*E633*/ GENx___x___x___ ,
+ /*E634*/ GENx___x___x900 ( "VPKZ"      , VSI  , ASMFMT_VSI      , vector_pack_zoned                                   ),
+ /*E635*/ GENx___x___x900 ( "VLRL"      , VSI  , ASMFMT_VSI      , vector_load_rightmost_with_length                   ),
+ /*E636*/ GENx___x___x___ ,
+ /*E637*/ GENx___x___x900 ( "VLRLR"     , VRS_d, ASMFMT_VRS_D    , vector_load_rightmost_with_length_reg               ),
+ /*E638*/ GENx___x___x___ ,
+ /*E639*/ GENx___x___x___ ,
+ /*E63A*/ GENx___x___x___ ,
+ /*E63B*/ GENx___x___x___ ,
+ /*E63C*/ GENx___x___x900 ( "VUPKZ"     , VSI  , ASMFMT_VSI      , vector_unpack_zoned                                 ),
+ /*E63D*/ GENx___x___x900 ( "VSTRL"     , VSI  , ASMFMT_VSI      , vector_store_rightmost_with_length                  ),
+ /*E63E*/ GENx___x___x___ ,
+ /*E63F*/ GENx___x___x900 ( "VSTRLR"    , VRS_d, ASMFMT_VRS_D    , vector_store_rightmost_with_length_reg              ),
+ /*E640*/ GENx___x___x___ ,
+ /*E641*/ GENx___x___x___ ,
+ /*E642*/ GENx___x___x___ ,
+ /*E643*/ GENx___x___x___ ,
+ /*E644*/ GENx___x___x___ ,
+ /*E645*/ GENx___x___x___ ,
+ /*E646*/ GENx___x___x___ ,
+ /*E647*/ GENx___x___x___ ,
+ /*E648*/ GENx___x___x___ ,
+ /*E649*/ GENx___x___x900 ( "VLIP"      , VRI_h, ASMFMT_VRI_H    , vector_load_immediate_decimal                       ),
+ /*E64A*/ GENx___x___x___ ,
+ /*E64B*/ GENx___x___x___ ,
+ /*E64C*/ GENx___x___x___ ,
+ /*E64D*/ GENx___x___x___ ,
+ /*E64E*/ GENx___x___x___ ,
+ /*E64F*/ GENx___x___x___ ,
+ /*E650*/ GENx___x___x900 ( "VCVB"      , VRR_i, ASMFMT_VRR_I    , vector_convert_to_binary_32                         ),
+ /*E651*/ GENx___x___x___ ,
+ /*E652*/ GENx___x___x900 ( "VCVBG"     , VRR_i, ASMFMT_VRR_I    , vector_convert_to_binary_64                         ),
+ /*E653*/ GENx___x___x___ ,
+ /*E654*/ GENx___x___x___ ,
+ /*E655*/ GENx___x___x___ ,
+ /*E656*/ GENx___x___x___ ,
+ /*E657*/ GENx___x___x___ ,
+ /*E658*/ GENx___x___x900 ( "VCVD"      , VRI_i, ASMFMT_VRI_I    , vector_convert_to_decimal_32                        ),
+ /*E659*/ GENx___x___x900 ( "VSRP"      , VRI_g, ASMFMT_VRI_G    , vector_shift_and_round_decimal                      ),
+ /*E65A*/ GENx___x___x900 ( "VCVDG"     , VRI_i, ASMFMT_VRI_I    , vector_convert_to_decimal_64                        ),
+ /*E65B*/ GENx___x___x900 ( "VPSOP"     , VRI_g, ASMFMT_VRI_G    , vector_perform_sign_operation_decimal               ),
+ /*E65C*/ GENx___x___x___ ,
+ /*E65D*/ GENx___x___x___ ,
+ /*E65E*/ GENx___x___x___ ,
+ /*E65F*/ GENx___x___x900 ( "VTP"       , VRR_g, ASMFMT_VRR_G    , vector_test_decimal                                 ),
+ /*E660*/ GENx___x___x___ ,
+ /*E661*/ GENx___x___x___ ,
+ /*E662*/ GENx___x___x___ ,
+ /*E663*/ GENx___x___x___ ,
+ /*E664*/ GENx___x___x___ ,
+ /*E665*/ GENx___x___x___ ,
+ /*E666*/ GENx___x___x___ ,
+ /*E667*/ GENx___x___x___ ,
+ /*E668*/ GENx___x___x___ ,
+ /*E669*/ GENx___x___x___ ,
+ /*E66A*/ GENx___x___x___ ,
+ /*E66B*/ GENx___x___x___ ,
+ /*E66C*/ GENx___x___x___ ,
+ /*E66D*/ GENx___x___x___ ,
+ /*E66E*/ GENx___x___x___ ,
+ /*E66F*/ GENx___x___x___ ,
+ /*E670*/ GENx___x___x___ ,
+ /*E671*/ GENx___x___x900 ( "VAP"       , VRI_f, ASMFMT_VRI_F    , vector_add_decimal                                  ),
+ /*E672*/ GENx___x___x___ ,
+ /*E673*/ GENx___x___x900 ( "VSP"       , VRI_f, ASMFMT_VRI_F    , vector_subtract_decimal                             ),
+ /*E674*/ GENx___x___x___ ,
+ /*E675*/ GENx___x___x___ ,
+ /*E676*/ GENx___x___x___ ,
+ /*E677*/ GENx___x___x900 ( "VCP"       , VRR_h, ASMFMT_VRR_H    , vector_compare_decimal                              ),
+ /*E678*/ GENx___x___x900 ( "VMP"       , VRI_f, ASMFMT_VRI_F    , vector_multiply_decimal                             ),
+ /*E679*/ GENx___x___x900 ( "VMSP"      , VRI_f, ASMFMT_VRI_F    , vector_multiply_and_shift_decimal                   ),
+ /*E67A*/ GENx___x___x900 ( "VDP"       , VRI_f, ASMFMT_VRI_F    , vector_divide_decimal                               ),
+ /*E67B*/ GENx___x___x900 ( "VRP"       , VRI_f, ASMFMT_VRI_F    , vector_remainder_decimal                            ),
+ /*E67C*/ GENx___x___x___ ,
+ /*E67D*/ GENx___x___x___ ,
+ /*E67E*/ GENx___x___x900 ( "VSDP"      , VRI_f, ASMFMT_VRI_F    , vector_shift_and_divide_decimal                     ),
+ /*E67F*/ GENx___x___x___ ,
+ /*E680*/ GENx___x___x___ ,
+ /*E681*/ GENx___x___x___ ,
+ /*E682*/ GENx___x___x___ ,
+ /*E683*/ GENx___x___x___ ,
+ /*E684*/ GENx___x___x___ ,
+ /*E685*/ GENx___x___x___ ,
+ /*E686*/ GENx___x___x___ ,
+ /*E687*/ GENx___x___x___ ,
+ /*E688*/ GENx___x___x___ ,
+ /*E689*/ GENx___x___x___ ,
+ /*E68A*/ GENx___x___x___ ,
+ /*E68B*/ GENx___x___x___ ,
+ /*E68C*/ GENx___x___x___ ,
+ /*E68D*/ GENx___x___x___ ,
+ /*E68E*/ GENx___x___x___ ,
+ /*E68F*/ GENx___x___x___ ,
+ /*E690*/ GENx___x___x___ ,
+ /*E691*/ GENx___x___x___ ,
+ /*E692*/ GENx___x___x___ ,
+ /*E693*/ GENx___x___x___ ,
+ /*E694*/ GENx___x___x___ ,
+ /*E695*/ GENx___x___x___ ,
+ /*E696*/ GENx___x___x___ ,
+ /*E697*/ GENx___x___x___ ,
+ /*E698*/ GENx___x___x___ ,
+ /*E699*/ GENx___x___x___ ,
+ /*E69A*/ GENx___x___x___ ,
+ /*E69B*/ GENx___x___x___ ,
+ /*E69C*/ GENx___x___x___ ,
+ /*E69D*/ GENx___x___x___ ,
+ /*E69E*/ GENx___x___x___ ,
+ /*E69F*/ GENx___x___x___ ,
+ /*E6A0*/ GENx___x___x___ ,
+ /*E6A1*/ GENx___x___x___ ,
+ /*E6A2*/ GENx___x___x___ ,
+ /*E6A3*/ GENx___x___x___ ,
+ /*E6A4*/ GENx___x___x___ ,
+ /*E6A5*/ GENx___x___x___ ,
+ /*E6A6*/ GENx___x___x___ ,
+ /*E6A7*/ GENx___x___x___ ,
+ /*E6A8*/ GENx___x___x___ ,
+ /*E6A9*/ GENx___x___x___ ,
+ /*E6AA*/ GENx___x___x___ ,
+ /*E6AB*/ GENx___x___x___ ,
+ /*E6AC*/ GENx___x___x___ ,
+ /*E6AD*/ GENx___x___x___ ,
+ /*E6AE*/ GENx___x___x___ ,
+ /*E6AF*/ GENx___x___x___ ,
+ /*E6B0*/ GENx___x___x___ ,
+ /*E6B1*/ GENx___x___x___ ,
+ /*E6B2*/ GENx___x___x___ ,
+ /*E6B3*/ GENx___x___x___ ,
+ /*E6B4*/ GENx___x___x___ ,
+ /*E6B5*/ GENx___x___x___ ,
+ /*E6B6*/ GENx___x___x___ ,
+ /*E6B7*/ GENx___x___x___ ,
+ /*E6B8*/ GENx___x___x___ ,
+ /*E6B9*/ GENx___x___x___ ,
+ /*E6BA*/ GENx___x___x___ ,
+ /*E6BB*/ GENx___x___x___ ,
+ /*E6BC*/ GENx___x___x___ ,
+ /*E6BD*/ GENx___x___x___ ,
+ /*E6BE*/ GENx___x___x___ ,
+ /*E6BF*/ GENx___x___x___ ,
+ /*E6C0*/ GENx___x___x___ ,
+ /*E6C1*/ GENx___x___x___ ,
+ /*E6C2*/ GENx___x___x___ ,
+ /*E6C3*/ GENx___x___x___ ,
+ /*E6C4*/ GENx___x___x___ ,
+ /*E6C5*/ GENx___x___x___ ,
+ /*E6C6*/ GENx___x___x___ ,
+ /*E6C7*/ GENx___x___x___ ,
+ /*E6C8*/ GENx___x___x___ ,
+ /*E6C9*/ GENx___x___x___ ,
+ /*E6CA*/ GENx___x___x___ ,
+ /*E6CB*/ GENx___x___x___ ,
+ /*E6CC*/ GENx___x___x___ ,
+ /*E6CD*/ GENx___x___x___ ,
+ /*E6CE*/ GENx___x___x___ ,
+ /*E6CF*/ GENx___x___x___ ,
+ /*E6D0*/ GENx___x___x___ ,
+ /*E6D1*/ GENx___x___x___ ,
+ /*E6D2*/ GENx___x___x___ ,
+ /*E6D3*/ GENx___x___x___ ,
+ /*E6D4*/ GENx___x___x___ ,
+ /*E6D5*/ GENx___x___x___ ,
+ /*E6D6*/ GENx___x___x___ ,
+ /*E6D7*/ GENx___x___x___ ,
+ /*E6D8*/ GENx___x___x___ ,
+ /*E6D9*/ GENx___x___x___ ,
+ /*E6DA*/ GENx___x___x___ ,
+ /*E6DB*/ GENx___x___x___ ,
+ /*E6DC*/ GENx___x___x___ ,
+ /*E6DD*/ GENx___x___x___ ,
+ /*E6DE*/ GENx___x___x___ ,
+ /*E6DF*/ GENx___x___x___ ,
+ /*E6E0*/ GENx___x___x___ ,
+ /*E6E1*/ GENx___x___x___ ,
+ /*E6E2*/ GENx___x___x___ ,
+ /*E6E3*/ GENx___x___x___ ,
+ /*E6E4*/ GENx___x___x___ ,
+ /*E6E5*/ GENx___x___x___ ,
+ /*E6E6*/ GENx___x___x___ ,
+ /*E6E7*/ GENx___x___x___ ,
+ /*E6E8*/ GENx___x___x___ ,
+ /*E6E9*/ GENx___x___x___ ,
+ /*E6EA*/ GENx___x___x___ ,
+ /*E6EB*/ GENx___x___x___ ,
+ /*E6EC*/ GENx___x___x___ ,
+ /*E6ED*/ GENx___x___x___ ,
+ /*E6EE*/ GENx___x___x___ ,
+ /*E6EF*/ GENx___x___x___ ,
+ /*E6F0*/ GENx___x___x___ ,
+ /*E6F1*/ GENx___x___x___ ,
+ /*E6F2*/ GENx___x___x___ ,
+ /*E6F3*/ GENx___x___x___ ,
+ /*E6F4*/ GENx___x___x___ ,
+ /*E6F5*/ GENx___x___x___ ,
+ /*E6F6*/ GENx___x___x___ ,
+ /*E6F7*/ GENx___x___x___ ,
+ /*E6F8*/ GENx___x___x___ ,
+ /*E6F9*/ GENx___x___x___ ,
+ /*E6FA*/ GENx___x___x___ ,
+ /*E6FB*/ GENx___x___x___ ,
+ /*E6FC*/ GENx___x___x___ ,
+ /*E6FD*/ GENx___x___x___ ,
+ /*E6FE*/ GENx___x___x___ ,
+ /*E6FF*/ GENx___x___x___
+};
+
+static INSTR_FUNC gen_opcode_e7xx[256][NUM_INSTR_TAB_PTRS] =
+{
+ /*E700*/ GENx___x___x900 ( "VLEB"      , VRX  , ASMFMT_VRX      , vector_load_element_8                               ),
+ /*E701*/ GENx___x___x900 ( "VLEH"      , VRX  , ASMFMT_VRX      , vector_load_element_16                              ),
+ /*E702*/ GENx___x___x900 ( "VLEG"      , VRX  , ASMFMT_VRX      , vector_load_element_64                              ),
+ /*E703*/ GENx___x___x900 ( "VLEF"      , VRX  , ASMFMT_VRX      , vector_load_element_32                              ),
+ /*E704*/ GENx___x___x900 ( "VLLEZ"     , VRX  , ASMFMT_VRX      , vector_load_logical_element_and_zero                ),
+ /*E705*/ GENx___x___x900 ( "VLREP"     , VRX  , ASMFMT_VRX      , vector_load_and_replicate                           ),
+ /*E706*/ GENx___x___x900 ( "VL"        , VRX  , ASMFMT_VRX      , vector_load                                         ),
+ /*E707*/ GENx___x___x900 ( "VLBB"      , VRX  , ASMFMT_VRX      , vector_load_to_block_boundary                       ),
+ /*E708*/ GENx___x___x900 ( "VSTEB"     , VRX  , ASMFMT_VRX      , vector_store_element_8                              ),
+ /*E709*/ GENx___x___x900 ( "VSTEH"     , VRX  , ASMFMT_VRX      , vector_store_element_16                             ),
+ /*E70A*/ GENx___x___x900 ( "VSTEG"     , VRX  , ASMFMT_VRX      , vector_store_element_64                             ),
+ /*E70B*/ GENx___x___x900 ( "VSTEF"     , VRX  , ASMFMT_VRX      , vector_store_element_32                             ),
+ /*E70C*/ GENx___x___x___ ,
+ /*E70D*/ GENx___x___x___ ,
+ /*E70E*/ GENx___x___x900 ( "VST"       , VRX  , ASMFMT_VRX      , vector_store                                        ),
+ /*E70F*/ GENx___x___x___ ,
+ /*E710*/ GENx___x___x___ ,
+ /*E711*/ GENx___x___x___ ,
+ /*E712*/ GENx___x___x900 ( "VGEG"      , VRV  , ASMFMT_VRV      , vector_gather_element_64                            ),
+ /*E713*/ GENx___x___x900 ( "VGEF"      , VRV  , ASMFMT_VRV      , vector_gather_element_32                            ),
+ /*E714*/ GENx___x___x___ ,
+ /*E715*/ GENx___x___x___ ,
+ /*E716*/ GENx___x___x___ ,
+ /*E717*/ GENx___x___x___ ,
+ /*E718*/ GENx___x___x___ ,
+ /*E719*/ GENx___x___x___ ,
+ /*E71A*/ GENx___x___x900 ( "VSCEG"     , VRV  , ASMFMT_VRV      , vector_scatter_element_64                           ),
+ /*E71B*/ GENx___x___x900 ( "VSCEF"     , VRV  , ASMFMT_VRV      , vector_scatter_element_32                           ),
+ /*E71C*/ GENx___x___x___ ,
+ /*E71D*/ GENx___x___x___ ,
+ /*E71E*/ GENx___x___x___ ,
+ /*E71F*/ GENx___x___x___ ,
+ /*E720*/ GENx___x___x___ ,
+ /*E721*/ GENx___x___x900 ( "VLGV"      , VRS_c, ASMFMT_VRS_C    , vector_load_gr_from_vr_element                      ),
+ /*E722*/ GENx___x___x900 ( "VLVG"      , VRS_b, ASMFMT_VRS_B    , vector_load_vr_element_from_gr                      ),
+ /*E723*/ GENx___x___x___ ,
+ /*E724*/ GENx___x___x___ ,
+ /*E725*/ GENx___x___x___ ,
+ /*E726*/ GENx___x___x___ ,
+ /*E727*/ GENx___x___x900 ( "LCBB"      , RXE  , ASMFMT_RXE_M3   , load_count_to_block_boundary                        ),
+ /*E728*/ GENx___x___x___ ,
+ /*E729*/ GENx___x___x___ ,
+ /*E72A*/ GENx___x___x___ ,
+ /*E72B*/ GENx___x___x___ ,
+ /*E72C*/ GENx___x___x___ ,
+ /*E72D*/ GENx___x___x___ ,
+ /*E72E*/ GENx___x___x___ ,
+ /*E72F*/ GENx___x___x___ ,
+ /*E730*/ GENx___x___x900 ( "VESL"      , VRS_a, ASMFMT_VRS_A    , vector_element_shift_left                           ),
+ /*E731*/ GENx___x___x___ ,
+ /*E732*/ GENx___x___x___ ,
+ /*E733*/ GENx___x___x900 ( "VERLL"     , VRS_a, ASMFMT_VRS_A    , vector_element_rotate_left_logical                  ),
+ /*E734*/ GENx___x___x___ ,
+ /*E735*/ GENx___x___x___ ,
+ /*E736*/ GENx___x___x900 ( "VLM"       , VRS_a, ASMFMT_VRS_A    , vector_load_multiple                                ),
+ /*E737*/ GENx___x___x900 ( "VLL"       , VRS_b, ASMFMT_VRS_B    , vector_load_with_length                             ),
+ /*E738*/ GENx___x___x900 ( "VESRL"     , VRS_a, ASMFMT_VRS_A    , vector_element_shift_right_logical                  ),
+ /*E739*/ GENx___x___x___ ,
+ /*E73A*/ GENx___x___x900 ( "VESRA"     , VRS_a, ASMFMT_VRS_A    , vector_element_shift_right_arithmetic               ),
+ /*E73B*/ GENx___x___x___ ,
+ /*E73C*/ GENx___x___x___ ,
+ /*E73D*/ GENx___x___x___ ,
+ /*E73E*/ GENx___x___x900 ( "VSTM"      , VRS_a, ASMFMT_VRS_A    , vector_store_multiple                               ),
+ /*E73F*/ GENx___x___x900 ( "VSTL"      , VRS_b, ASMFMT_VRS_B    , vector_store_with_length                            ),
+ /*E740*/ GENx___x___x900 ( "VLEIB"     , VRI_a, ASMFMT_VRI_A    , vector_load_element_immediate_8                     ),
+ /*E741*/ GENx___x___x900 ( "VLEIH"     , VRI_a, ASMFMT_VRI_A    , vector_load_element_immediate_16                    ),
+ /*E742*/ GENx___x___x900 ( "VLEIG"     , VRI_a, ASMFMT_VRI_A    , vector_load_element_immediate_64                    ),
+ /*E743*/ GENx___x___x900 ( "VLEIF"     , VRI_a, ASMFMT_VRI_A    , vector_load_element_immediate_32                    ),
+ /*E744*/ GENx___x___x900 ( "VGBM"      , VRI_a, ASMFMT_VRI_A    , vector_generate_byte_mask                           ),
+ /*E745*/ GENx___x___x900 ( "VREPI"     , VRI_a, ASMFMT_VRI_A    , vector_replicate_immediate                          ),
+ /*E746*/ GENx___x___x900 ( "VGM"       , VRI_b, ASMFMT_VRI_B    , vector_generate_mask                                ),
+ /*E747*/ GENx___x___x___ ,
+ /*E748*/ GENx___x___x___ ,
+ /*E749*/ GENx___x___x___ ,
+ /*E74A*/ GENx___x___x900 ( "VFTCI"     , VRI_e, ASMFMT_VRI_E    , vector_fp_test_data_class_immediate                 ),
+ /*E74B*/ GENx___x___x___ ,
+ /*E74C*/ GENx___x___x___ ,
+ /*E74D*/ GENx___x___x900 ( "VREP"      , VRI_c, ASMFMT_VRI_C    , vector_replicate                                    ),
+ /*E74E*/ GENx___x___x___ ,
+ /*E74F*/ GENx___x___x___ ,
+ /*E750*/ GENx___x___x900 ( "VPOPCT"    , VRR_a, ASMFMT_VRR_A    , vector_population_count                             ),
+ /*E751*/ GENx___x___x___ ,
+ /*E752*/ GENx___x___x900 ( "VCTZ"      , VRR_a, ASMFMT_VRR_A    , vector_count_trailing_zeros                         ),
+ /*E753*/ GENx___x___x900 ( "VCLZ"      , VRR_a, ASMFMT_VRR_A    , vector_count_leading_zeros                          ),
+ /*E754*/ GENx___x___x___ ,
+ /*E755*/ GENx___x___x___ ,
+ /*E756*/ GENx___x___x900 ( "VLR"       , VRR_a, ASMFMT_VRR_A    , vector_load_vector                                  ),
+ /*E757*/ GENx___x___x___ ,
+ /*E758*/ GENx___x___x___ ,
+ /*E759*/ GENx___x___x___ ,
+ /*E75A*/ GENx___x___x___ ,
+ /*E75B*/ GENx___x___x___ ,
+ /*E75C*/ GENx___x___x900 ( "VISTR"     , VRR_a, ASMFMT_VRR_A    , vector_isolate_string                               ),
+ /*E75D*/ GENx___x___x___ ,
+ /*E75E*/ GENx___x___x___ ,
+ /*E75F*/ GENx___x___x900 ( "VSEG"      , VRR_a, ASMFMT_VRR_A    , vector_sign_extend_to_doubleword                    ),
+ /*E760*/ GENx___x___x900 ( "VMRL"      , VRR_c, ASMFMT_VRR_C    , vector_merge_low                                    ),
+ /*E761*/ GENx___x___x900 ( "VMRH"      , VRR_c, ASMFMT_VRR_C    , vector_merge_high                                   ),
+ /*E762*/ GENx___x___x900 ( "VLVGP"     , VRR_f, ASMFMT_VRR_F    , vector_load_vr_from_grs_disjoint                    ),
+ /*E763*/ GENx___x___x___ ,
+ /*E764*/ GENx___x___x900 ( "VSUM"      , VRR_c, ASMFMT_VRR_C    , vector_sum_across_word                              ),
+ /*E765*/ GENx___x___x900 ( "VSUMG"     , VRR_c, ASMFMT_VRR_C    , vector_sum_across_doubleword                        ),
+ /*E766*/ GENx___x___x900 ( "VCKSM"     , VRR_c, ASMFMT_VRR_C    , vector_checksum                                     ),
+ /*E767*/ GENx___x___x900 ( "VSUMQ"     , VRR_c, ASMFMT_VRR_C    , vector_sum_across_quadword                          ),
+ /*E768*/ GENx___x___x900 ( "VN"        , VRR_c, ASMFMT_VRR_C    , vector_and                                          ),
+ /*E769*/ GENx___x___x900 ( "VNC"       , VRR_c, ASMFMT_VRR_C    , vector_and_with_complement                          ),
+ /*E76A*/ GENx___x___x900 ( "VO"        , VRR_c, ASMFMT_VRR_C    , vector_or                                           ),
+ /*E76B*/ GENx___x___x900 ( "VNO"       , VRR_c, ASMFMT_VRR_C    , vector_nor                                          ),
+ /*E76C*/ GENx___x___x___ ,
+ /*E76D*/ GENx___x___x900 ( "VX"        , VRR_c, ASMFMT_VRR_C    , vector_exclusive_or                                 ),
+ /*E76E*/ GENx___x___x___ ,
+ /*E76F*/ GENx___x___x___ ,
+ /*E770*/ GENx___x___x900 ( "VESLV"     , VRR_c, ASMFMT_VRR_C    , vector_element_shift_left_vector                    ),
+ /*E771*/ GENx___x___x___ ,
+ /*E772*/ GENx___x___x900 ( "VERIM"     , VRI_d, ASMFMT_VRI_D    , vector_element_rotate_and_insert_under_mask         ),
+ /*E773*/ GENx___x___x900 ( "VERLLV"    , VRR_c, ASMFMT_VRR_C    , vector_element_rotate_left_logical_vector           ),
+ /*E774*/ GENx___x___x900 ( "VSL"       , VRR_c, ASMFMT_VRR_C    , vector_shift_left                                   ),
+ /*E775*/ GENx___x___x900 ( "VSLB"      , VRR_c, ASMFMT_VRR_C    , vector_shift_left_by_byte                           ),
+ /*E776*/ GENx___x___x___ ,
+ /*E777*/ GENx___x___x900 ( "VSLDB"     , VRI_d, ASMFMT_VRI_D    , vector_shift_left_double_by_byte                    ),
+ /*E778*/ GENx___x___x900 ( "VESRLV"    , VRR_c, ASMFMT_VRR_C    , vector_element_shift_right_logical_vector           ),
+ /*E779*/ GENx___x___x___ ,
+ /*E77A*/ GENx___x___x900 ( "VESRAV"    , VRR_c, ASMFMT_VRR_C    , vector_element_shift_right_arithmetic_vector        ),
+ /*E77B*/ GENx___x___x___ ,
+ /*E77C*/ GENx___x___x900 ( "VSRL"      , VRR_c, ASMFMT_VRR_C    , vector_shift_right_logical                          ),
+ /*E77D*/ GENx___x___x900 ( "VSRLB"     , VRR_c, ASMFMT_VRR_C    , vector_shift_right_logical_by_byte                  ),
+ /*E77E*/ GENx___x___x900 ( "VSRA"      , VRR_c, ASMFMT_VRR_C    , vector_shift_right_arithmetic                       ),
+ /*E77F*/ GENx___x___x900 ( "VSRAB"     , VRR_c, ASMFMT_VRR_C    , vector_shift_right_arithmetic_by_byte               ),
+ /*E780*/ GENx___x___x900 ( "VFEE"      , VRR_b, ASMFMT_VRR_B    , vector_find_element_equal                           ),
+ /*E781*/ GENx___x___x900 ( "VFENE"     , VRR_b, ASMFMT_VRR_B    , vector_find_element_not_equal                       ),
+ /*E782*/ GENx___x___x900 ( "VFAE"      , VRR_b, ASMFMT_VRR_B    , vector_find_any_element_equal                       ),
+ /*E783*/ GENx___x___x___ ,
+ /*E784*/ GENx___x___x900 ( "VPDI"      , VRR_c, ASMFMT_VRR_C    , vector_permute_doubleword_immediate                 ),
+ /*E785*/ GENx___x___x___ ,
+ /*E786*/ GENx___x___x___ ,
+ /*E787*/ GENx___x___x___ ,
+ /*E788*/ GENx___x___x___ ,
+ /*E789*/ GENx___x___x___ ,
+ /*E78A*/ GENx___x___x900 ( "VSTRC"     , VRR_d, ASMFMT_VRR_D    , vector_string_range_compare                         ),
+ /*E78B*/ GENx___x___x___ ,
+ /*E78C*/ GENx___x___x900 ( "VPERM"     , VRR_e, ASMFMT_VRR_E    , vector_permute                                      ),
+ /*E78D*/ GENx___x___x900 ( "VSEL"      , VRR_e, ASMFMT_VRR_E    , vector_select                                       ),
+ /*E78E*/ GENx___x___x900 ( "VFMS"      , VRR_e, ASMFMT_VRR_E    , vector_fp_multiply_and_subtract                     ),
+ /*E78F*/ GENx___x___x900 ( "VFMA"      , VRR_e, ASMFMT_VRR_E    , vector_fp_multiply_and_add                          ),
+ /*E790*/ GENx___x___x___ ,
+ /*E791*/ GENx___x___x___ ,
+ /*E792*/ GENx___x___x___ ,
+ /*E793*/ GENx___x___x___ ,
+ /*E794*/ GENx___x___x900 ( "VPK"       , VRR_c, ASMFMT_VRR_C    , vector_pack                                         ),
+ /*E795*/ GENx___x___x900 ( "VPKLS"     , VRR_b, ASMFMT_VRR_B    , vector_pack_logical_saturate                        ),
+ /*E796*/ GENx___x___x___ ,
+ /*E797*/ GENx___x___x900 ( "VPKS"      , VRR_b, ASMFMT_VRR_B    , vector_pack_saturate                                ),
+ /*E798*/ GENx___x___x___ ,
+ /*E799*/ GENx___x___x___ ,
+ /*E79A*/ GENx___x___x___ ,
+ /*E79B*/ GENx___x___x___ ,
+ /*E79C*/ GENx___x___x___ ,
+ /*E79D*/ GENx___x___x___ ,
+ /*E79E*/ GENx___x___x___ ,
+ /*E79F*/ GENx___x___x___ ,
+ /*E7A0*/ GENx___x___x___ ,
+ /*E7A1*/ GENx___x___x900 ( "VMLH"      , VRR_c, ASMFMT_VRR_C    , vector_multiply_logical_high                        ),
+ /*E7A2*/ GENx___x___x900 ( "VML"       , VRR_c, ASMFMT_VRR_C    , vector_multiply_low                                 ),
+ /*E7A3*/ GENx___x___x900 ( "VMH"       , VRR_c, ASMFMT_VRR_C    , vector_multiply_high                                ),
+ /*E7A4*/ GENx___x___x900 ( "VMLE"      , VRR_c, ASMFMT_VRR_C    , vector_multiply_logical_even                        ),
+ /*E7A5*/ GENx___x___x900 ( "VMLO"      , VRR_c, ASMFMT_VRR_C    , vector_multiply_logical_odd                         ),
+ /*E7A6*/ GENx___x___x900 ( "VME"       , VRR_c, ASMFMT_VRR_C    , vector_multiply_even                                ),
+ /*E7A7*/ GENx___x___x900 ( "VMO"       , VRR_c, ASMFMT_VRR_C    , vector_multiply_odd                                 ),
+ /*E7A8*/ GENx___x___x___ ,
+ /*E7A9*/ GENx___x___x900 ( "VMALH"     , VRR_d, ASMFMT_VRR_D    , vector_multiply_and_add_logical_high                ),
+ /*E7AA*/ GENx___x___x900 ( "VMAL"      , VRR_d, ASMFMT_VRR_D    , vector_multiply_and_add_low                         ),
+ /*E7AB*/ GENx___x___x900 ( "VMAH"      , VRR_d, ASMFMT_VRR_D    , vector_multiply_and_add_high                        ),
+ /*E7AC*/ GENx___x___x900 ( "VMALE"     , VRR_d, ASMFMT_VRR_D    , vector_multiply_and_add_logical_even                ),
+ /*E7AD*/ GENx___x___x900 ( "VMALO"     , VRR_d, ASMFMT_VRR_D    , vector_multiply_and_add_logical_odd                 ),
+ /*E7AE*/ GENx___x___x900 ( "VMAE"      , VRR_d, ASMFMT_VRR_D    , vector_multiply_and_add_even                        ),
+ /*E7AF*/ GENx___x___x900 ( "VMAO"      , VRR_d, ASMFMT_VRR_D    , vector_multiply_and_add_odd                         ),
+ /*E7B0*/ GENx___x___x___ ,
+ /*E7B1*/ GENx___x___x___ ,
+ /*E7B2*/ GENx___x___x___ ,
+ /*E7B3*/ GENx___x___x___ ,
+ /*E7B4*/ GENx___x___x900 ( "VGFM"      , VRR_c, ASMFMT_VRR_C    , vector_galois_field_multiply_sum                    ),
+ /*E7B5*/ GENx___x___x___ ,
+ /*E7B6*/ GENx___x___x___ ,
+ /*E7B7*/ GENx___x___x___ ,
+ /*E7B8*/ GENx___x___x___ ,
+ /*E7B9*/ GENx___x___x900 ( "VACCC"     , VRR_d, ASMFMT_VRR_D    , vector_add_with_carry_compute_carry                 ),
+ /*E7BA*/ GENx___x___x___ ,
+ /*E7BB*/ GENx___x___x900 ( "VAC"       , VRR_d, ASMFMT_VRR_D    , vector_add_with_carry                               ),
+ /*E7BC*/ GENx___x___x900 ( "VGFMA"     , VRR_d, ASMFMT_VRR_D    , vector_galois_field_multiply_sum_and_accumulate     ),
+ /*E7BD*/ GENx___x___x900 ( "VSBCBI"    , VRR_d, ASMFMT_VRR_D    , vector_subtract_with_borrow_compute_borrow_indication ),
+ /*E7BE*/ GENx___x___x___ ,
+ /*E7BF*/ GENx___x___x900 ( "VSBI"      , VRR_d, ASMFMT_VRR_D    , vector_subtract_with_borrow_indication              ),
+ /*E7C0*/ GENx___x___x900 ( "VCLGD"     , VRR_a, ASMFMT_VRR_A    , vector_fp_convert_to_logical_64                     ),
+ /*E7C1*/ GENx___x___x900 ( "VCDLG"     , VRR_a, ASMFMT_VRR_A    , vector_fp_convert_from_logical_64                   ),
+ /*E7C2*/ GENx___x___x900 ( "VCGD"      , VRR_a, ASMFMT_VRR_A    , vector_fp_convert_to_fixed_64                       ),
+ /*E7C3*/ GENx___x___x900 ( "VCDG"      , VRR_a, ASMFMT_VRR_A    , vector_fp_convert_from_fixed_64                     ),
+ /*E7C4*/ GENx___x___x900 ( "VFLL"      , VRR_a, ASMFMT_VRR_A    , vector_fp_load_lengthened                           ),
+ /*E7C5*/ GENx___x___x900 ( "VFLR"      , VRR_a, ASMFMT_VRR_A    , vector_fp_load_rounded                              ),
+ /*E7C6*/ GENx___x___x___ ,
+ /*E7C7*/ GENx___x___x900 ( "VFI"       , VRR_a, ASMFMT_VRR_A    , vector_load_fp_integer                              ),
+ /*E7C8*/ GENx___x___x___ ,
+ /*E7C9*/ GENx___x___x___ ,
+ /*E7CA*/ GENx___x___x900 ( "WFK"       , VRR_a, ASMFMT_VRR_A    , vector_fp_compare_and_signal_scalar                 ),
+ /*E7CB*/ GENx___x___x900 ( "WFC"       , VRR_a, ASMFMT_VRR_A    , vector_fp_compare_scalar                            ),
+ /*E7CC*/ GENx___x___x900 ( "VFPSO"     , VRR_a, ASMFMT_VRR_A    , vector_fp_perform_sign_operation                    ),
+ /*E7CD*/ GENx___x___x___ ,
+ /*E7CE*/ GENx___x___x900 ( "VFSQ"      , VRR_a, ASMFMT_VRR_A    , vector_fp_square_root                               ),
+ /*E7CF*/ GENx___x___x___ ,
+ /*E7D0*/ GENx___x___x___ ,
+ /*E7D1*/ GENx___x___x___ ,
+ /*E7D2*/ GENx___x___x___ ,
+ /*E7D3*/ GENx___x___x___ ,
+ /*E7D4*/ GENx___x___x900 ( "VUPLL"     , VRR_a, ASMFMT_VRR_A    , vector_unpack_logical_low                           ),
+ /*E7D5*/ GENx___x___x900 ( "VUPLH"     , VRR_a, ASMFMT_VRR_A    , vector_unpack_logical_high                          ),
+ /*E7D6*/ GENx___x___x900 ( "VUPL"      , VRR_a, ASMFMT_VRR_A    , vector_unpack_low                                   ),
+ /*E7D7*/ GENx___x___x900 ( "VUPH"      , VRR_a, ASMFMT_VRR_A    , vector_unpack_high                                  ),
+ /*E7D8*/ GENx___x___x900 ( "VTM"       , VRR_a, ASMFMT_VRR_A    , vector_test_under_mask                              ),
+ /*E7D9*/ GENx___x___x900 ( "VECL"      , VRR_a, ASMFMT_VRR_A    , vector_element_compare_logical                      ),
+ /*E7DA*/ GENx___x___x___ ,
+ /*E7DB*/ GENx___x___x900 ( "VEC"       , VRR_a, ASMFMT_VRR_A    , vector_element_compare                              ),
+ /*E7DC*/ GENx___x___x___ ,
+ /*E7DD*/ GENx___x___x___ ,
+ /*E7DE*/ GENx___x___x900 ( "VLC"       , VRR_a, ASMFMT_VRR_A    , vector_load_complement                              ),
+ /*E7DF*/ GENx___x___x900 ( "VLP"       , VRR_a, ASMFMT_VRR_A    , vector_load_positive                                ),
+ /*E7E0*/ GENx___x___x___ ,
+ /*E7E1*/ GENx___x___x___ ,
+ /*E7E2*/ GENx___x___x900 ( "VFS"       , VRR_c, ASMFMT_VRR_C    , vector_fp_subtract                                  ),
+ /*E7E3*/ GENx___x___x900 ( "VFA"       , VRR_c, ASMFMT_VRR_C    , vector_fp_add                                       ),
+ /*E7E4*/ GENx___x___x___ ,
+ /*E7E5*/ GENx___x___x900 ( "VFD"       , VRR_c, ASMFMT_VRR_C    , vector_fp_divide                                    ),
+ /*E7E6*/ GENx___x___x___ ,
+ /*E7E7*/ GENx___x___x900 ( "VFM"       , VRR_c, ASMFMT_VRR_C    , vector_fp_multiply                                  ),
+ /*E7E8*/ GENx___x___x900 ( "VFCE"      , VRR_c, ASMFMT_VRR_C    , vector_fp_compare_equal                             ),
+ /*E7E9*/ GENx___x___x___ ,
+ /*E7EA*/ GENx___x___x900 ( "VFCHE"     , VRR_c, ASMFMT_VRR_C    , vector_fp_compare_high_or_equal                     ),
+ /*E7EB*/ GENx___x___x900 ( "VFCH"      , VRR_c, ASMFMT_VRR_C    , vector_fp_compare_high                              ),
+ /*E7EC*/ GENx___x___x___ ,
+ /*E7ED*/ GENx___x___x___ ,
+ /*E7EE*/ GENx___x___x___ ,
+ /*E7EF*/ GENx___x___x___ ,
+ /*E7F0*/ GENx___x___x900 ( "VAVGL"     , VRR_c, ASMFMT_VRR_C    , vector_average_logical                              ),
+ /*E7F1*/ GENx___x___x900 ( "VACC"      , VRR_c, ASMFMT_VRR_C    , vector_add_compute_carry                            ),
+ /*E7F2*/ GENx___x___x900 ( "VAVG"      , VRR_c, ASMFMT_VRR_C    , vector_average                                      ),
+ /*E7F3*/ GENx___x___x900 ( "VA"        , VRR_c, ASMFMT_VRR_C    , vector_add                                          ),
+ /*E7F4*/ GENx___x___x___ ,
+ /*E7F5*/ GENx___x___x900 ( "VSCBI"     , VRR_c, ASMFMT_VRR_C    , vector_subtract_compute_borrow_indication           ),
+ /*E7F6*/ GENx___x___x___ ,
+ /*E7F7*/ GENx___x___x900 ( "VS"        , VRR_c, ASMFMT_VRR_C    , vector_subtract                                     ),
+ /*E7F8*/ GENx___x___x900 ( "VCEQ"      , VRR_b, ASMFMT_VRR_B    , vector_compare_equal                                ),
+ /*E7F9*/ GENx___x___x900 ( "VCHL"      , VRR_b, ASMFMT_VRR_B    , vector_compare_high_logical                         ),
+ /*E7FA*/ GENx___x___x___ ,
+ /*E7FB*/ GENx___x___x900 ( "VCH"       , VRR_b, ASMFMT_VRR_B    , vector_compare_high                                 ),
+ /*E7FC*/ GENx___x___x900 ( "VMNL"      , VRR_c, ASMFMT_VRR_C    , vector_minimum_logical                              ),
+ /*E7FD*/ GENx___x___x900 ( "VMXL"      , VRR_c, ASMFMT_VRR_C    , vector_maximum_logical                              ),
+ /*E7FE*/ GENx___x___x900 ( "VMN"       , VRR_c, ASMFMT_VRR_C    , vector_minimum                                      ),
+ /*E7FF*/ GENx___x___x900 ( "VMX"       , VRR_c, ASMFMT_VRR_C    , vector_maximum                                      )
+};
+
 static INSTR_FUNC gen_opcode_ebxx[256][NUM_INSTR_TAB_PTRS] =
 {
  /*EB00*/ GENx___x___x___ ,
@@ -6726,6 +7769,18 @@ static INSTR_FUNC gen_opcode_E3_0______24[1][NUM_INSTR_TAB_PTRS] =
 
 #endif /* OPTION_OPTINST */
 
+#if defined( OPTION_COMPACT_OPCODE_DISPATCH )
+
+// Compact two-level dispatch second level jump "instructions"
+
+static INSTR_FUNC gen_opcode_xx_2nd[2][NUM_INSTR_TAB_PTRS] =
+{
+ /*xxyy*/ GENx370x390x900 ( ""          , none , ASMFMT_none     , execute_opcode_xx_yy                                ),
+ /*xx_y*/ GENx370x390x900 ( ""          , none , ASMFMT_none     , execute_opcode_xx__y                                )
+};
+
+#endif /* defined( OPTION_COMPACT_OPCODE_DISPATCH ) */
+
 /*-------------------------------------------------------------------*/
 /*                     runtime opcode tables                         */
 /*-------------------------------------------------------------------*/
@@ -6754,6 +7809,8 @@ static INSTR_FUNC gen_opcode_E3_0______24[1][NUM_INSTR_TAB_PTRS] =
 static INSTR_FUNC runtime_opcode_xxxx[NUM_GEN_ARCHS][256 * 256];
 
 static INSTR_FUNC runtime_opcode_e3________xx[NUM_GEN_ARCHS][256];
+static INSTR_FUNC runtime_opcode_e6________xx[NUM_GEN_ARCHS][256];
+static INSTR_FUNC runtime_opcode_e7________xx[NUM_GEN_ARCHS][256];
 static INSTR_FUNC runtime_opcode_eb________xx[NUM_GEN_ARCHS][256];
 static INSTR_FUNC runtime_opcode_ec________xx[NUM_GEN_ARCHS][256];
 static INSTR_FUNC runtime_opcode_ed________xx[NUM_GEN_ARCHS][256];
@@ -6762,6 +7819,81 @@ static INSTR_FUNC runtime_opcode_ed________xx[NUM_GEN_ARCHS][256];
 static INSTR_FUNC runtime_opcode_e3_0______xx[NUM_GEN_ARCHS][256];
 #endif
 
+#if defined( OPTION_COMPACT_OPCODE_DISPATCH )
+/*-------------------------------------------------------------------*/
+/*              compact two-level runtime opcode tables              */
+/*-------------------------------------------------------------------*/
+/*                                                                   */
+/* The 64K-entry runtime_opcode_xxxx table above is 512K per build   */
+/* architecture and is indexed by the first halfword of each and     */
+/* every instruction. Since the second byte of most instructions is  */
+/* an operand (register/index field) and not an extended opcode, the */
+/* same instruction will hit a different cache line depending on     */
+/* which registers it happens to use, causing the table to occupy    */
+/* far more of the host's L1/L2 cache than it should.                */
+/*                                                                   */
+/* In compact dispatch mode the runtime_opcode_xxxx table remains    */
+/* the master table (modified as always via the 'replace_opcode'     */
+/* functions) but the instruction dispatcher instead uses the below  */
+/* 256-entry primary table which is indexed by only the first byte   */
+/* of the instruction. Only those opcodes whose instruction function */
+/* actually depends on the second byte (01xx, A5_x, A7_x, B2xx, B3xx */
+/* B9xx, C0_x-CC_x, E5xx, E6xx and the optimized instructions) get a */
+/* secondary table, which the primary table's 'execute_opcode_xx_yy' */
+/* or 'execute_opcode_xx__y' jump "instruction" then indexes into.   */
+/* The E3, E7, EB, EC and ED opcodes (extended opcode in the 6th     */
+/* byte) continue to use their existing jump "instructions", the     */
+/* 'execute_opcode_xx________xx' ones.                               */
+/*                                                                   */
+/* Secondary tables are allocated sequentially from a pool so that   */
+/* the ones actually used are contiguous in storage.                 */
+/*                                                                   */
+/*-------------------------------------------------------------------*/
+
+static INSTR_FUNC        runtime_opcode_xx      [NUM_GEN_ARCHS][256];
+static const INSTR_FUNC* runtime_opcode_xx_2nd  [NUM_GEN_ARCHS][256];
+static INSTR_FUNC        runtime_opcode_xx_pool [NUM_GEN_ARCHS][256][256];
+static int               runtime_opcode_xx_used [NUM_GEN_ARCHS];
+
+/*-------------------------------------------------------------------*/
+/*  Rebuild compact opcode table entry from master runtime table     */
+/*-------------------------------------------------------------------*/
+static void rebuild_opcode_xx( int arch, int opcode1 )
+{
+  INSTR_FUNC*  xxxx = &runtime_opcode_xxxx[ arch ][ opcode1 * 256 ];
+  INSTR_FUNC*  pool;
+  bool  uniform = true;       /* Same function for all 2nd bytes     */
+  bool  nibble  = true;       /* Depends only on low 4 bits of 2nd   */
+  int   i;
+
+  for (i=1; i < 256; i++)
+  {
+    if (xxxx[i] != xxxx[0])
+      uniform = false;
+    if (xxxx[i] != xxxx[i & 0x0F])
+      nibble = false;
+  }
+
+  if (uniform)
+  {
+    runtime_opcode_xx[ arch ][ opcode1 ] = xxxx[0];
+    return;
+  }
+
+  /* Assign a secondary table from the pool if not done already */
+  if (!runtime_opcode_xx_2nd[ arch ][ opcode1 ])
+    runtime_opcode_xx_2nd[ arch ][ opcode1 ] =
+      runtime_opcode_xx_pool[ arch ][ runtime_opcode_xx_used[ arch ]++ ];
+
+  pool = (INSTR_FUNC*) runtime_opcode_xx_2nd[ arch ][ opcode1 ];
+  memcpy( pool, xxxx, 256 * sizeof( INSTR_FUNC ));
+
+  /* Secondary table must be filled in BEFORE primary entry updated */
+  runtime_opcode_xx[ arch ][ opcode1 ] = nibble ? gen_opcode_xx_2nd[1][ arch ]
+                                                : gen_opcode_xx_2nd[0][ arch ];
+}
+#endif /* defined( OPTION_COMPACT_OPCODE_DISPATCH ) */
+
 /*-------------------------------------------------------------------*/
 /*                Opcode Table Replacement Functions                 */
 /*-------------------------------------------------------------------*/
@@ -6865,6 +7997,18 @@ static INSTR_FUNC replace_opcode_xx________xx( int arch, INSTR_FUNC inst, int op
                       runtime_opcode_e3________xx[arch][opcode2] = inst;
             break;
         }
+        case 0xe6:
+        {
+            oldinst = runtime_opcode_e6________xx[arch][opcode2];
+                      runtime_opcode_e6________xx[arch][opcode2] = inst;
+            break;
+        }
+        case 0xe7:
+        {
+            oldinst = runtime_opcode_e7________xx[arch][opcode2];
+                      runtime_opcode_e7________xx[arch][opcode2] = inst;
+            break;
+        }
         case 0xeb:
         {
             oldinst = runtime_opcode_eb________xx[arch][opcode2];
@@ -6897,7 +8041,7 @@ static INSTR_FUNC replace_opcode_xx________xx( int arch, INSTR_FUNC inst, int op
 /*-------------------------------------------------------------------*/
 /* Called by hdl.c for dynamic instruction modules such as dyncrypt  */
 /*-------------------------------------------------------------------*/
-DLL_EXPORT void* the_real_replace_opcode( int arch, INSTR_FUNC inst, int opcode1, int opcode2 )
+static void* replace_opcode_any( int arch, INSTR_FUNC inst, int opcode1, int opcode2 )
 {
   switch(opcode1)
   {
@@ -6909,12 +8053,19 @@ DLL_EXPORT void* the_real_replace_opcode( int arch, INSTR_FUNC inst, int opcode1
     case 0xb9:
     case 0xe4:
     case 0xe5:
-    case 0xe6:
 
     {
       return(replace_opcode_xxxx(arch, inst, opcode1, opcode2));
     }
 
+    case 0xe6:
+    {
+      if(arch == ARCH_900_IDX)
+        return(replace_opcode_xx________xx(arch, inst, opcode1, opcode2));
+
+      return(replace_opcode_xxxx(arch, inst, opcode1, opcode2));
+    }
+
     case 0xa5:
     {
       if(arch == ARCH_900_IDX)
@@ -6941,6 +8092,7 @@ DLL_EXPORT void* the_real_replace_opcode( int arch, INSTR_FUNC inst, int opcode1
     }
 
     case 0xe3:
+    case 0xe7:
     case 0xeb:
     case 0xec:
     case 0xed:
@@ -6958,6 +8110,18 @@ DLL_EXPORT void* the_real_replace_opcode( int arch, INSTR_FUNC inst, int opcode1
   UNREACHABLE_CODE( return NULL );
 }
 
+DLL_EXPORT void* the_real_replace_opcode( int arch, INSTR_FUNC inst, int opcode1, int opcode2 )
+{
+  void* oldinst = replace_opcode_any( arch, inst, opcode1, opcode2 );
+
+#if defined( OPTION_COMPACT_OPCODE_DISPATCH )
+  if (oldinst && opcode1 >= 0 && opcode1 <= 0xff)
+    rebuild_opcode_xx( arch, opcode1 );
+#endif
+
+  return oldinst;
+}
+
 /*-------------------------------------------------------------------*/
 /*  init_runtime_opcode_tables  --  called by impl.c function impl   */
 /*-------------------------------------------------------------------*/
@@ -7034,7 +8198,15 @@ void init_runtime_opcode_tables()
         replace_opcode_xxxx(arch, gen_v_opcode_e4xx[i][arch], 0xe4, i);
 
       replace_opcode_xxxx(arch, gen_opcode_e5xx[i][arch], 0xe5, i);
-      replace_opcode_xxxx(arch, gen_opcode_e6xx[i][arch], 0xe6, i);
+
+      // E6 is ECPS:VM in S/370 but vector decimal in z/Arch
+
+      if(arch == ARCH_900_IDX)
+        replace_opcode_xx________xx(arch, gen_opcode_e6________xx[i][arch], 0xe6, i);
+      else
+        replace_opcode_xxxx(arch, gen_opcode_e6xx[i][arch], 0xe6, i);
+
+      replace_opcode_xx________xx(arch, gen_opcode_e7xx[i][arch], 0xe7, i);
       replace_opcode_xx________xx(arch, gen_opcode_ebxx[i][arch], 0xeb, i);
       replace_opcode_xx________xx(arch, gen_opcode_ecxx[i][arch], 0xec, i);
       replace_opcode_xx________xx(arch, gen_opcode_edxx[i][arch], 0xed, i);
@@ -7118,6 +8290,15 @@ void init_runtime_opcode_tables()
 #endif /* !defined( OPTION_NO_E3_OPTINST ) */
 
 #endif /* defined( OPTION_OPTINST ) */
+
+#if defined( OPTION_COMPACT_OPCODE_DISPATCH )
+
+    // Compact two-level dispatch tables (derived from above)
+
+    for(i = 0; i < 256; i++)
+      rebuild_opcode_xx(arch, i);
+
+#endif /* defined( OPTION_COMPACT_OPCODE_DISPATCH ) */
   }
 }
 
@@ -7146,22 +8327,37 @@ void init_regs_runtime_opcode_pointers( REGS* regs )
 
   regs->s370_runtime_opcode_xxxx         = runtime_opcode_xxxx        [ARCH_370_IDX];
   regs->s370_runtime_opcode_e3________xx = runtime_opcode_e3________xx[ARCH_370_IDX];
+  regs->s370_runtime_opcode_e6________xx = runtime_opcode_e6________xx[ARCH_370_IDX];
+  regs->s370_runtime_opcode_e7________xx = runtime_opcode_e7________xx[ARCH_370_IDX];
   regs->s370_runtime_opcode_eb________xx = runtime_opcode_eb________xx[ARCH_370_IDX];
   regs->s370_runtime_opcode_ec________xx = runtime_opcode_ec________xx[ARCH_370_IDX];
   regs->s370_runtime_opcode_ed________xx = runtime_opcode_ed________xx[ARCH_370_IDX];
 
   regs->s390_runtime_opcode_xxxx         = runtime_opcode_xxxx        [ARCH_390_IDX];
   regs->s390_runtime_opcode_e3________xx = runtime_opcode_e3________xx[ARCH_390_IDX];
+  regs->s390_runtime_opcode_e6________xx = runtime_opcode_e6________xx[ARCH_390_IDX];
+  regs->s390_runtime_opcode_e7________xx = runtime_opcode_e7________xx[ARCH_390_IDX];
   regs->s390_runtime_opcode_eb________xx = runtime_opcode_eb________xx[ARCH_390_IDX];
   regs->s390_runtime_opcode_ec________xx = runtime_opcode_ec________xx[ARCH_390_IDX];
   regs->s390_runtime_opcode_ed________xx = runtime_opcode_ed________xx[ARCH_390_IDX];
 
   regs->z900_runtime_opcode_xxxx         = runtime_opcode_xxxx        [ARCH_900_IDX];
   regs->z900_runtime_opcode_e3________xx = runtime_opcode_e3________xx[ARCH_900_IDX];
+  regs->z900_runtime_opcode_e6________xx = runtime_opcode_e6________xx[ARCH_900_IDX];
+  regs->z900_runtime_opcode_e7________xx = runtime_opcode_e7________xx[ARCH_900_IDX];
   regs->z900_runtime_opcode_eb________xx = runtime_opcode_eb________xx[ARCH_900_IDX];
   regs->z900_runtime_opcode_ec________xx = runtime_opcode_ec________xx[ARCH_900_IDX];
   regs->z900_runtime_opcode_ed________xx = runtime_opcode_ed________xx[ARCH_900_IDX];
 
+#if defined( OPTION_COMPACT_OPCODE_DISPATCH )
+  regs->s370_runtime_opcode_xx           = runtime_opcode_xx          [ARCH_370_IDX];
+  regs->s370_runtime_opcode_xx_2nd       = runtime_opcode_xx_2nd      [ARCH_370_IDX];
+  regs->s390_runtime_opcode_xx           = runtime_opcode_xx          [ARCH_390_IDX];
+  regs->s390_runtime_opcode_xx_2nd       = runtime_opcode_xx_2nd      [ARCH_390_IDX];
+  regs->z900_runtime_opcode_xx           = runtime_opcode_xx          [ARCH_900_IDX];
+  regs->z900_runtime_opcode_xx_2nd       = runtime_opcode_xx_2nd      [ARCH_900_IDX];
+#endif
+
 #if defined( OPTION_OPTINST ) && !defined( OPTION_NO_E3_OPTINST )
   regs->s370_runtime_opcode_e3_0______xx = runtime_opcode_e3_0______xx[ARCH_370_IDX];
   regs->s390_runtime_opcode_e3_0______xx = runtime_opcode_e3_0______xx[ARCH_390_IDX];
@@ -224,181 +224,135 @@ OPCD_DLL_IMPORT int iprint_router_func( int arch_mode, BYTE inst[], char mnemoni
 /*-------------------------------------------------------------------*/
 /*               Individual instruction counting                     */
 /*-------------------------------------------------------------------*/
+/* Each CPU counts into its own IMAPS block (sysblk.imaps[cpuad]),   */
+/* so there is no cache line contention between CPUs; the icount     */
+/* command merges them when it displays or exports them. Execution   */
+/* time is measured in host cycles (see host_cycles() in clock.h),   */
+/* but only for one in every sysblk.icount_sample instructions.      */
+/* END_COUNT_INSTR must not look at '_inst' again since 'ip' has     */
+/* usually been advanced to the next instruction by then.            */
+/*-------------------------------------------------------------------*/
 
 #if defined( OPTION_INSTR_COUNT_AND_TIME )
 
+/* IMAPS slots: one per opcode. Extended opcodes are grouped by     */
+/* first byte like our opcode tables: 256 slots when the second (or  */
+/* sixth for E3/E7/EB/EC/ED) opcode byte is a full byte, 16 when it  */
+/* is a nibble.                                                      */
+enum
+{
+    IMAP_XX =           0,              /* (all other opcodes)       */
+    IMAP_01 = IMAP_XX + 256,
+    IMAP_A4 = IMAP_01 + 256,
+    IMAP_A5 = IMAP_A4 + 256,
+    IMAP_A6 = IMAP_A5 +  16,
+    IMAP_A7 = IMAP_A6 + 256,
+    IMAP_B2 = IMAP_A7 +  16,
+    IMAP_B3 = IMAP_B2 + 256,
+    IMAP_B9 = IMAP_B3 + 256,
+    IMAP_C0 = IMAP_B9 + 256,
+    IMAP_C2 = IMAP_C0 +  16,
+    IMAP_C4 = IMAP_C2 +  16,
+    IMAP_C6 = IMAP_C4 +  16,
+    IMAP_C8 = IMAP_C6 +  16,
+    IMAP_E3 = IMAP_C8 +  16,
+    IMAP_E4 = IMAP_E3 + 256,
+    IMAP_E5 = IMAP_E4 + 256,
+    IMAP_E7 = IMAP_E5 + 256,
+    IMAP_EB = IMAP_E7 + 256,
+    IMAP_EC = IMAP_EB + 256,
+    IMAP_ED = IMAP_EC + 256,
+    IMAP_SLOTS = IMAP_ED + 256
+};
+
+#define IMAP_HIST   16                  /* log2 cycle histogram size */
+
+static INLINE int imap_slot( BYTE inst[] )
+{
+    switch (inst[0])
+    {
+    case 0x01: return IMAP_01 +  inst[1];
+    case 0xA4: return IMAP_A4 +  inst[1];
+    case 0xA5: return IMAP_A5 + (inst[1] & 0x0F);
+    case 0xA6: return IMAP_A6 +  inst[1];
+    case 0xA7: return IMAP_A7 + (inst[1] & 0x0F);
+    case 0xB2: return IMAP_B2 +  inst[1];
+    case 0xB3: return IMAP_B3 +  inst[1];
+    case 0xB9: return IMAP_B9 +  inst[1];
+    case 0xC0: return IMAP_C0 + (inst[1] & 0x0F);
+    case 0xC2: return IMAP_C2 + (inst[1] & 0x0F);
+    case 0xC4: return IMAP_C4 + (inst[1] & 0x0F);
+    case 0xC6: return IMAP_C6 + (inst[1] & 0x0F);
+    case 0xC8: return IMAP_C8 + (inst[1] & 0x0F);
+    case 0xE3: return IMAP_E3 +  inst[5];
+    case 0xE4: return IMAP_E4 +  inst[1];
+    case 0xE5: return IMAP_E5 +  inst[1];
+    case 0xE7: return IMAP_E7 +  inst[5];
+    case 0xEB: return IMAP_EB +  inst[5];
+    case 0xEC: return IMAP_EC +  inst[5];
+    case 0xED: return IMAP_ED +  inst[5];
+    default:   return IMAP_XX +  inst[0];
+    }
+}
+
 #define BEG_COUNT_INSTR( _inst, _regs )                             \
     do                                                              \
     {                                                               \
-        if (sysblk.icount)                                          \
+        IMAPS* imaps;                                               \
+        if (sysblk.icount && (imaps = sysblk.imaps[(_regs)->cpuad]))\
         {                                                           \
-            U64 used;                                               \
-            gettimeofday(&sysblk.start_time, NULL);                 \
-            switch ((_inst)[0]) {                                   \
-            case 0x01:                                              \
-                used = sysblk.imaps.imap01[(_inst)[1]]++;           \
-                break;                                              \
-            case 0xA4:                                              \
-                used = sysblk.imaps.imapa4[(_inst)[1]]++;           \
-                break;                                              \
-            case 0xA5:                                              \
-                used = sysblk.imaps.imapa5[(_inst)[1] & 0x0F]++;    \
-                break;                                              \
-            case 0xA6:                                              \
-                used = sysblk.imaps.imapa6[(_inst)[1]]++;           \
-                break;                                              \
-            case 0xA7:                                              \
-                used = sysblk.imaps.imapa7[(_inst)[1] & 0x0F]++;    \
-                break;                                              \
-            case 0xB2:                                              \
-                used = sysblk.imaps.imapb2[(_inst)[1]]++;           \
-                break;                                              \
-            case 0xB3:                                              \
-                used = sysblk.imaps.imapb3[(_inst)[1]]++;           \
-                break;                                              \
-            case 0xB9:                                              \
-                used = sysblk.imaps.imapb9[(_inst)[1]]++;           \
-                break;                                              \
-            case 0xC0:                                              \
-                used = sysblk.imaps.imapc0[(_inst)[1] & 0x0F]++;    \
-                break;                                              \
-            case 0xC2:                                              \
-                used = sysblk.imaps.imapc2[(_inst)[1] & 0x0F]++;    \
-                break;                                              \
-            case 0xC4:                                              \
-                used = sysblk.imaps.imapc4[(_inst)[1] & 0x0F]++;    \
-                break;                                              \
-            case 0xC6:                                              \
-                used = sysblk.imaps.imapc6[(_inst)[1] & 0x0F]++;    \
-                break;                                              \
-            case 0xC8:                                              \
-                used = sysblk.imaps.imapc8[(_inst)[1] & 0x0F]++;    \
-                break;                                              \
-            case 0xE3:                                              \
-                used = sysblk.imaps.imape3[(_inst)[5]]++;           \
-                break;                                              \
-            case 0xE4:                                              \
-                used = sysblk.imaps.imape4[(_inst)[1]]++;           \
-                break;                                              \
-            case 0xE5:                                              \
-                used = sysblk.imaps.imape5[(_inst)[1]]++;           \
-                break;                                              \
-            case 0xE7:                                              \
-                used = sysblk.imaps.imape7[(_inst)[5]]++;           \
-                break;                                              \
-            case 0xEB:                                              \
-                used = sysblk.imaps.imapeb[(_inst)[5]]++;           \
-                break;                                              \
-            case 0xEC:                                              \
-                used = sysblk.imaps.imapec[(_inst)[5]]++;           \
-                break;                                              \
-            case 0xED:                                              \
-                used = sysblk.imaps.imaped[(_inst)[5]]++;           \
-                break;                                              \
-            default:                                                \
-                used = sysblk.imaps.imapxx[(_inst)[0]]++;           \
-            }                                                       \
+            int slot = imap_slot( (_inst) );                        \
                                                                     \
-            if (!used)                                              \
+            if (!imaps->count[ slot ]++)                            \
             {                                                       \
                 /* "%s" */                                          \
                 WRMSG( HHC02292, "I", "First use" );                \
                 ARCH_DEP( display_inst )( (_regs), (_inst) );       \
             }                                                       \
+                                                                    \
+            if (!--imaps->countdown)                                \
+            {                                                       \
+                imaps->slot      = slot;                            \
+                imaps->start     = host_cycles();                   \
+                /* Jitter the interval to avoid aliasing with */    \
+                /* loops; it still averages icount_sample     */    \
+                imaps->countdown = 1 + (U32)(imaps->start %         \
+                                   (2 * sysblk.icount_sample - 1)); \
+            }                                                       \
+            else                                                    \
+                imaps->slot = -1;                                   \
         }                                                           \
     } while (0)
 
-#else // !defined( OPTION_INSTR_COUNT_AND_TIME )
-
-#define BEG_COUNT_INSTR(_inst, _regs)
-
-#endif // defined( OPTION_INSTR_COUNT_AND_TIME )
-
-#if defined( OPTION_INSTR_COUNT_AND_TIME )
-
-#define END_COUNT_INSTR(_inst, _regs)                               \
+#define END_COUNT_INSTR( _inst, _regs )                             \
     do                                                              \
     {                                                               \
-        if (sysblk.icount)                                          \
+        IMAPS* imaps;                                               \
+        if (1                                                       \
+            && sysblk.icount                                        \
+            && (imaps = sysblk.imaps[(_regs)->cpuad])               \
+            && imaps->slot >= 0                                     \
+        )                                                           \
         {                                                           \
-            struct timeval end_time;                                \
-            struct timeval dur;                                     \
-            U64 elapsed_usecs;                                      \
+            U64 cycles = host_cycles() - imaps->start;              \
+            U64 c      = cycles;                                    \
+            int bucket = 0;                                         \
                                                                     \
-            gettimeofday(&end_time, NULL);                          \
-            timeval_subtract(&sysblk.start_time, &end_time, &dur);  \
-            elapsed_usecs = (dur.tv_sec * 1000000) + dur.tv_usec;   \
+            while (c > 1 && bucket < IMAP_HIST - 1)                 \
+                c >>= 1, bucket++;                                  \
                                                                     \
-            switch ((_inst)[0]) {                                   \
-            case 0x01:                                              \
-                sysblk.imaps.imap01T[(_inst)[1]]+=elapsed_usecs;    \
-                break;                                              \
-            case 0xA4:                                              \
-                sysblk.imaps.imapa4T[(_inst)[1]]+=elapsed_usecs;    \
-                break;                                              \
-            case 0xA5:                                              \
-                sysblk.imaps.imapa5T[(_inst)[1] & 0x0F]+=elapsed_usecs;   \
-                break;                                              \
-            case 0xA6:                                              \
-                sysblk.imaps.imapa6T[(_inst)[1]]+=elapsed_usecs;    \
-                break;                                              \
-            case 0xA7:                                              \
-                sysblk.imaps.imapa7T[(_inst)[1] & 0x0F]+=elapsed_usecs;   \
-                break;                                              \
-            case 0xB2:                                              \
-                sysblk.imaps.imapb2T[(_inst)[1]]+=elapsed_usecs;    \
-                break;                                              \
-            case 0xB3:                                              \
-                sysblk.imaps.imapb3T[(_inst)[1]]+=elapsed_usecs;    \
-                break;                                              \
-            case 0xB9:                                              \
-                sysblk.imaps.imapb9T[(_inst)[1]]+=elapsed_usecs;    \
-                break;                                              \
-            case 0xC0:                                              \
-                sysblk.imaps.imapc0T[(_inst)[1] & 0x0F]+=elapsed_usecs;   \
-                break;                                              \
-            case 0xC2:                                              \
-                sysblk.imaps.imapc2T[(_inst)[1] & 0x0F]+=elapsed_usecs;   \
-                break;                                              \
-            case 0xC4:                                              \
-                sysblk.imaps.imapc4T[(_inst)[1] & 0x0F]+=elapsed_usecs;   \
-                break;                                              \
-            case 0xC6:                                              \
-                sysblk.imaps.imapc6T[(_inst)[1] & 0x0F]+=elapsed_usecs;   \
-                break;                                              \
-            case 0xC8:                                              \
-                sysblk.imaps.imapc8T[(_inst)[1] & 0x0F]+=elapsed_usecs;   \
-                break;                                              \
-            case 0xE3:                                              \
-                sysblk.imaps.imape3T[(_inst)[5]]+=elapsed_usecs;    \
-                break;                                              \
-            case 0xE4:                                              \
-                sysblk.imaps.imape4T[(_inst)[1]]+=elapsed_usecs;    \
-                break;                                              \
-            case 0xE5:                                              \
-                sysblk.imaps.imape5T[(_inst)[1]]+=elapsed_usecs;    \
-                break;                                              \
-            case 0xE7:                                              \
-                sysblk.imaps.imape7T[(_inst)[5]]+=elapsed_usecs;    \
-                break;                                              \
-            case 0xEB:                                              \
-                sysblk.imaps.imapebT[(_inst)[5]]+=elapsed_usecs;    \
-                break;                                              \
-            case 0xEC:                                              \
-                sysblk.imaps.imapecT[(_inst)[5]]+=elapsed_usecs;    \
-                break;                                              \
-            case 0xED:                                              \
-                sysblk.imaps.imapedT[(_inst)[5]]+=elapsed_usecs;    \
-                break;                                              \
-            default:                                                \
-                sysblk.imaps.imapxxT[(_inst)[0]]+=elapsed_usecs;    \
-            }                                                       \
+            imaps->cycles [ imaps->slot ] += cycles;                \
+            imaps->samples[ imaps->slot ]++;                        \
+            imaps->hist   [ imaps->slot ][ bucket ]++;              \
+            imaps->slot = -1;                                       \
         }                                                           \
     } while (0)
 
-
 #else // !defined( OPTION_INSTR_COUNT_AND_TIME )
+
+#define BEG_COUNT_INSTR(_inst, _regs)
 #define END_COUNT_INSTR(_inst, _regs)
+
 #endif // defined( OPTION_INSTR_COUNT_AND_TIME )
 
 
@@ -1470,12 +1424,32 @@ do { \
 
 #endif /* !defined( FEATURE_073_TRANSACT_EXEC_FACILITY ) */
 
+//---------------------------------------------------------------------
+// The RUNTIME_OPCODE_TABLE macro returns the runtime opcode table
+// the instruction dispatcher should use for the current architecture,
+// and RUNTIME_OPCODE_INDEX the index into it for a given instruction.
+// Normally this is the 64K-entry table indexed by the first halfword
+// of the instruction, but when OPTION_COMPACT_OPCODE_DISPATCH is
+// #defined it is instead the compact 256-entry primary table indexed
+// by just the first byte (see opcode.c "runtime_opcode_xx").
+
+#undef  RUNTIME_OPCODE_TABLE
+#undef  RUNTIME_OPCODE_INDEX
+
+#if defined( OPTION_COMPACT_OPCODE_DISPATCH )
+  #define RUNTIME_OPCODE_TABLE( _regs )   (_regs)->ARCH_DEP( runtime_opcode_xx )
+  #define RUNTIME_OPCODE_INDEX( _ip )     ((_ip)[0])
+#else
+  #define RUNTIME_OPCODE_TABLE( _regs )   (_regs)->ARCH_DEP( runtime_opcode_xxxx )
+  #define RUNTIME_OPCODE_INDEX( _ip )     fetch_hw( (_ip) )
+#endif
+
 #undef  EXECUTE_INSTRUCTION
 #define EXECUTE_INSTRUCTION( _oct, _ip, _regs )                       \
 do {                                                                  \
     FOOTPRINT( (_ip), (_regs) );                                      \
     BEG_COUNT_INSTR( (_ip), (_regs) );                                \
-    (_oct)[ fetch_hw( (_ip) )]( (_ip), (_regs) );                     \
+    (_oct)[ RUNTIME_OPCODE_INDEX( (_ip) )]( (_ip), (_regs) );         \
     END_COUNT_INSTR( (_ip), (_regs) );                                \
 } while (0)
 
@@ -1487,7 +1461,7 @@ do {                                                                  \
       CHECK_TXF_CONSTRAINTS( (_ip), (_regs) );                        \
       FOOTPRINT( (_ip), (_regs) );                                    \
       BEG_COUNT_INSTR( (_ip), (_regs) );                              \
-      (_oct)[ fetch_hw( (_ip) )]( (_ip), (_regs) );                   \
+      (_oct)[ RUNTIME_OPCODE_INDEX( (_ip) )]( (_ip), (_regs) );       \
       END_COUNT_INSTR( (_ip), (_regs) );                              \
   } while (0)
 
@@ -2069,6 +2043,23 @@ do {                                                                  \
 
 #endif /* !defined( FEATURE_BASIC_FP_EXTENSIONS ) */
 
+/* Program check if vector instruction is executed when the AFP or   */
+/* vector enablement control is zero                                 */
+#undef ZVECTOR_CHECK
+#define ZVECTOR_CHECK(_regs)                                                        \
+                                                                                    \
+    if (0                                                                           \
+        || !((_regs)->CR(0) & CR0_AFP)                                              \
+        || !((_regs)->CR(0) & CR0_VOP)                                              \
+        || (SIE_MODE((_regs)) && !(HOST(_regs)->CR(0) & CR0_AFP))                   \
+        || (SIE_MODE((_regs)) && !(HOST(_regs)->CR(0) & CR0_VOP))                   \
+    )                                                                               \
+    {                                                                               \
+        (_regs)->dxc = DXC_VECTOR_INSTRUCTION;                                      \
+        (_regs)->program_interrupt( (_regs), PGM_DATA_EXCEPTION );                  \
+    }                                                                               \
+    TXF_FLOAT_INSTR_CHECK( _regs )
+
 /*-------------------------------------------------------------------*/
 /*               (end floating-point helper macros)                  */
 /*-------------------------------------------------------------------*/
@@ -2673,6 +2664,7 @@ void z900_process_trace( REGS* regs, BYTE* dest );
 #endif
 
 int cpu_init (int cpu, REGS *regs, REGS *hostregs);
+void cpuloops_update( REGS* regs );
 void ARCH_DEP( perform_io_interrupt ) (REGS *regs);
 void ARCH_DEP( checkstop_all_cpus )( REGS* regs );
 U64 make_psw64( REGS* regs, int arch /*370/390/900*/, bool bc );
@@ -3552,10 +3544,185 @@ DEF_INST(convert_dfp_ext_to_packed);
 DEF_INST(convert_dfp_long_to_packed);
 #endif
 
+#if defined( FEATURE_129_ZVECTOR_FACILITY )
+DEF_INST( vector_load_element_8 );
+DEF_INST( vector_load_element_16 );
+DEF_INST( vector_load_element_64 );
+DEF_INST( vector_load_element_32 );
+DEF_INST( vector_load_logical_element_and_zero );
+DEF_INST( vector_load_and_replicate );
+DEF_INST( vector_load );
+DEF_INST( vector_load_to_block_boundary );
+DEF_INST( vector_store_element_8 );
+DEF_INST( vector_store_element_16 );
+DEF_INST( vector_store_element_64 );
+DEF_INST( vector_store_element_32 );
+DEF_INST( vector_store );
+DEF_INST( vector_gather_element_64 );
+DEF_INST( vector_gather_element_32 );
+DEF_INST( vector_scatter_element_64 );
+DEF_INST( vector_scatter_element_32 );
+DEF_INST( vector_load_gr_from_vr_element );
+DEF_INST( vector_load_vr_element_from_gr );
+DEF_INST( load_count_to_block_boundary );
+DEF_INST( vector_element_shift_left );
+DEF_INST( vector_element_rotate_left_logical );
+DEF_INST( vector_load_multiple );
+DEF_INST( vector_load_with_length );
+DEF_INST( vector_element_shift_right_logical );
+DEF_INST( vector_element_shift_right_arithmetic );
+DEF_INST( vector_store_multiple );
+DEF_INST( vector_store_with_length );
+DEF_INST( vector_load_element_immediate_8 );
+DEF_INST( vector_load_element_immediate_16 );
+DEF_INST( vector_load_element_immediate_64 );
+DEF_INST( vector_load_element_immediate_32 );
+DEF_INST( vector_generate_byte_mask );
+DEF_INST( vector_replicate_immediate );
+DEF_INST( vector_generate_mask );
+DEF_INST( vector_fp_test_data_class_immediate );
+DEF_INST( vector_replicate );
+DEF_INST( vector_population_count );
+DEF_INST( vector_count_trailing_zeros );
+DEF_INST( vector_count_leading_zeros );
+DEF_INST( vector_load_vector );
+DEF_INST( vector_isolate_string );
+DEF_INST( vector_sign_extend_to_doubleword );
+DEF_INST( vector_merge_low );
+DEF_INST( vector_merge_high );
+DEF_INST( vector_load_vr_from_grs_disjoint );
+DEF_INST( vector_sum_across_word );
+DEF_INST( vector_sum_across_doubleword );
+DEF_INST( vector_checksum );
+DEF_INST( vector_sum_across_quadword );
+DEF_INST( vector_and );
+DEF_INST( vector_and_with_complement );
+DEF_INST( vector_or );
+DEF_INST( vector_nor );
+DEF_INST( vector_exclusive_or );
+DEF_INST( vector_element_shift_left_vector );
+DEF_INST( vector_element_rotate_and_insert_under_mask );
+DEF_INST( vector_element_rotate_left_logical_vector );
+DEF_INST( vector_shift_left );
+DEF_INST( vector_shift_left_by_byte );
+DEF_INST( vector_shift_left_double_by_byte );
+DEF_INST( vector_element_shift_right_logical_vector );
+DEF_INST( vector_element_shift_right_arithmetic_vector );
+DEF_INST( vector_shift_right_logical );
+DEF_INST( vector_shift_right_logical_by_byte );
+DEF_INST( vector_shift_right_arithmetic );
+DEF_INST( vector_shift_right_arithmetic_by_byte );
+DEF_INST( vector_find_element_equal );
+DEF_INST( vector_find_element_not_equal );
+DEF_INST( vector_find_any_element_equal );
+DEF_INST( vector_permute_doubleword_immediate );
+DEF_INST( vector_string_range_compare );
+DEF_INST( vector_permute );
+DEF_INST( vector_select );
+DEF_INST( vector_fp_multiply_and_subtract );
+DEF_INST( vector_fp_multiply_and_add );
+DEF_INST( vector_pack );
+DEF_INST( vector_pack_logical_saturate );
+DEF_INST( vector_pack_saturate );
+DEF_INST( vector_multiply_logical_high );
+DEF_INST( vector_multiply_low );
+DEF_INST( vector_multiply_high );
+DEF_INST( vector_multiply_logical_even );
+DEF_INST( vector_multiply_logical_odd );
+DEF_INST( vector_multiply_even );
+DEF_INST( vector_multiply_odd );
+DEF_INST( vector_multiply_and_add_logical_high );
+DEF_INST( vector_multiply_and_add_low );
+DEF_INST( vector_multiply_and_add_high );
+DEF_INST( vector_multiply_and_add_logical_even );
+DEF_INST( vector_multiply_and_add_logical_odd );
+DEF_INST( vector_multiply_and_add_even );
+DEF_INST( vector_multiply_and_add_odd );
+DEF_INST( vector_galois_field_multiply_sum );
+DEF_INST( vector_add_with_carry_compute_carry );
+DEF_INST( vector_add_with_carry );
+DEF_INST( vector_galois_field_multiply_sum_and_accumulate );
+DEF_INST( vector_subtract_with_borrow_compute_borrow_indication );
+DEF_INST( vector_subtract_with_borrow_indication );
+DEF_INST( vector_fp_convert_to_logical_64 );
+DEF_INST( vector_fp_convert_from_logical_64 );
+DEF_INST( vector_fp_convert_to_fixed_64 );
+DEF_INST( vector_fp_convert_from_fixed_64 );
+DEF_INST( vector_fp_load_lengthened );
+DEF_INST( vector_fp_load_rounded );
+DEF_INST( vector_load_fp_integer );
+DEF_INST( vector_fp_compare_and_signal_scalar );
+DEF_INST( vector_fp_compare_scalar );
+DEF_INST( vector_fp_perform_sign_operation );
+DEF_INST( vector_fp_square_root );
+DEF_INST( vector_unpack_logical_low );
+DEF_INST( vector_unpack_logical_high );
+DEF_INST( vector_unpack_low );
+DEF_INST( vector_unpack_high );
+DEF_INST( vector_test_under_mask );
+DEF_INST( vector_element_compare_logical );
+DEF_INST( vector_element_compare );
+DEF_INST( vector_load_complement );
+DEF_INST( vector_load_positive );
+DEF_INST( vector_fp_subtract );
+DEF_INST( vector_fp_add );
+DEF_INST( vector_fp_divide );
+DEF_INST( vector_fp_multiply );
+DEF_INST( vector_fp_compare_equal );
+DEF_INST( vector_fp_compare_high_or_equal );
+DEF_INST( vector_fp_compare_high );
+DEF_INST( vector_average_logical );
+DEF_INST( vector_add_compute_carry );
+DEF_INST( vector_average );
+DEF_INST( vector_add );
+DEF_INST( vector_subtract_compute_borrow_indication );
+DEF_INST( vector_subtract );
+DEF_INST( vector_compare_equal );
+DEF_INST( vector_compare_high_logical );
+DEF_INST( vector_compare_high );
+DEF_INST( vector_minimum_logical );
+DEF_INST( vector_maximum_logical );
+DEF_INST( vector_minimum );
+DEF_INST( vector_maximum );
+#endif
+
+#if defined( FEATURE_134_ZVECTOR_PACK_DEC_FACILITY )
+DEF_INST( vector_pack_zoned );
+DEF_INST( vector_load_rightmost_with_length );
+DEF_INST( vector_load_rightmost_with_length_reg );
+DEF_INST( vector_unpack_zoned );
+DEF_INST( vector_store_rightmost_with_length );
+DEF_INST( vector_store_rightmost_with_length_reg );
+DEF_INST( vector_load_immediate_decimal );
+DEF_INST( vector_convert_to_binary_32 );
+DEF_INST( vector_convert_to_binary_64 );
+DEF_INST( vector_convert_to_decimal_32 );
+DEF_INST( vector_shift_and_round_decimal );
+DEF_INST( vector_convert_to_decimal_64 );
+DEF_INST( vector_perform_sign_operation_decimal );
+DEF_INST( vector_test_decimal );
+DEF_INST( vector_add_decimal );
+DEF_INST( vector_subtract_decimal );
+DEF_INST( vector_compare_decimal );
+DEF_INST( vector_multiply_decimal );
+DEF_INST( vector_multiply_and_shift_decimal );
+DEF_INST( vector_divide_decimal );
+DEF_INST( vector_remainder_decimal );
+DEF_INST( vector_shift_and_divide_decimal );
+#endif
+
 #if defined( FEATURE_145_INS_REF_BITS_MULT_FACILITY )
 DEF_INST( insert_reference_bits_multiple );
 #endif
 
+#if defined( FEATURE_150_ENH_SORT_FACILITY )
+DEF_INST( sort_lists );
+#endif
+
+#if defined( FEATURE_151_DEFLATE_CONV_FACILITY )
+DEF_INST( deflate_conversion_call );
+#endif
+
 #if defined( FEATURE_193_BEAR_ENH_FACILITY )
 DEF_INST( load_bear );
 DEF_INST( store_bear );
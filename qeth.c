@@ -438,12 +438,12 @@ static inline void set_alsi( DEVBLK* dev, BYTE bits )
     {
         BYTE* alsi = dev->mainstor + dev->qdio.alsi;
 
-        obtain_lock( &sysblk.mainlock );
+        OBTAIN_DEVMAINLOCK( alsi, alsi );
         {
             *alsi |= bits;
             ARCH_DEP( or_dev_4K_storage_key )( dev, dev->qdio.alsi, (STORKEY_REF | STORKEY_CHANGE) );
         }
-        release_lock( &sysblk.mainlock );
+        RELEASE_DEVMAINLOCK( alsi, alsi );
     }
 }
 
@@ -460,7 +460,7 @@ static inline void set_dsci( DEVBLK* dev, BYTE bits )
         BYTE* dsci = dev->mainstor + dev->qdio.dsci;
         BYTE* alsi = dev->mainstor + dev->qdio.alsi;
 
-        obtain_lock( &sysblk.mainlock );
+        OBTAIN_DEVMAINLOCK( dsci, alsi );
         {
             *dsci |= bits;
             ARCH_DEP( or_dev_4K_storage_key )( dev, dev->qdio.dsci, (STORKEY_REF | STORKEY_CHANGE) );
@@ -468,7 +468,7 @@ static inline void set_dsci( DEVBLK* dev, BYTE bits )
             *alsi |= bits;
             ARCH_DEP( or_dev_4K_storage_key )( dev, dev->qdio.alsi, (STORKEY_REF | STORKEY_CHANGE) );
         }
-        release_lock( &sysblk.mainlock );
+        RELEASE_DEVMAINLOCK( dsci, alsi );
     }
 }
 #define SET_DSCI(_dev,_bits)    set_dsci((_dev),(_bits))
@@ -716,6 +716,10 @@ int     i;                              /* (work)                    */
     memcpy( GUESTREGS->gr,  regs->gr,  14 * sizeof( regs->gr [0] ));
     memcpy( GUESTREGS->ar,  regs->ar,  16 * sizeof( regs->ar [0] ));
     memcpy( GUESTREGS->fpr, regs->fpr, 32 * sizeof( regs->fpr[0] ));
+#if defined( _FEATURE_129_ZVECTOR_FACILITY )
+    memcpy( GUESTREGS->vrl, regs->vrl, sizeof( regs->vrl ));
+    memcpy( GUESTREGS->vrh, regs->vrh, sizeof( regs->vrh ));
+#endif
 #if defined( FEATURE_BINARY_FLOATING_POINT )
     GUESTREGS->fpc =  regs->fpc;
 #endif
@@ -742,7 +746,22 @@ int     i;                              /* (work)                    */
     /*----------------------------------------*/
     /* Maybe purge the guest's TLB/ALB or not */
     /*----------------------------------------*/
-#if !defined( OPTION_SIE_PURGE_DAT_ALWAYS )
+#if defined( OPTION_SIE_TLB_CONTEXTS )
+    /*
+     *   Switch to the guest's TLB context, which still holds its
+     *   TLB entries from when it was last dispatched if this host
+     *   cpu dispatched it last. The ALB is always purged.
+     */
+    UNREFERENCED( same_state );
+
+    switch (GUESTREGS->arch_mode)
+    {
+    case ARCH_370_IDX: s370_sie_tlb_context( GUESTREGS, effective_addr2, same_cpu );                              break;
+    case ARCH_390_IDX: s390_sie_tlb_context( GUESTREGS, effective_addr2, same_cpu ); s390_purge_alb( GUESTREGS ); break;
+    case ARCH_900_IDX: z900_sie_tlb_context( GUESTREGS, effective_addr2, same_cpu ); z900_purge_alb( GUESTREGS ); break;
+    default: CRASH();
+    }
+#elif !defined( OPTION_SIE_PURGE_DAT_ALWAYS )
     /*
      *   If this is not the same last host cpu that dispatched
      *   this state descriptor then clear the guest TLB entries.
@@ -1052,6 +1071,9 @@ static int ARCH_DEP( run_sie )( REGS* regs )
                 )
                     break;
 
+                if (TLB_SHOOTDOWN_PENDING( regs ))
+                    tlb_shootdown_ack( regs );
+
                 if (SIE_IC_INTERRUPT_CPU( GUESTREGS ))
                 {
                     SIE_PERFMON( SIE_PERF_INTCHECK );
@@ -1170,7 +1192,7 @@ static int ARCH_DEP( run_sie )( REGS* regs )
 sie_fetch_instruction:
 
                 ip = INSTRUCTION_FETCH( GUESTREGS, 0 );
-                current_opcode_table = GUESTREGS->ARCH_DEP( runtime_opcode_xxxx );
+                current_opcode_table = RUNTIME_OPCODE_TABLE( GUESTREGS );
 
 #if defined( SIE_DEBUG )
                 ARCH_DEP( display_inst )( GUESTREGS, GUESTREGS->instinvalid ? NULL : ip );
@@ -1216,7 +1238,7 @@ sie_fetch_instruction:
                 UPDATE_SYSBLK_INSTCOUNT( 1 );
                 SIE_PERFMON( SIE_PERF_EXEC_U );
 
-                for (i=0; i < MAX_CPU_LOOPS/2; i++)
+                for (i=0; i < regs->cpuloops; i++)
                 {
                     UNROLLED_EXECUTE( current_opcode_table, GUESTREGS );
                     UNROLLED_EXECUTE( current_opcode_table, GUESTREGS );
@@ -1243,7 +1265,7 @@ txf_facility_loop:
                 UPDATE_SYSBLK_INSTCOUNT( 1 );
                 SIE_PERFMON( SIE_PERF_EXEC_U );
 
-                for (i=0; i < MAX_CPU_LOOPS/2; i++)
+                for (i=0; i < regs->cpuloops; i++)
                 {
                     if (GUESTREGS->txf_tnd)
                         break;
@@ -1270,7 +1292,7 @@ txf_slower_loop:
                 UPDATE_SYSBLK_INSTCOUNT( 1 );
                 SIE_PERFMON( SIE_PERF_EXEC_U );
 
-                for (i=0; i < MAX_CPU_LOOPS/2; i++)
+                for (i=0; i < regs->cpuloops; i++)
                 {
                     if (!GUESTREGS->txf_tnd)
                         break;
@@ -1332,8 +1354,8 @@ endloop:        ; // (nop to make compiler happy)
            */
             if (sysblk.ipled)
             {
-                regs->instcount += MAX_CPU_LOOPS/2;
-                UPDATE_SYSBLK_INSTCOUNT( MAX_CPU_LOOPS/2 );
+                regs->instcount += regs->cpuloops;
+                UPDATE_SYSBLK_INSTCOUNT( regs->cpuloops );
 
                 /* Perform automatic instruction tracing if it's enabled */
                 DO_AUTOMATIC_TRACING();
@@ -1655,6 +1677,10 @@ void ARCH_DEP( sie_exit )( REGS* regs, int icode )
     memcpy( regs->gr,  GUESTREGS->gr,  14 * sizeof( regs->gr [0] ));
     memcpy( regs->ar,  GUESTREGS->ar,  16 * sizeof( regs->ar [0] ));
     memcpy( regs->fpr, GUESTREGS->fpr, 32 * sizeof( regs->fpr[0] ));
+#if defined( _FEATURE_129_ZVECTOR_FACILITY )
+    memcpy( regs->vrl, GUESTREGS->vrl, sizeof( regs->vrl ));
+    memcpy( regs->vrh, GUESTREGS->vrh, sizeof( regs->vrh ));
+#endif
 #if defined( FEATURE_BINARY_FLOATING_POINT )
     regs->fpc = GUESTREGS->fpc;
 #endif
@@ -262,7 +262,7 @@ inline bool ARCH_DEP( LockUnlockSCALock )( REGS* regs, bool lock, bool trylock )
         BYTE old = scabk->scaiplk0;
 
         // MAINLOCK may be required if cmpxchg assists unavailable
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK( regs, &scabk->scaiplk0 );
         {
             // If not TRY call, keep looping until we obtain it.
             // Otherwise TRY just once, and return success or not.
@@ -321,7 +321,7 @@ inline void ARCH_DEP( LockUnlockRCPLock )( REGS* regs, RCPTE* rcpte, bool lock )
         BYTE old = rcpte->rcpbyte;
 
         // MAINLOCK may be required if cmpxchg assists unavailable
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK( regs, &rcpte->rcpbyte );
         {
             // Keep looping until we eventually obtain it...
             do
@@ -371,7 +371,7 @@ inline void ARCH_DEP( LockUnlockSKALock )( REGS* regs, bool lock )
         BYTE old = regs->siebk->SIE_RCPO0;
 
         // MAINLOCK may be required if cmpxchg assists unavailable
-        OBTAIN_MAINLOCK( regs );
+        OBTAIN_MAINLOCK( regs, &regs->siebk->SIE_RCPO0 );
         {
             // Keep looping until we eventually obtain it...
             do
@@ -74,6 +74,24 @@ inline BYTE* _get_dev_storekey2_ptr( DEVBLK* dev, U64 abs )
     return &STOREKEY2( abs, dev );
 }
 
+/*-------------------------------------------------------------------*/
+/*  Mark a 4K frame as changed in the host's dirty frame bitmap.     */
+/*  Called whenever a change bit is set (see get_dirty_frames).      */
+/*-------------------------------------------------------------------*/
+
+#define DIRTYMAP_BYTE( abs )  sysblk.dirtymap[ (abs) >> (SHIFT_4K + 3) ]
+#define DIRTYMAP_BIT(  abs )  (0x80 >> (((abs) >> SHIFT_4K) & 7))
+
+inline void _mark_dirty_frame( U64 abs )
+{
+    BYTE* ptr = &DIRTYMAP_BYTE( abs );
+    BYTE  bit =  DIRTYMAP_BIT(  abs );
+
+    /* (always atomic: a lost bit would be a lost update) */
+    if (!(*ptr & bit))
+        (void) H_ATOMIC_OP( ptr, bit, or, Or, | );
+}
+
 #endif // defined( _SKEY_H )
 
 /*-------------------------------------------------------------------*/
@@ -157,6 +175,8 @@ inline BYTE ARCH_DEP( _get_dev_storage_key )( DEVBLK* dev, U64 abs, BYTE K )
 inline void ARCH_DEP( _put_storage_key )( U64 abs, BYTE key, BYTE K )
 {
     UNREFERENCED( K ); // (for FEATURE_4K_STORAGE_KEYS case)
+    if (key & STORKEY_CHANGE)
+        _mark_dirty_frame( abs );
     if (IS_DOUBLE_KEYED_4K_BYTE_BLOCK( K ))
     {
         *_get_storekey1_ptr( abs ) = key;
@@ -188,6 +208,8 @@ inline void ARCH_DEP( _and_storage_key )( U64 abs, BYTE bits, BYTE K )
 inline void ARCH_DEP( _or_storage_key )( U64 abs, BYTE bits, BYTE K )
 {
     UNREFERENCED( K ); // (for FEATURE_4K_STORAGE_KEYS case)
+    if (bits & STORKEY_CHANGE)
+        _mark_dirty_frame( abs );
     if (IS_DOUBLE_KEYED_4K_BYTE_BLOCK( K ))
     {
         BYTE* skey1_ptr = _get_storekey1_ptr( abs );
@@ -205,6 +227,8 @@ inline void ARCH_DEP( _or_storage_key )( U64 abs, BYTE bits, BYTE K )
 inline void ARCH_DEP( _or_dev_storage_key )( DEVBLK* dev, U64 abs, BYTE bits, BYTE K )
 {
     UNREFERENCED( K ); // (for FEATURE_4K_STORAGE_KEYS case)
+    if (bits & STORKEY_CHANGE)
+        _mark_dirty_frame( abs );
     if (IS_DOUBLE_KEYED_4K_BYTE_BLOCK( K ))
     {
         BYTE* skey1_ptr = _get_dev_storekey1_ptr( dev, abs );
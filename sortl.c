@@ -0,0 +1,599 @@
+/* SORTL.C      (C) and others 2026                                  */
+/*              Enhanced-Sort Facility                               */
+/*                                                                   */
+/*   Released under "The Q Public License Version 1"                 */
+/*   (http://www.hercules-390.org/herclic.html) as modifications to  */
+/*   Hercules.                                                       */
+
+/*-------------------------------------------------------------------*/
+/* This module implements the SORT LISTS instruction of the          */
+/* Enhanced-Sort Facility (facility bit 150).                        */
+/*                                                                   */
+/* Records are compared in place in guest storage by an ordinary     */
+/* tournament (loser) tree: in merge mode its leaves are the heads   */
+/* of the input lists, otherwise they are the records of the run     */
+/* being sorted.  Only the merged output is buffered, so that        */
+/* nothing is stored until every access exception has been           */
+/* recognized.  Consumed records are removed from the input list     */
+/* descriptors as they are output, which makes the lists themselves  */
+/* the state of an interrupted merge: an execution ending with cc1   */
+/* or cc3 only has to remember, in the continuation flag, that the   */
+/* run it was building is still open.                                */
+/*                                                                   */
+/*   GR0   bit 55       OD   Store operand-2 run delimiters          */
+/*         bit 56       MM   Merge mode                              */
+/*         bits 57-63   FC   Function code                           */
+/*                                                                   */
+/*   PB    +7   bit 7   CF   Continuation flag                       */
+/*         +8   U32     SOV  Active input lists, list 0 leftmost     */
+/*         +12  U16     KL   Key length                              */
+/*         +14  U16     PL   Payload length (SFLR only)              */
+/*         +64  16*32        ILA (U64) and ILL (U64) of each list    */
+/*                                                                   */
+/* SFLR records are a key followed by a payload of fixed length;     */
+/* SVLR records are a key followed by a fullword payload length and  */
+/* the payload.  Keys are compared as unsigned binary strings and    */
+/* records with equal keys keep their input order.  Each operand-2   */
+/* delimiter is the doubleword address of the end of a sorted run.   */
+/*-------------------------------------------------------------------*/
+
+#include "hstdinc.h"
+
+#define _SORTL_C_
+#define _HENGINE_DLL_
+
+#include "hercules.h"
+#include "opcode.h"
+#include "inline.h"
+
+#if !defined( _SORTL_C )
+#define _SORTL_C
+
+#if defined( _FEATURE_150_ENH_SORT_FACILITY )
+
+/*-------------------------------------------------------------------*/
+/* Function codes and general register 0 fields                      */
+/*-------------------------------------------------------------------*/
+#define SORTL_QAF           0           /* Query Available Functions */
+#define SORTL_SFLR          1           /* Sort Fixed-Length Records */
+#define SORTL_SVLR          2           /* Sort Variable-Length Recs */
+
+#define SORTL_GR0_OD        0x0100      /* Operand-2 delimiters      */
+#define SORTL_GR0_MM        0x0080      /* Merge mode                */
+#define SORTL_GR0_FC        0x007F      /* Function code             */
+
+/*-------------------------------------------------------------------*/
+/* Parameter block format 0                                          */
+/*-------------------------------------------------------------------*/
+#define SORTL_QAF_LEN       32          /* QAF parameter block length*/
+#define SORTL_MAX_LISTS     32          /* Input lists               */
+#define SORTL_PB_LEN        (64 + 16 * SORTL_MAX_LISTS)
+
+#define SORTL_PB_CF         7           /* Continuation flag byte    */
+#define SORTL_CF            0x01        /*  Continuation flag        */
+#define SORTL_PB_SOV        8           /* Active input lists        */
+#define SORTL_PB_KL         12          /* Key length                */
+#define SORTL_PB_PL         14          /* Fixed payload length      */
+#define SORTL_PB_IL         64          /* Input list descriptors    */
+
+/*-------------------------------------------------------------------*/
+/* Limits of this implementation                                     */
+/*-------------------------------------------------------------------*/
+#define SORTL_MAX_KEY       4096        /* Longest key               */
+#define SORTL_MAX_PAYLOAD   4096        /* Longest payload           */
+#define SORTL_OUT_MAX       32768       /* Output bytes per execution*/
+#define SORTL_RUN_MAX       256         /* Records per sorted run    */
+#define SORTL_MAX_RUNS      64          /* Runs per execution        */
+
+/*-------------------------------------------------------------------*/
+/* Tournament tree                                                   */
+/*-------------------------------------------------------------------*/
+/* Leaf 'n' is the sentinel which beats everything while the tree is */
+/* being built; an exhausted leaf loses to every record.             */
+/*-------------------------------------------------------------------*/
+#define SORTL_MIN           0           /* Sentinel                  */
+#define SORTL_REC           1           /* Leaf holds a record       */
+#define SORTL_EOF           2           /* Leaf is exhausted         */
+
+typedef struct SORTL_LEAF
+{
+    VADR   addr;                        /* Record address            */
+    BYTE*  key;                         /* Key in main storage, or   */
+                                        /* NULL if it crosses a page */
+    GREG   left;                        /* Bytes left in input list  */
+    U32    len;                         /* Record length             */
+    int    state;                       /* SORTL_MIN, _REC or _EOF   */
+}
+SORTL_LEAF;
+
+typedef struct SORTL_CTX
+{
+    U32         kl;                     /* Key length                */
+    U32         pl;                     /* Fixed payload length      */
+    bool        var;                    /* SVLR records              */
+    int         n;                      /* Number of leaves          */
+    int         tree[ SORTL_RUN_MAX ];  /* Losers; tree[0] winner    */
+    SORTL_LEAF  leaf[ SORTL_RUN_MAX + 1 ];
+}
+SORTL_CTX;
+
+#endif /* defined( _FEATURE_150_ENH_SORT_FACILITY ) */
+
+#endif /* !defined( _SORTL_C ) */
+
+#if defined( FEATURE_150_ENH_SORT_FACILITY )
+
+/*-------------------------------------------------------------------*/
+/* Guest storage helpers, one page at a time                         */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( sortl_fetch )( BYTE* dst, VADR addr, size_t len,
+                                     int arn, REGS* regs )
+{
+    while (len)
+    {
+        size_t n = PAGEFRAME_PAGESIZE - (addr & PAGEFRAME_BYTEMASK);
+        if (n > len)
+            n = len;
+        memcpy( dst, MADDRL( addr, n, arn, regs, ACCTYPE_READ,
+                             regs->psw.pkey ), n );
+        dst  += n;
+        len  -= n;
+        addr  = (addr + n) & ADDRESS_MAXWRAP( regs );
+    }
+}
+
+/* Recognize any access exception before anything is stored          */
+static void ARCH_DEP( sortl_validate )( VADR addr, size_t len,
+                                        int arn, REGS* regs )
+{
+    while (len)
+    {
+        size_t n = PAGEFRAME_PAGESIZE - (addr & PAGEFRAME_BYTEMASK);
+        if (n > len)
+            n = len;
+        MADDRL( addr, n, arn, regs, ACCTYPE_WRITE_SKP, regs->psw.pkey );
+        len  -= n;
+        addr  = (addr + n) & ADDRESS_MAXWRAP( regs );
+    }
+}
+
+static void ARCH_DEP( sortl_store )( const BYTE* src, VADR addr, size_t len,
+                                     int arn, REGS* regs )
+{
+    while (len)
+    {
+        size_t n = PAGEFRAME_PAGESIZE - (addr & PAGEFRAME_BYTEMASK);
+        if (n > len)
+            n = len;
+        memcpy( MADDRL( addr, n, arn, regs, ACCTYPE_WRITE,
+                        regs->psw.pkey ), src, n );
+        src  += n;
+        len  -= n;
+        addr  = (addr + n) & ADDRESS_MAXWRAP( regs );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* Point a leaf at the record at 'addr' with 'left' bytes remaining  */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( sortl_record )( SORTL_CTX* ctx, SORTL_LEAF* lf,
+                                      VADR addr, GREG left, REGS* regs )
+{
+    U32  plen;
+
+    lf->addr = addr;
+    lf->left = left;
+
+    if (!left)
+    {
+        lf->state = SORTL_EOF;
+        return;
+    }
+
+    if (ctx->var)
+    {
+        if (left < (GREG) ctx->kl + 4)
+            ARCH_DEP( program_interrupt )( regs, PGM_SPECIFICATION_EXCEPTION );
+
+        plen = ARCH_DEP( vfetch4 )( (addr + ctx->kl)
+                                    & ADDRESS_MAXWRAP( regs ), 1, regs );
+        if (0
+            || plen > SORTL_MAX_PAYLOAD
+            || left < (GREG) ctx->kl + 4 + plen
+        )
+            ARCH_DEP( program_interrupt )( regs, PGM_SPECIFICATION_EXCEPTION );
+
+        lf->len = ctx->kl + 4 + plen;
+    }
+    else
+        lf->len = ctx->kl + ctx->pl;
+
+    lf->key = (addr & PAGEFRAME_BYTEMASK) + ctx->kl <= PAGEFRAME_PAGESIZE
+            ? MADDRL( addr, ctx->kl, 1, regs, ACCTYPE_READ, regs->psw.pkey )
+            : NULL;
+    lf->state = SORTL_REC;
+}
+
+/*-------------------------------------------------------------------*/
+/* Compare two keys, piecewise where one of them crosses a page      */
+/*-------------------------------------------------------------------*/
+static int ARCH_DEP( sortl_keycmp )( const SORTL_CTX* ctx,
+                                     const SORTL_LEAF* a,
+                                     const SORTL_LEAF* b, REGS* regs )
+{
+    VADR  aa, ba;
+    U32   off, n;
+    int   rc;
+
+    if (a->key && b->key)
+        return memcmp( a->key, b->key, ctx->kl );
+
+    for (off = 0; off < ctx->kl; off += n)
+    {
+        aa = (a->addr + off) & ADDRESS_MAXWRAP( regs );
+        ba = (b->addr + off) & ADDRESS_MAXWRAP( regs );
+        n  = ctx->kl - off;
+        n  = min( n, PAGEFRAME_PAGESIZE - (aa & PAGEFRAME_BYTEMASK) );
+        n  = min( n, PAGEFRAME_PAGESIZE - (ba & PAGEFRAME_BYTEMASK) );
+
+        rc = memcmp( MADDRL( aa, n, 1, regs, ACCTYPE_READ, regs->psw.pkey ),
+                     MADDRL( ba, n, 1, regs, ACCTYPE_READ, regs->psw.pkey ),
+                     n );
+        if (rc)
+            return rc;
+    }
+    return 0;
+}
+
+/* Whether leaf 'a' is output before leaf 'b'                         */
+static bool ARCH_DEP( sortl_beats )( const SORTL_CTX* ctx, int a, int b,
+                                     REGS* regs )
+{
+    const SORTL_LEAF*  la = &ctx->leaf[ a ];
+    const SORTL_LEAF*  lb = &ctx->leaf[ b ];
+    int                rc;
+
+    if (la->state != lb->state)
+        return la->state < lb->state;
+
+    if (la->state == SORTL_REC
+        && (rc = ARCH_DEP( sortl_keycmp )( ctx, la, lb, regs )) != 0)
+        return rc < 0;
+
+    /* Equal keys are output in input order */
+    return a < b;
+}
+
+/* Replay the matches from leaf 's' up to the root                    */
+static void ARCH_DEP( sortl_adjust )( SORTL_CTX* ctx, int s, REGS* regs )
+{
+    int  t, w;
+
+    for (t = (s + ctx->n) / 2; t > 0; t /= 2)
+    {
+        if (ARCH_DEP( sortl_beats )( ctx, ctx->tree[t], s, regs ))
+        {
+            w            = ctx->tree[t];
+            ctx->tree[t] = s;
+            s            = w;
+        }
+    }
+    ctx->tree[0] = s;
+}
+
+static void ARCH_DEP( sortl_build )( SORTL_CTX* ctx, REGS* regs )
+{
+    int  i;
+
+    ctx->leaf[ ctx->n ].state = SORTL_MIN;
+
+    for (i = 0; i < ctx->n; i++)
+        ctx->tree[i] = ctx->n;
+
+    for (i = ctx->n - 1; i >= 0; i--)
+        ARCH_DEP( sortl_adjust )( ctx, i, regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* SORTL-QAF  Query Available Functions                              */
+/*-------------------------------------------------------------------*/
+static int ARCH_DEP( sortl_qaf )( REGS* regs )
+{
+    BYTE  qaf[ SORTL_QAF_LEN ];
+
+    memset( qaf, 0, sizeof( qaf ));
+
+    qaf[0]  = 0x80 >> SORTL_QAF         /* Installed functions       */
+            | 0x80 >> SORTL_SFLR
+            | 0x80 >> SORTL_SVLR;
+    qaf[24] = 0x80;                     /* Parameter block format 0  */
+
+    ARCH_DEP( vstorec )( qaf, SORTL_QAF_LEN - 1,
+                         GR_A( 1, regs ) & ADDRESS_MAXWRAP( regs ), 1, regs );
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* SORTL-SFLR and SORTL-SVLR  Sort Fixed/Variable-Length Records     */
+/*-------------------------------------------------------------------*/
+static int ARCH_DEP( sortl_sort )( int r1, int r2, BYTE* pb, bool var,
+                                   bool mm, bool od, REGS* regs )
+{
+    VADR       addr1 = GR_A( r1,     regs ) & ADDRESS_MAXWRAP( regs );
+    GREG       len1  = GR_A( r1 + 1, regs );
+    VADR       addr2 = GR_A( r2,     regs ) & ADDRESS_MAXWRAP( regs );
+    GREG       len2  = GR_A( r2 + 1, regs );
+    U32        sov   = fetch_fw( pb + SORTL_PB_SOV );
+    bool       cf    = (pb[ SORTL_PB_CF ] & SORTL_CF) ? true : false;
+    VADR       ila[ SORTL_MAX_LISTS ];  /* Input list addresses      */
+    GREG       ill[ SORTL_MAX_LISTS ];  /* Input list lengths        */
+    int        list[ SORTL_MAX_LISTS ]; /* Descriptor of each list   */
+    BYTE       out[ SORTL_OUT_MAX ];    /* Output records            */
+    BYTE       delim[ 8 * SORTL_MAX_RUNS ]; /* Output run delimiters */
+    SORTL_CTX  ctx;
+    SORTL_LEAF *lf;
+    BYTE      *il;
+    size_t     cap, outlen = 0, runlen;
+    int        nl = 0, ndelim = 0, li, i, w, cc;
+
+    ctx.kl  = fetch_hw( pb + SORTL_PB_KL );
+    ctx.pl  = var ? 0 : fetch_hw( pb + SORTL_PB_PL );
+    ctx.var = var;
+
+    if (0
+        || !ctx.kl
+        || (ctx.kl & 7)
+        || ctx.kl > SORTL_MAX_KEY
+        || (ctx.pl & 7)
+        || ctx.pl > SORTL_MAX_PAYLOAD
+    )
+        ARCH_DEP( program_interrupt )( regs, PGM_SPECIFICATION_EXCEPTION );
+
+    /* Gather the active input lists */
+    for (i = 0; i < SORTL_MAX_LISTS; i++)
+    {
+        if (!(sov & (0x80000000 >> i)))
+            continue;
+
+        il = pb + SORTL_PB_IL + 16 * i;
+        ila[ nl ]  = fetch_dw( il ) & ADDRESS_MAXWRAP( regs );
+        ill[ nl ]  = regs->psw.amode64 ? fetch_dw( il + 8 )
+                                       : fetch_fw( il + 12 );
+        list[ nl ] = i;
+
+        if (!var && ill[ nl ] % (ctx.kl + ctx.pl))
+            ARCH_DEP( program_interrupt )( regs, PGM_SPECIFICATION_EXCEPTION );
+        nl++;
+    }
+
+    cap = (size_t) min( len1, (GREG) SORTL_OUT_MAX );
+
+    if (mm)
+    {
+        /* Merge the heads of the input lists */
+        ctx.n = nl;
+        for (i = 0; i < nl; i++)
+            ARCH_DEP( sortl_record )( &ctx, &ctx.leaf[i],
+                                      ila[i], ill[i], regs );
+        ARCH_DEP( sortl_build )( &ctx, regs );
+
+        for (;;)
+        {
+            if (!nl || ctx.leaf[ ctx.tree[0] ].state == SORTL_EOF)
+            {
+                cc = 0;
+                break;
+            }
+
+            w  = ctx.tree[0];
+            lf = &ctx.leaf[w];
+
+            if (lf->len > len1 - outlen)
+            {
+                cc = 1;
+                break;
+            }
+            if (lf->len > cap - outlen)
+            {
+                cc = 3;
+                break;
+            }
+
+            ARCH_DEP( sortl_fetch )( out + outlen, lf->addr, lf->len,
+                                     1, regs );
+            outlen += lf->len;
+
+            ARCH_DEP( sortl_record )( &ctx, lf,
+                                      (lf->addr + lf->len)
+                                      & ADDRESS_MAXWRAP( regs ),
+                                      lf->left - lf->len, regs );
+            ARCH_DEP( sortl_adjust )( &ctx, w, regs );
+        }
+
+        for (i = 0; i < nl; i++)
+        {
+            ila[i] = ctx.leaf[i].addr;
+            ill[i] = ctx.leaf[i].left;
+        }
+
+        /* The run ends when all lists are exhausted */
+        if (cc == 0 && od && (cf || outlen))
+        {
+            if (len2 < 8)
+                cc = 1;
+            else
+                store_dw( delim + 8 * ndelim++,
+                          (addr1 + outlen) & ADDRESS_MAXWRAP( regs ));
+        }
+        cf = cc != 0 && (cf || outlen);
+    }
+    else
+    {
+        /* Sort successive runs of records taken in list order */
+        for (li = 0, cc = -1; cc < 0; )
+        {
+            while (li < nl && !ill[ li ])
+                li++;
+
+            if (li == nl)
+                cc = 0;
+            else if (od && len2 - 8 * ndelim < 8)
+                cc = 1;
+            else if (ndelim == SORTL_MAX_RUNS)
+                cc = 3;
+            if (cc >= 0)
+                break;
+
+            for (ctx.n = 0, runlen = 0; ctx.n < SORTL_RUN_MAX; ctx.n++)
+            {
+                while (li < nl && !ill[ li ])
+                    li++;
+                if (li == nl)
+                    break;
+
+                lf = &ctx.leaf[ ctx.n ];
+                ARCH_DEP( sortl_record )( &ctx, lf, ila[ li ], ill[ li ],
+                                          regs );
+                if (outlen + runlen + lf->len > cap)
+                    break;
+
+                runlen    += lf->len;
+                ila[ li ]  = (ila[ li ] + lf->len) & ADDRESS_MAXWRAP( regs );
+                ill[ li ] -= lf->len;
+            }
+
+            if (!ctx.n)
+            {
+                cc = ctx.leaf[0].len > len1 - outlen ? 1 : 3;
+                break;
+            }
+
+            ARCH_DEP( sortl_build )( &ctx, regs );
+
+            for (i = 0; i < ctx.n; i++)
+            {
+                w  = ctx.tree[0];
+                lf = &ctx.leaf[w];
+
+                ARCH_DEP( sortl_fetch )( out + outlen, lf->addr, lf->len,
+                                         1, regs );
+                outlen    += lf->len;
+                lf->state  = SORTL_EOF;
+                ARCH_DEP( sortl_adjust )( &ctx, w, regs );
+            }
+
+            store_dw( delim + 8 * ndelim++,
+                          (addr1 + outlen) & ADDRESS_MAXWRAP( regs ));
+        }
+
+        /* Runs are always completed within one execution */
+        cf = false;
+    }
+
+    /* Recognize access exceptions, then store the results */
+    ARCH_DEP( sortl_validate )( addr1, outlen, r1, regs );
+    if (od)
+        ARCH_DEP( sortl_validate )( addr2, 8 * ndelim, r2, regs );
+
+    ARCH_DEP( sortl_store )( out, addr1, outlen, r1, regs );
+    if (od)
+        ARCH_DEP( sortl_store )( delim, addr2, 8 * ndelim, r2, regs );
+    else
+        ndelim = 0;
+
+    for (i = 0; i < nl; i++)
+    {
+        il = pb + SORTL_PB_IL + 16 * list[i];
+        store_dw( il, ila[i] );
+        if (regs->psw.amode64)
+            store_dw( il + 8, ill[i] );
+        else
+            store_fw( il + 12, (U32) ill[i] );
+    }
+
+    if (cf)
+        pb[ SORTL_PB_CF ] |=  SORTL_CF;
+    else
+        pb[ SORTL_PB_CF ] &= ~SORTL_CF;
+
+    SET_GR_A( r1,     regs, (addr1 + outlen) & ADDRESS_MAXWRAP( regs ));
+    SET_GR_A( r1 + 1, regs, len1 - outlen );
+    SET_GR_A( r2,     regs, (addr2 + 8 * ndelim) & ADDRESS_MAXWRAP( regs ));
+    SET_GR_A( r2 + 1, regs, len2 - 8 * ndelim );
+
+    return cc;
+}
+
+/*-------------------------------------------------------------------*/
+/* B938 SORTL - Sort Lists                                     [RRE] */
+/*-------------------------------------------------------------------*/
+DEF_INST( sort_lists )
+{
+    int   r1, r2;                       /* Operand register numbers  */
+    BYTE  pb[ SORTL_PB_LEN ];           /* Parameter block           */
+    BYTE  fc;                           /* Function code             */
+    VADR  addr;                         /* Parameter block address   */
+
+    RRE( inst, regs, r1, r2 );
+
+    TXF_INSTR_CHECK( regs );
+
+#if defined( FEATURE_PER_ZERO_ADDRESS_DETECTION_FACILITY )
+    if (0
+        || GR_A( 1,  regs ) == 0
+        || GR_A( r1, regs ) == 0
+        || GR_A( r2, regs ) == 0
+    )
+        ARCH_DEP( per3_zero )( regs );
+#endif
+
+    fc   = regs->GR_L( 0 ) & SORTL_GR0_FC;
+    addr = GR_A( 1, regs ) & ADDRESS_MAXWRAP( regs );
+
+    if (fc == SORTL_QAF)
+    {
+        regs->psw.cc = ARCH_DEP( sortl_qaf )( regs );
+        return;
+    }
+
+    /* Operands 1 and 2 are even-odd pairs other than 0 and the     */
+    /* parameter block is on a doubleword boundary                  */
+    if (0
+        || (fc != SORTL_SFLR && fc != SORTL_SVLR)
+        || !r1 || (r1 & 1)
+        || !r2 || (r2 & 1)
+        || (addr & 7)
+    )
+        ARCH_DEP( program_interrupt )( regs, PGM_SPECIFICATION_EXCEPTION );
+
+    ARCH_DEP( sortl_fetch )( pb, addr, SORTL_PB_LEN, 1, regs );
+    ARCH_DEP( sortl_validate )( addr, SORTL_PB_LEN, 1, regs );
+
+    regs->psw.cc = ARCH_DEP( sortl_sort )( r1, r2, pb, fc == SORTL_SVLR,
+                       (regs->GR_L( 0 ) & SORTL_GR0_MM) ? true : false,
+                       (regs->GR_L( 0 ) & SORTL_GR0_OD) ? true : false,
+                       regs );
+
+    ARCH_DEP( sortl_store )( pb, addr, SORTL_PB_LEN, 1, regs );
+}
+
+#endif /* defined( FEATURE_150_ENH_SORT_FACILITY ) */
+
+/*-------------------------------------------------------------------*/
+/*          (delineates ARCH_DEP from non-arch_dep)                  */
+/*-------------------------------------------------------------------*/
+
+#if !defined( _GEN_ARCH )
+
+  #if defined(              _ARCH_NUM_1 )
+    #define   _GEN_ARCH     _ARCH_NUM_1
+    #include "sortl.c"
+  #endif
+
+  #if defined(              _ARCH_NUM_2 )
+    #undef    _GEN_ARCH
+    #define   _GEN_ARCH     _ARCH_NUM_2
+    #include "sortl.c"
+  #endif
+
+#endif /* !defined( _GEN_ARCH ) */
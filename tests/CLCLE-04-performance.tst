@@ -23,6 +23,11 @@
 #               /         1,000,000 iterations of CLCLE took      49,178 microseconds
 #               /         1,000,000 iterations of CLCLE took      68,355 microseconds
 #               /         1,000,000 iterations of CLCLE took      69,991 microseconds
+#
+#  Each test is run twice: first with the host SIMD kernels disabled
+#  ("simd none") and then with the best ones the host supports
+#  ("simd best"), so that the two sets of timings show the speedup
+#  of the kernels. Both timing lines below need to be uncommented.
 #  ----------------------------------------------------------------------------------
 
 archlvl     390
@@ -30,6 +35,17 @@ mainsize    3
 numcpu      1
 sysclear
 
+simd        none      # (first without the host SIMD kernels)
+
+loadcore    "$(testpath)/CLCLE-04-performance.core" 0x0
+
+#r           21fd=ff   # (enable timing tests)
+#runtest     300       # (TIMING test duration)
+runtest      0.1       # (NOP TEST)
+
+simd        best      # (then with the best ones the host supports)
+sysclear
+
 loadcore    "$(testpath)/CLCLE-04-performance.core" 0x0
 
 #r           21fd=ff   # (enable timing tests)
@@ -29,6 +29,11 @@
 #        1,000,000 iterations of CUSE  took     340,440 microseconds
 #        1,000,000 iterations of CUSE  took   2,210,040 microseconds
 #        1,000,000 iterations of CUSE  took   2,313,153 microseconds
+#
+#  Each test is run twice: first with the host SIMD kernels disabled
+#  ("simd none") and then with the best ones the host supports
+#  ("simd best"), so that the two sets of timings show the speedup
+#  of the kernels. Both timing lines below need to be uncommented.
 # ------------------------------------------------------------------------------
 
 mainsize    16
@@ -36,6 +41,19 @@ numcpu      1
 sysclear
 archlvl     z/Arch
 
+simd        none      # (first without the host SIMD kernels)
+
+loadcore    "$(testpath)/CUSE-02-performance.core" 0x0
+
+diag8cmd    enable    # (needed for messages to Hercules console)
+#r           408=ff    # (enable timing tests)
+runtest     300       # (test duration, depends on host)
+diag8cmd    disable   # (reset back to default)
+
+simd        best      # (then with the best ones the host supports)
+sysclear
+archlvl     z/Arch
+
 loadcore    "$(testpath)/CUSE-02-performance.core" 0x0
 
 diag8cmd    enable    # (needed for messages to Hercules console)
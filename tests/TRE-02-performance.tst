@@ -24,6 +24,11 @@
 #               /         1,000,000 iterations of TRE   took     305,606 microseconds
 #               /         1,000,000 iterations of TRE   took   1,016,256 microseconds
 #               /         1,000,000 iterations of TRE   took   1,056,531 microseconds
+#
+#  Each test is run twice: first with the host SIMD kernels disabled
+#  ("simd none") and then with the best ones the host supports
+#  ("simd best"), so that the two sets of timings show the speedup
+#  of the kernels. Both timing lines below need to be uncommented.
 #  ----------------------------------------------------------------------------------
 
 archlvl     390
@@ -31,6 +36,16 @@ mainsize    3
 numcpu      1
 sysclear
 
+simd        none      # (first without the host SIMD kernels)
+
+loadcore    "$(testpath)/TRE-02-performance.core" 0x0
+
+#r           21fd=ff    # (uncomment to enable timing tests!)
+runtest     10         # (test duration, depends on host)
+
+simd        best      # (then with the best ones the host supports)
+sysclear
+
 loadcore    "$(testpath)/TRE-02-performance.core" 0x0
 
 #r           21fd=ff    # (uncomment to enable timing tests!)
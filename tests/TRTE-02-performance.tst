@@ -30,6 +30,11 @@
 #             1,000,000 iterations of TRTE  took   1,406,504 microseconds
 #             1,000,000 iterations of TRTE  took   2,369,744 microseconds
 #             1,000,000 iterations of TRTE  took   2,774,618 microseconds
+#
+#  Each test is run twice: first with the host SIMD kernels disabled
+#  ("simd none") and then with the best ones the host supports
+#  ("simd best"), so that the two sets of timings show the speedup
+#  of the kernels. Both timing lines below need to be uncommented.
 # ------------------------------------------------------------------------------
 
 mainsize    16
@@ -37,6 +42,19 @@ numcpu      1
 sysclear
 archlvl     z/Arch
 
+simd        none      # (first without the host SIMD kernels)
+
+loadcore    "$(testpath)/TRTE-02-performance.core" 0x0
+
+diag8cmd    enable    # (needed for messages to Hercules console)
+#r           408=ff    # (enable timing tests)
+runtest     200       # (test duration, depends on host)
+diag8cmd    disable   # (reset back to default)
+
+simd        best      # (then with the best ones the host supports)
+sysclear
+archlvl     z/Arch
+
 loadcore    "$(testpath)/TRTE-02-performance.core" 0x0
 
 diag8cmd    enable    # (needed for messages to Hercules console)
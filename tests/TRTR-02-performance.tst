@@ -25,6 +25,11 @@
 #              1,000,000 iterations of TRTR  took     213,296 microseconds
 #              1,000,000 iterations of TRTR  took     244,180 microseconds
 #              1,000,000 iterations of TRTR  took     253,886 microseconds
+#
+#  Each test is run twice: first with the host SIMD kernels disabled
+#  ("simd none") and then with the best ones the host supports
+#  ("simd best"), so that the two sets of timings show the speedup
+#  of the kernels. Both timing lines below need to be uncommented.
 # ------------------------------------------------------------------------------
 
 mainsize    16
@@ -32,6 +37,19 @@ numcpu      1
 sysclear
 archlvl     z/Arch
 
+simd        none      # (first without the host SIMD kernels)
+
+loadcore    "$(testpath)/TRTR-02-performance.core" 0x0
+
+diag8cmd    enable    # (needed for messages to Hercules console)
+#r           408=ff    # (enable timing tests)
+runtest     300       # (test duration, depends on host)
+diag8cmd    disable   # (reset back to default)
+
+simd        best      # (then with the best ones the host supports)
+sysclear
+archlvl     z/Arch
+
 loadcore    "$(testpath)/TRTR-02-performance.core" 0x0
 
 diag8cmd    enable    # (needed for messages to Hercules console)
@@ -0,0 +1,45 @@
+#-------------------------------------------------------------------------------
+
+*Testcase cpuloops adaptive interrupt check interval command
+
+#-------------------------------------------------------------------------------
+
+msglevel -debug
+numcpu 1
+
+*Compare
+
+* Default is the fixed interval
+cpuloops
+*Info 1 HHC02203I CPULOOPS      : OFF (fixed interval of 256)
+*Info HHC02288I Processor CP00: interval   256, interrupts 0, latency avg 0 max 0 usecs
+
+* Invalid targets
+cpuloops 0
+*Error HHC02205E Invalid argument 0: must be 'off' or n where 1 <= n <= 1000000
+
+cpuloops 1000001
+*Error HHC02205E Invalid argument 1000001: must be 'off' or n where 1 <= n <= 1000000
+
+cpuloops 20us
+*Error HHC02205E Invalid argument 20us: must be 'off' or n where 1 <= n <= 1000000
+
+cpuloops 20 30
+*Error HHC02299E Invalid command usage. Type 'help CPULOOPS' for assistance.
+
+* Set and display a latency target
+cpuloops 20
+cpuloops
+*Info 1 HHC02203I CPULOOPS      : 20 usecs
+
+cpuloops reset
+*Info HHC02268I Done!
+
+* Back to the fixed interval
+cpuloops off
+cpuloops
+*Info 1 HHC02203I CPULOOPS      : OFF (fixed interval of 256)
+
+*Done nowait
+
+#-------------------------------------------------------------------------------
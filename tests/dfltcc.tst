@@ -0,0 +1,225 @@
+#-------------------------------------------------------------------------------
+
+*Testcase dfltcc DEFLATE conversion call
+
+#-------------------------------------------------------------------------------
+#
+#  DFLTCC query and generate dynamic-Huffman table, then 96K of mixed
+#  text-like, repeated and random data is compressed and expanded back
+#  both in one go and in small pieces, so that compression resumes with
+#  an open block and expansion resumes in the middle of matches, codes,
+#  block headers and stored blocks.  The expanded data and the check
+#  values (CRC-32 and Adler-32) must match the original.
+#
+#-------------------------------------------------------------------------------
+
+msglevel -debug
+numcpu 1
+sysclear
+archlvl z/Arch
+
+*Compare
+
+r 1a0=00000001800000000000000000000200   # z/Arch restart PSW
+r 1d0=0002000180000000000000000000DEAD   # z/Arch pgm new PSW
+
+r 200=C0D100002000             #       LGFI  13,X'2000'
+r 206=C0C100001000             #       LGFI  12,X'1000'
+r 20c=C02100010000             #       LGFI  2,X'10000'
+r 212=C03100010000             #       LGFI  3,X'10000'
+r 218=C05100003039             #       LGFI  5,X'3039'
+r 21e=C25100010DCD             #       MSFI  5,69069
+r 224=C25B00000001             #       ALFI  5,1
+r 22a=1895                     #       LR    9,5
+r 22c=8890001C                 #       SRL   9,28
+r 230=43A9CF00                 #       IC    10,X'F00'(9,12)
+r 234=42A02000                 #       STC   10,0(,2)
+r 238=41202001                 #       LA    2,1(,2)
+r 23c=A737FFF1                 #       BRCTG 3,FILL
+r 240=C03100008000             #       LGFI  3,X'8000'
+r 246=C25100010DCD             #       MSFI  5,69069
+r 24c=C25B00000001             #       ALFI  5,1
+r 252=1895                     #       LR    9,5
+r 254=88900018                 #       SRL   9,24
+r 258=42902000                 #       STC   9,0(,2)
+r 25c=41202001                 #       LA    2,1(,2)
+r 260=A737FFF3                 #       BRCTG 3,RAND
+r 264=C02100018000             #       LGFI  2,X'18000'
+r 26a=C03100004000             #       LGFI  3,X'4000'
+r 270=C0A100010000             #       LGFI  10,X'10000'
+r 276=C0B100004000             #       LGFI  11,X'4000'
+r 27c=0E2A                     #       MVCL  2,10        32K back copy
+r 27e=C0210001C000             #       LGFI  2,X'1C000'
+r 284=C03100001000             #       LGFI  3,X'1000'
+r 28a=A7A90000                 #       LGHI  10,0
+r 28e=C0B1A7000000             #       LGFI  11,X'A7000000'
+r 294=0E2A                     #       MVCL  2,10        run of X'A7'
+r 296=A7090000                 #       LGHI  0,0
+r 29a=C01100006000             #       LGFI  1,X'6000'
+r 2a0=B9398046                 #       DFLTCC 4,6,8
+r 2a4=A7A80000                 #       LHI   10,0
+r 2a8=B22200A0                 #       IPM   10
+r 2ac=50A0D100                 #       ST    10,X'100'(,13)
+r 2b0=A7090001                 #       LGHI  0,1
+r 2b4=C01100005800             #       LGFI  1,X'5800'
+r 2ba=B9398046                 #       DFLTCC 4,6,8
+r 2be=A7A80000                 #       LHI   10,0
+r 2c2=B22200A0                 #       IPM   10
+r 2c6=50A0D104                 #       ST    10,X'104'(,13)
+r 2ca=C08100030000             #       LGFI  8,X'30000'
+r 2d0=C01100003000             #       LGFI  1,X'3000'
+r 2d6=92891010                 #       MVI   X'10'(1),X'89'
+r 2da=A7090082                 #       LGHI  0,130
+r 2de=C04100040000             #       LGFI  4,X'40000'
+r 2e4=C05100020000             #       LGFI  5,X'20000'
+r 2ea=C06100010000             #       LGFI  6,X'10000'
+r 2f0=C07100018000             #       LGFI  7,X'18000'
+r 2f6=B9398046                 #       DFLTCC 4,6,8
+r 2fa=A714FFFE                 #       BRC   1,A1
+r 2fe=A7A80000                 #       LHI   10,0
+r 302=B22200A0                 #       IPM   10
+r 306=50A0D108                 #       ST    10,X'108'(,13)
+r 30a=B9040074                 #       LGR   7,4
+r 30e=C27400040000             #       SLGFI 7,X'40000'
+r 314=A77B0002                 #       AGHI  7,2
+r 318=C01100003800             #       LGFI  1,X'3800'
+r 31e=92801010                 #       MVI   X'10'(1),X'80'
+r 322=A7090084                 #       LGHI  0,132
+r 326=C04100060000             #       LGFI  4,X'60000'
+r 32c=C05100018000             #       LGFI  5,X'18000'
+r 332=C06100040000             #       LGFI  6,X'40000'
+r 338=B9398046                 #       DFLTCC 4,6,8
+r 33c=A714FFFE                 #       BRC   1,B1
+r 340=A7A80000                 #       LHI   10,0
+r 344=B22200A0                 #       IPM   10
+r 348=50A0D10C                 #       ST    10,X'10C'(,13)
+r 34c=E350D0000024             #       STG   5,X'000'(,13)
+r 352=C02100060000             #       LGFI  2,X'60000'
+r 358=C03100018000             #       LGFI  3,X'18000'
+r 35e=C0A100010000             #       LGFI  10,X'10000'
+r 364=C0B100018000             #       LGFI  11,X'18000'
+r 36a=0F2A                     #       CLCL  2,10
+r 36c=A7A80000                 #       LHI   10,0
+r 370=B22200A0                 #       IPM   10
+r 374=50A0D110                 #       ST    10,X'110'(,13)
+r 378=C03100003000             #       LGFI  3,X'3000'
+r 37e=D50330303830             #       CLC   X'030'(4,3),X'830'(3)  CV A vs B
+r 384=A7A80000                 #       LHI   10,0
+r 388=B22200A0                 #       IPM   10
+r 38c=50A0D114                 #       ST    10,X'114'(,13)
+r 390=C01100004000             #       LGFI  1,X'4000'
+r 396=92801010                 #       MVI   X'10'(1),X'80'
+r 39a=A7090084                 #       LGHI  0,132
+r 39e=C04100080000             #       LGFI  4,X'80000'
+r 3a4=A7590000                 #       LGHI  5,0
+r 3a8=C06100040000             #       LGFI  6,X'40000'
+r 3ae=A7790000                 #       LGHI  7,0
+r 3b2=C0B1000F4240             #       LGFI  11,X'F4240'
+r 3b8=B9398046                 #       DFLTCC 4,6,8
+r 3bc=A7840012                 #       BRC   8,C9
+r 3c0=A7440006                 #       BRC   4,C4
+r 3c4=A7240008                 #       BRC   2,C2
+r 3c8=A7F40008                 #       J     C5
+r 3cc=A75B0032                 #       AGHI  5,50
+r 3d0=A7F40004                 #       J     C5
+r 3d4=A77B0007                 #       AGHI  7,7
+r 3d8=A7B7FFF0                 #       BRCTG 11,C1
+r 3dc=92EED118                 #       MVI   X'118'(13),X'EE'
+r 3e0=C02100080000             #       LGFI  2,X'80000'
+r 3e6=C03100018000             #       LGFI  3,X'18000'
+r 3ec=C0A100010000             #       LGFI  10,X'10000'
+r 3f2=C0B100018000             #       LGFI  11,X'18000'
+r 3f8=0F2A                     #       CLCL  2,10
+r 3fa=A7A80000                 #       LHI   10,0
+r 3fe=B22200A0                 #       IPM   10
+r 402=50A0D11C                 #       ST    10,X'11C'(,13)
+r 406=C03100003800             #       LGFI  3,X'3800'
+r 40c=D50330303830             #       CLC   X'030'(4,3),X'830'(3)  CV B vs C
+r 412=A7A80000                 #       LHI   10,0
+r 416=B22200A0                 #       IPM   10
+r 41a=50A0D120                 #       ST    10,X'120'(,13)
+r 41e=C01100004800             #       LGFI  1,X'4800'
+r 424=92A81010                 #       MVI   X'10'(1),X'A8'
+r 428=A7090082                 #       LGHI  0,130
+r 42c=C041000A0000             #       LGFI  4,X'A0000'
+r 432=A7590000                 #       LGHI  5,0
+r 436=C06100010000             #       LGFI  6,X'10000'
+r 43c=A7790000                 #       LGHI  7,0
+r 440=C09100018000             #       LGFI  9,X'18000'
+r 446=C0B1000F4240             #       LGFI  11,X'F4240'
+r 44c=B9020077                 #       LTGR  7,7
+r 450=A7740014                 #       BRC   7,D3
+r 454=B9020099                 #       LTGR  9,9
+r 458=A784001A                 #       BRC   8,D9
+r 45c=A77903E8                 #       LGHI  7,1000
+r 460=B9200079                 #       CGR   7,9
+r 464=A7C40004                 #       BRC   12,D2
+r 468=B9040079                 #       LGR   7,9
+r 46c=B9090097                 #       SGR   9,7
+r 470=A7740004                 #       BRC   7,D3
+r 474=96011010                 #       OI    X'10'(1),X'01'
+r 478=B9398046                 #       DFLTCC 4,6,8
+r 47c=A7B40004                 #       BRC   11,D5
+r 480=A75B0028                 #       AGHI  5,40
+r 484=A7B7FFE4                 #       BRCTG 11,D1
+r 488=92EED124                 #       MVI   X'124'(13),X'EE'
+r 48c=B9040074                 #       LGR   7,4
+r 490=C274000A0000             #       SLGFI 7,X'A0000'
+r 496=A77B0002                 #       AGHI  7,2
+r 49a=E370D0080024             #       STG   7,X'008'(,13)
+r 4a0=C01100005000             #       LGFI  1,X'5000'
+r 4a6=92A01010                 #       MVI   X'10'(1),X'A0'
+r 4aa=A7090084                 #       LGHI  0,132
+r 4ae=C041000C0000             #       LGFI  4,X'C0000'
+r 4b4=C05100018000             #       LGFI  5,X'18000'
+r 4ba=C061000A0000             #       LGFI  6,X'A0000'
+r 4c0=B9398046                 #       DFLTCC 4,6,8
+r 4c4=A714FFFE                 #       BRC   1,E1
+r 4c8=A7A80000                 #       LHI   10,0
+r 4cc=B22200A0                 #       IPM   10
+r 4d0=50A0D128                 #       ST    10,X'128'(,13)
+r 4d4=C021000C0000             #       LGFI  2,X'C0000'
+r 4da=C03100018000             #       LGFI  3,X'18000'
+r 4e0=C0A100010000             #       LGFI  10,X'10000'
+r 4e6=C0B100018000             #       LGFI  11,X'18000'
+r 4ec=0F2A                     #       CLCL  2,10
+r 4ee=A7A80000                 #       LHI   10,0
+r 4f2=B22200A0                 #       IPM   10
+r 4f6=50A0D12C                 #       ST    10,X'12C'(,13)
+r 4fa=C03100004800             #       LGFI  3,X'4800'
+r 500=D50330303830             #       CLC   X'030'(4,3),X'830'(3)  CV D vs E
+r 506=A7A80000                 #       LHI   10,0
+r 50a=B22200A0                 #       IPM   10
+r 50e=50A0D130                 #       ST    10,X'130'(,13)
+r 512=B2B20600                 #       LPSWE DONE
+
+r 600=00020001800000000000000000000000   # DONE
+
+r 1f00=6574616F696E7372686C642063752E0A   # letters
+
+runtest 5
+
+r 2000.8 # op1 remaining after one-shot XPND
+*Want 00000000 00000000
+r 2100.10 # cc QAF GDHT CMPR XPND
+*Want 00000000 00000000 00000000 00000000
+r 2110.10 # cc CLCL CV guard CLCL
+*Want 00000000 00000000 00000000 00000000
+r 2120.10 # cc CV guard XPND CLCL
+*Want 00000000 00000000 00000000 00000000
+r 2130.4 # cc CV
+*Want 00000000
+r 3030.4 # CRC-32
+*Want 40EE7AB2
+r 4830.4 # Adler-32
+*Want F92DF0EC
+r 5838.2 # CDHTL
+*Want 0153
+r 5840.8 # CDHT
+*Want BDE3366C 0386B9F7
+r 6000.10 # QAF installed functions
+*Want E8000000 00000000 00000000 00000000
+r 6010.10 # QAF installed formats
+*Want 00000000 00000000 80000000 00000000
+
+*Done
@@ -0,0 +1,54 @@
+*Testcase dirty: changed frame bitmap
+
+# After the bitmap is reset, the program (DAT on, identity mapped)
+# stores into frames 3, 5 (twice) and 7, and the restart interrupt
+# stores its old PSW into the PSA in frame 0: four frames changed.
+# Resetting the bitmap must also purge the TLB, so that running the
+# program again (whose stores would otherwise hit in the TLB without
+# setting the change bit again) marks the same frames again.
+
+sysclear
+archlvl z/Arch
+
+r 1a0=00000001800000000000000000000200  # z/Arch restart PSW
+r 1d0=0002000180000000000000000000DEAD  # z/Arch pgm new PSW
+
+r 200=EB110288002F                      # LCTLG 1,1,ASCE
+r 206=B2B20290                          # LPSWE DATPSW
+r 288=0000000000010000                  # ASCE: segment table at 10000
+r 290=04000001800000000000000000000300  # DATPSW: DAT on, go to 300
+r 2a0=00020001800000000000000000000000  # GOODPSW
+
+r 300=C02F00003000                      # IILF  2,X'3000'
+r 306=92012000                          # MVI   0(2),1
+r 30a=C02F00005000                      # IILF  2,X'5000'
+r 310=92022000                          # MVI   0(2),2
+r 314=92032800                          # MVI   X'800'(2),3
+r 318=C02F00007000                      # IILF  2,X'7000'
+r 31e=92042000                          # MVI   0(2),4
+r 322=B2B202A0                          # LPSWE GOODPSW
+
+r 10000=0000000000011000                # STE 0: page table at 11000
+r 11000=0000000000000000                # PTE 0x0000 -> 0000
+r 11018=0000000000003000                # PTE 0x3000 -> 3000
+r 11028=0000000000005000                # PTE 0x5000 -> 5000
+r 11038=0000000000007000                # PTE 0x7000 -> 7000
+
+dirty reset
+runtest .1
+
+*Compare
+dirty
+*Info 1 HHC17019I MAIN     storage has 4 of 512 4K frames changed
+
+dirty reset
+*Info 1 HHC17019I MAIN     storage has 4 of 512 4K frames changed
+
+dirty
+*Info 1 HHC17019I MAIN     storage has 0 of 512 4K frames changed
+
+runtest .1
+dirty
+*Info 1 HHC17019I MAIN     storage has 4 of 512 4K frames changed
+
+*Done
@@ -0,0 +1,63 @@
+*Testcase edat-tlb: EDAT-1 large frame TLB entries
+
+# With enhanced DAT enabled, segments 0 and 3 are 1M frames at real
+# 0 and 100000. After the first load from segment 3, the loads from
+# its other pages are translated from the large frame TLB entry. The
+# IPTE of a page table entry for a page of the frame must purge that
+# entry, so the next load walks the tables again.
+
+sysclear
+archlvl z/Arch
+tlb reset
+
+r 1a0=00000001800000000000000000000200  # z/Arch restart PSW
+r 1d0=0002000180000000000000000000DEAD  # z/Arch pgm new PSW
+
+r 200=EB000280002F                      # LCTLG 0,0,CR0
+r 206=EB110288002F                      # LCTLG 1,1,ASCE
+r 20c=B2B20290                          # LPSWE DATPSW
+r 280=00000000008000E0                  # CR0: enhanced DAT enabled
+r 288=0000000000010000                  # ASCE: segment table at 10000
+r 290=04000001800000000000000000000300  # DATPSW: DAT on, go to 300
+r 2a0=00020001800000000000000000000000  # GOODPSW
+
+r 300=C02F00301000                      # IILF  2,X'301000'
+r 306=58102000                          # L     1,0(,2)    (walk)
+r 30a=C02F00302000                      # IILF  2,X'302000'
+r 310=58202000                          # L     2,0(,2)    (large)
+r 314=C03F00303000                      # IILF  3,X'303000'
+r 31a=58303000                          # L     3,0(,3)    (large)
+r 31e=C04F00305000                      # IILF  4,X'305000'
+r 324=C05F00011000                      # IILF  5,X'11000'  (PTO)
+r 32a=B2210054                          # IPTE  5,4
+r 32e=C07F00304000                      # IILF  7,X'304000'
+r 334=58707000                          # L     7,0(,7)    (walk)
+r 338=C08F00306000                      # IILF  8,X'306000'
+r 33e=58808000                          # L     8,0(,8)    (large)
+r 342=B2B202A0                          # LPSWE GOODPSW
+
+r 10000=0000000000000400                # STE 0: 1M frame at 0
+r 10018=0000000000100400                # STE 3: 1M frame at 100000
+r 11028=0000000000104000                # PTE purged by IPTE
+r 101000=11111111
+r 102000=22222222
+r 103000=33333333
+r 104000=44444444
+r 106000=66666666
+
+runtest .1
+*Compare
+gpr
+*Gpr 1 11111111
+*Gpr 2 22222222
+*Gpr 3 33333333
+*Gpr 7 44444444
+*Gpr 8 66666666
+
+r 1102c.4
+*Want 00104400
+
+tlb stats
+*Info HHC02284I CP00: large frame entries 3, TLB misses resolved 3
+
+*Done
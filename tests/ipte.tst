@@ -0,0 +1,45 @@
+*Testcase ipte: IPTE purges the TLB entry for the page, whatever its way
+
+# Pages 0x5000 and 0x405000 use the same TLB set, so the first page's
+# entry is in way 1 of the set when it is invalidated by IPTE. The
+# final load from it must then take a page translation exception.
+
+sysclear
+archlvl z/Arch
+
+r 1a0=00000001800000000000000000000200  # z/Arch restart PSW
+r 1d0=00000001800000000000000000000400  # z/Arch pgm new PSW
+
+r 200=EB110280002F                      # LCTLG 1,1,ASCE
+r 206=B2B20290                          # LPSWE DATPSW
+r 280=0000000000010000                  # ASCE: segment table at 10000
+r 290=04000001800000000000000000000300  # DATPSW: DAT on, go to 300
+r 2a0=0002000180000000000000000000DEAD  # BADPSW
+r 2b0=00020001800000000000000000000000  # GOODPSW
+
+r 300=C02F00005000                      # IILF  2,X'5000'
+r 306=C04F00405000                      # IILF  4,X'405000'
+r 30c=C03F00011000                      # IILF  3,X'11000'  (PTO)
+r 312=58102000                          # L     1,0(,2)    (way 1)
+r 316=58504000                          # L     5,0(,4)    (way 0)
+r 31a=B2210032                          # IPTE  3,2
+r 31e=58602000                          # L     6,0(,2)    (PIC 11)
+r 322=B2B202A0                          # LPSWE BADPSW
+r 400=B2B202B0                          # LPSWE GOODPSW
+
+r 10000=0000000000011000                # STE 0: page table at 11000
+r 10020=0000000000011800                # STE 4: page table at 11800
+r 11028=0000000000005000                # PTE 0x5000   -> 5000
+r 11828=0000000000006000                # PTE 0x405000 -> 6000
+r 5000=11111111
+r 6000=22222222
+
+runtest .1
+gpr
+*Compare
+r 8c.4
+*Want 00040011
+*Gpr 1 11111111
+*Gpr 5 22222222
+*Gpr 6 0
+*Done
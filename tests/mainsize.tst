@@ -198,6 +198,24 @@ mainsize 64k
 archlvl z/Arch
 *Info 2 HHC17006W MAINSIZE increased to 1M architectural minimum
 
+#-------------------------------------------------------------------------------
+# Test that clearing storage releases it to the host instead of zeroing it
+
+* Test 26
+
+*If $ptrsize \= 4
+
+  mainsize 4g
+  r 100=01
+  r ffff0000=02
+  sysclear
+  qstor main
+  *Info HHC17018I MAIN     storage has 0 of 4G resident in host memory
+  r 100.1
+  *Want 00
+
+*Fi
+
 *Done nowait
 
 #-------------------------------------------------------------------------------
@@ -0,0 +1,95 @@
+*Testcase msa-performance (crypto instructions with and without host kernels)
+# ------------------------------------------------------------------------------
+#  This tests the host crypto kernels against the portable crypto code and,
+#  optionally, the performance of the two.
+#
+#  The test program in msa-performance.subtst enciphers 20K of data at
+#  addresses that are not aligned on a block, so that blocks cross page
+#  boundaries, with KM (AES-128), KMC (AES-192) and KMCTR (AES-256), and
+#  hashes it with KIMD (GHASH) and KLMD (SHA-1 and SHA-256). It then hashes
+#  the three cipher outputs with KLMD (SHA-256) and deciphers the KM and KMC
+#  outputs in place, comparing them with the original data. It is run once
+#  without the host kernels ("simd none") and once with the best ones the
+#  host supports ("simd best"); both runs must give the same results.
+#
+#  The default is to NOT run performance tests. To enable this performance
+#  test, uncomment the "#r 408=ff" line at the end of the .subtst file.
+#
+#     Output:
+#
+#        For each run, a console line will be generated with timing
+#        results, as follows:
+#
+#        500 passes of KM, KMC, KMCTR, KIMD and KLMD over 20K took 1,234,567 microseconds
+#
+# ------------------------------------------------------------------------------
+numcpu      1
+sysclear
+archlvl     z/Arch
+diag8cmd    enable    # (needed for messages to Hercules console)
+
+*Compare
+
+simd        none      # (first without the host kernels)
+script      "$(testpath)/msa-performance.subtst"
+runtest     60        # (test duration, depends on host)
+
+r 5100.8 # KM and KMC deciphered in place
+*Want 00000000 00000000
+r 5300.10 # GHASH
+*Want 8BD0A4A4 B6DC2370 FAB1C3F1 54E78B47
+r 5310.10 # SHA-1
+*Want 7650DD49 9553BE71 AB254414 BF017EEF
+r 5320.4
+*Want AFE273A4
+r 5330.10 # SHA-256
+*Want F06989EE 66217C15 ABE3573D 1194A878
+r 5340.10
+*Want 01A4A98F D526BD86 3174BE7D AD11234E
+r 4600.10 # SHA-256 of the KM output
+*Want 418BDFFA 63057374 DAF0A43B 69805D42
+r 4610.10
+*Want CC76DE19 12C2A190 1BD0F3DB 9088240F
+r 4640.10 # SHA-256 of the KMC output
+*Want 7EFBD428 67B3334C F963D845 32DD5606
+r 4650.10
+*Want B04D2821 E3B4787C E2CBFACE D21A9DDA
+r 4680.10 # SHA-256 of the KMCTR output
+*Want 21EE31ED 01D01DB8 DC6BC876 DF62A40D
+r 4690.10
+*Want C177A515 CD1554CB 4CD8F62E 3B2BB787
+
+sysclear
+archlvl     z/Arch
+simd        best      # (then with the best ones the host supports)
+script      "$(testpath)/msa-performance.subtst"
+runtest     60
+
+r 5100.8 # KM and KMC deciphered in place
+*Want 00000000 00000000
+r 5300.10 # GHASH
+*Want 8BD0A4A4 B6DC2370 FAB1C3F1 54E78B47
+r 5310.10 # SHA-1
+*Want 7650DD49 9553BE71 AB254414 BF017EEF
+r 5320.4
+*Want AFE273A4
+r 5330.10 # SHA-256
+*Want F06989EE 66217C15 ABE3573D 1194A878
+r 5340.10
+*Want 01A4A98F D526BD86 3174BE7D AD11234E
+r 4600.10 # SHA-256 of the KM output
+*Want 418BDFFA 63057374 DAF0A43B 69805D42
+r 4610.10
+*Want CC76DE19 12C2A190 1BD0F3DB 9088240F
+r 4640.10 # SHA-256 of the KMC output
+*Want 7EFBD428 67B3334C F963D845 32DD5606
+r 4650.10
+*Want B04D2821 E3B4787C E2CBFACE D21A9DDA
+r 4680.10 # SHA-256 of the KMCTR output
+*Want 21EE31ED 01D01DB8 DC6BC876 DF62A40D
+r 4690.10
+*Want C177A515 CD1554CB 4CD8F62E 3B2BB787
+
+sysclear
+diag8cmd    disable   # (reset back to default)
+*Done
@@ -0,0 +1,96 @@
+*Testcase mvcl-performance: MVCL move rate, scalar and host SIMD
+
+# Each entry of the table at 800 is run as a loop of MVCLs, timed with
+# STCK, and its rate in bytes per microsecond (i.e. MB/s) is stored in
+# EBCDIC in the last eight bytes of the entry. The table is run once
+# with the host SIMD kernels disabled and once with the best ones the
+# host supports, and the moved data is checked after each run. The
+# rates themselves depend on the host and are only displayed.
+#
+#   Table entry:  dst F, src F, len F, iterations F, label CL8, MB/s CL8
+#
+#   ALIGNED  4K from a doubleword aligned source
+#   UNALIGN  4000 bytes from a source one byte off a doubleword
+#   XPAGE    4K with both operands crossing a page boundary
+#   SHORT    256 bytes
+
+sysclear
+archlvl z/Arch
+
+r 1a0=00000001800000000000000000000200  # z/Arch restart PSW
+r 1d0=0002000180000000000000000000DEAD  # z/Arch pgm new PSW
+
+r 200=41400800                          #       LA    4,TABLE
+r 204=58504000                          # LOOP  L     5,0(,4)
+r 208=1255                              #       LTR   5,5
+r 20a=A7840031                          #       BRC   8,DONE
+r 20e=5890400C                          #       L     9,12(,4)
+r 212=B2050900                          #       STCK  START
+r 216=58204000                          # MOVE  L     2,0(,4)
+r 21a=58304008                          #       L     3,8(,4)
+r 21e=58604004                          #       L     6,4(,4)
+r 222=1873                              #       LR    7,3
+r 224=0E26                              #       MVCL  2,6
+r 226=A796FFF8                          #       BRCT  9,MOVE
+r 22a=B2050908                          #       STCK  STOP
+r 22e=E31009080004                      #       LG    1,STOP
+r 234=E31009000009                      #       SG    1,START
+r 23a=EB11000C000C                      #       SRLG  1,1,12
+r 240=E3B040080016                      #       LLGF  11,8(,4)
+r 246=E3B0400C001C                      #       MSGF  11,12(,4)
+r 24c=A7A90000                          #       LGHI  10,0
+r 250=B98700A1                          #       DLGR  10,1
+r 254=4EB00910                          #       CVD   11,DEC
+r 258=D20740180918                      #       MVC   24(8,4),PATTERN
+r 25e=DE0740180914                      #       ED    24(8,4),DEC+4
+r 264=41404020                          #       LA    4,32(,4)
+r 268=A7F4FFCE                          #       BRC   15,LOOP
+r 26c=B2B20920                          # DONE  LPSWE GOODPSW
+
+r 918=4020202020202120                  # PATTERN
+r 920=00020001800000000000000000000000  # GOODPSW
+
+r 800=000200000001000000001000000186A0  # ALIGNED
+r 810=C1D3C9C7D5C5C4404040404040404040
+r 820=000200000001000100000FA0000186A0  # UNALIGN
+r 830=E4D5C1D3C9C7D5404040404040404040
+r 840=000304000001080000001000000186A0  # XPAGE
+r 850=E7D7C1C7C54040404040404040404040
+r 860=00020000000100000000010000061A80  # SHORT
+r 870=E2C8D6D9E34040404040404040404040
+r 880=00000000
+
+r 10000=00112233445566778899AABBCCDDEEFF  # Start of ALIGNED and SHORT
+r 10f91=FFEEDDCCBBAA99887766554433221100  # End of UNALIGN
+r 117f0=0123456789ABCDEFFEDCBA9876543210  # End of XPAGE
+
+simd none
+runtest 10
+
+*Compare
+r 20000.10
+*Want 00112233 44556677 8899AABB CCDDEEFF
+r 20f90.10
+*Want FFEEDDCC BBAA9988 77665544 33221100
+r 313f0.10
+*Want 01234567 89ABCDEF FEDCBA98 76543210
+
+r 800.80
+
+r 20000=00000000000000000000000000000000
+r 20f90=00000000000000000000000000000000
+r 313f0=00000000000000000000000000000000
+simd best
+runtest 10
+
+*Compare
+r 20000.10
+*Want 00112233 44556677 8899AABB CCDDEEFF
+r 20f90.10
+*Want FFEEDDCC BBAA9988 77665544 33221100
+r 313f0.10
+*Want 01234567 89ABCDEF FEDCBA98 76543210
+
+r 800.80
+
+*Done
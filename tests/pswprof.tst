@@ -0,0 +1,49 @@
+#-------------------------------------------------------------------------------
+
+*Testcase pswprof PSW sampling profiler command
+
+#-------------------------------------------------------------------------------
+
+msglevel -debug
+numcpu 1
+
+*Compare
+
+* Off and no samples by default
+pswprof
+*Info HHC02203I PSWPROF       : OFF
+
+* Invalid arguments
+pswprof on 0
+*Error HHC02205E Invalid argument 0: must be n where 1 <= n <= 1000000
+
+pswprof on 1000001
+*Error HHC02205E Invalid argument 1000001: must be n where 1 <= n <= 1000000
+
+pswprof bogus
+*Error HHC02299E Invalid command usage. Type 'help PSWPROF' for assistance.
+
+pswprof folded
+*Error HHC02299E Invalid command usage. Type 'help PSWPROF' for assistance.
+
+* Start sampling; a stopped CPU is never sampled
+pswprof on 200
+pswprof
+*Info 1 HHC02203I PSWPROF       : ON, every 200 usecs
+*Info HHC02295I 0 samples, 0 waiting, 0 dropped, 0 distinct
+
+pswprof off
+pswprof
+*Info 1 HHC02203I PSWPROF       : OFF
+*Info HHC02295I 0 samples, 0 waiting, 0 dropped, 0 distinct
+
+* Reset while off discards the table
+pswprof reset
+*Info HHC02268I Done!
+
+pswprof pprof pswprof.prof
+*Error HHC02219E Error in function pswprof_collect(): no samples
+
+*Done nowait
+
+#-------------------------------------------------------------------------------
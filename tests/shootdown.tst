@@ -0,0 +1,64 @@
+*Testcase shootdown: IPTE purges the TLB entry of another running CPU
+
+# CPU 1 keeps loading from virtual 5000 while CPU 0 (DAT off) invalidates
+# the page table entry for it with IPTE. CPU 1 must see the invalidation
+# (its TLB entry purged at its next instruction loop boundary) and take
+# a page translation exception.
+
+sysclear
+archlvl z/Arch
+numcpu 2
+
+r 1a0=00000001800000000000000000000200  # CPU 0 z/Arch restart PSW
+r 1d0=0002000180000000000000000000DEAD  # CPU 0 z/Arch pgm new PSW
+r 2a0=00020001800000000000000000000000  # GOODPSW
+
+r 200=A7182000                          # LHI   1,X'2000'
+r 204=A7380001                          # LHI   3,1
+r 208=AE13000D                          # SIGP  1,3,X'0D'  set prefix
+r 20c=AE130006                          # SIGP  1,3,X'06'  restart
+r 210=C06F00007000                      # IILF  6,X'7000'
+r 216=95FF6000                          # CLI   0(6),X'FF' CPU 1 looping?
+r 21a=A774FFFE                          # JNE   *-4
+r 21e=C02F00005000                      # IILF  2,X'5000'
+r 224=C03F00011000                      # IILF  3,X'11000'  (PTO)
+r 22a=B2210032                          # IPTE  3,2
+r 22e=95FF6001                          # CLI   1(6),X'FF' CPU 1 PIC 11?
+r 232=A774FFFE                          # JNE   *-4
+r 236=B2B202A0                          # LPSWE GOODPSW
+
+r 21a0=00000001800000000000000000004100 # CPU 1 z/Arch restart PSW
+r 21d0=00000001800000000000000000004200 # CPU 1 z/Arch pgm new PSW
+
+r 4000=C02F00005000                     # IILF  2,X'5000'
+r 4006=C06F00007000                     # IILF  6,X'7000'
+r 400c=58102000                         # L     1,0(,2)
+r 4010=92FF6000                         # MVI   0(6),X'FF'
+r 4014=58102000                         # L     1,0(,2)
+r 4018=A7F4FFFE                         # J     *-4
+r 4100=C05F00008000                     # IILF  5,X'8000'
+r 4106=EB115000002F                     # LCTLG 1,1,0(5)   ASCE
+r 410c=B2B25010                         # LPSWE 16(5)      DATPSW
+r 4200=C06F00007000                     # IILF  6,X'7000'
+r 4206=92FF6001                         # MVI   1(6),X'FF'
+r 420a=B2B26010                         # LPSWE 16(6)      GOODPSW
+
+r 7010=00020001800000000000000000000000 # GOODPSW
+r 8000=0000000000010000                 # ASCE: segment table at 10000
+r 8010=04000001800000000000000000004000 # DATPSW: DAT on, go to 4000
+
+r 10000=0000000000011000                # STE 0: page table at 11000
+r 11020=0000000000004000                # PTE 0x4000 -> 4000
+r 11028=0000000000006000                # PTE 0x5000 -> 6000
+r 11038=0000000000007000                # PTE 0x7000 -> 7000
+r 6000=11111111
+
+runtest 1
+*Compare
+r 7000.2
+*Want FFFF
+r 208c.4
+*Want 00040011
+*Done
+
+numcpu 1
@@ -0,0 +1,45 @@
+*Testcase sie-tlb: SIE guest TLB contexts
+
+# A z/Arch host alternately dispatches two preferred (V=R) z/Arch
+# guests 100 times each. Each guest loads a word from 5000 and then
+# issues an SVC, which is intercepted. Apart from the first dispatch
+# of each guest, every dispatch should reuse the guest's TLB context.
+
+sysclear
+archlvl z/Arch
+tlb reset
+
+r 1a0=00000001800000000000000000000200  # z/Arch restart PSW
+r 1d0=0002000180000000000000000000DEAD  # z/Arch pgm new PSW
+
+r 200=C02F00005000                      # IILF  2,X'5000'
+r 206=C04F00003000                      # IILF  4,X'3000'
+r 20c=A7380064                          # LHI   3,100
+r 210=B2144000                          # SIE   0(4)          guest A
+r 214=D20740980290                      # MVC   X'98'(8,4),GUESTIA
+r 21a=B2144200                          # SIE   X'200'(4)     guest B
+r 21e=D20742980290                      # MVC   X'298'(8,4),GUESTIA
+r 224=A736FFF6                          # BRCT  3,*-20
+r 228=B2B202A0                          # LPSWE GOODPSW
+r 290=0000000000004000                  # GUESTIA
+r 2a0=00020001800000000000000000000000  # GOODPSW
+
+r 3000=0000080800008000                 # SD A: ESAME, V=R, prefix 8000
+r 3040=80000000                         #       intercept all SVCs
+r 3090=00000001800000000000000000004000 #       guest PSW
+r 3200=000008080000A000                 # SD B: ESAME, V=R, prefix A000
+r 3240=80000000                         #       intercept all SVCs
+r 3290=00000001800000000000000000004000 #       guest PSW
+
+r 4000=581020000A00                     # L 1,0(,2) / SVC 0
+r 5000=11111111
+
+runtest .5
+*Compare
+gpr
+*Gpr 1 11111111
+*Gpr 3 0
+tlb stats
+*Info 1 HHC02284I CP00 SIE: hits 396, misses 4, hit ratio 99.00%
+*Info HHC02284I CP00 SIE: dispatches 200, TLB context reused 198
+*Done
@@ -0,0 +1,48 @@
+*Testcase sortl-performance (SORTL merge against a program merge)
+# ------------------------------------------------------------------------------
+#  This ONLY tests the performance of the Enhanced-Sort Facility against
+#  the same merge done by the program itself.
+#
+#  Two sorted lists of 2,048 16-byte records are merged, with SORTL when
+#  the facility is installed and with a CLC/MVC loop otherwise.  The test
+#  program in sortl-performance.subtst checks the merged keys, and is run
+#  once with the facility enabled and once with it disabled.
+#
+#  The default is to NOT run performance tests. To enable this performance
+#  test, uncomment the "#r 408=ff" line at the end of the .subtst file.
+#
+#     Output:
+#
+#        For each run, a console line will be generated with timing
+#        results, as follows:
+#
+#        1,000 merges of 4,096 records with SORTL    took      80,430 microseconds
+#        1,000 merges of 4,096 records without SORTL took     435,700 microseconds
+#
+# ------------------------------------------------------------------------------
+numcpu      1
+sysclear
+archlvl     z/Arch
+diag8cmd    enable    # (needed for messages to Hercules console)
+
+*Compare
+
+script      "$(testpath)/sortl-performance.subtst"
+runtest     60        # (test duration, depends on host)
+
+r 2100.8 # merged keys ok, SORTL used
+*Want 00000000 00000001
+
+sysclear
+facility    disable   150_ENH_SORT   z/Arch
+archlvl     z/Arch
+script      "$(testpath)/sortl-performance.subtst"
+runtest     60
+
+r 2100.8 # merged keys ok, SORTL not used
+*Want 00000000 00000000
+
+sysclear
+facility    enable    150_ENH_SORT   z/Arch
+diag8cmd    disable   # (reset back to default)
+*Done
@@ -0,0 +1,221 @@
+#-------------------------------------------------------------------------------
+
+*Testcase sortl SORT LISTS
+
+#-------------------------------------------------------------------------------
+#
+#  SORTL query, then a merge of three fixed-length record lists, with a
+#  key crossing a page boundary and equal keys in every list, both in one
+#  go and continued 40 bytes of output at a time; sorted runs with run
+#  delimiters built from two unsorted lists; and a merge of two lists of
+#  variable-length records.
+#
+#-------------------------------------------------------------------------------
+
+msglevel -debug
+numcpu 1
+sysclear
+archlvl z/Arch
+
+*Compare
+
+r 1a0=00000001800000000000000000000200   # z/Arch restart PSW
+r 1d0=0002000180000000000000000000DEAD   # z/Arch pgm new PSW
+
+r 200=C0D100002000             #       LGFI  13,X'2000'
+r 206=A7090000                 #       LGHI  0,0
+r 20a=C01100004000             #       LGFI  1,X'4000'
+r 210=B9380046                 #       SORTL 4,6
+r 214=A7A80000                 #       LHI   10,0
+r 218=B22200A0                 #       IPM   10
+r 21c=50A0D100                 #       ST    10,X'100'(,13)
+r 220=A7090181                 #       LGHI  0,X'181'
+r 224=C01100003000             #       LGFI  1,X'3000'
+r 22a=C04100020000             #       LGFI  4,X'20000'
+r 230=C05100001000             #       LGFI  5,X'1000'
+r 236=C06100028000             #       LGFI  6,X'28000'
+r 23c=A7790040                 #       LGHI  7,64
+r 240=B9380046                 #       SORTL 4,6
+r 244=A714FFFE                 #       BRC   1,A1
+r 248=A7A80000                 #       LHI   10,0
+r 24c=B22200A0                 #       IPM   10
+r 250=50A0D104                 #       ST    10,X'104'(,13)
+r 254=EB47D2000024             #       STMG  4,7,X'200'(13)
+r 25a=A7090081                 #       LGHI  0,X'81'
+r 25e=C01100003400             #       LGFI  1,X'3400'
+r 264=C04100021000             #       LGFI  4,X'21000'
+r 26a=A7590028                 #       LGHI  5,40
+r 26e=C06100028800             #       LGFI  6,X'28800'
+r 274=A7790000                 #       LGHI  7,0
+r 278=A7B90064                 #       LGHI  11,100
+r 27c=B9380046                 #       SORTL 4,6
+r 280=A714FFFE                 #       BRC   1,B1
+r 284=A784000B                 #       BRC   8,B9
+r 288=D200D1141007             #       MVC   X'114'(1,13),X'007'(1)  CF
+r 28e=A75B0028                 #       AGHI  5,40
+r 292=A7B7FFF5                 #       BRCTG 11,B1
+r 296=92EED118                 #       MVI   X'118'(13),X'EE'
+r 29a=C02100021000             #       LGFI  2,X'21000'
+r 2a0=C03100020000             #       LGFI  3,X'20000'
+r 2a6=D5BF20003000             #       CLC   0(192,2),0(3)  B vs A
+r 2ac=A7A80000                 #       LHI   10,0
+r 2b0=B22200A0                 #       IPM   10
+r 2b4=50A0D108                 #       ST    10,X'108'(,13)
+r 2b8=A7090101                 #       LGHI  0,X'101'
+r 2bc=C01100003800             #       LGFI  1,X'3800'
+r 2c2=C04100022000             #       LGFI  4,X'22000'
+r 2c8=A7590030                 #       LGHI  5,48
+r 2cc=C06100029000             #       LGFI  6,X'29000'
+r 2d2=A7790040                 #       LGHI  7,64
+r 2d6=A7B90064                 #       LGHI  11,100
+r 2da=B9380046                 #       SORTL 4,6
+r 2de=A714FFFE                 #       BRC   1,C1
+r 2e2=A7840008                 #       BRC   8,C9
+r 2e6=A75B0030                 #       AGHI  5,48
+r 2ea=A7B7FFF8                 #       BRCTG 11,C1
+r 2ee=92EED11C                 #       MVI   X'11C'(13),X'EE'
+r 2f2=A7A80000                 #       LHI   10,0
+r 2f6=B22200A0                 #       IPM   10
+r 2fa=50A0D10C                 #       ST    10,X'10C'(,13)
+r 2fe=EB47D2200024             #       STMG  4,7,X'220'(13)
+r 304=A7090082                 #       LGHI  0,X'82'
+r 308=C01100003C00             #       LGFI  1,X'3C00'
+r 30e=C04100023000             #       LGFI  4,X'23000'
+r 314=C05100001000             #       LGFI  5,X'1000'
+r 31a=C06100029800             #       LGFI  6,X'29800'
+r 320=A7790000                 #       LGHI  7,0
+r 324=B9380046                 #       SORTL 4,6
+r 328=A714FFFE                 #       BRC   1,D1
+r 32c=A7A80000                 #       LHI   10,0
+r 330=B22200A0                 #       IPM   10
+r 334=50A0D110                 #       ST    10,X'110'(,13)
+r 338=B2B20600                 #       LPSWE DONE
+
+
+r 600=00020001800000000000000000000000   # DONE
+
+r 3000=0000000000000000D000000000080008   # A: lists 0, 1 and 3
+r 3040=00000000000100000000000000000040
+r 3050=0000000000011FFC0000000000000040
+r 3070=00000000000121000000000000000040
+r 3400=0000000000000000D000000000080008   # B: the same lists
+r 3440=00000000000100000000000000000040
+r 3450=0000000000011FFC0000000000000040
+r 3470=00000000000121000000000000000040
+r 3800=00000000000000008400000000080008   # C: lists 0 and 5
+r 3840=00000000000150000000000000000050
+r 3890=00000000000151000000000000000030
+r 3c00=0000000000000000C000000000080000   # D: lists 0 and 1
+r 3c40=00000000000140000000000000000033
+r 3c50=0000000000014800000000000000002A
+
+r 10000=0000000000000001C100000000000001  # list A
+r 10010=0000000000000003C100000000000002
+r 10020=0000000000000005C100000000000003
+r 10030=0000000000000007C100000000000004
+r 11ffc=0000000000000002C200000000000001  # list B, first key crosses a page
+r 1200c=0000000000000003C200000000000002
+r 1201c=0000000000000006C200000000000003
+r 1202c=0000000000000009C200000000000004
+r 12100=0000000000000000C300000000000001  # list C
+r 12110=0000000000000003C300000000000002
+r 12120=0000000000000008C300000000000003
+r 12130=0000000000000008C300000000000004
+r 14000=00000000000000100000000381828300  # variable list 0
+r 14010=00000000000030000000000000000000
+r 14020=0000500000000CC1C2C3C4C5C6C7C8C9
+r 14030=D1D2D3
+r 14800=000000000000002000000005F1F2F3F4  # variable list 1
+r 14810=F5000000000000003000000001E70000
+r 14820=00000000004000000000
+r 15000=0000000000000009C400000000000001  # unsorted list 0
+r 15010=0000000000000004C400000000000002
+r 15020=0000000000000004C400000000000003
+r 15030=0000000000000001C400000000000004
+r 15040=0000000000000007C400000000000005
+r 15100=0000000000000003C500000000000001  # unsorted list 5
+r 15110=0000000000000008C500000000000002
+r 15120=0000000000000002C500000000000003
+
+runtest 5
+
+r 2100.10 # cc QAF A B C
+*Want 00000000 00000000 00000000 00000000
+r 2110.10 # cc D, CF after cc1, loop guards
+*Want 00000000 01000000 00000000 00000000
+r 4000.10 # QAF installed functions
+*Want E0000000 00000000 00000000 00000000
+r 4010.10 # QAF installed formats
+*Want 00000000 00000000 80000000 00000000
+r 20000.10 # A: merged
+*Want 00000000 00000000 C3000000 00000001
+r 20010.10
+*Want 00000000 00000001 C1000000 00000001
+r 20020.10
+*Want 00000000 00000002 C2000000 00000001
+r 20030.10
+*Want 00000000 00000003 C1000000 00000002
+r 20040.10
+*Want 00000000 00000003 C2000000 00000002
+r 20050.10
+*Want 00000000 00000003 C3000000 00000002
+r 20060.10
+*Want 00000000 00000005 C1000000 00000003
+r 20070.10
+*Want 00000000 00000006 C2000000 00000003
+r 20080.10
+*Want 00000000 00000007 C1000000 00000004
+r 20090.10
+*Want 00000000 00000008 C3000000 00000003
+r 200a0.10
+*Want 00000000 00000008 C3000000 00000004
+r 200b0.10
+*Want 00000000 00000009 C2000000 00000004
+r 28000.8 # A: delimiter
+*Want 00000000 000200C0
+r 2200.10 # A: R4 R5
+*Want 00000000 000200C0 00000000 00000F40
+r 2210.10 # A: R6 R7
+*Want 00000000 00028008 00000000 00000038
+r 3040.10 # A: list 0 consumed
+*Want 00000000 00010040 00000000 00000000
+r 3400.10 # B: CF reset at the end
+*Want 00000000 00000000 D0000000 00080008
+r 22000.10 # C: sorted runs
+*Want 00000000 00000004 C4000000 00000002
+r 22010.10
+*Want 00000000 00000004 C4000000 00000003
+r 22020.10
+*Want 00000000 00000009 C4000000 00000001
+r 22030.10
+*Want 00000000 00000001 C4000000 00000004
+r 22040.10
+*Want 00000000 00000003 C5000000 00000001
+r 22050.10
+*Want 00000000 00000007 C4000000 00000005
+r 22060.10
+*Want 00000000 00000002 C5000000 00000003
+r 22070.10
+*Want 00000000 00000008 C5000000 00000002
+r 29000.10 # C: delimiters
+*Want 00000000 00022030 00000000 00022060
+r 29010.8
+*Want 00000000 00022080
+r 2220.10 # C: R4 R5
+*Want 00000000 00022080 00000000 00000010
+r 2230.10 # C: R6 R7
+*Want 00000000 00029018 00000000 00000028
+r 23000.10 # D: merged variable-length records
+*Want 00000000 00000010 00000003 81828300
+r 23010.10
+*Want 00000000 00002000 000005F1 F2F3F4F5
+r 23020.10
+*Want 00000000 00000030 00000000 00000000
+r 23030.10
+*Want 00000030 00000001 E7000000 00000000
+r 23040.10
+*Want 40000000 00000000 00000000 50000000
+r 23050.d
+*Want 0CC1C2C3 C4C5C6C7 C8C9D1D2 D3
+
+*Done
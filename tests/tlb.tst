@@ -0,0 +1,26 @@
+#-------------------------------------------------------------------------------
+
+*Testcase tlb statistics command
+
+#-------------------------------------------------------------------------------
+
+msglevel -debug
+numcpu 1
+
+*Compare
+
+tlb bogus
+*Error HHC02299E Invalid command usage. Type 'help TLB' for assistance.
+
+tlb stats extra
+*Error HHC02299E Invalid command usage. Type 'help TLB' for assistance.
+
+tlb reset
+*Info HHC02268I Done!
+
+tlb stats
+*Info HHC02284I CP00: hits 0, misses 0, hit ratio 0.00%
+
+*Done nowait
+
+#-------------------------------------------------------------------------------
@@ -0,0 +1,96 @@
+#-------------------------------------------------------------------------------
+
+*Testcase xpndsize expanded storage backed by host memory or a host file
+
+#-------------------------------------------------------------------------------
+
+msglevel -debug
+numcpu 1
+archlvl esa/390
+mainsize 1m
+
+*Compare
+
+#-------------------------------------------------------------------------------
+# Page out two pages to expanded storage and page them back in elsewhere
+
+r 000=0008000080000200           # ESA/390 restart PSW
+r 068=000A00000000DEAD           # ESA/390 pgm new PSW
+
+r 200=A7181000                   #       LHI   1,X'1000'
+r 204=1B22                       #       SR    2,2
+r 206=B22F0012                   #       PGOUT 1,2        block 0
+r 20a=A7183000                   #       LHI   1,X'3000'
+r 20e=A7280063                   #       LHI   2,99
+r 212=B22F0012                   #       PGOUT 1,2        block 99
+r 216=A7182000                   #       LHI   1,X'2000'
+r 21a=1B22                       #       SR    2,2
+r 21c=B22E0012                   #       PGIN  1,2        block 0
+r 220=A7184000                   #       LHI   1,X'4000'
+r 224=A7280063                   #       LHI   2,99
+r 228=B22E0012                   #       PGIN  1,2        block 99
+r 22c=A7280100                   #       LHI   2,256      (beyond 1M)
+r 230=B22E0012                   #       PGIN  1,2
+r 234=B2220050                   #       IPM   5          cc3 wanted
+r 238=82000300                   #       LPSW  DONE
+
+r 300=000A000000000000           # DONE
+
+* Test 1  (expanded storage backed by host memory)
+
+xpndsize 1m
+*Info HHC17003I EXPANDED storage is 1M (xpndsize); storage is not locked
+
+r 1000=0123456789ABCDEF
+r 1ff8=FEDCBA9876543210
+r 3000=00112233445566778899AABBCCDDEEFF
+r 3ff0=FFEEDDCCBBAA99887766554433221100
+
+runtest 1
+
+r 2000.8
+*Want 01234567 89ABCDEF
+r 2ff8.8
+*Want FEDCBA98 76543210
+r 4000.10
+*Want 00112233 44556677 8899AABB CCDDEEFF
+r 4ff0.10
+*Want FFEEDDCC BBAA9988 77665544 33221100
+gpr
+*Gpr 5 30000000
+
+* Test 2  (expanded storage backed by a sparse host file)
+
+xpndsize 1m file=xpndsize.tmp
+
+*If $platform = "Windows"
+  *Error HHC17015E File backed expanded storage support not included in this engine build
+*Else
+  *Info 1 HHC17003I EXPANDED storage is 1M (xpndsize); storage is not locked
+  *Info   HHC17023I EXPANDED storage is backed by file xpndsize.tmp
+*Fi
+
+r 2000=0000000000000000
+r 2ff8=0000000000000000
+r 4000=00000000000000000000000000000000
+r 4ff0=00000000000000000000000000000000
+gpr 5=0
+
+runtest 1
+
+r 2000.8
+*Want 01234567 89ABCDEF
+r 2ff8.8
+*Want FEDCBA98 76543210
+r 4000.10
+*Want 00112233 44556677 8899AABB CCDDEEFF
+r 4ff0.10
+*Want FFEEDDCC BBAA9988 77665544 33221100
+gpr
+*Gpr 5 30000000
+
+xpndsize 0
+
+*Done nowait
+
+#-------------------------------------------------------------------------------
@@ -0,0 +1,97 @@
+*Testcase zvecdec-performance (vector packed decimal against AP and MP)
+# ------------------------------------------------------------------------------
+#  This ONLY tests the performance of the vector packed decimal facility
+#  against the storage-to-storage decimal instructions.
+#
+#  The default is to NOT run performance tests. To enable this performance
+#  test, uncomment the "#r 408=ff   # (enable timing tests)" line below.
+#
+#  Tests:
+#
+#        1. VAP accumulating a 7 digit value into a vector register and
+#           VMP of two 7 digit values, both with 31 result digits
+#        2. AP accumulating the same value into a 16 byte field, and
+#           ZAP and MP of the same values into a 16 byte field
+#
+#     Output:
+#
+#        For each test, a console line will be generated with timing
+#        results, as follows:
+#
+#        1,000,000 iterations of VAP/VMP took     143,259 microseconds
+#        1,000,000 iterations of AP/MP   took     849,739 microseconds
+#
+# ------------------------------------------------------------------------------
+mainsize    1
+numcpu      1
+sysclear
+archlvl     z/Arch
+
+cr 0=00000000000600E0            # AFP and vector enablement
+
+r 1a0=00000001800000000000000000000200   # z/Arch restart PSW
+r 1d0=0002000180000000000000000000DEAD   # z/Arch pgm new PSW
+
+r 200=A7B81000                 #       LHI   11,X'1000'  data
+r 204=A7C82000                 #       LHI   12,X'2000'  results
+r 208=95FF0408                 #       CLI   X'408',X'FF'  timing enabled?
+r 20c=A774005A                 #       BRC   7,DONE  no, skip
+r 210=E710B0000006             #       VL    1,X'000'(,11)
+r 216=E720B0100006             #       VL    2,X'010'(,11)
+r 21c=E730B0400006             #       VL    3,X'040'(,11)
+r 222=C031000F4240             #       LGFI  3,1000000
+r 228=B205C000                 #       STCK  X'000'(,12)
+r 22c=E6332001F071             #       VAP   3,3,2,31,0
+r 232=E6412001F078             #       VMP   4,1,2,31,0
+r 238=A736FFFA                 #       BRCT  3,LOOP1
+r 23c=B205C008                 #       STCK  X'008'(,12)
+r 240=C031000F4240             #       LGFI  3,1000000
+r 246=B205C010                 #       STCK  X'010'(,12)
+r 24a=FAFFB040B010             #       AP    X'040'(16,11),X'010'(16,11)
+r 250=F8FFB060B000             #       ZAP   X'060'(16,11),X'000'(16,11)
+r 256=FCF7B060B018             #       MP    X'060'(16,11),X'018'(8,11)
+r 25c=A736FFF7                 #       BRCT  3,LOOP2
+r 260=B205C018                 #       STCK  X'018'(,12)
+r 264=E340C0080004             #       LG    4,X'008'(,12)
+r 26a=E340C0000009             #       SG    4,X'000'(,12)
+r 270=EB44000C000C             #       SRLG  4,4,12  microseconds
+r 276=4E40C020                 #       CVD   4,X'020'(,12)
+r 27a=D20BC12EB080             #       MVC   X'12E'(12,12),X'080'(11)  edit pattern
+r 280=DE0BC12EC023             #       ED    X'12E'(12,12),X'023'(12)
+r 286=4110C100                 #       LA    1,X'100'(,12)
+r 28a=A7280047                 #       LHI   2,71
+r 28e=83120008                 #       DIAG  1,2,X'008'
+r 292=E340C0180004             #       LG    4,X'018'(,12)
+r 298=E340C0100009             #       SG    4,X'010'(,12)
+r 29e=EB44000C000C             #       SRLG  4,4,12  microseconds
+r 2a4=4E40C020                 #       CVD   4,X'020'(,12)
+r 2a8=D20BC1AEB080             #       MVC   X'1AE'(12,12),X'080'(11)  edit pattern
+r 2ae=DE0BC1AEC023             #       ED    X'1AE'(12,12),X'023'(12)
+r 2b4=4110C180                 #       LA    1,X'180'(,12)
+r 2b8=A7280047                 #       LHI   2,71
+r 2bc=83120008                 #       DIAG  1,2,X'008'
+r 2c0=B2B20400                 #       LPSWE DONE
+
+r 400=00020001800000000000000000000000   # DONE
+
+r 1000=0000000000000000000000001234567C   # multiplicand
+r 1010=0000000000000000000000007654321C   # addend and multiplier
+r 1040=0000000000000000000000000000000C   # accumulator
+r 1080=402020206B2020206B202120           # edit pattern
+
+r 2100=D4E2C7D5D6C8405C40F16BF0F0F06BF0
+r 2110=F0F04089A3859981A3899695A2409686
+r 2120=40E5C1D761E5D4D740A3969692404040
+r 2130=40404040404040404040409489839996
+r 2140=A28583969584A2
+r 2180=D4E2C7D5D6C8405C40F16BF0F0F06BF0
+r 2190=F0F04089A3859981A3899695A2409686
+r 21a0=40C1D761D4D7404040A3969692404040
+r 21b0=40404040404040404040409489839996
+r 21c0=A28583969584A2
+
+diag8cmd    enable    # (needed for messages to Hercules console)
+#r           408=ff    # (enable timing tests)
+runtest     60        # (test duration, depends on host)
+diag8cmd    disable   # (reset back to default)
+*Done
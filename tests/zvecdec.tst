@@ -0,0 +1,188 @@
+#-------------------------------------------------------------------------------
+
+*Testcase zvecdec z/Architecture vector packed decimal facility instructions
+
+#-------------------------------------------------------------------------------
+#
+#  The vector packed decimal arithmetic, compare, test, conversion, sign
+#  and shift instructions, including a result that loses significant
+#  digits, the zoned decimal pack and unpack instructions and the
+#  rightmost with length loads and stores.
+#
+#-------------------------------------------------------------------------------
+
+msglevel -debug
+numcpu 1
+sysclear
+archlvl z/Arch
+mainsize 1m
+
+*Compare
+
+cr 0=00000000000600E0            # AFP and vector enablement
+
+r 1a0=00000001800000000000000000000200   # z/Arch restart PSW
+r 1d0=0002000180000000000000000000DEAD   # z/Arch pgm new PSW
+
+r 200=A7B81000                 #       LHI   11,X'1000'  data
+r 204=A7C82000                 #       LHI   12,X'2000'  results
+r 208=E61012340049             #       VLIP  1,X'1234',0
+r 20e=E710C000000E             #       VST   1,X'000'(,12)
+r 214=E62056789049             #       VLIP  2,X'5678',9
+r 21a=E720C010000E             #       VST   2,X'010'(,12)
+r 220=E6312011F071             #       VAP   3,1,2,31,1
+r 226=E730C020000E             #       VST   3,X'020'(,12)
+r 22c=A7580000                 #       LHI   5,0
+r 230=B2220050                 #       IPM   5
+r 234=5050C200                 #       ST    5,X'200'(,12)  cc 1
+r 238=E6311011F073             #       VSP   3,1,1,31,1
+r 23e=E730C030000E             #       VST   3,X'030'(,12)
+r 244=A7580000                 #       LHI   5,0
+r 248=B2220050                 #       IPM   5
+r 24c=5050C204                 #       ST    5,X'204'(,12)  cc 0
+r 250=E6412011F078             #       VMP   4,1,2,31,1
+r 256=E740C040000E             #       VST   4,X'040'(,12)
+r 25c=A7580000                 #       LHI   5,0
+r 260=B2220050                 #       IPM   5
+r 264=5050C208                 #       ST    5,X'208'(,12)  cc 1
+r 268=E6541011F07A             #       VDP   5,4,1,31,1
+r 26e=E750C050000E             #       VST   5,X'050'(,12)
+r 274=A7580000                 #       LHI   5,0
+r 278=B2220050                 #       IPM   5
+r 27c=5050C20C                 #       ST    5,X'20C'(,12)  cc 1
+r 280=E6521011F07B             #       VRP   5,2,1,31,1
+r 286=E750C060000E             #       VST   5,X'060'(,12)
+r 28c=A7580000                 #       LHI   5,0
+r 290=B2220050                 #       IPM   5
+r 294=5050C210                 #       ST    5,X'210'(,12)  cc 1
+r 298=E65410302079             #       VMSP  5,4,1,2,3
+r 29e=E750C070000E             #       VST   5,X'070'(,12)
+r 2a4=A7580000                 #       LHI   5,0
+r 2a8=B2220050                 #       IPM   5
+r 2ac=5050C214                 #       ST    5,X'214'(,12)  cc 2
+r 2b0=E6512010A07E             #       VSDP  5,1,2,10,1
+r 2b6=E750C080000E             #       VST   5,X'080'(,12)
+r 2bc=A7580000                 #       LHI   5,0
+r 2c0=B2220050                 #       IPM   5
+r 2c4=5050C218                 #       ST    5,X'218'(,12)  cc 1
+r 2c8=E65110183071             #       VAP   5,1,1,X'83',1
+r 2ce=E750C090000E             #       VST   5,X'090'(,12)
+r 2d4=A7580000                 #       LHI   5,0
+r 2d8=B2220050                 #       IPM   5
+r 2dc=5050C21C                 #       ST    5,X'21C'(,12)  cc 3
+r 2e0=E60120000077             #       VCP   1,2,0
+r 2e6=A7580000                 #       LHI   5,0
+r 2ea=B2220050                 #       IPM   5
+r 2ee=5050C220                 #       ST    5,X'220'(,12)  cc 2
+r 2f2=E760B0000006             #       VL    6,X'000'(,11)
+r 2f8=E6060000005F             #       VTP   6
+r 2fe=A7580000                 #       LHI   5,0
+r 302=B2220050                 #       IPM   5
+r 306=5050C224                 #       ST    5,X'224'(,12)  cc 2
+r 30a=E760B0100006             #       VL    6,X'010'(,11)
+r 310=E6060000005F             #       VTP   6
+r 316=A7580000                 #       LHI   5,0
+r 31a=B2220050                 #       IPM   5
+r 31e=5050C228                 #       ST    5,X'228'(,12)  cc 1
+r 322=A708CFC7                 #       LHI   0,-12345
+r 326=E6700001F058             #       VCVD  7,0,31,0
+r 32c=E770C0A0000E             #       VST   7,X'0A0'(,12)
+r 332=E68700100050             #       VCVB  8,7,1
+r 338=A7580000                 #       LHI   5,0
+r 33c=B2220050                 #       IPM   5
+r 340=5050C22C                 #       ST    5,X'22C'(,12)  cc 1
+r 344=E380B0200004             #       LG    8,X'020'(,11)
+r 34a=E6780001F05A             #       VCVDG 7,8,31,0
+r 350=E770C0B0000E             #       VST   7,X'0B0'(,12)
+r 356=E69700100052             #       VCVBG 9,7,1
+r 35c=E390C2300024             #       STG   9,X'230'(,12)
+r 362=A7580000                 #       LHI   5,0
+r 366=B2220050                 #       IPM   5
+r 36a=5050C238                 #       ST    5,X'238'(,12)  cc 2
+r 36e=E6A4FA11F059             #       VSRP  10,4,31,X'FA',1
+r 374=E7A0C0C0000E             #       VST   10,X'0C0'(,12)
+r 37a=A7580000                 #       LHI   5,0
+r 37e=B2220050                 #       IPM   5
+r 382=5050C23C                 #       ST    5,X'23C'(,12)  cc 1
+r 386=E6A103105059             #       VSRP  10,1,5,3,1
+r 38c=E7A0C0D0000E             #       VST   10,X'0D0'(,12)
+r 392=A7580000                 #       LHI   5,0
+r 396=B2220050                 #       IPM   5
+r 39a=5050C240                 #       ST    5,X'240'(,12)  cc 3
+r 39e=E6B10111F05B             #       VPSOP 11,1,31,1,1
+r 3a4=E7B0C0E0000E             #       VST   11,X'0E0'(,12)
+r 3aa=A7580000                 #       LHI   5,0
+r 3ae=B2220050                 #       IPM   5
+r 3b2=5050C244                 #       ST    5,X'244'(,12)  cc 1
+r 3b6=E603B030C034             #       VPKZ  12,X'030'(,11),3
+r 3bc=E7C0C0F0000E             #       VST   12,X'0F0'(,12)
+r 3c2=E605C100C03C             #       VUPKZ 12,X'100'(,12),5
+r 3c8=E602B040D035             #       VLRL  13,X'040'(,11),2
+r 3ce=E7D0C110000E             #       VST   13,X'110'(,12)
+r 3d4=A7E80004                 #       LHI   14,4
+r 3d8=E60EC120D03F             #       VSTRLR 13,14,X'120'(,12)
+r 3de=B2B20400                 #       LPSWE DONE
+
+
+r 400=00020001800000000000000000000000   # DONE
+
+r 1000=000000000000000000000000000001AC   # invalid digit
+r 1010=00000000000000000000000000012345   # invalid sign
+r 1020=7FFFFFFFFFFFFFFF                   # maximum positive doubleword
+r 1030=F1F2F3C4                           # zoned +1234
+r 1040=AABBCC
+
+runtest 1
+
+r 2000.10 # VLIP
+*Want 00000000 00000000 00000000 0001234C
+r 2010.10 # VLIP
+*Want 00000000 00000000 00000005 6780000D
+r 2020.10 # VAP
+*Want 00000000 00000000 00000005 6778766D
+r 2030.10 # VSP
+*Want 00000000 00000000 00000000 0000000C
+r 2040.10 # VMP
+*Want 00000000 00000000 00007006 6520000D
+r 2050.10 # VDP
+*Want 00000000 00000000 00000005 6780000D
+r 2060.10 # VRP
+*Want 00000000 00000000 00000000 0001192D
+r 2070.10 # VMSP
+*Want 00000000 00000000 00086462 0856800F
+r 2080.10 # VSDP
+*Want 00000000 00000000 00000000 0217330D
+r 2090.10 # VAP overflow
+*Want 00000000 00000000 00000000 0000468C
+r 20a0.10 # VCVD
+*Want 00000000 00000000 00000000 0012345D
+r 20b0.10 # VCVDG
+*Want 00000000 00009223 37203685 4775807C
+r 20c0.10 # VSRP right rounded
+*Want 00000000 00000000 00000000 0070067D
+r 20d0.10 # VSRP left overflow
+*Want 00000000 00000000 00000000 0034000C
+r 20e0.10 # VPSOP complement
+*Want 00000000 00000000 00000000 0001234D
+r 20f0.10 # VPKZ
+*Want 00000000 00000000 00000000 0001234C
+r 2100.8 # VUPKZ
+*Want F0F0F1F2 F3C40000
+r 2110.10 # VLRL
+*Want 00000000 00000000 00000000 00AABBCC
+r 2120.8 # VSTRLR
+*Want 0000AABB CC000000
+r 2200.10 # cc VAP VSP VMP VDP
+*Want 10000000 00000000 10000000 10000000
+r 2210.10 # cc VRP VMSP VSDP VAP overflow
+*Want 10000000 20000000 10000000 30000000
+r 2220.10 # cc VCP VTP VTP VCVB
+*Want 20000000 20000000 10000000 10000000
+r 2230.8 # VCVBG
+*Want 7FFFFFFF FFFFFFFF
+r 2238.8 # cc VCVBG VSRP
+*Want 20000000 10000000
+r 2240.8 # cc VSRP VPSOP
+*Want 30000000 10000000
+
+*Done
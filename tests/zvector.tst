@@ -0,0 +1,193 @@
+#-------------------------------------------------------------------------------
+
+*Testcase zvector z/Architecture vector facility instructions
+
+#-------------------------------------------------------------------------------
+#
+#  Loads, element arithmetic and compares, the string search instructions
+#  and a vector BFP add, run once without the host SIMD kernels and once
+#  with the best ones the host supports, which must give the same results.
+#
+#-------------------------------------------------------------------------------
+
+msglevel -debug
+numcpu 1
+sysclear
+archlvl z/Arch
+mainsize 1m
+
+*Compare
+
+cr 0=00000000000600E0            # AFP and vector enablement
+
+r 1a0=00000001800000000000000000000200   # z/Arch restart PSW
+r 1d0=0002000180000000000000000000DEAD   # z/Arch pgm new PSW
+
+r 200=A7B81000                 #       LHI   11,X'1000'  data
+r 204=A7C82000                 #       LHI   12,X'2000'  results
+r 208=E710B0000006             #       VL    1,X'000'(,11)
+r 20e=E720B0100006             #       VL    2,X'010'(,11)
+r 214=E760B0200006             #       VL    6,X'020'(,11)
+r 21a=E770B0300006             #       VL    7,X'030'(,11)
+r 220=E7A0B0400006             #       VL    10,X'040'(,11)
+r 226=E7B0B0500006             #       VL    11,X'050'(,11)
+r 22c=E7D0B0600006             #       VL    13,X'060'(,11)
+r 232=E7E0B0700006             #       VL    14,X'070'(,11)
+r 238=E731200020F3             #       VAF   3,1,2
+r 23e=E730C000000E             #       VST   3,X'000'(,12)
+r 244=E741201000F8             #       VCEQBS 4,1,2
+r 24a=E740C010000E             #       VST   4,X'010'(,12)
+r 250=A7580000                 #       LHI   5,0
+r 254=B2220050                 #       IPM   5
+r 258=5050C100                 #       ST    5,X'100'(,12)  cc 1
+r 25c=E741201010F9             #       VCHLHS 4,1,2
+r 262=E740C020000E             #       VST   4,X'020'(,12)
+r 268=A7580000                 #       LHI   5,0
+r 26c=B2220050                 #       IPM   5
+r 270=5050C104                 #       ST    5,X'104'(,12)  cc 1
+r 274=E741201000FB             #       VCHBS 4,1,2
+r 27a=E740C030000E             #       VST   4,X'030'(,12)
+r 280=A7580000                 #       LHI   5,0
+r 284=B2220050                 #       IPM   5
+r 288=5050C108                 #       ST    5,X'108'(,12)  cc 1
+r 28c=E75160300082             #       VFAEZBS 5,1,6
+r 292=E750C040000E             #       VST   5,X'040'(,12)
+r 298=A7580000                 #       LHI   5,0
+r 29c=B2220050                 #       IPM   5
+r 2a0=5050C10C                 #       ST    5,X'10C'(,12)  cc 2
+r 2a4=E75160500082             #       VFAEBS 5,1,6,RT
+r 2aa=E750C050000E             #       VST   5,X'050'(,12)
+r 2b0=A7580000                 #       LHI   5,0
+r 2b4=B2220050                 #       IPM   5
+r 2b8=5050C110                 #       ST    5,X'110'(,12)  cc 1
+r 2bc=E75170300080             #       VFEEZBS 5,1,7
+r 2c2=E750C060000E             #       VST   5,X'060'(,12)
+r 2c8=A7580000                 #       LHI   5,0
+r 2cc=B2220050                 #       IPM   5
+r 2d0=5050C114                 #       ST    5,X'114'(,12)  cc 0
+r 2d4=E75120100081             #       VFENEBS 5,1,2
+r 2da=E750C070000E             #       VST   5,X'070'(,12)
+r 2e0=A7580000                 #       LHI   5,0
+r 2e4=B2220050                 #       IPM   5
+r 2e8=5050C118                 #       ST    5,X'118'(,12)  cc 1
+r 2ec=E7810010005C             #       VISTRBS 8,1
+r 2f2=E780C080000E             #       VST   8,X'080'(,12)
+r 2f8=A7580000                 #       LHI   5,0
+r 2fc=B2220050                 #       IPM   5
+r 300=5050C11C                 #       ST    5,X'11C'(,12)  cc 0
+r 304=E791A0B0B08A             #       VSTRCZBS 9,1,10,11,IN
+r 30a=E790C090000E             #       VST   9,X'090'(,12)
+r 310=A7580000                 #       LHI   5,0
+r 314=B2220050                 #       IPM   5
+r 318=5050C120                 #       ST    5,X'120'(,12)  cc 2
+r 31c=E791A050B08A             #       VSTRCBS 9,1,10,11,RT
+r 322=E790C0A0000E             #       VST   9,X'0A0'(,12)
+r 328=A7580000                 #       LHI   5,0
+r 32c=B2220050                 #       IPM   5
+r 330=5050C124                 #       ST    5,X'124'(,12)  cc 1
+r 334=E7CDE00030E3             #       VFADB 12,13,14
+r 33a=E7C0C0B0000E             #       VST   12,X'0B0'(,12)
+r 340=E7DE000030CB             #       WFCDB 13,14
+r 346=A7580000                 #       LHI   5,0
+r 34a=B2220050                 #       IPM   5
+r 34e=5050C128                 #       ST    5,X'128'(,12)  cc 1
+r 352=E74300000856             #       VLR   20,3
+r 358=E740C0C0080E             #       VST   20,X'0C0'(,12)
+r 35e=E7A400012421             #       VLGVF 10,20,1
+r 364=E3A0C0D00024             #       STG   10,X'0D0'(,12)
+r 36a=B2B20400                 #       LPSWE DONE
+
+
+r 400=00020001800000000000000000000000   # DONE
+
+r 1000=4142434445464748004A4B4C4D4E4F50   # "ABCDEFGH",0,"JKLMNOP"
+r 1010=41FF43004500470000004B004D004F01
+r 1020=43454758434547584345475843454758   # "CEGX" x 4
+r 1030=FFFFFFFFFFFFFFFFFFFF4BFFFFFFFFFF
+r 1040=41440000000000000000000000000000   # range "A" to "D"
+r 1050=A0C00000000000000000000000000000   # >= and <=
+r 1060=3FF00000000000004000000000000000   # 1.0, 2.0
+r 1070=40080000000000003FE0000000000000   # 3.0, 0.5
+
+* Test 1  (without the host SIMD kernels)
+
+simd none
+runtest 1
+
+r 2000.10 # VAF
+*Want 83418644 8A468E48 004A964C 9A4E9E51
+r 2010.10 # VCEQB
+*Want FF00FF00 FF00FF00 FF00FF00 FF00FF00
+r 2020.10 # VCHLH
+*Want 0000FFFF FFFFFFFF FFFFFFFF FFFFFFFF
+r 2030.10 # VCHB
+*Want 00FF00FF 00FF00FF 00FF00FF 00FF00FF
+r 2040.10 # VFAE index
+*Want 00000000 00000002 00000000 00000000
+r 2050.10 # VFAE RT mask
+*Want 0000FF00 FF00FF00 00000000 00000000
+r 2060.10 # VFEE (zero first)
+*Want 00000000 00000008 00000000 00000000
+r 2070.10 # VFENE
+*Want 00000000 00000001 00000000 00000000
+r 2080.10 # VISTR
+*Want 41424344 45464748 00000000 00000000
+r 2090.10 # VSTRC IN
+*Want 00000000 00000004 00000000 00000000
+r 20a0.10 # VSTRC RT mask
+*Want FFFFFFFF 00000000 00000000 00000000
+r 20b0.10 # VFADB
+*Want 40100000 00000000 40040000 00000000
+r 20c0.10 # VLR to VR20
+*Want 83418644 8A468E48 004A964C 9A4E9E51
+r 20d0.8  # VLGVF
+*Want 00000000 8A468E48
+r 2100.10 # cc VCEQ VCHL VCH VFAE
+*Want 10000000 10000000 10000000 20000000
+r 2110.10 # cc VFAE VFEE VFENE VISTR
+*Want 10000000 00000000 10000000 00000000
+r 2120.c  # cc VSTRC VSTRC WFC
+*Want 20000000 10000000 10000000
+
+* Test 2  (with the best host SIMD kernels, results at X'3000')
+
+simd best
+r 206=3000
+runtest 1
+
+r 3000.10 # VAF
+*Want 83418644 8A468E48 004A964C 9A4E9E51
+r 3010.10 # VCEQB
+*Want FF00FF00 FF00FF00 FF00FF00 FF00FF00
+r 3020.10 # VCHLH
+*Want 0000FFFF FFFFFFFF FFFFFFFF FFFFFFFF
+r 3030.10 # VCHB
+*Want 00FF00FF 00FF00FF 00FF00FF 00FF00FF
+r 3040.10 # VFAE index
+*Want 00000000 00000002 00000000 00000000
+r 3050.10 # VFAE RT mask
+*Want 0000FF00 FF00FF00 00000000 00000000
+r 3060.10 # VFEE (zero first)
+*Want 00000000 00000008 00000000 00000000
+r 3070.10 # VFENE
+*Want 00000000 00000001 00000000 00000000
+r 3080.10 # VISTR
+*Want 41424344 45464748 00000000 00000000
+r 3090.10 # VSTRC IN
+*Want 00000000 00000004 00000000 00000000
+r 30a0.10 # VSTRC RT mask
+*Want FFFFFFFF 00000000 00000000 00000000
+r 30b0.10 # VFADB
+*Want 40100000 00000000 40040000 00000000
+r 30c0.10 # VLR to VR20
+*Want 83418644 8A468E48 004A964C 9A4E9E51
+r 30d0.8  # VLGVF
+*Want 00000000 8A468E48
+r 3100.10 # cc VCEQ VCHL VCH VFAE
+*Want 10000000 10000000 10000000 20000000
+r 3110.10 # cc VFAE VFEE VFENE VISTR
+*Want 10000000 00000000 10000000 00000000
+r 3120.c  # cc VSTRC VSTRC WFC
+*Want 20000000 10000000 10000000
+
+*Done
@@ -155,6 +155,123 @@ CPU_BITMAP      intmask = 0;            /* Interrupt CPU mask        */
 } /* end function check_timer_event */
 
 
+/*-------------------------------------------------------------------*/
+/* Return the instruction address a running CPU is executing         */
+/*                                                                   */
+/* The CPU thread is not stopped while it is sampled, so this reads  */
+/* 'ip' and the instruction accelerator fields without a lock. The   */
+/* accelerator is only trusted when 'ip' lies within the page it     */
+/* describes; otherwise the (possibly stale) PSW address is used.    */
+/* An occasional misattributed sample is harmless to a statistical   */
+/* profile and avoids slowing the CPU down to take it.               */
+/*-------------------------------------------------------------------*/
+static U64 pswprof_ia( REGS* regs )
+{
+BYTE   *ip  = regs->ip;                 /* Instruction pointer       */
+BYTE   *aip = regs->aip;                /* Accelerator page address  */
+U64     ia;                             /* Instruction address       */
+
+    if (regs->aie && ip >= aip && ip < aip + 4096)
+        ia = regs->AIV_G + (U64)(ip - aip);
+    else
+        ia = regs->psw.IA_G;
+
+    if (regs->psw.amode64)
+        return ia;
+    if (regs->psw.amode)
+        return ia & 0x7FFFFFFF;
+    return ia & 0x00FFFFFF;
+}
+
+/*-------------------------------------------------------------------*/
+/* Take one PSW sample of each started CPU         (pswprof command) */
+/*                                                                   */
+/* Called by the timer thread once every 'sysblk.pswprof_intv'       */
+/* microseconds (but never more often than 'sysblk.timerint'). Each  */
+/* sample is accumulated in the sysblk.pswprof hash table, keyed on  */
+/* the instruction address, CPU, problem state, SIE and primary ASN. */
+/*-------------------------------------------------------------------*/
+static void pswprof_sample( void )
+{
+PSWPROF  *prof;                         /* -> sample table           */
+PSWSAMP  *samp;                         /* -> sample table entry     */
+REGS     *regs;                         /* -> CPU register context   */
+U64       ia;                           /* Sampled instruction addr  */
+U32       key;                          /* Sample key                */
+U32       hash;                         /* Hash table index          */
+BYTE      flags;                        /* PSWPROF_xxx flags         */
+int       cpu, n;                       /* Work                      */
+
+    obtain_lock( &sysblk.pswproflock );
+
+    if (!(prof = sysblk.pswprof) || host_tod() < prof->next)
+    {
+        release_lock( &sysblk.pswproflock );
+        return;
+    }
+
+    /* host_tod() is in units of 1/16 microsecond */
+    prof->next = host_tod() + ((U64) sysblk.pswprof_intv << 4);
+
+    for (cpu=0; cpu < sysblk.hicpu; cpu++)
+    {
+        if (!IS_CPU_ONLINE( cpu )
+         || CPUSTATE_STARTED != sysblk.regs[ cpu ]->cpustate)
+            continue;
+
+        if (sysblk.waiting_mask & CPU_BIT( cpu ))
+        {
+            prof->waits++;
+            continue;
+        }
+
+        regs  = sysblk.regs[ cpu ];
+        flags = 0;
+
+        if (regs->sie_active && GUESTREGS)
+        {
+            regs   = GUESTREGS;
+            flags |= PSWPROF_SIE;
+        }
+
+        if (PROBSTATE( &regs->psw ))
+            flags |= PSWPROF_PROB;
+
+        ia  = pswprof_ia( regs );
+        key = PSWPROF_KEY( cpu, flags, ARCH_370_IDX == regs->arch_mode ?
+                                       0 : regs->CR_LHL(4) );
+
+        hash = (U32)(((ia >> 1) ^ ((U64) key << 20)) * 0x9E3779B97F4A7C15ULL >> 40);
+
+        for (n=0; n < PSWPROF_PROBES; n++, hash++)
+        {
+            samp = &prof->tab[ hash & (PSWPROF_SLOTS-1) ];
+
+            if (!samp->count)
+            {
+                samp->ia  = ia;
+                samp->key = key;
+                prof->used++;
+                break;
+            }
+            if (samp->ia == ia && samp->key == key)
+                break;
+        }
+
+        if (n < PSWPROF_PROBES)
+        {
+            samp->count++;
+            prof->samples++;
+        }
+        else
+            prof->drops++;
+    }
+
+    release_lock( &sysblk.pswproflock );
+
+} /* end function pswprof_sample */
+
+
 /*-------------------------------------------------------------------*/
 /* TOD clock and timer thread                                        */
 /*                                                                   */
@@ -323,6 +440,10 @@ bool    txf_PPA;                        /* true == PPA assist needed */
 
         } /* end if (intv_secs >= one_sec) */
 
+        /* Take PSW profiler samples if enabled */
+        if (sysblk.pswprof_intv)
+            pswprof_sample();
+
         /* Sleep for another timer update interval... */
 
 #if defined( _FEATURE_073_TRANSACT_EXEC_FACILITY )
@@ -200,6 +200,20 @@ inline void concpy( REGS* regs, void* d, void* s, int n )
     /* Copy double words on enough length and src - dst distance */
     if (n && labs( u8d - u8s ) > 7)
     {
+        /* Let a host SIMD kernel do the bulk of a long move, provided
+           a destructive overlap would still ripple the same way */
+        if (1
+            && n >= HSIMD_CONCPY_MIN
+            && hsimd_concpy
+            && (u8s > u8d || u8d - u8s >= HSIMD_CONCPY_DIST)
+        )
+        {
+            size_t done = hsimd_concpy( u8d, u8s, (size_t) n );
+            u8d += done;
+            u8s += done;
+            n   -= (int) done;
+        }
+
         while(n > 7)
         {
             store_dw_noswap( u8d, fetch_dw_noswap( u8s ));
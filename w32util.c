@@ -1640,10 +1640,31 @@ DLL_EXPORT void w32_init_hostinfo( HOST_INFO* pHostInfo )
         __cpuid(CPUInfo, 1);
         if ( CPUInfo[2] & ( 1 << 25 ) )
             pHostInfo->cpu_aes_extns = 1;
+        if ( CPUInfo[2] & ( 1 << 1 ) )
+            pHostInfo->cpu_pclmul = 1;
         if ( CPUInfo[3] & 1 )
             pHostInfo->fp_unit = 1;
         if ( CPUInfo[3] & 0x03800000 ) /* bit 23 = MMX, 24 = SSE, 25 == SSE2 */
             pHostInfo->vector_unit = 1;
+        if ( CPUInfo[3] & ( 1 << 26 ) )
+            pHostInfo->cpu_sse2 = 1;
+
+        /* AVX2 also needs the OS to save the YMM state (OSXSAVE, XCR0) */
+        if ( (CPUInfo[2] & ( 1 << 27 )) && (CPUInfo[2] & ( 1 << 28 ))
+            && (_xgetbv( 0 ) & 6) == 6 )
+        {
+            __cpuidex( CPUInfo, 7, 0 );
+            if ( CPUInfo[1] & ( 1 << 5 ) )
+                pHostInfo->cpu_avx2 = 1;
+        }
+
+        __cpuid( CPUInfo, 0 );
+        if ( CPUInfo[0] >= 7 )
+        {
+            __cpuidex( CPUInfo, 7, 0 );
+            if ( CPUInfo[1] & ( 1 << 29 ) )
+                pHostInfo->cpu_sha_extns = 1;
+        }
     }
 
     pgnsi = (PGNSI) GetProcAddress( GetModuleHandle(TEXT("kernel32.dll")), "GetNativeSystemInfo");
@@ -84,6 +84,10 @@ size_t  xoffs;                          /* Byte offset into xpndstor */
     /* Copy data from expanded to main */
     memcpy (maddr, sysblk.xpndstor + xoffs, XSTORE_PAGESIZE);
 
+    /* Read ahead of a sequential run from an expanded storage file */
+    if (sysblk.xpndstor_mapped)
+        xpndstor_advise (regs, xaddr, false);
+
     /* cc0 means pgin ok */
     regs->psw.cc = 0;
 
@@ -151,6 +155,10 @@ size_t  xoffs;                          /* Byte offset into xpndstor */
     /* Copy data from main to expanded */
     memcpy (sysblk.xpndstor + xoffs, maddr, XSTORE_PAGESIZE);
 
+    /* Let the host write a sequential run back to its file first */
+    if (sysblk.xpndstor_mapped)
+        xpndstor_advise (regs, xaddr, true);
+
     /* cc0 means pgout ok */
     regs->psw.cc = 0;
 
@@ -180,8 +188,6 @@ int     r1, r2;                         /* Operand register numbers  */
     {
         OBTAIN_INTLOCK( regs );
         {
-            SYNCHRONIZE_CPUS( regs );
-
             /* Invalidate page table entry */
             ARCH_DEP( invalidate_pte )( inst[1], regs->GR_G( r1 ), regs->GR( r2 ), regs, false );
         }
@@ -186,10 +186,10 @@ static inline void set_alsi(DEVBLK *dev, BYTE bits)
     {
     BYTE *alsi = dev->mainstor + dev->qdio.alsi;
 
-        obtain_lock(&sysblk.mainlock);
+        OBTAIN_DEVMAINLOCK(alsi, alsi);
         *alsi |= bits;
         ARCH_DEP( or_dev_4K_storage_key )( dev, dev->qdio.alsi, (STORKEY_REF | STORKEY_CHANGE) );
-        release_lock(&sysblk.mainlock);
+        RELEASE_DEVMAINLOCK(alsi, alsi);
     }
 }
 
@@ -204,12 +204,12 @@ static inline void set_dsci(DEVBLK *dev, BYTE bits)
     BYTE *dsci = dev->mainstor + dev->qdio.dsci;
     BYTE *alsi = dev->mainstor + dev->qdio.alsi;
 
-        obtain_lock(&sysblk.mainlock);
+        OBTAIN_DEVMAINLOCK(dsci, alsi);
         *dsci |= bits;
         ARCH_DEP( or_dev_4K_storage_key )( dev, dev->qdio.dsci, (STORKEY_REF | STORKEY_CHANGE) );
         *alsi |= bits;
         ARCH_DEP( or_dev_4K_storage_key )( dev, dev->qdio.alsi, (STORKEY_REF | STORKEY_CHANGE) );
-        release_lock(&sysblk.mainlock);
+        RELEASE_DEVMAINLOCK(dsci, alsi);
     }
 }
 #endif /*defined(_FEATURE_QDIO_THININT)*/
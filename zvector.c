@@ -0,0 +1,2454 @@
+/* ZVECTOR.C    (C) and others 2026                                  */
+/*              z/Architecture Vector Facility instructions          */
+/*                                                                   */
+/*   Released under "The Q Public License Version 1"                 */
+/*   (http://www.hercules-390.org/herclic.html) as modifications to  */
+/*   Hercules.                                                       */
+
+/*-------------------------------------------------------------------*/
+/* This module implements the non floating point instructions of     */
+/* the Vector Facility for z/Architecture (facility bit 129), as     */
+/* described in SA22-7832 "z/Architecture Principles of Operation",  */
+/* chapters 21 to 23. The vector floating point instructions are in  */
+/* ieee.c, where the SoftFloat support already is.                   */
+/*                                                                   */
+/* The 128-bit vector registers are kept partly in the floating      */
+/* point registers and partly in REGS vrh/vrl (see inline.h), and    */
+/* each instruction copies its operands to local VR variables, in    */
+/* which the elements are arranged as the host's own 128-bit integer */
+/* would arrange them. On an x86 host a VR is thus also an SSE2      */
+/* register image, and the element wise arithmetic, the compares and */
+/* the string searches, which are the ones compiled code uses the    */
+/* most, are done with SSE2 intrinsics when the 'simd' level allows. */
+/*-------------------------------------------------------------------*/
+
+#include "hstdinc.h"
+
+#define _ZVECTOR_C_
+#define _HENGINE_DLL_
+
+#include "hercules.h"
+#include "opcode.h"
+#include "inline.h"
+
+#if defined( HSIMD_X86 )
+  #include <immintrin.h>
+#endif
+
+#if !defined( COMPILE_THIS_ONLY_ONCE )
+#define       COMPILE_THIS_ONLY_ONCE
+
+#if defined( _FEATURE_129_ZVECTOR_FACILITY )
+/*-------------------------------------------------------------------*/
+/*                    Vector element helpers                         */
+/*-------------------------------------------------------------------*/
+/* The element size codes of the M fields are 0 for bytes, 1 for     */
+/* halfwords, 2 for words, 3 for doublewords and 4 for quadwords.    */
+/* Element i of a register is the i'th from the left, as in the PoO. */
+/*-------------------------------------------------------------------*/
+
+#define NELEM( _m )     (16 >> (_m))    /* Elements in a register    */
+#define EBITS( _m )     (8 << (_m))     /* Bits in an element        */
+
+static INLINE U64 vr_get( const VR* v, int m, int i )
+{
+    switch (m)
+    {
+    case 0:  return VR_B( *v, i );
+    case 1:  return VR_H( *v, i );
+    case 2:  return VR_F( *v, i );
+    default: return VR_D( *v, i );
+    }
+}
+
+static INLINE S64 vr_gets( const VR* v, int m, int i )
+{
+    switch (m)
+    {
+    case 0:  return (S8)  VR_B( *v, i );
+    case 1:  return (S16) VR_H( *v, i );
+    case 2:  return (S32) VR_F( *v, i );
+    default: return (S64) VR_D( *v, i );
+    }
+}
+
+static INLINE void vr_put( VR* v, int m, int i, U64 x )
+{
+    switch (m)
+    {
+    case 0:  VR_B( *v, i ) = (BYTE) x; break;
+    case 1:  VR_H( *v, i ) = (U16)  x; break;
+    case 2:  VR_F( *v, i ) = (U32)  x; break;
+    default: VR_D( *v, i ) =        x; break;
+    }
+}
+
+/* Mask of the value bits of an element */
+static INLINE U64 emask( int m )
+{
+    return m >= 3 ? 0xFFFFFFFFFFFFFFFFULL : (1ULL << EBITS( m )) - 1;
+}
+
+/*-------------------------------------------------------------------*/
+/* The string instructions work with byte masks in which PoO byte j  */
+/* of a register is bit 15-j, which on a little endian host is the   */
+/* same mask the SSE2 movemask instruction returns, and in which all */
+/* of the bits of a matching element are set.                        */
+/*-------------------------------------------------------------------*/
+static INLINE U32 elem_bytes( int m, int i )
+{
+    int  n = 1 << m;
+    return ((1U << n) - 1) << (16 - (i + 1) * n);
+}
+
+/* Byte index of the first (leftmost) element of a byte mask, or 16 */
+static INLINE int first_byte( U32 mask )
+{
+#if defined( __GNUC__ )
+    return mask ? __builtin_clz( mask ) - 16 : 16;
+#else
+    int  j;
+    for (j=0; j < 16 && !(mask & 0x8000); j++, mask <<= 1);
+    return j;
+#endif
+}
+
+static INLINE void vr_from_bytes( VR* v, const BYTE* b )
+{
+    VR_D( *v, 0 ) = fetch_dw( b     );
+    VR_D( *v, 1 ) = fetch_dw( b + 8 );
+}
+
+static INLINE void vr_to_bytes( BYTE* b, const VR* v )
+{
+    store_dw( b,     VR_D( *v, 0 ));
+    store_dw( b + 8, VR_D( *v, 1 ));
+}
+
+/* 128-bit a + b + c, returning the carry out of bit 0 */
+static INLINE int vr_add128( VR* r, const VR* a, const VR* b, int c )
+{
+    U64  l, l2, h, h2;
+    int  cl, ch;
+
+    l  = VR_D( *a, 1 ) + VR_D( *b, 1 );
+    l2 = l + c;
+    cl = (l < VR_D( *a, 1 )) | (l2 < l);
+    h  = VR_D( *a, 0 ) + VR_D( *b, 0 );
+    h2 = h + cl;
+    ch = (h < VR_D( *a, 0 )) | (h2 < h);
+
+    VR_D( *r, 0 ) = h2;
+    VR_D( *r, 1 ) = l2;
+    return ch;
+}
+
+static INLINE void vr_not( VR* r, const VR* a )
+{
+    VR_D( *r, 0 ) = ~VR_D( *a, 0 );
+    VR_D( *r, 1 ) = ~VR_D( *a, 1 );
+}
+
+/* 128-bit shifts by 0 to 127 bits */
+static INLINE void vr_shl( VR* v, int n )
+{
+    U64  h = VR_D( *v, 0 ), l = VR_D( *v, 1 );
+
+    if (n >= 64) { h = l << (n - 64); l = 0; }
+    else if (n)  { h = (h << n) | (l >> (64 - n)); l <<= n; }
+
+    VR_D( *v, 0 ) = h;
+    VR_D( *v, 1 ) = l;
+}
+
+static INLINE void vr_shr( VR* v, int n, bool arith )
+{
+    U64  h = VR_D( *v, 0 ), l = VR_D( *v, 1 );
+    U64  s = arith && (S64) h < 0 ? 0xFFFFFFFFFFFFFFFFULL : 0;
+
+    if (n >= 64)
+    {
+        l = n > 64 ? (h >> (n - 64)) | (s << (128 - n)) : h;
+        h = s;
+    }
+    else if (n)
+    {
+        l = (l >> n) | (h << (64 - n));
+        h = (h >> n) | (s << (64 - n));
+    }
+
+    VR_D( *v, 0 ) = h;
+    VR_D( *v, 1 ) = l;
+}
+
+/* Carry-less multiply of two elements of up to 32 bits */
+static INLINE U64 clmul( U64 a, U64 b )
+{
+    U64  r = 0;
+
+    for (; b; b >>= 1, a <<= 1)
+        if (b & 1)
+            r ^= a;
+    return r;
+}
+
+/* Carry-less multiply of two doublewords into a quadword */
+static INLINE void clmul128( U64 a, U64 b, U64* hi, U64* lo )
+{
+    U64  h = 0, l = 0;
+    int  i;
+
+    for (i=0; i < 64; i++)
+    {
+        if (b & (1ULL << i))
+        {
+            l ^= a << i;
+            if (i)
+                h ^= a >> (64 - i);
+        }
+    }
+    *hi = h;
+    *lo = l;
+}
+
+static INLINE int clz64( U64 x, int bits )
+{
+    int  n;
+    for (n=0; n < bits && !(x & (1ULL << (bits - 1))); n++, x <<= 1);
+    return n;
+}
+
+static INLINE int ctz64( U64 x, int bits )
+{
+    int  n;
+    for (n=0; n < bits && !(x & 1); n++, x >>= 1);
+    return n;
+}
+
+static INLINE int popcnt64( U64 x )
+{
+    int  n;
+    for (n=0; x; n++)
+        x &= x - 1;
+    return n;
+}
+
+/*-------------------------------------------------------------------*/
+/*                    SSE2 element operations                        */
+/*-------------------------------------------------------------------*/
+
+enum
+{
+    ZV_ADD,                             /* VA                        */
+    ZV_SUB,                             /* VS                        */
+    ZV_CEQ,                             /* VCEQ                      */
+    ZV_CH,                              /* VCH                       */
+    ZV_CHL,                             /* VCHL                      */
+    ZV_MN,                              /* VMN                       */
+    ZV_MNL,                             /* VMNL                      */
+    ZV_MX,                              /* VMX                       */
+    ZV_MXL,                             /* VMXL                      */
+    ZV_AVGL,                            /* VAVGL                     */
+};
+
+#if defined( HSIMD_X86 )
+
+#define XMM( _v )       _mm_loadu_si128( (const __m128i*) (_v) )
+
+HSIMD_TARGET( "sse2" )
+static INLINE __m128i sse2_set1( int m, U64 x )
+{
+    switch (m)
+    {
+    case 0:  return _mm_set1_epi8(  (char)  x );
+    case 1:  return _mm_set1_epi16( (short) x );
+    case 2:  return _mm_set1_epi32( (int)   x );
+    default: return _mm_set_epi32( (int)(x >> 32), (int) x, (int)(x >> 32), (int) x );
+    }
+}
+
+/* The sign bit of each element, to turn unsigned compares to signed */
+HSIMD_TARGET( "sse2" )
+static INLINE __m128i sse2_sign( int m )
+{
+    return sse2_set1( m, 1ULL << (EBITS( m ) - 1) );
+}
+
+HSIMD_TARGET( "sse2" )
+static INLINE __m128i sse2_cmpeq( int m, __m128i a, __m128i b )
+{
+    __m128i  t;
+
+    switch (m)
+    {
+    case 0:  return _mm_cmpeq_epi8(  a, b );
+    case 1:  return _mm_cmpeq_epi16( a, b );
+    case 2:  return _mm_cmpeq_epi32( a, b );
+    default:
+        t = _mm_cmpeq_epi32( a, b );
+        return _mm_and_si128( t, _mm_shuffle_epi32( t, _MM_SHUFFLE( 2, 3, 0, 1 )));
+    }
+}
+
+/* Signed greater than; not for doublewords */
+HSIMD_TARGET( "sse2" )
+static INLINE __m128i sse2_cmpgt( int m, __m128i a, __m128i b )
+{
+    switch (m)
+    {
+    case 0:  return _mm_cmpgt_epi8(  a, b );
+    case 1:  return _mm_cmpgt_epi16( a, b );
+    default: return _mm_cmpgt_epi32( a, b );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* Perform one of the ZV_xxx operations on a and b for element size */
+/* m with SSE2, storing the result in r. Returns false without doing */
+/* anything for the combinations which SSE2 does not have.           */
+/*-------------------------------------------------------------------*/
+HSIMD_TARGET( "sse2" )
+static bool sse2_binop( int op, int m, VR* r, const VR* a, const VR* b )
+{
+    __m128i  x = XMM( a ), y = XMM( b ), z, s, gt;
+
+    switch (op)
+    {
+    case ZV_ADD:
+    case ZV_SUB:
+        switch (m)
+        {
+        case 0:  z = op == ZV_ADD ? _mm_add_epi8(  x, y ) : _mm_sub_epi8(  x, y ); break;
+        case 1:  z = op == ZV_ADD ? _mm_add_epi16( x, y ) : _mm_sub_epi16( x, y ); break;
+        case 2:  z = op == ZV_ADD ? _mm_add_epi32( x, y ) : _mm_sub_epi32( x, y ); break;
+        case 3:  z = op == ZV_ADD ? _mm_add_epi64( x, y ) : _mm_sub_epi64( x, y ); break;
+        default: return false;
+        }
+        break;
+
+    case ZV_CEQ:
+        z = sse2_cmpeq( m, x, y );
+        break;
+
+    case ZV_CH:
+        if (m > 2)
+            return false;
+        z = sse2_cmpgt( m, x, y );
+        break;
+
+    case ZV_CHL:
+        if (m > 2)
+            return false;
+        s = sse2_sign( m );
+        z = sse2_cmpgt( m, _mm_xor_si128( x, s ), _mm_xor_si128( y, s ));
+        break;
+
+    case ZV_MN:
+    case ZV_MNL:
+    case ZV_MX:
+    case ZV_MXL:
+        if (m > 2)
+            return false;
+        if (m == 0 && op == ZV_MNL) { z = _mm_min_epu8(  x, y ); break; }
+        if (m == 0 && op == ZV_MXL) { z = _mm_max_epu8(  x, y ); break; }
+        if (m == 1 && op == ZV_MN ) { z = _mm_min_epi16( x, y ); break; }
+        if (m == 1 && op == ZV_MX ) { z = _mm_max_epi16( x, y ); break; }
+        s  = op == ZV_MNL || op == ZV_MXL ? sse2_sign( m ) : _mm_setzero_si128();
+        gt = sse2_cmpgt( m, _mm_xor_si128( x, s ), _mm_xor_si128( y, s ));
+        if (op == ZV_MN || op == ZV_MNL)
+            z = _mm_or_si128( _mm_and_si128( gt, y ), _mm_andnot_si128( gt, x ));
+        else
+            z = _mm_or_si128( _mm_and_si128( gt, x ), _mm_andnot_si128( gt, y ));
+        break;
+
+    case ZV_AVGL:
+        switch (m)
+        {
+        case 0:  z = _mm_avg_epu8(  x, y ); break;
+        case 1:  z = _mm_avg_epu16( x, y ); break;
+        default: return false;
+        }
+        break;
+
+    default:
+        return false;
+    }
+
+    _mm_storeu_si128( (__m128i*) r, z );
+    return true;
+}
+
+/* Byte mask of the elements of a which are equal to those of b */
+HSIMD_TARGET( "sse2" )
+static U32 sse2_eqmask( int m, const VR* a, const VR* b )
+{
+    return _mm_movemask_epi8( sse2_cmpeq( m, XMM( a ), XMM( b )));
+}
+
+/* Byte mask of the elements of a which are equal to any of b */
+HSIMD_TARGET( "sse2" )
+static U32 sse2_anymask( int m, const VR* a, const VR* b )
+{
+    __m128i  x = XMM( a ), z = _mm_setzero_si128();
+    int      i;
+
+    for (i=0; i < NELEM( m ); i++)
+        z = _mm_or_si128( z, sse2_cmpeq( m, x, sse2_set1( m, vr_get( b, m, i ))));
+
+    return _mm_movemask_epi8( z );
+}
+
+/* Byte mask of the elements of a which are in any of the ranges     */
+/* given by the element pairs of b under the control of those of c   */
+HSIMD_TARGET( "sse2" )
+static U32 sse2_rangemask( int m, const VR* a, const VR* b, const VR* c )
+{
+    __m128i  s = sse2_sign( m );
+    __m128i  x = _mm_xor_si128( XMM( a ), s );
+    __m128i  z = _mm_setzero_si128(), t[2], y;
+    int      i, k, ctl;
+
+    for (i=0; i < NELEM( m ); i += 2)
+    {
+        for (k=0; k < 2; k++)
+        {
+            y   = _mm_xor_si128( sse2_set1( m, vr_get( b, m, i+k )), s );
+            ctl = (int)(vr_get( c, m, i+k ) >> (EBITS( m ) - 3));
+            t[k] = _mm_setzero_si128();
+            if (ctl & 4) t[k] = _mm_or_si128( t[k], sse2_cmpeq( m, x, y ));
+            if (ctl & 2) t[k] = _mm_or_si128( t[k], sse2_cmpgt( m, y, x ));
+            if (ctl & 1) t[k] = _mm_or_si128( t[k], sse2_cmpgt( m, x, y ));
+        }
+        z = _mm_or_si128( z, _mm_and_si128( t[0], t[1] ));
+    }
+
+    return _mm_movemask_epi8( z );
+}
+
+#define SSE2_ACTIVE()   (hsimd_level >= HSIMD_SSE2)
+#define SSE2_BINOP( _op, _m, _r, _a, _b ) \
+        (SSE2_ACTIVE() && sse2_binop( (_op), (_m), (_r), (_a), (_b) ))
+
+#else // !defined( HSIMD_X86 )
+
+#define SSE2_BINOP( _op, _m, _r, _a, _b )   (false)
+
+#endif // defined( HSIMD_X86 )
+
+/*-------------------------------------------------------------------*/
+/*                String instruction element masks                   */
+/*-------------------------------------------------------------------*/
+
+static U32 vr_eqmask( int m, const VR* a, const VR* b )
+{
+    U32  mask = 0;
+    int  i;
+
+#if defined( HSIMD_X86 )
+    if (SSE2_ACTIVE())
+        return sse2_eqmask( m, a, b );
+#endif
+    for (i=0; i < NELEM( m ); i++)
+        if (vr_get( a, m, i ) == vr_get( b, m, i ))
+            mask |= elem_bytes( m, i );
+    return mask;
+}
+
+static U32 vr_zeromask( int m, const VR* a )
+{
+    VR  zero;
+
+    VR_D( zero, 0 ) = VR_D( zero, 1 ) = 0;
+    return vr_eqmask( m, a, &zero );
+}
+
+static U32 vr_anymask( int m, const VR* a, const VR* b )
+{
+    U32  mask = 0;
+    U64  x;
+    int  i, k;
+
+#if defined( HSIMD_X86 )
+    if (SSE2_ACTIVE())
+        return sse2_anymask( m, a, b );
+#endif
+    for (i=0; i < NELEM( m ); i++)
+    {
+        x = vr_get( a, m, i );
+        for (k=0; k < NELEM( m ); k++)
+        {
+            if (x == vr_get( b, m, k ))
+            {
+                mask |= elem_bytes( m, i );
+                break;
+            }
+        }
+    }
+    return mask;
+}
+
+/* Range compare of x against limit y under control ctl (EQ LT GT) */
+static INLINE bool range_cond( U64 x, U64 y, int ctl )
+{
+    return x < y ? (ctl & 2) != 0
+         : x > y ? (ctl & 1) != 0
+         :         (ctl & 4) != 0;
+}
+
+static U32 vr_rangemask( int m, const VR* a, const VR* b, const VR* c )
+{
+    U32  mask = 0;
+    U64  x;
+    int  i, k, sh = EBITS( m ) - 3;
+
+#if defined( HSIMD_X86 )
+    if (SSE2_ACTIVE())
+        return sse2_rangemask( m, a, b, c );
+#endif
+    for (i=0; i < NELEM( m ); i++)
+    {
+        x = vr_get( a, m, i );
+        for (k=0; k < NELEM( m ); k += 2)
+        {
+            if (1
+                && range_cond( x, vr_get( b, m, k   ), (int)(vr_get( c, m, k   ) >> sh) )
+                && range_cond( x, vr_get( b, m, k+1 ), (int)(vr_get( c, m, k+1 ) >> sh) )
+            )
+            {
+                mask |= elem_bytes( m, i );
+                break;
+            }
+        }
+    }
+    return mask;
+}
+
+/*-------------------------------------------------------------------*/
+/* Common result of VFAE and VSTRC: either the byte index of the     */
+/* first matching (or, with ZS, zero) element in byte 7, or with RT  */
+/* a mask of all of the matching elements. Returns the cond code.    */
+/*-------------------------------------------------------------------*/
+static int find_any_result( VR* v1, U32 match, U32 zero, bool rt, bool zs )
+{
+    int  fm = first_byte( match );
+    int  fz = zs ? first_byte( zero ) : 16;
+    int  j;
+
+    if (rt)
+    {
+        for (j=0; j < 16; j++)
+            VR_B( *v1, j ) = (match >> (15 - j)) & 1 ? 0xFF : 0x00;
+    }
+    else
+    {
+        VR_D( *v1, 0 ) = MIN( fm, fz );
+        VR_D( *v1, 1 ) = 0;
+    }
+
+    if (fm == 16 && fz == 16) return 3;
+    if (fz == 16)             return 1;
+    if (fm < fz)              return 2;
+    return 0;
+}
+
+/* Condition code of a vector compare from its result mask */
+static INLINE int compare_cc( const VR* v )
+{
+    if (VR_D( *v, 0 ) == 0xFFFFFFFFFFFFFFFFULL && VR_D( *v, 1 ) == 0xFFFFFFFFFFFFFFFFULL)
+        return 0;
+    if (VR_D( *v, 0 ) == 0 && VR_D( *v, 1 ) == 0)
+        return 3;
+    return 1;
+}
+
+#endif /* defined( _FEATURE_129_ZVECTOR_FACILITY ) */
+
+#endif // COMPILE_THIS_ONLY_ONCE
+
+#if defined( FEATURE_129_ZVECTOR_FACILITY )
+
+/* Program check if an element size or index field is out of range */
+#define ZV_SPEC_CHECK( _cond, _regs )                                       \
+    if (_cond)                                                              \
+        (_regs)->program_interrupt( (_regs), PGM_SPECIFICATION_EXCEPTION )
+
+/*-------------------------------------------------------------------*/
+/* E700 VLEB  - Vector Load Element (8)                        [VRX] */
+/* E701 VLEH  - Vector Load Element (16)                       [VRX] */
+/* E702 VLEG  - Vector Load Element (64)                       [VRX] */
+/* E703 VLEF  - Vector Load Element (32)                       [VRX] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_load_element )( BYTE inst[], REGS* regs, int m )
+{
+int     v1, x2, b2;                     /* Instruction fields        */
+int     m3;                             /* Element index             */
+VADR    effective_addr2;                /* Effective address         */
+U64     x;                              /* Element value             */
+VR      v;                              /* Operand                   */
+
+    VRX( inst, regs, v1, x2, b2, effective_addr2, m3 );
+    PER_ZEROADDR_XCHECK2( regs, x2, b2 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m3 >= NELEM( m ), regs );
+
+    switch (m)
+    {
+    case 0:  x = ARCH_DEP( vfetchb )( effective_addr2, b2, regs ); break;
+    case 1:  x = ARCH_DEP( vfetch2 )( effective_addr2, b2, regs ); break;
+    case 2:  x = ARCH_DEP( vfetch4 )( effective_addr2, b2, regs ); break;
+    default: x = ARCH_DEP( vfetch8 )( effective_addr2, b2, regs ); break;
+    }
+
+    vr_fetch( regs, v1, &v );
+    vr_put( &v, m, m3, x );
+    vr_store( regs, v1, &v );
+}
+
+DEF_INST( vector_load_element_8 )  { ARCH_DEP( vector_load_element )( inst, regs, 0 ); }
+DEF_INST( vector_load_element_16 ) { ARCH_DEP( vector_load_element )( inst, regs, 1 ); }
+DEF_INST( vector_load_element_32 ) { ARCH_DEP( vector_load_element )( inst, regs, 2 ); }
+DEF_INST( vector_load_element_64 ) { ARCH_DEP( vector_load_element )( inst, regs, 3 ); }
+
+/*-------------------------------------------------------------------*/
+/* E704 VLLEZ - Vector Load Logical Element and Zero           [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_logical_element_and_zero )
+{
+int     v1, x2, b2;                     /* Instruction fields        */
+int     m3;                             /* Element size              */
+VADR    effective_addr2;                /* Effective address         */
+VR      v;                              /* Result                    */
+
+    VRX( inst, regs, v1, x2, b2, effective_addr2, m3 );
+    PER_ZEROADDR_XCHECK2( regs, x2, b2 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m3 > 3, regs );
+
+    /* The element goes to the rightmost position of doubleword 0 */
+    switch (m3)
+    {
+    case 0:  VR_D( v, 0 ) = ARCH_DEP( vfetchb )( effective_addr2, b2, regs ); break;
+    case 1:  VR_D( v, 0 ) = ARCH_DEP( vfetch2 )( effective_addr2, b2, regs ); break;
+    case 2:  VR_D( v, 0 ) = ARCH_DEP( vfetch4 )( effective_addr2, b2, regs ); break;
+    default: VR_D( v, 0 ) = ARCH_DEP( vfetch8 )( effective_addr2, b2, regs ); break;
+    }
+    VR_D( v, 1 ) = 0;
+
+    vr_store( regs, v1, &v );
+}
+
+/*-------------------------------------------------------------------*/
+/* E705 VLREP - Vector Load and Replicate                      [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_and_replicate )
+{
+int     v1, x2, b2;                     /* Instruction fields        */
+int     m3;                             /* Element size              */
+VADR    effective_addr2;                /* Effective address         */
+U64     x;                              /* Element value             */
+int     i;                              /* Element index             */
+VR      v;                              /* Result                    */
+
+    VRX( inst, regs, v1, x2, b2, effective_addr2, m3 );
+    PER_ZEROADDR_XCHECK2( regs, x2, b2 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m3 > 3, regs );
+
+    switch (m3)
+    {
+    case 0:  x = ARCH_DEP( vfetchb )( effective_addr2, b2, regs ); break;
+    case 1:  x = ARCH_DEP( vfetch2 )( effective_addr2, b2, regs ); break;
+    case 2:  x = ARCH_DEP( vfetch4 )( effective_addr2, b2, regs ); break;
+    default: x = ARCH_DEP( vfetch8 )( effective_addr2, b2, regs ); break;
+    }
+
+    for (i=0; i < NELEM( m3 ); i++)
+        vr_put( &v, m3, i, x );
+
+    vr_store( regs, v1, &v );
+}
+
+/*-------------------------------------------------------------------*/
+/* E706 VL    - Vector Load                                    [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load )
+{
+int     v1, x2, b2;                     /* Instruction fields        */
+int     m3;                             /* Alignment hint (ignored)  */
+VADR    effective_addr2;                /* Effective address         */
+BYTE    buf[16];                        /* Storage operand           */
+VR      v;                              /* Result                    */
+
+    VRX( inst, regs, v1, x2, b2, effective_addr2, m3 );
+    PER_ZEROADDR_XCHECK2( regs, x2, b2 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m3 );
+
+    ARCH_DEP( vfetchc )( buf, 16-1, effective_addr2, b2, regs );
+    vr_from_bytes( &v, buf );
+    vr_store( regs, v1, &v );
+}
+
+/*-------------------------------------------------------------------*/
+/* E707 VLBB  - Vector Load to Block Boundary                  [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_to_block_boundary )
+{
+int     v1, x2, b2;                     /* Instruction fields        */
+int     m3;                             /* Block boundary code       */
+VADR    effective_addr2;                /* Effective address         */
+U32     block;                          /* Block size                */
+int     len;                            /* Bytes to load             */
+int     j;                              /* Byte index                */
+BYTE    buf[16];                        /* Storage operand           */
+VR      v;                              /* Result                    */
+
+    VRX( inst, regs, v1, x2, b2, effective_addr2, m3 );
+    PER_ZEROADDR_XCHECK2( regs, x2, b2 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m3 > 6, regs );
+
+    block = 64U << m3;
+    len   = (int) MIN( 16, block - (effective_addr2 & (block - 1)) );
+
+    ARCH_DEP( vfetchc )( buf, len-1, effective_addr2, b2, regs );
+
+    /* The bytes beyond the boundary are left unchanged */
+    vr_fetch( regs, v1, &v );
+    for (j=0; j < len; j++)
+        VR_B( v, j ) = buf[j];
+    vr_store( regs, v1, &v );
+}
+
+/*-------------------------------------------------------------------*/
+/* E708 VSTEB - Vector Store Element (8)                       [VRX] */
+/* E709 VSTEH - Vector Store Element (16)                      [VRX] */
+/* E70A VSTEG - Vector Store Element (64)                      [VRX] */
+/* E70B VSTEF - Vector Store Element (32)                      [VRX] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_store_element )( BYTE inst[], REGS* regs, int m )
+{
+int     v1, x2, b2;                     /* Instruction fields        */
+int     m3;                             /* Element index             */
+VADR    effective_addr2;                /* Effective address         */
+VR      v;                              /* Operand                   */
+
+    VRX( inst, regs, v1, x2, b2, effective_addr2, m3 );
+    PER_ZEROADDR_XCHECK2( regs, x2, b2 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m3 >= NELEM( m ), regs );
+
+    vr_fetch( regs, v1, &v );
+
+    switch (m)
+    {
+    case 0:  ARCH_DEP( vstoreb )( VR_B( v, m3 ), effective_addr2, b2, regs ); break;
+    case 1:  ARCH_DEP( vstore2 )( VR_H( v, m3 ), effective_addr2, b2, regs ); break;
+    case 2:  ARCH_DEP( vstore4 )( VR_F( v, m3 ), effective_addr2, b2, regs ); break;
+    default: ARCH_DEP( vstore8 )( VR_D( v, m3 ), effective_addr2, b2, regs ); break;
+    }
+}
+
+DEF_INST( vector_store_element_8 )  { ARCH_DEP( vector_store_element )( inst, regs, 0 ); }
+DEF_INST( vector_store_element_16 ) { ARCH_DEP( vector_store_element )( inst, regs, 1 ); }
+DEF_INST( vector_store_element_32 ) { ARCH_DEP( vector_store_element )( inst, regs, 2 ); }
+DEF_INST( vector_store_element_64 ) { ARCH_DEP( vector_store_element )( inst, regs, 3 ); }
+
+/*-------------------------------------------------------------------*/
+/* E70E VST   - Vector Store                                   [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_store )
+{
+int     v1, x2, b2;                     /* Instruction fields        */
+int     m3;                             /* Alignment hint (ignored)  */
+VADR    effective_addr2;                /* Effective address         */
+BYTE    buf[16];                        /* Storage operand           */
+VR      v;                              /* Operand                   */
+
+    VRX( inst, regs, v1, x2, b2, effective_addr2, m3 );
+    PER_ZEROADDR_XCHECK2( regs, x2, b2 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m3 );
+
+    vr_fetch( regs, v1, &v );
+    vr_to_bytes( buf, &v );
+    ARCH_DEP( vstorec )( buf, 16-1, effective_addr2, b2, regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* E712 VGEG  - Vector Gather Element (64)                     [VRV] */
+/* E713 VGEF  - Vector Gather Element (32)                     [VRV] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_gather_element )( BYTE inst[], REGS* regs, int m )
+{
+int     v1, v2, b2;                     /* Instruction fields        */
+int     m3;                             /* Element index             */
+VADR    effective_addr2;                /* Effective address         */
+VR      v, x;                           /* Target and index vector   */
+
+    VRV( inst, regs, v1, v2, b2, effective_addr2, m3 );
+    PER_ZEROADDR_XCHECK( regs, b2 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m3 >= NELEM( m ), regs );
+
+    vr_fetch( regs, v2, &x );
+    effective_addr2 += (VADR) vr_get( &x, m, m3 );
+    effective_addr2 &= ADDRESS_MAXWRAP( regs );
+
+    vr_fetch( regs, v1, &v );
+    if (m == 2)
+        VR_F( v, m3 ) = ARCH_DEP( vfetch4 )( effective_addr2, b2, regs );
+    else
+        VR_D( v, m3 ) = ARCH_DEP( vfetch8 )( effective_addr2, b2, regs );
+    vr_store( regs, v1, &v );
+}
+
+DEF_INST( vector_gather_element_32 ) { ARCH_DEP( vector_gather_element )( inst, regs, 2 ); }
+DEF_INST( vector_gather_element_64 ) { ARCH_DEP( vector_gather_element )( inst, regs, 3 ); }
+
+/*-------------------------------------------------------------------*/
+/* E71A VSCEG - Vector Scatter Element (64)                    [VRV] */
+/* E71B VSCEF - Vector Scatter Element (32)                    [VRV] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_scatter_element )( BYTE inst[], REGS* regs, int m )
+{
+int     v1, v2, b2;                     /* Instruction fields        */
+int     m3;                             /* Element index             */
+VADR    effective_addr2;                /* Effective address         */
+VR      v, x;                           /* Source and index vector   */
+
+    VRV( inst, regs, v1, v2, b2, effective_addr2, m3 );
+    PER_ZEROADDR_XCHECK( regs, b2 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m3 >= NELEM( m ), regs );
+
+    vr_fetch( regs, v2, &x );
+    effective_addr2 += (VADR) vr_get( &x, m, m3 );
+    effective_addr2 &= ADDRESS_MAXWRAP( regs );
+
+    vr_fetch( regs, v1, &v );
+    if (m == 2)
+        ARCH_DEP( vstore4 )( VR_F( v, m3 ), effective_addr2, b2, regs );
+    else
+        ARCH_DEP( vstore8 )( VR_D( v, m3 ), effective_addr2, b2, regs );
+}
+
+DEF_INST( vector_scatter_element_32 ) { ARCH_DEP( vector_scatter_element )( inst, regs, 2 ); }
+DEF_INST( vector_scatter_element_64 ) { ARCH_DEP( vector_scatter_element )( inst, regs, 3 ); }
+
+/*-------------------------------------------------------------------*/
+/* E721 VLGV  - Vector Load GR from VR Element               [VRS-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_gr_from_vr_element )
+{
+int     r1, v3, b2;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+VADR    effective_addr2;                /* Element index             */
+VR      v;                              /* Operand                   */
+
+    VRS_C( inst, regs, r1, v3, b2, effective_addr2, m4 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v3, &v );
+    regs->GR_G( r1 ) = vr_get( &v, m4, (int)(effective_addr2 & (NELEM( m4 ) - 1)) );
+}
+
+/*-------------------------------------------------------------------*/
+/* E722 VLVG  - Vector Load VR Element from GR               [VRS-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_vr_element_from_gr )
+{
+int     v1, r3, b2;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+VADR    effective_addr2;                /* Element index             */
+VR      v;                              /* Result                    */
+
+    VRS_B( inst, regs, v1, r3, b2, effective_addr2, m4 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v1, &v );
+    vr_put( &v, m4, (int)(effective_addr2 & (NELEM( m4 ) - 1)), regs->GR_G( r3 ));
+    vr_store( regs, v1, &v );
+}
+
+/*-------------------------------------------------------------------*/
+/* E727 LCBB  - Load Count to Block Boundary                   [RXE] */
+/*-------------------------------------------------------------------*/
+DEF_INST( load_count_to_block_boundary )
+{
+int     r1, x2, b2;                     /* Instruction fields        */
+int     m3;                             /* Block boundary code       */
+VADR    effective_addr2;                /* Effective address         */
+U32     block;                          /* Block size                */
+U32     count;                          /* Bytes to the boundary     */
+
+    RXE_M3( inst, regs, r1, x2, b2, effective_addr2, m3 );
+    ZV_SPEC_CHECK( m3 > 6, regs );
+
+    block = 64U << m3;
+    count = MIN( 16, block - (U32)(effective_addr2 & (block - 1)) );
+
+    regs->GR_L( r1 ) = count;
+    regs->psw.cc = count == 16 ? 0 : 3;
+}
+
+/*-------------------------------------------------------------------*/
+/* E730 VESL  - Vector Element Shift Left                    [VRS-a] */
+/* E733 VERLL - Vector Element Rotate Left Logical           [VRS-a] */
+/* E738 VESRL - Vector Element Shift Right Logical           [VRS-a] */
+/* E73A VESRA - Vector Element Shift Right Arithmetic        [VRS-a] */
+/*-------------------------------------------------------------------*/
+enum { ZV_SL, ZV_RLL, ZV_SRL, ZV_SRA };
+
+/* Shift or rotate element x of size m by n (0 to EBITS(m)-1) bits */
+static INLINE U64 element_shift( int op, int m, U64 x, int n )
+{
+    int  bits = EBITS( m );
+
+    switch (op)
+    {
+    case ZV_SL:  return x << n;
+    case ZV_RLL: return n ? (x << n) | ((x & emask( m )) >> (bits - n)) : x;
+    case ZV_SRL: return (x & emask( m )) >> n;
+    default:     return (U64)(((S64)(x << (64 - bits))) >> (64 - bits + n));
+    }
+}
+
+static void ARCH_DEP( vector_element_shift )( BYTE inst[], REGS* regs, int op )
+{
+int     v1, v3, b2;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+VADR    effective_addr2;                /* Shift amount              */
+int     n;                              /* Shift count               */
+int     i;                              /* Element index             */
+VR      a, r;                           /* Operand and result        */
+
+    VRS_A( inst, regs, v1, v3, b2, effective_addr2, m4 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 > 3, regs );
+
+    n = (int)(effective_addr2 & (EBITS( m4 ) - 1));
+    vr_fetch( regs, v3, &a );
+    for (i=0; i < NELEM( m4 ); i++)
+        vr_put( &r, m4, i, element_shift( op, m4, vr_get( &a, m4, i ), n ));
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_element_shift_left )             { ARCH_DEP( vector_element_shift )( inst, regs, ZV_SL  ); }
+DEF_INST( vector_element_rotate_left_logical )    { ARCH_DEP( vector_element_shift )( inst, regs, ZV_RLL ); }
+DEF_INST( vector_element_shift_right_logical )    { ARCH_DEP( vector_element_shift )( inst, regs, ZV_SRL ); }
+DEF_INST( vector_element_shift_right_arithmetic ) { ARCH_DEP( vector_element_shift )( inst, regs, ZV_SRA ); }
+
+/*-------------------------------------------------------------------*/
+/* E736 VLM   - Vector Load Multiple                         [VRS-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_multiple )
+{
+int     v1, v3, b2;                     /* Instruction fields        */
+int     m4;                             /* Alignment hint (ignored)  */
+VADR    effective_addr2;                /* Effective address         */
+int     n;                              /* Number of registers       */
+int     i;                              /* Register index            */
+BYTE    buf[256];                       /* Storage operand           */
+VR      v;                              /* Register value            */
+
+    VRS_A( inst, regs, v1, v3, b2, effective_addr2, m4 );
+    PER_ZEROADDR_XCHECK( regs, b2 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m4 );
+
+    n = v3 - v1 + 1;
+    ZV_SPEC_CHECK( n <= 0 || n > 16, regs );
+
+    ARCH_DEP( vfetchc )( buf, n*16 - 1, effective_addr2, b2, regs );
+    for (i=0; i < n; i++)
+    {
+        vr_from_bytes( &v, buf + i*16 );
+        vr_store( regs, v1 + i, &v );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* E737 VLL   - Vector Load With Length                      [VRS-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_with_length )
+{
+int     v1, r3, b2;                     /* Instruction fields        */
+int     m4;                             /* Unused                    */
+VADR    effective_addr2;                /* Effective address         */
+int     len;                            /* Bytes to load             */
+int     j;                              /* Byte index                */
+BYTE    buf[16];                        /* Storage operand           */
+VR      v;                              /* Result                    */
+
+    VRS_B( inst, regs, v1, r3, b2, effective_addr2, m4 );
+    PER_ZEROADDR_XCHECK( regs, b2 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m4 );
+
+    /* R3 holds the highest byte index to be loaded */
+    len = (int) MIN( regs->GR_L( r3 ), 15 ) + 1;
+    ARCH_DEP( vfetchc )( buf, len-1, effective_addr2, b2, regs );
+
+    for (j=0; j < 16; j++)
+        VR_B( v, j ) = j < len ? buf[j] : 0;
+    vr_store( regs, v1, &v );
+}
+
+/*-------------------------------------------------------------------*/
+/* E73E VSTM  - Vector Store Multiple                        [VRS-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_store_multiple )
+{
+int     v1, v3, b2;                     /* Instruction fields        */
+int     m4;                             /* Alignment hint (ignored)  */
+VADR    effective_addr2;                /* Effective address         */
+int     n;                              /* Number of registers       */
+int     i;                              /* Register index            */
+BYTE    buf[256];                       /* Storage operand           */
+VR      v;                              /* Register value            */
+
+    VRS_A( inst, regs, v1, v3, b2, effective_addr2, m4 );
+    PER_ZEROADDR_XCHECK( regs, b2 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m4 );
+
+    n = v3 - v1 + 1;
+    ZV_SPEC_CHECK( n <= 0 || n > 16, regs );
+
+    for (i=0; i < n; i++)
+    {
+        vr_fetch( regs, v1 + i, &v );
+        vr_to_bytes( buf + i*16, &v );
+    }
+    ARCH_DEP( vstorec )( buf, n*16 - 1, effective_addr2, b2, regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* E73F VSTL  - Vector Store With Length                     [VRS-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_store_with_length )
+{
+int     v1, r3, b2;                     /* Instruction fields        */
+int     m4;                             /* Unused                    */
+VADR    effective_addr2;                /* Effective address         */
+int     len;                            /* Bytes to store            */
+BYTE    buf[16];                        /* Storage operand           */
+VR      v;                              /* Operand                   */
+
+    VRS_B( inst, regs, v1, r3, b2, effective_addr2, m4 );
+    PER_ZEROADDR_XCHECK( regs, b2 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m4 );
+
+    len = (int) MIN( regs->GR_L( r3 ), 15 ) + 1;
+    vr_fetch( regs, v1, &v );
+    vr_to_bytes( buf, &v );
+    ARCH_DEP( vstorec )( buf, len-1, effective_addr2, b2, regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* E740 VLEIB - Vector Load Element Immediate (8)            [VRI-a] */
+/* E741 VLEIH - Vector Load Element Immediate (16)           [VRI-a] */
+/* E742 VLEIG - Vector Load Element Immediate (64)           [VRI-a] */
+/* E743 VLEIF - Vector Load Element Immediate (32)           [VRI-a] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_load_element_immediate )( BYTE inst[], REGS* regs, int m )
+{
+int     v1;                             /* Instruction field         */
+U16     i2;                             /* Immediate                 */
+int     m3;                             /* Element index             */
+VR      v;                              /* Result                    */
+
+    VRI_A( inst, regs, v1, i2, m3 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m3 >= NELEM( m ), regs );
+
+    vr_fetch( regs, v1, &v );
+    vr_put( &v, m, m3, (U64)(S64)(S16) i2 );
+    vr_store( regs, v1, &v );
+}
+
+DEF_INST( vector_load_element_immediate_8 )  { ARCH_DEP( vector_load_element_immediate )( inst, regs, 0 ); }
+DEF_INST( vector_load_element_immediate_16 ) { ARCH_DEP( vector_load_element_immediate )( inst, regs, 1 ); }
+DEF_INST( vector_load_element_immediate_32 ) { ARCH_DEP( vector_load_element_immediate )( inst, regs, 2 ); }
+DEF_INST( vector_load_element_immediate_64 ) { ARCH_DEP( vector_load_element_immediate )( inst, regs, 3 ); }
+
+/*-------------------------------------------------------------------*/
+/* E744 VGBM  - Vector Generate Byte Mask                    [VRI-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_generate_byte_mask )
+{
+int     v1;                             /* Instruction field         */
+U16     i2;                             /* Byte mask                 */
+int     m3;                             /* Unused                    */
+int     j;                              /* Byte index                */
+VR      v;                              /* Result                    */
+
+    VRI_A( inst, regs, v1, i2, m3 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m3 );
+
+    for (j=0; j < 16; j++)
+        VR_B( v, j ) = (i2 >> (15 - j)) & 1 ? 0xFF : 0x00;
+    vr_store( regs, v1, &v );
+}
+
+/*-------------------------------------------------------------------*/
+/* E745 VREPI - Vector Replicate Immediate                   [VRI-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_replicate_immediate )
+{
+int     v1;                             /* Instruction field         */
+U16     i2;                             /* Immediate                 */
+int     m3;                             /* Element size              */
+int     i;                              /* Element index             */
+VR      v;                              /* Result                    */
+
+    VRI_A( inst, regs, v1, i2, m3 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m3 > 3, regs );
+
+    for (i=0; i < NELEM( m3 ); i++)
+        vr_put( &v, m3, i, (U64)(S64)(S16) i2 );
+    vr_store( regs, v1, &v );
+}
+
+/*-------------------------------------------------------------------*/
+/* E746 VGM   - Vector Generate Mask                         [VRI-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_generate_mask )
+{
+int     v1;                             /* Instruction field         */
+int     i2, i3;                         /* First and last bit        */
+int     m4;                             /* Element size              */
+int     bits;                           /* Element size in bits      */
+int     b;                              /* Bit number                */
+U64     x = 0;                          /* Element value             */
+int     i;                              /* Element index             */
+VR      v;                              /* Result                    */
+
+    VRI_B( inst, regs, v1, i2, i3, m4 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 > 3, regs );
+
+    bits = EBITS( m4 );
+    i2 &= bits - 1;
+    i3 &= bits - 1;
+
+    /* The bits from i2 to i3 are ones, wrapping around if i2 > i3 */
+    for (b=0; b < bits; b++)
+        if (i2 <= i3 ? (b >= i2 && b <= i3) : (b >= i2 || b <= i3))
+            x |= 1ULL << (bits - 1 - b);
+
+    for (i=0; i < NELEM( m4 ); i++)
+        vr_put( &v, m4, i, x );
+    vr_store( regs, v1, &v );
+}
+
+/*-------------------------------------------------------------------*/
+/* E74D VREP  - Vector Replicate                             [VRI-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_replicate )
+{
+int     v1, v3;                         /* Instruction fields        */
+U16     i2;                             /* Element index             */
+int     m4;                             /* Element size              */
+U64     x;                              /* Element value             */
+int     i;                              /* Element index             */
+VR      v;                              /* Operand and result        */
+
+    VRI_C( inst, regs, v1, v3, i2, m4 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 > 3 || i2 >= NELEM( m4 ), regs );
+
+    vr_fetch( regs, v3, &v );
+    x = vr_get( &v, m4, i2 );
+    for (i=0; i < NELEM( m4 ); i++)
+        vr_put( &v, m4, i, x );
+    vr_store( regs, v1, &v );
+}
+
+/*-------------------------------------------------------------------*/
+/* E750 VPOPCT - Vector Population Count                     [VRR-a] */
+/* E752 VCTZ  - Vector Count Trailing Zeros                  [VRR-a] */
+/* E753 VCLZ  - Vector Count Leading Zeros                   [VRR-a] */
+/*-------------------------------------------------------------------*/
+enum { ZV_POPCT, ZV_CTZ, ZV_CLZ };
+
+static void ARCH_DEP( vector_count )( BYTE inst[], REGS* regs, int op )
+{
+int     v1, v2;                         /* Instruction fields        */
+int     m3, m4, m5;                     /* Element size, unused      */
+U64     x;                              /* Element value             */
+int     n;                              /* Count                     */
+int     i;                              /* Element index             */
+VR      a, r;                           /* Operand and result        */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    /* Population count only counts bytes without facility 135 */
+    ZV_SPEC_CHECK( op == ZV_POPCT ? m3 != 0 : m3 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    for (i=0; i < NELEM( m3 ); i++)
+    {
+        x = vr_get( &a, m3, i );
+        switch (op)
+        {
+        case ZV_POPCT: n = popcnt64( x );              break;
+        case ZV_CTZ:   n = ctz64( x, EBITS( m3 ));     break;
+        default:       n = clz64( x, EBITS( m3 ));     break;
+        }
+        vr_put( &r, m3, i, n );
+    }
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_population_count )     { ARCH_DEP( vector_count )( inst, regs, ZV_POPCT ); }
+DEF_INST( vector_count_trailing_zeros ) { ARCH_DEP( vector_count )( inst, regs, ZV_CTZ   ); }
+DEF_INST( vector_count_leading_zeros )  { ARCH_DEP( vector_count )( inst, regs, ZV_CLZ   ); }
+
+/*-------------------------------------------------------------------*/
+/* E756 VLR   - Vector Load Vector                           [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_vector )
+{
+int     v1, v2;                         /* Instruction fields        */
+int     m3, m4, m5;                     /* Unused                    */
+VR      v;                              /* Operand                   */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m3 );
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    vr_fetch( regs, v2, &v );
+    vr_store( regs, v1, &v );
+}
+
+/*-------------------------------------------------------------------*/
+/* E75C VISTR - Vector Isolate String                        [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_isolate_string )
+{
+int     v1, v2;                         /* Instruction fields        */
+int     m3;                             /* Element size              */
+int     m4;                             /* Unused                    */
+int     m5;                             /* Flags (CS)                */
+int     fz;                             /* Byte index of first zero  */
+int     j;                              /* Byte index                */
+VR      v;                              /* Operand and result        */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m3 > 2, regs );
+    UNREFERENCED( m4 );
+
+    vr_fetch( regs, v2, &v );
+    fz = first_byte( vr_zeromask( m3, &v ));
+
+    /* The zero element and everything to its right become zero */
+    for (j=fz; j < 16; j++)
+        VR_B( v, j ) = 0;
+    vr_store( regs, v1, &v );
+
+    if (m5 & 0x1)
+        regs->psw.cc = fz < 16 ? 0 : 3;
+}
+
+/*-------------------------------------------------------------------*/
+/* E75F VSEG  - Vector Sign Extend to Doubleword             [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_sign_extend_to_doubleword )
+{
+int     v1, v2;                         /* Instruction fields        */
+int     m3;                             /* Element size              */
+int     m4, m5;                         /* Unused                    */
+VR      a, r;                           /* Operand and result        */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m3 > 2, regs );
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    /* The rightmost element of each doubleword is extended */
+    vr_fetch( regs, v2, &a );
+    VR_D( r, 0 ) = (U64) vr_gets( &a, m3, NELEM( m3 ) / 2 - 1 );
+    VR_D( r, 1 ) = (U64) vr_gets( &a, m3, NELEM( m3 )     - 1 );
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E760 VMRL  - Vector Merge Low                             [VRR-c] */
+/* E761 VMRH  - Vector Merge High                            [VRR-c] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_merge )( BYTE inst[], REGS* regs, bool low )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+int     m5, m6;                         /* Unused                    */
+int     i, k;                           /* Element indexes           */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 > 3, regs );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    k = low ? NELEM( m4 ) / 2 : 0;
+    for (i=0; i < NELEM( m4 ) / 2; i++)
+    {
+        vr_put( &r, m4, 2*i,   vr_get( &a, m4, k+i ));
+        vr_put( &r, m4, 2*i+1, vr_get( &b, m4, k+i ));
+    }
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_merge_low )  { ARCH_DEP( vector_merge )( inst, regs, true  ); }
+DEF_INST( vector_merge_high ) { ARCH_DEP( vector_merge )( inst, regs, false ); }
+
+/*-------------------------------------------------------------------*/
+/* E762 VLVGP - Vector Load VR from GRs Disjoint             [VRR-f] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_vr_from_grs_disjoint )
+{
+int     v1, r2, r3;                     /* Instruction fields        */
+VR      v;                              /* Result                    */
+
+    VRR_F( inst, regs, v1, r2, r3 );
+    ZVECTOR_CHECK( regs );
+
+    VR_D( v, 0 ) = regs->GR_G( r2 );
+    VR_D( v, 1 ) = regs->GR_G( r3 );
+    vr_store( regs, v1, &v );
+}
+
+/*-------------------------------------------------------------------*/
+/* E764 VSUM  - Vector Sum Across Word                       [VRR-c] */
+/* E765 VSUMG - Vector Sum Across Doubleword                 [VRR-c] */
+/* E767 VSUMQ - Vector Sum Across Quadword                   [VRR-c] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_sum_across )( BYTE inst[], REGS* regs, int rm )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+int     m5, m6;                         /* Unused                    */
+int     n;                              /* Elements per result       */
+int     i, k;                           /* Element indexes           */
+VR      a, b, r, t;                     /* Operands and result       */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    /* The result element size rm is 2, 3 or 4 and the operand's one  */
+    /* may be either of the two sizes below it                        */
+    ZV_SPEC_CHECK( m4 >= rm || m4 < rm - 2, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    n = 1 << (rm - m4);
+
+    if (rm == 4)
+    {
+        /* Quadword sum: 128-bit additions with carry */
+        VR_D( r, 0 ) = 0;
+        VR_D( r, 1 ) = vr_get( &b, m4, NELEM( m4 ) - 1 );
+        for (k=0; k < n; k++)
+        {
+            VR_D( t, 0 ) = 0;
+            VR_D( t, 1 ) = vr_get( &a, m4, k );
+            vr_add128( &r, &r, &t, 0 );
+        }
+    }
+    else
+    {
+        for (i=0; i < NELEM( rm ); i++)
+        {
+            U64  sum = vr_get( &b, m4, (i+1)*n - 1 );
+            for (k=0; k < n; k++)
+                sum += vr_get( &a, m4, i*n + k );
+            vr_put( &r, rm, i, sum );
+        }
+    }
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_sum_across_word )       { ARCH_DEP( vector_sum_across )( inst, regs, 2 ); }
+DEF_INST( vector_sum_across_doubleword ) { ARCH_DEP( vector_sum_across )( inst, regs, 3 ); }
+DEF_INST( vector_sum_across_quadword )   { ARCH_DEP( vector_sum_across )( inst, regs, 4 ); }
+
+/*-------------------------------------------------------------------*/
+/* E766 VCKSM - Vector Checksum                              [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_checksum )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4, m5, m6;                     /* Unused                    */
+U64     sum;                            /* Checksum                  */
+int     i;                              /* Element index             */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    /* Word 1 of the third operand plus the second operand's words */
+    /* with end-around carry, as CKSM does                         */
+    sum = VR_F( b, 1 );
+    for (i=0; i < 4; i++)
+    {
+        sum += VR_F( a, i );
+        sum  = (sum & 0xFFFFFFFF) + (sum >> 32);
+    }
+
+    VR_D( r, 0 ) = sum & 0xFFFFFFFF;
+    VR_D( r, 1 ) = 0;
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E768 VN    - Vector AND                                   [VRR-c] */
+/* E769 VNC   - Vector AND with Complement                   [VRR-c] */
+/* E76A VO    - Vector OR                                    [VRR-c] */
+/* E76B VNO   - Vector NOR                                   [VRR-c] */
+/* E76D VX    - Vector Exclusive OR                          [VRR-c] */
+/*-------------------------------------------------------------------*/
+enum { ZV_N, ZV_NC, ZV_O, ZV_NO, ZV_X };
+
+static void ARCH_DEP( vector_logical )( BYTE inst[], REGS* regs, int op )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4, m5, m6;                     /* Unused                    */
+int     i;                              /* Doubleword index          */
+U64     x, y;                           /* Operand doublewords       */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    for (i=0; i < 2; i++)
+    {
+        x = VR_D( a, i );
+        y = VR_D( b, i );
+        switch (op)
+        {
+        case ZV_N:  VR_D( r, i ) =   x &  y;  break;
+        case ZV_NC: VR_D( r, i ) =   x & ~y;  break;
+        case ZV_O:  VR_D( r, i ) =   x |  y;  break;
+        case ZV_NO: VR_D( r, i ) = ~(x |  y); break;
+        default:    VR_D( r, i ) =   x ^  y;  break;
+        }
+    }
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_and )                 { ARCH_DEP( vector_logical )( inst, regs, ZV_N  ); }
+DEF_INST( vector_and_with_complement ) { ARCH_DEP( vector_logical )( inst, regs, ZV_NC ); }
+DEF_INST( vector_or )                  { ARCH_DEP( vector_logical )( inst, regs, ZV_O  ); }
+DEF_INST( vector_nor )                 { ARCH_DEP( vector_logical )( inst, regs, ZV_NO ); }
+DEF_INST( vector_exclusive_or )        { ARCH_DEP( vector_logical )( inst, regs, ZV_X  ); }
+
+/*-------------------------------------------------------------------*/
+/* E770 VESLV - Vector Element Shift Left                    [VRR-c] */
+/* E773 VERLLV - Vector Element Rotate Left Logical          [VRR-c] */
+/* E778 VESRLV - Vector Element Shift Right Logical          [VRR-c] */
+/* E77A VESRAV - Vector Element Shift Right Arithmetic       [VRR-c] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_element_shift_vector )( BYTE inst[], REGS* regs, int op )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+int     m5, m6;                         /* Unused                    */
+int     n;                              /* Shift count               */
+int     i;                              /* Element index             */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 > 3, regs );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    for (i=0; i < NELEM( m4 ); i++)
+    {
+        n = (int)(vr_get( &b, m4, i ) & (EBITS( m4 ) - 1));
+        vr_put( &r, m4, i, element_shift( op, m4, vr_get( &a, m4, i ), n ));
+    }
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_element_shift_left_vector )             { ARCH_DEP( vector_element_shift_vector )( inst, regs, ZV_SL  ); }
+DEF_INST( vector_element_rotate_left_logical_vector )    { ARCH_DEP( vector_element_shift_vector )( inst, regs, ZV_RLL ); }
+DEF_INST( vector_element_shift_right_logical_vector )    { ARCH_DEP( vector_element_shift_vector )( inst, regs, ZV_SRL ); }
+DEF_INST( vector_element_shift_right_arithmetic_vector ) { ARCH_DEP( vector_element_shift_vector )( inst, regs, ZV_SRA ); }
+
+/*-------------------------------------------------------------------*/
+/* E772 VERIM - Vector Element Rotate and Insert Under Mask  [VRI-d] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_element_rotate_and_insert_under_mask )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     i4;                             /* Rotate amount             */
+int     m5;                             /* Element size              */
+U64     x, mask;                        /* Rotated element and mask  */
+int     i;                              /* Element index             */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRI_D( inst, regs, v1, v2, v3, i4, m5 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m5 > 3, regs );
+
+    vr_fetch( regs, v1, &r );
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    for (i=0; i < NELEM( m5 ); i++)
+    {
+        x    = element_shift( ZV_RLL, m5, vr_get( &a, m5, i ), i4 & (EBITS( m5 ) - 1) );
+        mask = vr_get( &b, m5, i );
+        vr_put( &r, m5, i, (x & mask) | (vr_get( &r, m5, i ) & ~mask) );
+    }
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E774 VSL   - Vector Shift Left                            [VRR-c] */
+/* E775 VSLB  - Vector Shift Left by Byte                    [VRR-c] */
+/* E77C VSRL  - Vector Shift Right Logical                   [VRR-c] */
+/* E77D VSRLB - Vector Shift Right Logical by Byte           [VRR-c] */
+/* E77E VSRA  - Vector Shift Right Arithmetic                [VRR-c] */
+/* E77F VSRAB - Vector Shift Right Arithmetic by Byte        [VRR-c] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_shift )( BYTE inst[], REGS* regs, int op, bool bytes )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4, m5, m6;                     /* Unused                    */
+int     n;                              /* Shift count in bits       */
+VR      a, b;                           /* Operands and result       */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    /* The shift amount is taken from byte element 7 of operand 3:   */
+    /* bits 1-4 for a byte shift, bits 5-7 for a bit shift           */
+    n = bytes ? ((VR_B( b, 7 ) >> 3) & 0xF) * 8 : VR_B( b, 7 ) & 0x7;
+
+    if (op == ZV_SL)
+        vr_shl( &a, n );
+    else
+        vr_shr( &a, n, op == ZV_SRA );
+    vr_store( regs, v1, &a );
+}
+
+DEF_INST( vector_shift_left )                     { ARCH_DEP( vector_shift )( inst, regs, ZV_SL,  false ); }
+DEF_INST( vector_shift_left_by_byte )             { ARCH_DEP( vector_shift )( inst, regs, ZV_SL,  true  ); }
+DEF_INST( vector_shift_right_logical )            { ARCH_DEP( vector_shift )( inst, regs, ZV_SRL, false ); }
+DEF_INST( vector_shift_right_logical_by_byte )    { ARCH_DEP( vector_shift )( inst, regs, ZV_SRL, true  ); }
+DEF_INST( vector_shift_right_arithmetic )         { ARCH_DEP( vector_shift )( inst, regs, ZV_SRA, false ); }
+DEF_INST( vector_shift_right_arithmetic_by_byte ) { ARCH_DEP( vector_shift )( inst, regs, ZV_SRA, true  ); }
+
+/*-------------------------------------------------------------------*/
+/* E777 VSLDB - Vector Shift Left Double by Byte             [VRI-d] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_shift_left_double_by_byte )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     i4;                             /* Shift amount              */
+int     m5;                             /* Unused                    */
+int     j, k;                           /* Byte indexes              */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRI_D( inst, regs, v1, v2, v3, i4, m5 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m5 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    for (j=0; j < 16; j++)
+    {
+        k = j + (i4 & 0xF);
+        VR_B( r, j ) = k < 16 ? VR_B( a, k ) : VR_B( b, k - 16 );
+    }
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E780 VFEE  - Vector Find Element Equal                    [VRR-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_find_element_equal )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+int     m5;                             /* Flags (ZS, CS)            */
+int     fe, fz;                         /* First equal and zero      */
+int     cc;                             /* Condition code            */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRR_B( inst, regs, v1, v2, v3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 > 2, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    fe = first_byte( vr_eqmask( m4, &a, &b ));
+    fz = m5 & 0x2 ? first_byte( vr_zeromask( m4, &a )) : 16;
+
+    if (fe == 16 && fz == 16) cc = 3;
+    else if (fe <= fz)        cc = 1;
+    else                      cc = 0;
+
+    VR_D( r, 0 ) = MIN( fe, fz );
+    VR_D( r, 1 ) = 0;
+    vr_store( regs, v1, &r );
+
+    if (m5 & 0x1)
+        regs->psw.cc = cc;
+}
+
+/*-------------------------------------------------------------------*/
+/* E781 VFENE - Vector Find Element Not Equal                [VRR-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_find_element_not_equal )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+int     m5;                             /* Flags (ZS, CS)            */
+int     fn, fz;                         /* First unequal and zero    */
+int     cc;                             /* Condition code            */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRR_B( inst, regs, v1, v2, v3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 > 2, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    fn = first_byte( ~vr_eqmask( m4, &a, &b ) & 0xFFFF );
+    fz = m5 & 0x2 ? first_byte( vr_zeromask( m4, &a )) : 16;
+
+    if (fn == 16 && fz == 16) cc = 3;
+    else if (fz < fn)         cc = 0;
+    else cc = vr_get( &a, m4, fn >> m4 ) < vr_get( &b, m4, fn >> m4 ) ? 1 : 2;
+
+    VR_D( r, 0 ) = MIN( fn, fz );
+    VR_D( r, 1 ) = 0;
+    vr_store( regs, v1, &r );
+
+    if (m5 & 0x1)
+        regs->psw.cc = cc;
+}
+
+/*-------------------------------------------------------------------*/
+/* E782 VFAE  - Vector Find Any Element Equal                [VRR-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_find_any_element_equal )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+int     m5;                             /* Flags (IN, RT, ZS, CS)    */
+U32     match;                          /* Matching elements         */
+int     cc;                             /* Condition code            */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRR_B( inst, regs, v1, v2, v3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 > 2, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    match = vr_anymask( m4, &a, &b );
+    if (m5 & 0x8)
+        match = ~match & 0xFFFF;
+
+    cc = find_any_result( &r, match, (m5 & 0x2) ? vr_zeromask( m4, &a ) : 0,
+                          (m5 & 0x4) != 0, (m5 & 0x2) != 0 );
+    vr_store( regs, v1, &r );
+
+    if (m5 & 0x1)
+        regs->psw.cc = cc;
+}
+
+/*-------------------------------------------------------------------*/
+/* E784 VPDI  - Vector Permute Doubleword Immediate          [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_permute_doubleword_immediate )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4;                             /* Doubleword selection      */
+int     m5, m6;                         /* Unused                    */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    VR_D( r, 0 ) = VR_D( a, (m4 & 0x4) ? 1 : 0 );
+    VR_D( r, 1 ) = VR_D( b, (m4 & 0x1) ? 1 : 0 );
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E78A VSTRC - Vector String Range Compare                  [VRR-d] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_string_range_compare )
+{
+int     v1, v2, v3, v4;                 /* Instruction fields        */
+int     m5;                             /* Element size              */
+int     m6;                             /* Flags (IN, RT, ZS, CS)    */
+U32     match;                          /* Matching elements         */
+int     cc;                             /* Condition code            */
+VR      a, b, c, r;                     /* Operands and result       */
+
+    VRR_D( inst, regs, v1, v2, v3, v4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m5 > 2, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    vr_fetch( regs, v4, &c );
+
+    match = vr_rangemask( m5, &a, &b, &c );
+    if (m6 & 0x8)
+        match = ~match & 0xFFFF;
+
+    cc = find_any_result( &r, match, (m6 & 0x2) ? vr_zeromask( m5, &a ) : 0,
+                          (m6 & 0x4) != 0, (m6 & 0x2) != 0 );
+    vr_store( regs, v1, &r );
+
+    if (m6 & 0x1)
+        regs->psw.cc = cc;
+}
+
+/*-------------------------------------------------------------------*/
+/* E78C VPERM - Vector Permute                               [VRR-e] */
+/* E78D VSEL  - Vector Select                                [VRR-e] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_permute )
+{
+int     v1, v2, v3, v4;                 /* Instruction fields        */
+int     m5, m6;                         /* Unused                    */
+int     j, k;                           /* Byte indexes              */
+VR      a, b, c, r;                     /* Operands and result       */
+
+    VRR_E( inst, regs, v1, v2, v3, v4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    vr_fetch( regs, v4, &c );
+    for (j=0; j < 16; j++)
+    {
+        k = VR_B( c, j ) & 0x1F;
+        VR_B( r, j ) = k < 16 ? VR_B( a, k ) : VR_B( b, k - 16 );
+    }
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_select )
+{
+int     v1, v2, v3, v4;                 /* Instruction fields        */
+int     m5, m6;                         /* Unused                    */
+int     i;                              /* Doubleword index          */
+VR      a, b, c, r;                     /* Operands and result       */
+
+    VRR_E( inst, regs, v1, v2, v3, v4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    vr_fetch( regs, v4, &c );
+    for (i=0; i < 2; i++)
+        VR_D( r, i ) = (VR_D( a, i ) & VR_D( c, i )) | (VR_D( b, i ) & ~VR_D( c, i ));
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E794 VPK   - Vector Pack                                  [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_pack )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+int     m5, m6;                         /* Unused                    */
+int     n;                              /* Operand elements          */
+int     i;                              /* Element index             */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 < 1 || m4 > 3, regs );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    n = NELEM( m4 );
+    for (i=0; i < n; i++)
+    {
+        vr_put( &r, m4-1, i,     vr_get( &a, m4, i ));
+        vr_put( &r, m4-1, n + i, vr_get( &b, m4, i ));
+    }
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E795 VPKLS - Vector Pack Logical Saturate                 [VRR-b] */
+/* E797 VPKS  - Vector Pack Saturate                         [VRR-b] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_pack_sat )( BYTE inst[], REGS* regs, bool logical )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+int     m5;                             /* Flags (CS)                */
+int     n;                              /* Operand elements          */
+int     i;                              /* Element index             */
+int     sat = 0;                        /* Saturated element count   */
+U64     umax;                           /* Unsigned maximum          */
+S64     smax, smin, x;                  /* Signed limits and value   */
+VR      a, b, r;                        /* Operands and result       */
+const VR* src;                          /* Operand of the element    */
+
+    VRR_B( inst, regs, v1, v2, v3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 < 1 || m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    n    = NELEM( m4 );
+    umax = emask( m4-1 );
+    smax = (S64)(umax >> 1);
+    smin = -smax - 1;
+
+    for (i=0; i < 2*n; i++)
+    {
+        src = i < n ? &a : &b;
+        if (logical)
+        {
+            U64  u = vr_get( src, m4, i % n );
+            if (u > umax) { u = umax; sat++; }
+            vr_put( &r, m4-1, i, u );
+        }
+        else
+        {
+            x = vr_gets( src, m4, i % n );
+            if      (x > smax) { x = smax; sat++; }
+            else if (x < smin) { x = smin; sat++; }
+            vr_put( &r, m4-1, i, (U64) x );
+        }
+    }
+    vr_store( regs, v1, &r );
+
+    if (m5 & 0x1)
+        regs->psw.cc = sat == 0 ? 0 : sat == 2*n ? 3 : 1;
+}
+
+DEF_INST( vector_pack_logical_saturate ) { ARCH_DEP( vector_pack_sat )( inst, regs, true  ); }
+DEF_INST( vector_pack_saturate )         { ARCH_DEP( vector_pack_sat )( inst, regs, false ); }
+
+/*-------------------------------------------------------------------*/
+/* E7A1 VMLH  - Vector Multiply Logical High                 [VRR-c] */
+/* E7A2 VML   - Vector Multiply Low                          [VRR-c] */
+/* E7A3 VMH   - Vector Multiply High                         [VRR-c] */
+/* E7A9 VMALH - Vector Multiply and Add Logical High         [VRR-d] */
+/* E7AA VMAL  - Vector Multiply and Add Low                  [VRR-d] */
+/* E7AB VMAH  - Vector Multiply and Add High                 [VRR-d] */
+/*-------------------------------------------------------------------*/
+enum { ZV_LOW, ZV_HIGH, ZV_LHIGH };
+
+static void ARCH_DEP( vector_multiply )( BYTE inst[], REGS* regs, int op, bool add )
+{
+int     v1, v2, v3, v4;                 /* Instruction fields        */
+int     m;                              /* Element size              */
+int     m5, m6;                         /* Unused                    */
+int     i;                              /* Element index             */
+U64     p;                              /* Product                   */
+VR      a, b, c, r;                     /* Operands and result       */
+
+    if (add)
+    {
+        VRR_D( inst, regs, v1, v2, v3, v4, m, m6 );
+        m5 = 0;
+    }
+    else
+    {
+        VRR_C( inst, regs, v1, v2, v3, m, m5, m6 );
+        v4 = 0;
+    }
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m > 2, regs );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    if (add)
+        vr_fetch( regs, v4, &c );
+
+    /* Elements are at most 32 bits so the sum fits 64 bits */
+    for (i=0; i < NELEM( m ); i++)
+    {
+        if (op == ZV_LHIGH)
+            p = vr_get( &a, m, i ) * vr_get( &b, m, i )
+              + (add ? vr_get( &c, m, i ) : 0);
+        else
+            p = (U64)(vr_gets( &a, m, i ) * vr_gets( &b, m, i )
+              + (add ? vr_gets( &c, m, i ) : 0));
+
+        vr_put( &r, m, i, op == ZV_LOW ? p : p >> EBITS( m ));
+    }
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_multiply_logical_high )         { ARCH_DEP( vector_multiply )( inst, regs, ZV_LHIGH, false ); }
+DEF_INST( vector_multiply_low )                  { ARCH_DEP( vector_multiply )( inst, regs, ZV_LOW,   false ); }
+DEF_INST( vector_multiply_high )                 { ARCH_DEP( vector_multiply )( inst, regs, ZV_HIGH,  false ); }
+DEF_INST( vector_multiply_and_add_logical_high ) { ARCH_DEP( vector_multiply )( inst, regs, ZV_LHIGH, true  ); }
+DEF_INST( vector_multiply_and_add_low )          { ARCH_DEP( vector_multiply )( inst, regs, ZV_LOW,   true  ); }
+DEF_INST( vector_multiply_and_add_high )         { ARCH_DEP( vector_multiply )( inst, regs, ZV_HIGH,  true  ); }
+
+/*-------------------------------------------------------------------*/
+/* E7A4 VMLE  - Vector Multiply Logical Even                 [VRR-c] */
+/* E7A5 VMLO  - Vector Multiply Logical Odd                  [VRR-c] */
+/* E7A6 VME   - Vector Multiply Even                         [VRR-c] */
+/* E7A7 VMO   - Vector Multiply Odd                          [VRR-c] */
+/* E7AC VMALE - Vector Multiply and Add Logical Even         [VRR-d] */
+/* E7AD VMALO - Vector Multiply and Add Logical Odd          [VRR-d] */
+/* E7AE VMAE  - Vector Multiply and Add Even                 [VRR-d] */
+/* E7AF VMAO  - Vector Multiply and Add Odd                  [VRR-d] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_multiply_wide )( BYTE inst[], REGS* regs, bool logical, bool odd, bool add )
+{
+int     v1, v2, v3, v4;                 /* Instruction fields        */
+int     m;                              /* Element size              */
+int     m5, m6;                         /* Unused                    */
+int     i, k;                           /* Element indexes           */
+U64     p;                              /* Product                   */
+VR      a, b, c, r;                     /* Operands and result       */
+
+    if (add)
+    {
+        VRR_D( inst, regs, v1, v2, v3, v4, m, m6 );
+        m5 = 0;
+    }
+    else
+    {
+        VRR_C( inst, regs, v1, v2, v3, m, m5, m6 );
+        v4 = 0;
+    }
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m > 2, regs );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    if (add)
+        vr_fetch( regs, v4, &c );
+
+    /* Each product of two elements is a double width element */
+    for (i=0; i < NELEM( m+1 ); i++)
+    {
+        k = 2*i + (odd ? 1 : 0);
+        if (logical)
+            p = vr_get( &a, m, k ) * vr_get( &b, m, k )
+              + (add ? vr_get( &c, m+1, i ) : 0);
+        else
+            p = (U64)(vr_gets( &a, m, k ) * vr_gets( &b, m, k )
+              + (add ? vr_gets( &c, m+1, i ) : 0));
+        vr_put( &r, m+1, i, p );
+    }
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_multiply_logical_even )         { ARCH_DEP( vector_multiply_wide )( inst, regs, true,  false, false ); }
+DEF_INST( vector_multiply_logical_odd )          { ARCH_DEP( vector_multiply_wide )( inst, regs, true,  true,  false ); }
+DEF_INST( vector_multiply_even )                 { ARCH_DEP( vector_multiply_wide )( inst, regs, false, false, false ); }
+DEF_INST( vector_multiply_odd )                  { ARCH_DEP( vector_multiply_wide )( inst, regs, false, true,  false ); }
+DEF_INST( vector_multiply_and_add_logical_even ) { ARCH_DEP( vector_multiply_wide )( inst, regs, true,  false, true  ); }
+DEF_INST( vector_multiply_and_add_logical_odd )  { ARCH_DEP( vector_multiply_wide )( inst, regs, true,  true,  true  ); }
+DEF_INST( vector_multiply_and_add_even )         { ARCH_DEP( vector_multiply_wide )( inst, regs, false, false, true  ); }
+DEF_INST( vector_multiply_and_add_odd )          { ARCH_DEP( vector_multiply_wide )( inst, regs, false, true,  true  ); }
+
+/*-------------------------------------------------------------------*/
+/* E7B4 VGFM  - Vector Galois Field Multiply Sum             [VRR-c] */
+/* E7BC VGFMA - Vector Galois Field Multiply Sum and Accumulate      */
+/*                                                           [VRR-d] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_gf_multiply_sum )( BYTE inst[], REGS* regs, bool acc )
+{
+int     v1, v2, v3, v4;                 /* Instruction fields        */
+int     m;                              /* Element size              */
+int     m5, m6;                         /* Unused                    */
+int     i;                              /* Element index             */
+U64     h0, l0, h1, l1;                 /* Doubleword products       */
+VR      a, b, c, r;                     /* Operands and result       */
+
+    if (acc)
+    {
+        VRR_D( inst, regs, v1, v2, v3, v4, m, m6 );
+        m5 = 0;
+    }
+    else
+    {
+        VRR_C( inst, regs, v1, v2, v3, m, m5, m6 );
+        v4 = 0;
+    }
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m > 3, regs );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    if (m == 3)
+    {
+        clmul128( VR_D( a, 0 ), VR_D( b, 0 ), &h0, &l0 );
+        clmul128( VR_D( a, 1 ), VR_D( b, 1 ), &h1, &l1 );
+        VR_D( r, 0 ) = h0 ^ h1;
+        VR_D( r, 1 ) = l0 ^ l1;
+    }
+    else
+    {
+        VR_D( r, 0 ) = VR_D( r, 1 ) = 0;
+        for (i=0; i < NELEM( m+1 ); i++)
+            vr_put( &r, m+1, i, clmul( vr_get( &a, m, 2*i   ), vr_get( &b, m, 2*i   ))
+                              ^ clmul( vr_get( &a, m, 2*i+1 ), vr_get( &b, m, 2*i+1 )));
+    }
+
+    if (acc)
+    {
+        vr_fetch( regs, v4, &c );
+        VR_D( r, 0 ) ^= VR_D( c, 0 );
+        VR_D( r, 1 ) ^= VR_D( c, 1 );
+    }
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_galois_field_multiply_sum )                { ARCH_DEP( vector_gf_multiply_sum )( inst, regs, false ); }
+DEF_INST( vector_galois_field_multiply_sum_and_accumulate ) { ARCH_DEP( vector_gf_multiply_sum )( inst, regs, true  ); }
+
+/*-------------------------------------------------------------------*/
+/* E7B9 VACCC - Vector Add With Carry Compute Carry          [VRR-d] */
+/* E7BB VAC   - Vector Add With Carry                        [VRR-d] */
+/* E7BD VSBCBI - Vector Subtract With Borrow Compute Borrow          */
+/*              Indication                                   [VRR-d] */
+/* E7BF VSBI  - Vector Subtract With Borrow Indication       [VRR-d] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_add_carry_in )( BYTE inst[], REGS* regs, bool sub, bool carry )
+{
+int     v1, v2, v3, v4;                 /* Instruction fields        */
+int     m5;                             /* Element size              */
+int     m6;                             /* Unused                    */
+int     c;                              /* Carry out                 */
+VR      a, b, d, r;                     /* Operands and result       */
+
+    VRR_D( inst, regs, v1, v2, v3, v4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m5 != 4, regs );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    vr_fetch( regs, v4, &d );
+
+    /* Subtraction adds the complement; the carry (or borrow      */
+    /* indication) in is the rightmost bit of the fourth operand  */
+    if (sub)
+        vr_not( &b, &b );
+    c = vr_add128( &r, &a, &b, (int)(VR_D( d, 1 ) & 1) );
+
+    if (carry)
+    {
+        VR_D( r, 0 ) = 0;
+        VR_D( r, 1 ) = c;
+    }
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_add_with_carry_compute_carry )                    { ARCH_DEP( vector_add_carry_in )( inst, regs, false, true  ); }
+DEF_INST( vector_add_with_carry )                                  { ARCH_DEP( vector_add_carry_in )( inst, regs, false, false ); }
+DEF_INST( vector_subtract_with_borrow_compute_borrow_indication ) { ARCH_DEP( vector_add_carry_in )( inst, regs, true,  true  ); }
+DEF_INST( vector_subtract_with_borrow_indication )                 { ARCH_DEP( vector_add_carry_in )( inst, regs, true,  false ); }
+
+/*-------------------------------------------------------------------*/
+/* E7D4 VUPLL - Vector Unpack Logical Low                    [VRR-a] */
+/* E7D5 VUPLH - Vector Unpack Logical High                   [VRR-a] */
+/* E7D6 VUPL  - Vector Unpack Low                            [VRR-a] */
+/* E7D7 VUPH  - Vector Unpack High                           [VRR-a] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_unpack )( BYTE inst[], REGS* regs, bool logical, bool low )
+{
+int     v1, v2;                         /* Instruction fields        */
+int     m3;                             /* Element size              */
+int     m4, m5;                         /* Unused                    */
+int     n;                              /* Result elements           */
+int     i;                              /* Element index             */
+VR      a, r;                           /* Operand and result        */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m3 > 2, regs );
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    vr_fetch( regs, v2, &a );
+    n = NELEM( m3+1 );
+    for (i=0; i < n; i++)
+        vr_put( &r, m3+1, i, logical ? vr_get( &a, m3, (low ? n : 0) + i )
+                            : (U64) vr_gets( &a, m3, (low ? n : 0) + i ));
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_unpack_logical_low )  { ARCH_DEP( vector_unpack )( inst, regs, true,  true  ); }
+DEF_INST( vector_unpack_logical_high ) { ARCH_DEP( vector_unpack )( inst, regs, true,  false ); }
+DEF_INST( vector_unpack_low )          { ARCH_DEP( vector_unpack )( inst, regs, false, true  ); }
+DEF_INST( vector_unpack_high )         { ARCH_DEP( vector_unpack )( inst, regs, false, false ); }
+
+/*-------------------------------------------------------------------*/
+/* E7D8 VTM   - Vector Test Under Mask                       [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_test_under_mask )
+{
+int     v1, v2;                         /* Instruction fields        */
+int     m3, m4, m5;                     /* Unused                    */
+U64     s0, s1;                         /* Selected bits             */
+VR      a, b;                           /* Operands                  */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    UNREFERENCED( m3 );
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    vr_fetch( regs, v1, &a );
+    vr_fetch( regs, v2, &b );
+    s0 = VR_D( a, 0 ) & VR_D( b, 0 );
+    s1 = VR_D( a, 1 ) & VR_D( b, 1 );
+
+    regs->psw.cc = !(s0 | s1)                                   ? 0
+                 : s0 == VR_D( b, 0 ) && s1 == VR_D( b, 1 )     ? 3
+                 :                                                1;
+}
+
+/*-------------------------------------------------------------------*/
+/* E7D9 VECL  - Vector Element Compare Logical               [VRR-a] */
+/* E7DB VEC   - Vector Element Compare                       [VRR-a] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_element_cmp )( BYTE inst[], REGS* regs, bool logical )
+{
+int     v1, v2;                         /* Instruction fields        */
+int     m3;                             /* Element size              */
+int     m4, m5;                         /* Unused                    */
+int     i;                              /* Element index             */
+VR      a, b;                           /* Operands                  */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m3 > 3, regs );
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    /* The rightmost element of doubleword 0 is compared */
+    vr_fetch( regs, v1, &a );
+    vr_fetch( regs, v2, &b );
+    i = NELEM( m3 ) / 2 - 1;
+
+    if (logical)
+        regs->psw.cc = vr_get( &a, m3, i ) == vr_get( &b, m3, i ) ? 0
+                     : vr_get( &a, m3, i ) <  vr_get( &b, m3, i ) ? 1 : 2;
+    else
+        regs->psw.cc = vr_gets( &a, m3, i ) == vr_gets( &b, m3, i ) ? 0
+                     : vr_gets( &a, m3, i ) <  vr_gets( &b, m3, i ) ? 1 : 2;
+}
+
+DEF_INST( vector_element_compare_logical ) { ARCH_DEP( vector_element_cmp )( inst, regs, true  ); }
+DEF_INST( vector_element_compare )         { ARCH_DEP( vector_element_cmp )( inst, regs, false ); }
+
+/*-------------------------------------------------------------------*/
+/* E7DE VLC   - Vector Load Complement                       [VRR-a] */
+/* E7DF VLP   - Vector Load Positive                         [VRR-a] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_load_complement_positive )( BYTE inst[], REGS* regs, bool positive )
+{
+int     v1, v2;                         /* Instruction fields        */
+int     m3;                             /* Element size              */
+int     m4, m5;                         /* Unused                    */
+S64     x;                              /* Element value             */
+int     i;                              /* Element index             */
+VR      a, r;                           /* Operand and result        */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m3 > 3, regs );
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    vr_fetch( regs, v2, &a );
+    for (i=0; i < NELEM( m3 ); i++)
+    {
+        x = vr_gets( &a, m3, i );
+        vr_put( &r, m3, i, (!positive || x < 0) ? 0 - (U64) x : (U64) x );
+    }
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_load_complement ) { ARCH_DEP( vector_load_complement_positive )( inst, regs, false ); }
+DEF_INST( vector_load_positive )   { ARCH_DEP( vector_load_complement_positive )( inst, regs, true  ); }
+
+/*-------------------------------------------------------------------*/
+/* E7F0 VAVGL - Vector Average Logical                       [VRR-c] */
+/* E7F2 VAVG  - Vector Average                               [VRR-c] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_avg )( BYTE inst[], REGS* regs, bool logical )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+int     m5, m6;                         /* Unused                    */
+int     i;                              /* Element index             */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 > 3, regs );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    /* (a + b + 1) / 2 computed without overflowing the element */
+    if (!logical || !SSE2_BINOP( ZV_AVGL, m4, &r, &a, &b ))
+    {
+        for (i=0; i < NELEM( m4 ); i++)
+        {
+            if (logical)
+            {
+                U64  x = vr_get( &a, m4, i ), y = vr_get( &b, m4, i );
+                vr_put( &r, m4, i, (x >> 1) + (y >> 1) + ((x | y) & 1) );
+            }
+            else
+            {
+                S64  x = vr_gets( &a, m4, i ), y = vr_gets( &b, m4, i );
+                vr_put( &r, m4, i, (U64)((x >> 1) + (y >> 1) + ((x | y) & 1)) );
+            }
+        }
+    }
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_average_logical ) { ARCH_DEP( vector_avg )( inst, regs, true  ); }
+DEF_INST( vector_average )         { ARCH_DEP( vector_avg )( inst, regs, false ); }
+
+/*-------------------------------------------------------------------*/
+/* E7F1 VACC  - Vector Add Compute Carry                     [VRR-c] */
+/* E7F3 VA    - Vector Add                                   [VRR-c] */
+/* E7F5 VSCBI - Vector Subtract Compute Borrow Indication    [VRR-c] */
+/* E7F7 VS    - Vector Subtract                              [VRR-c] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_add_subtract )( BYTE inst[], REGS* regs, bool sub, bool carry )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+int     m5, m6;                         /* Unused                    */
+int     i;                              /* Element index             */
+int     c;                              /* Carry out                 */
+U64     x, y, s;                        /* Elements and sum          */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 > 4, regs );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    if (m4 == 4)
+    {
+        /* Quadword: subtraction adds the complement plus one */
+        if (sub)
+            vr_not( &b, &b );
+        c = vr_add128( &r, &a, &b, sub ? 1 : 0 );
+        if (carry)
+        {
+            VR_D( r, 0 ) = 0;
+            VR_D( r, 1 ) = c;
+        }
+    }
+    else if (carry || !SSE2_BINOP( sub ? ZV_SUB : ZV_ADD, m4, &r, &a, &b ))
+    {
+        for (i=0; i < NELEM( m4 ); i++)
+        {
+            x = vr_get( &a, m4, i );
+            y = vr_get( &b, m4, i );
+            if (!carry)
+                s = sub ? x - y : x + y;
+            else if (sub)
+                s = x >= y;                     /* 1 if no borrow    */
+            else if (m4 == 3)
+                s = x + y < x;
+            else
+                s = (x + y) >> EBITS( m4 );
+            vr_put( &r, m4, i, s );
+        }
+    }
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_add_compute_carry )                  { ARCH_DEP( vector_add_subtract )( inst, regs, false, true  ); }
+DEF_INST( vector_add )                                { ARCH_DEP( vector_add_subtract )( inst, regs, false, false ); }
+DEF_INST( vector_subtract_compute_borrow_indication ) { ARCH_DEP( vector_add_subtract )( inst, regs, true,  true  ); }
+DEF_INST( vector_subtract )                           { ARCH_DEP( vector_add_subtract )( inst, regs, true,  false ); }
+
+/*-------------------------------------------------------------------*/
+/* E7F8 VCEQ  - Vector Compare Equal                         [VRR-b] */
+/* E7F9 VCHL  - Vector Compare High Logical                  [VRR-b] */
+/* E7FB VCH   - Vector Compare High                          [VRR-b] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_compare )( BYTE inst[], REGS* regs, int op )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+int     m5;                             /* Flags (CS)                */
+int     i;                              /* Element index             */
+bool    t;                              /* Element compare result    */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRR_B( inst, regs, v1, v2, v3, m4, m5 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    if (!SSE2_BINOP( op, m4, &r, &a, &b ))
+    {
+        for (i=0; i < NELEM( m4 ); i++)
+        {
+            switch (op)
+            {
+            case ZV_CEQ: t = vr_get(  &a, m4, i ) == vr_get(  &b, m4, i ); break;
+            case ZV_CHL: t = vr_get(  &a, m4, i ) >  vr_get(  &b, m4, i ); break;
+            default:     t = vr_gets( &a, m4, i ) >  vr_gets( &b, m4, i ); break;
+            }
+            vr_put( &r, m4, i, t ? 0xFFFFFFFFFFFFFFFFULL : 0 );
+        }
+    }
+    vr_store( regs, v1, &r );
+
+    if (m5 & 0x1)
+        regs->psw.cc = compare_cc( &r );
+}
+
+DEF_INST( vector_compare_equal )        { ARCH_DEP( vector_compare )( inst, regs, ZV_CEQ ); }
+DEF_INST( vector_compare_high_logical ) { ARCH_DEP( vector_compare )( inst, regs, ZV_CHL ); }
+DEF_INST( vector_compare_high )         { ARCH_DEP( vector_compare )( inst, regs, ZV_CH  ); }
+
+/*-------------------------------------------------------------------*/
+/* E7FC VMNL  - Vector Minimum Logical                       [VRR-c] */
+/* E7FD VMXL  - Vector Maximum Logical                       [VRR-c] */
+/* E7FE VMN   - Vector Minimum                               [VRR-c] */
+/* E7FF VMX   - Vector Maximum                               [VRR-c] */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vector_minimum_maximum )( BYTE inst[], REGS* regs, int op )
+{
+int     v1, v2, v3;                     /* Instruction fields        */
+int     m4;                             /* Element size              */
+int     m5, m6;                         /* Unused                    */
+int     i;                              /* Element index             */
+bool    lt;                             /* First operand is lower    */
+VR      a, b, r;                        /* Operands and result       */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+    ZVECTOR_CHECK( regs );
+    ZV_SPEC_CHECK( m4 > 3, regs );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    if (!SSE2_BINOP( op, m4, &r, &a, &b ))
+    {
+        for (i=0; i < NELEM( m4 ); i++)
+        {
+            lt = op == ZV_MNL || op == ZV_MXL
+               ? vr_get(  &a, m4, i ) < vr_get(  &b, m4, i )
+               : vr_gets( &a, m4, i ) < vr_gets( &b, m4, i );
+
+            if (op == ZV_MX || op == ZV_MXL)
+                lt = !lt;
+
+            vr_put( &r, m4, i, vr_get( lt ? &a : &b, m4, i ));
+        }
+    }
+    vr_store( regs, v1, &r );
+}
+
+DEF_INST( vector_minimum_logical ) { ARCH_DEP( vector_minimum_maximum )( inst, regs, ZV_MNL ); }
+DEF_INST( vector_maximum_logical ) { ARCH_DEP( vector_minimum_maximum )( inst, regs, ZV_MXL ); }
+DEF_INST( vector_minimum )         { ARCH_DEP( vector_minimum_maximum )( inst, regs, ZV_MN  ); }
+DEF_INST( vector_maximum )         { ARCH_DEP( vector_minimum_maximum )( inst, regs, ZV_MX  ); }
+
+#endif /* defined( FEATURE_129_ZVECTOR_FACILITY ) */
+
+/*-------------------------------------------------------------------*/
+/*          (delineates ARCH_DEP from non-arch_dep)                  */
+/*-------------------------------------------------------------------*/
+
+#if !defined( _GEN_ARCH )
+
+  #if defined(              _ARCH_NUM_1 )
+    #define   _GEN_ARCH     _ARCH_NUM_1
+    #include "zvector.c"
+  #endif
+
+  #if defined(              _ARCH_NUM_2 )
+    #undef    _GEN_ARCH
+    #define   _GEN_ARCH     _ARCH_NUM_2
+    #include "zvector.c"
+  #endif
+
+#endif /* !defined( _GEN_ARCH ) */